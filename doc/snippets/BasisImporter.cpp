@@ -24,12 +24,15 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
 #include <Magnum/Trade/AbstractImporter.h>
 #include <Magnum/Trade/ImageData.h>
 
+#include "MagnumPlugins/BasisImporter/BasisImporter.h"
+
 #ifdef MAGNUM_TARGET_GL
 #include <Corrade/PluginManager/PluginMetadata.h>
 #include <Magnum/GL/Context.h>
@@ -75,6 +78,32 @@ image = importer->image2D(0);
 /* [target-format-config] */
 }
 
+{
+PluginManager::Manager<Trade::AbstractImporter> manager;
+/* [transcode-into] */
+Containers::Pointer<Trade::AbstractImporter> importer =
+    manager.instantiate("BasisImporterBc3RGBA");
+auto& basisImporter = static_cast<Trade::BasisImporter&>(*importer);
+basisImporter.configuration().setValue("threads", 0);
+basisImporter.openFile("mytexture.basis");
+
+/* Calculate where each level of the first image goes */
+const UnsignedInt levelCount = basisImporter.image2DLevelCount(0);
+Containers::Array<std::size_t> offsets{levelCount + 1};
+for(UnsignedInt i = 0; i != levelCount; ++i)
+    offsets[i + 1] = offsets[i] + basisImporter.image2DTranscodedDataSize(0, i);
+
+/* Transcode the whole mip chain into a single staging buffer */
+Containers::Array<char> staging{NoInit, offsets[levelCount]};
+Containers::Array<Trade::BasisImporter::TranscodeJob> jobs{levelCount};
+for(UnsignedInt i = 0; i != levelCount; ++i)
+    jobs[i] = {0, i, staging.slice(offsets[i], offsets[i + 1])};
+if(!basisImporter.transcodeImage2DInto(jobs)) {
+    // handle errors
+}
+/* [transcode-into] */
+}
+
 #ifdef MAGNUM_TARGET_GL
 {
 PluginManager::Manager<Trade::AbstractImporter> manager;
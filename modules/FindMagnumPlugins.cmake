@@ -391,8 +391,8 @@ foreach(_component ${MagnumPlugins_FIND_COMPONENTS})
                     INTERFACE_LINK_LIBRARIES ${JPEG_LIBRARIES})
             endif()
 
-        # KtxImageConverter has no dependencies
-        # KtxImporter has no dependencies
+        # KtxImageConverter / KtxImporter have only optional dependencies,
+        # linked below for static builds
 
         # MeshOptimizerSceneConverter plugin dependencies
         elseif(_component STREQUAL MeshOptimizerSceneConverter)
@@ -474,6 +474,23 @@ foreach(_component ${MagnumPlugins_FIND_COMPONENTS})
             endif()
         endif()
 
+        # Optional supercompression dependencies of static KtxImageConverter /
+        # KtxImporter, the plugin records them in its configure.h
+        if((_component STREQUAL KtxImageConverter OR _component STREQUAL KtxImporter) AND _MAGNUMPLUGINS_${_COMPONENT}_INCLUDE_DIR AND NOT _magnumPlugins${_component}_BUILD_STATIC EQUAL -1)
+            string(FIND "${_magnumPlugins${_component}Configure}" "#define MAGNUM_${_COMPONENT}_WITH_ZSTD" _magnumPlugins${_component}_WITH_ZSTD)
+            if(NOT _magnumPlugins${_component}_WITH_ZSTD EQUAL -1)
+                find_package(Zstd)
+                set_property(TARGET MagnumPlugins::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Zstd::Zstd)
+            endif()
+            string(FIND "${_magnumPlugins${_component}Configure}" "#define MAGNUM_${_COMPONENT}_WITH_ZLIB" _magnumPlugins${_component}_WITH_ZLIB)
+            if(NOT _magnumPlugins${_component}_WITH_ZLIB EQUAL -1)
+                find_package(ZLIB)
+                set_property(TARGET MagnumPlugins::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES ZLIB::ZLIB)
+            endif()
+        endif()
+
         if(_component IN_LIST _MAGNUMPLUGINS_PLUGIN_COMPONENTS OR _component IN_LIST _MAGNUMPLUGINS_LIBRARY_COMPONENTS)
             # Link to core Magnum library, add other Magnum dependencies
             set_property(TARGET MagnumPlugins::${_component} APPEND PROPERTY
@@ -25,6 +25,7 @@
 
 #include "Parsers.h"
 
+#include <cmath>
 #include <cstring>
 #include <limits>
 #include <tuple>
@@ -117,11 +118,6 @@ template<std::size_t n> inline const char* prefix(const Containers::ArrayView<co
     return equalsPrefix(data.prefix(end), compare) ? end : nullptr;
 }
 
-void extractWithoutUnderscore(const Containers::ArrayView<const char> data, std::string& buffer) {
-    buffer.clear();
-    for(char c: data) if(c != '_') buffer += c;
-}
-
 }
 
 bool equals(const Containers::ArrayView<const char> a, const Containers::ArrayView<const char> b) {
@@ -293,57 +289,6 @@ template<> struct IntegralType<Double> {
 };
 template<class T> using IntegralTypeFor = typename IntegralType<T>::Type;
 
-template<class> struct ExtractToType;
-/** @todo isn't there something better for extracting to unsigned int on webgl? */
-#ifndef CORRADE_TARGET_EMSCRIPTEN
-template<> struct ExtractToType<UnsignedLong> {
-    typedef UnsignedLong Type;
-    static UnsignedLong extract(const std::string& buffer, Int base) {
-        return std::stoul(buffer, nullptr, base);
-    }
-};
-template<> struct ExtractToType<UnsignedByte>: ExtractToType<UnsignedLong> {};
-template<> struct ExtractToType<Byte>: ExtractToType<UnsignedLong> {};
-template<> struct ExtractToType<UnsignedShort>: ExtractToType<UnsignedLong> {};
-template<> struct ExtractToType<Short>: ExtractToType<UnsignedLong> {};
-template<> struct ExtractToType<UnsignedInt>: ExtractToType<UnsignedLong> {};
-template<> struct ExtractToType<Int>: ExtractToType<UnsignedLong> {};
-template<> struct ExtractToType<Long>: ExtractToType<UnsignedLong> {};
-#ifdef CORRADE_TARGET_APPLE
-template<> struct ExtractToType<unsigned long>: ExtractToType<UnsignedLong> {};
-template<> struct ExtractToType<long>: ExtractToType<UnsignedLong> {};
-#endif
-#else
-template<> struct ExtractToType<UnsignedInt> {
-    typedef UnsignedInt Type;
-    static UnsignedInt extract(const std::string& buffer, Int base) {
-        return std::stoi(buffer, nullptr, base);
-    }
-};
-template<> struct ExtractToType<UnsignedByte>: ExtractToType<UnsignedInt> {};
-template<> struct ExtractToType<Byte>: ExtractToType<UnsignedInt> {};
-template<> struct ExtractToType<UnsignedShort>: ExtractToType<UnsignedInt> {};
-template<> struct ExtractToType<Short>: ExtractToType<UnsignedInt> {};
-template<> struct ExtractToType<Int>: ExtractToType<UnsignedInt> {};
-/* Emscripten 1.38.10 and newer has std::size_t defined as unsigned long, while
-   it was unsigned int before. We should support both cases,
-   integralLiteral<std::size_t>() is used in some places in the parsers. */
-static_assert(sizeof(unsigned long) == 4, "unsigned long is not four bytes on Emscripten");
-template<> struct ExtractToType<unsigned long>: ExtractToType<UnsignedInt> {};
-#endif
-template<class T> using ExtractedType = typename ExtractToType<T>::Type;
-
-template<> struct ExtractToType<Float> {
-    static Float extract(const std::string& buffer) {
-        return std::stof(buffer);
-    }
-};
-template<> struct ExtractToType<Double> {
-    static Double extract(const std::string& buffer) {
-        return std::stod(buffer);
-    }
-};
-
 template<class> constexpr Type typeFor();
 #define _c(T) template<> constexpr Type typeFor<T>() { return Type::T; }
 _c(UnsignedByte)
@@ -380,52 +325,369 @@ blah LONG_MAX i/ugh
 #endif
 #endif
 
-template<Int base> const char* possiblyNumericCharacters(const Containers::ArrayView<const char> data) {
-    /* Propagate errors */
-    if(!data) return {};
-
-    const char* i = data;
-    while(i != data.end() && (isBaseN<base>(*i) || (i != data && *i == '_'))) ++i;
+/* Value of a (verified) digit in base 16 or less */
+constexpr UnsignedInt digitValue(char c) {
+    return c <= '9' ? c - '0' : (c | 0x20) - 'a' + 0xa;
+}
 
-    return i;
+#ifndef CORRADE_TARGET_BIG_ENDIAN
+/* If all eight characters are decimal digits, returns their value, otherwise
+   ~0. Adding 6 to a byte makes everything above '9' overflow into the upper
+   nibble, so a byte is a digit if its upper nibble is 3 both before and after
+   the addition. The digits are then combined pairwise in three
+   multiplications, on little-endian the first digit is in the lowest byte. */
+inline UnsignedLong eightDecimalDigits(const char* const data) {
+    UnsignedLong v;
+    std::memcpy(&v, data, 8);
+    if(((v & 0xf0f0f0f0f0f0f0f0ull)|(((v + 0x0606060606060606ull) & 0xf0f0f0f0f0f0f0f0ull) >> 4)) != 0x3333333333333333ull)
+        return ~UnsignedLong{};
+
+    v = ((v & 0x0f0f0f0f0f0f0f0full)*2561) >> 8;
+    v = ((v & 0x00ff00ff00ff00ffull)*6553601) >> 16;
+    return ((v & 0x0000ffff0000ffffull)*42949672960001ull) >> 32;
 }
+#endif
 
-template<Int base, class T> const char* numericCharacters(const Containers::ArrayView<const char> data, ParseError& error) {
+template<Int base, class T> std::pair<const char*, T> baseNLiteral(const Containers::ArrayView<const char> data, ParseError& error) {
     /* Propagate errors */
     if(!data) return {};
 
-    const char* const i = possiblyNumericCharacters<base>(data);
+    /* Accumulate the value directly, skipping underscores (except for a
+       leading one, which isn't allowed) */
+    UnsignedLong value = 0;
+    bool overflow = false;
+    const char* i = data;
+    for(; i != data.end(); ++i) {
+        const char c = *i;
+        if(c == '_' && i != data) continue;
+        if(!isBaseN<base>(c)) break;
+
+        const UnsignedInt digit = digitValue(c);
+        if(value > (~UnsignedLong{} - digit)/base) overflow = true;
+        value = value*base + digit;
+    }
 
     if(i == data) {
         error = {ParseErrorType::InvalidLiteral, typeFor<T>(), data};
         return {};
     }
 
+    if(overflow || value > UnsignedLong(std::numeric_limits<T>::max())) {
+        error = {ParseErrorType::LiteralOutOfRange, typeFor<T>(), data};
+        return {};
+    }
+
+    return {i, T(value)};
+}
+
+/* Decimal digits of a floating-point literal, the value is
+   mantissa*10^exponent */
+struct DecimalMantissa {
+    UnsignedLong value;
+    /* Count of significant digits in value, i.e. without leading zeros */
+    Int digits;
+    Int exponent;
+};
+
+/* Up to 19 decimal digits always fit into 64 bits */
+constexpr Int MaxMantissaDigits = 19;
+
+/* Consumes decimal digits and underscores (except for a leading one) into the
+   mantissa. Digits that don't fit anymore only increase the exponent if
+   they're before the decimal point and are dropped if after. */
+const char* decimalDigits(const char* i, const char* const end, DecimalMantissa& mantissa, const bool fraction) {
+    const char* const begin = i;
+    while(i != end) {
+        #ifndef CORRADE_TARGET_BIG_ENDIAN
+        /* Eight digits at once, as long as they're all digits and fit */
+        if(end - i >= 8 && mantissa.digits + 8 <= MaxMantissaDigits) {
+            const UnsignedLong eight = eightDecimalDigits(i);
+            if(eight != ~UnsignedLong{}) {
+                if(mantissa.value) mantissa.digits += 8;
+                else for(UnsignedLong j = eight; j; j /= 10) ++mantissa.digits;
+                mantissa.value = mantissa.value*100000000ull + eight;
+                if(fraction) mantissa.exponent -= 8;
+                i += 8;
+                continue;
+            }
+        }
+        #endif
+
+        const char c = *i;
+        if(c == '_' && i != begin) {
+            ++i;
+            continue;
+        }
+        if(!isBaseN<10>(c)) break;
+
+        if(mantissa.digits < MaxMantissaDigits) {
+            mantissa.value = mantissa.value*10 + digitValue(c);
+            if(mantissa.value) ++mantissa.digits;
+            if(fraction) --mantissa.exponent;
+        } else if(!fraction) ++mantissa.exponent;
+
+        ++i;
+    }
+
     return i;
 }
 
-template<Int base, class T> std::pair<const char*, T> baseNLiteral(const Containers::ArrayView<const char> data, std::string& buffer, ParseError& error) {
-    /* Propagate errors */
-    if(!data) return {};
+/* Powers of ten that are exactly representable in a double */
+constexpr Double ExactPowersOfTen[]{
+    1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7, 1.0e8, 1.0e9,
+    1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16, 1.0e17, 1.0e18,
+    1.0e19, 1.0e20, 1.0e21, 1.0e22
+};
+
+/* Powers of ten that are exactly representable in a float */
+constexpr Float ExactFloatPowersOfTen[]{
+    1.0e0f, 1.0e1f, 1.0e2f, 1.0e3f, 1.0e4f, 1.0e5f, 1.0e6f, 1.0e7f, 1.0e8f,
+    1.0e9f, 1.0e10f
+};
 
-    const char* i = numericCharacters<base, T>(data, error);
+/* Arbitrary-precision unsigned integer, just large enough for comparing
+   any decimal literal that's in range of a double with a halfway point
+   between two doubles, see correctlyRounded() below */
+struct BigInteger {
+    enum: std::size_t { Capacity = 128 };
 
-    /* Propagate errors */
-    if(!i) return {};
+    explicit BigInteger(UnsignedLong value = 0): size{0} {
+        for(; value; value >>= 32) limbs[size++] = UnsignedInt(value);
+    }
 
-    extractWithoutUnderscore(data.prefix(i), buffer);
-    const ExtractedType<T> out = ExtractToType<T>::extract(buffer, base);
-    if(out > ExtractedType<T>(std::numeric_limits<T>::max())) {
-        error = {ParseErrorType::LiteralOutOfRange, typeFor<T>(), data};
-        return {};
+    UnsignedInt limbs[Capacity];
+    std::size_t size;
+};
+
+void multiplyAdd(BigInteger& integer, const UnsignedInt multiplier, UnsignedInt addend = 0) {
+    UnsignedLong carry = addend;
+    for(std::size_t i = 0; i != integer.size; ++i) {
+        carry += UnsignedLong(integer.limbs[i])*multiplier;
+        integer.limbs[i] = UnsignedInt(carry);
+        carry >>= 32;
+    }
+    if(carry) {
+        CORRADE_INTERNAL_ASSERT(integer.size < BigInteger::Capacity);
+        integer.limbs[integer.size++] = UnsignedInt(carry);
+    }
+}
+
+void multiplyPowerOfFive(BigInteger& integer, Int exponent) {
+    /* 5^13 is the largest power of five that fits into 32 bits */
+    for(; exponent >= 13; exponent -= 13) multiplyAdd(integer, 1220703125u);
+    UnsignedInt power = 1;
+    for(; exponent; --exponent) power *= 5;
+    multiplyAdd(integer, power);
+}
+
+void shiftLeft(BigInteger& integer, const Int bits) {
+    if(!integer.size) return;
+
+    const std::size_t limbs = bits/32;
+    const Int remainder = bits%32;
+    CORRADE_INTERNAL_ASSERT(integer.size + limbs + 1 <= BigInteger::Capacity);
+    integer.limbs[integer.size + limbs] = 0;
+    for(std::size_t i = integer.size; i != 0; --i) {
+        const UnsignedLong shifted = UnsignedLong(integer.limbs[i - 1]) << remainder;
+        integer.limbs[i + limbs] |= UnsignedInt(shifted >> 32);
+        integer.limbs[i - 1 + limbs] = UnsignedInt(shifted);
+    }
+    for(std::size_t i = 0; i != limbs; ++i) integer.limbs[i] = 0;
+    integer.size += limbs + 1;
+    if(!integer.limbs[integer.size - 1]) --integer.size;
+}
+
+Int compare(const BigInteger& a, const BigInteger& b) {
+    if(a.size != b.size) return a.size < b.size ? -1 : 1;
+    for(std::size_t i = a.size; i != 0; --i)
+        if(a.limbs[i - 1] != b.limbs[i - 1])
+            return a.limbs[i - 1] < b.limbs[i - 1] ? -1 : 1;
+    return 0;
+}
+
+/* Compares digits*10^exponent10 with halfway*2^exponent2, returning -1, 0 or
+   1 if it's less, equal or greater */
+Int compareWithHalfway(const BigInteger& digits, const Int exponent10, const UnsignedLong halfway, const Int exponent2) {
+    BigInteger a = digits;
+    BigInteger b{halfway};
+    if(exponent10 < 0) multiplyPowerOfFive(b, -exponent10);
+    else multiplyPowerOfFive(a, exponent10);
+    if(exponent10 > exponent2) shiftLeft(a, exponent10 - exponent2);
+    else shiftLeft(b, exponent2 - exponent10);
+    return compare(a, b);
+}
+
+/* Significant decimal digits above which the rest is only remembered as being
+   zero or not. No halfway point between two doubles needs more than 767. */
+constexpr Int MaxExactDigits = 800;
+
+/* Nudges an approximation that's at most a few ULPs off to the correctly
+   rounded value of the decimal literal, ties to even. The digits are taken
+   from the original text, as the mantissa may have some of them dropped. */
+template<class T> T correctlyRounded(T value, const Containers::ArrayView<const char> text, Int exponent) {
+    BigInteger digits;
+    Int significant = 0;
+    bool fraction = false, sticky = false;
+    UnsignedInt chunk = 0, chunkPower = 1;
+    for(const char c: text) {
+        if(c == '.') {
+            fraction = true;
+            continue;
+        }
+        if(c == '_') continue;
+
+        if(fraction) --exponent;
+        if(!significant && c == '0') continue;
+
+        if(significant < MaxExactDigits) {
+            chunk = chunk*10 + digitValue(c);
+            chunkPower *= 10;
+            if(chunkPower == 1000000000) {
+                multiplyAdd(digits, chunkPower, chunk);
+                chunk = 0;
+                chunkPower = 1;
+            }
+            ++significant;
+        } else {
+            if(c != '0') sticky = true;
+            ++exponent;
+        }
+    }
+    multiplyAdd(digits, chunkPower, chunk);
+
+    /* Anything nonzero after the exact digits puts the value strictly between
+       the exact digits and their successor */
+    if(sticky) {
+        multiplyAdd(digits, 10, 1);
+        --exponent;
+    }
+
+    /* Values that are clearly out of range, without getting the integers
+       unnecessarily large */
+    if(significant + exponent > std::numeric_limits<Double>::max_exponent10 + 1)
+        return std::numeric_limits<T>::infinity();
+    if(significant + exponent < std::numeric_limits<Double>::min_exponent10 - 30)
+        return T(0);
+
+    constexpr Int MantissaBits = std::numeric_limits<T>::digits;
+    constexpr Int MinExponent = std::numeric_limits<T>::min_exponent - MantissaBits;
+    if(std::isinf(value)) value = std::numeric_limits<T>::max();
+    for(;;) {
+        /* Value as an integer times a power of two, the integer having less
+           bits for denormals */
+        Int exponent2 = MinExponent;
+        if(value != T(0)) {
+            std::frexp(value, &exponent2);
+            exponent2 -= MantissaBits;
+            if(exponent2 < MinExponent) exponent2 = MinExponent;
+        }
+        const UnsignedLong integer = UnsignedLong(std::ldexp(value, -exponent2));
+
+        /* Above the halfway point to the next value or exactly on it and the
+           next value is even, go up */
+        const Int above = compareWithHalfway(digits, exponent, 2*integer + 1, exponent2 - 1);
+        if(above > 0 || (above == 0 && (integer & 1))) {
+            value = std::nextafter(value, std::numeric_limits<T>::infinity());
+            if(above == 0 || std::isinf(value)) return value;
+            continue;
+        }
+
+        if(!integer) return value;
+
+        /* Below the halfway point to the previous value, which is twice as
+           close for powers of two, or exactly on it and the previous value is
+           even, go down */
+        const bool powerOfTwo = integer == 1ull << (MantissaBits - 1) && exponent2 != MinExponent;
+        const Int below = powerOfTwo ?
+            compareWithHalfway(digits, exponent, 4*integer - 1, exponent2 - 2) :
+            compareWithHalfway(digits, exponent, 2*integer - 1, exponent2 - 1);
+        if(below < 0 || (below == 0 && (integer & 1))) {
+            value = std::nextafter(value, T(0));
+            if(below == 0) return value;
+            continue;
+        }
+
+        return value;
     }
+}
 
-    return {i, T(out)};
+/* If both the mantissa and the power of ten are exactly representable in
+   the type, a single multiplication or division is correctly rounded. That's
+   the case for the vast majority of literals in practice. */
+template<class T> bool exactFastPath(const DecimalMantissa&, T&);
+template<> bool exactFastPath(const DecimalMantissa& mantissa, Float& out) {
+    if(mantissa.value > (1ull << 24) || mantissa.exponent < -10 || mantissa.exponent > 10)
+        return false;
+
+    const Float value = Float(mantissa.value);
+    out = mantissa.exponent < 0 ?
+        value/ExactFloatPowersOfTen[-mantissa.exponent] :
+        value*ExactFloatPowersOfTen[mantissa.exponent];
+    return true;
+}
+template<> bool exactFastPath(const DecimalMantissa& mantissa, Double& out) {
+    if(mantissa.value > (1ull << 53) || mantissa.exponent < -22 || mantissa.exponent > 22)
+        return false;
+
+    const Double value = Double(mantissa.value);
+    out = mantissa.exponent < 0 ?
+        value/ExactPowersOfTen[-mantissa.exponent] :
+        value*ExactPowersOfTen[mantissa.exponent];
+    return true;
 }
 
+/* Floats that don't hit their own fast path can still mostly use the double
+   one. The double is correctly rounded, so narrowing it to a float is correct
+   as well, unless it landed exactly halfway between two floats. */
+template<class T> bool narrowedFastPath(const DecimalMantissa&, T&) { return false; }
+template<> bool narrowedFastPath(const DecimalMantissa& mantissa, Float& out) {
+    Double value;
+    if(!exactFastPath(mantissa, value)) return false;
+
+    out = Float(value);
+    if(Double(out) == value) return true;
+    const Float other = std::nextafter(out, value < Double(out) ? 0.0f : std::numeric_limits<Float>::infinity());
+    return value != (Double(out) + Double(other))*0.5;
 }
 
-template<class T> std::tuple<const char*, T, Int> integralLiteral(const Containers::ArrayView<const char> data, std::string& buffer, ParseError& error) {
+template<class T> T decimalToFloatingPoint(const DecimalMantissa& mantissa, const Containers::ArrayView<const char> text, const Int exponent) {
+    if(!mantissa.value) return T(0);
+
+    T value;
+    if(exactFastPath(mantissa, value) || narrowedFastPath(mantissa, value))
+        return value;
+
+    /* Otherwise calculate an approximation with the power by squaring, in
+       extended precision where the platform has it */
+    const Int absoluteExponent = mantissa.exponent < 0 ? -mantissa.exponent : mantissa.exponent;
+    long double approximation = mantissa.value;
+    long double power = 10.0l;
+    for(Int e = absoluteExponent; e; e >>= 1, power *= power) {
+        if(!(e & 1)) continue;
+        if(mantissa.exponent < 0) approximation /= power;
+        else approximation *= power;
+    }
+    value = T(approximation);
+
+    /* If the extended precision is enough to tell that the approximation is
+       far from both halfway points around the nearest value, that value is
+       correctly rounded. The error bound accounts for the roundings in the
+       power calculation and for the digits dropped from the mantissa. On MSVC
+       long double is the same as double, there it always has to go through
+       the exact comparison below. */
+    if(std::numeric_limits<long double>::digits >= std::numeric_limits<T>::digits + 8 && value != T(0) && value < std::numeric_limits<T>::max()) {
+        const long double error = std::ldexp(approximation, -std::numeric_limits<long double>::digits)*(absoluteExponent + 32);
+        const long double below = (value + static_cast<long double>(std::nextafter(value, T(0))))*0.5l;
+        const long double above = (value + static_cast<long double>(std::nextafter(value, std::numeric_limits<T>::infinity())))*0.5l;
+        if(approximation - below > error && above - approximation > error)
+            return value;
+    }
+
+    return correctlyRounded(value, text, exponent);
+}
+}
+
+template<class T> std::tuple<const char*, T, Int> integralLiteral(const Containers::ArrayView<const char> data, ParseError& error) {
     /* Propagate errors */
     if(!data) return {};
 
@@ -462,19 +724,19 @@ template<class T> std::tuple<const char*, T, Int> integralLiteral(const Containe
         case 'x':
         case 'X': {
             base = 16;
-            std::tie(i, value) = baseNLiteral<16, T>(data.suffix(i + 2), buffer, error);
+            std::tie(i, value) = baseNLiteral<16, T>(data.suffix(i + 2), error);
             break;
         }
         case 'o':
         case 'O': {
             base = 8;
-            std::tie(i, value) = baseNLiteral<8, T>(data.suffix(i + 2), buffer, error);
+            std::tie(i, value) = baseNLiteral<8, T>(data.suffix(i + 2), error);
             break;
         }
         case 'b':
         case 'B': {
             base = 2;
-            std::tie(i, value) = baseNLiteral<2, T>(data.suffix(i + 2), buffer, error);
+            std::tie(i, value) = baseNLiteral<2, T>(data.suffix(i + 2), error);
             break;
         }
 
@@ -483,35 +745,35 @@ template<class T> std::tuple<const char*, T, Int> integralLiteral(const Containe
     /* Decimal literal  */
     } else {
         base = 10;
-        std::tie(i, value) = baseNLiteral<10, T>(data.suffix(i), buffer, error);
+        std::tie(i, value) = baseNLiteral<10, T>(data.suffix(i), error);
     }
 
     /** @todo C++14: use {} */
     return std::make_tuple(i, sign*value, base);
 }
 
-template std::tuple<const char*, UnsignedByte, Int> integralLiteral<UnsignedByte>(Containers::ArrayView<const char>, std::string&, ParseError&);
-template std::tuple<const char*, Byte, Int> integralLiteral<Byte>(Containers::ArrayView<const char>, std::string&, ParseError&);
-template std::tuple<const char*, UnsignedShort, Int> integralLiteral<UnsignedShort>(Containers::ArrayView<const char>, std::string&, ParseError&);
-template std::tuple<const char*, Short, Int> integralLiteral<Short>(Containers::ArrayView<const char>, std::string&, ParseError&);
-template std::tuple<const char*, UnsignedInt, Int> integralLiteral<UnsignedInt>(Containers::ArrayView<const char>, std::string&, ParseError&);
-template std::tuple<const char*, Int, Int> integralLiteral<Int>(Containers::ArrayView<const char>, std::string&, ParseError&);
+template std::tuple<const char*, UnsignedByte, Int> integralLiteral<UnsignedByte>(Containers::ArrayView<const char>, ParseError&);
+template std::tuple<const char*, Byte, Int> integralLiteral<Byte>(Containers::ArrayView<const char>, ParseError&);
+template std::tuple<const char*, UnsignedShort, Int> integralLiteral<UnsignedShort>(Containers::ArrayView<const char>, ParseError&);
+template std::tuple<const char*, Short, Int> integralLiteral<Short>(Containers::ArrayView<const char>, ParseError&);
+template std::tuple<const char*, UnsignedInt, Int> integralLiteral<UnsignedInt>(Containers::ArrayView<const char>, ParseError&);
+template std::tuple<const char*, Int, Int> integralLiteral<Int>(Containers::ArrayView<const char>, ParseError&);
 #ifdef CORRADE_TARGET_APPLE
-template std::tuple<const char*, unsigned long, Int> integralLiteral<unsigned long>(Containers::ArrayView<const char>, std::string&, ParseError&);
-template std::tuple<const char*, long, Int> integralLiteral<long>(Containers::ArrayView<const char>, std::string&, ParseError&);
+template std::tuple<const char*, unsigned long, Int> integralLiteral<unsigned long>(Containers::ArrayView<const char>, ParseError&);
+template std::tuple<const char*, long, Int> integralLiteral<long>(Containers::ArrayView<const char>, ParseError&);
 #endif
 #ifndef CORRADE_TARGET_EMSCRIPTEN
-template std::tuple<const char*, UnsignedLong, Int> integralLiteral<UnsignedLong>(Containers::ArrayView<const char>, std::string&, ParseError&);
-template std::tuple<const char*, Long, Int> integralLiteral<Long>(Containers::ArrayView<const char>, std::string&, ParseError&);
+template std::tuple<const char*, UnsignedLong, Int> integralLiteral<UnsignedLong>(Containers::ArrayView<const char>, ParseError&);
+template std::tuple<const char*, Long, Int> integralLiteral<Long>(Containers::ArrayView<const char>, ParseError&);
 #else
 /* Emscripten 1.38.10 and newer has std::size_t defined as unsigned long, while
    it was unsigned int before. We should support both cases,
    integralLiteral<std::size_t>() is used in some places in the parsers. */
 static_assert(sizeof(unsigned long) == 4, "unsigned long is not four bytes on Emscripten");
-template std::tuple<const char*, unsigned long, Int> integralLiteral<unsigned long>(Containers::ArrayView<const char>, std::string&, ParseError&);
+template std::tuple<const char*, unsigned long, Int> integralLiteral<unsigned long>(Containers::ArrayView<const char>, ParseError&);
 #endif
 
-template<class T> std::pair<const char*, T> floatingPointLiteral(const Containers::ArrayView<const char> data, std::string& buffer, ParseError& error) {
+template<class T> std::pair<const char*, T> floatingPointLiteral(const Containers::ArrayView<const char> data, ParseError& error) {
     /* Propagate errors */
     if(!data) return {};
 
@@ -536,17 +798,17 @@ template<class T> std::pair<const char*, T> floatingPointLiteral(const Container
         switch(i[1]) {
             case 'x':
             case 'X': {
-                std::tie(i, integralValue) = baseNLiteral<16, IntegralTypeFor<T>>(data.suffix(i + 2), buffer, error);
+                std::tie(i, integralValue) = baseNLiteral<16, IntegralTypeFor<T>>(data.suffix(i + 2), error);
                 break;
             }
             case 'o':
             case 'O': {
-                std::tie(i, integralValue) = baseNLiteral<8, IntegralTypeFor<T>>(data.suffix(i + 2), buffer, error);
+                std::tie(i, integralValue) = baseNLiteral<8, IntegralTypeFor<T>>(data.suffix(i + 2), error);
                 break;
             }
             case 'b':
             case 'B': {
-                std::tie(i, integralValue) = baseNLiteral<2, IntegralTypeFor<T>>(data.suffix(i + 2), buffer, error);
+                std::tie(i, integralValue) = baseNLiteral<2, IntegralTypeFor<T>>(data.suffix(i + 2), error);
                 break;
             }
 
@@ -557,13 +819,18 @@ template<class T> std::pair<const char*, T> floatingPointLiteral(const Container
         return {i, sign*floatValue};
     }
 
+    /* The digits are parsed right during validation, without extracting them
+       anywhere. Can't use std::strtod() or similar, as these depend on
+       locale. */
+    DecimalMantissa mantissa{};
+
     /* Decimal before dot */
     const char* const before = i;
-    i = possiblyNumericCharacters<10>(data.suffix(i));
+    i = decimalDigits(i, data.end(), mantissa, false);
 
     /* Dot and decimal after dot */
-    if(i && i + 1 < data.end() && *i == '.') {
-        i = possiblyNumericCharacters<10>(data.suffix(i + 1));
+    if(i + 1 < data.end() && *i == '.') {
+        i = decimalDigits(i + 1, data.end(), mantissa, true);
 
         /* Expecting at least .0 or 0. */
         if(before + 1 == i) {
@@ -578,26 +845,49 @@ template<class T> std::pair<const char*, T> floatingPointLiteral(const Container
     }
 
     /* Exponent etc */
-    if(i && i != data.end() && (*i == 'e' || *i == 'E')) {
+    const char* const digitsEnd = i;
+    Int exponent = 0;
+    if(i != data.end() && (*i == 'e' || *i == 'E')) {
         ++i;
 
         /* Exponent sign */
-        if(*i == '+' || *i == '-') ++i;
+        bool negativeExponent = false;
+        if(i != data.end() && (*i == '+' || *i == '-')) {
+            negativeExponent = *i == '-';
+            ++i;
+        }
 
-        i = numericCharacters<10, T>(data.suffix(i), error);
-    }
+        const char* const exponentBegin = i;
+        for(; i != data.end(); ++i) {
+            const char c = *i;
+            if(c == '_' && i != exponentBegin) continue;
+            if(!isBaseN<10>(c)) break;
 
-    /* Propagate errors */
-    if(!i) return {};
+            /* Anything this large is out of range anyway, saturate to avoid
+               overflowing */
+            if(exponent < 100000) exponent = exponent*10 + digitValue(c);
+        }
+
+        if(i == exponentBegin) {
+            error = {ParseErrorType::InvalidLiteral, typeFor<T>(), data};
+            return {};
+        }
+
+        if(negativeExponent) exponent = -exponent;
+        mantissa.exponent += exponent;
+    }
 
-    /** @todo verifying out-of-range */
+    const T value = decimalToFloatingPoint<T>(mantissa, {before, std::size_t(digitsEnd - before)}, exponent);
+    if(std::isinf(value)) {
+        error = {ParseErrorType::LiteralOutOfRange, typeFor<T>(), data};
+        return {};
+    }
 
-    extractWithoutUnderscore(data.prefix(i), buffer);
-    return {i, ExtractToType<T>::extract(buffer)};
+    return {i, sign*value};
 }
 
-template std::pair<const char*, Float> floatingPointLiteral<Float>(Containers::ArrayView<const char>, std::string&, ParseError&);
-template std::pair<const char*, Double> floatingPointLiteral<Double>(Containers::ArrayView<const char>, std::string&, ParseError&);
+template std::pair<const char*, Float> floatingPointLiteral<Float>(Containers::ArrayView<const char>, ParseError&);
+template std::pair<const char*, Double> floatingPointLiteral<Double>(Containers::ArrayView<const char>, ParseError&);
 
 std::pair<const char*, std::string> stringLiteral(const Containers::ArrayView<const char> data, ParseError& error) {
     /* Propagate errors */
@@ -733,7 +1023,7 @@ std::pair<const char*, Type> typeLiteral(const Containers::ArrayView<const char>
     return {};
 }
 
-std::pair<const char*, InternalPropertyType> propertyValue(const Containers::ArrayView<const char> data, bool& boolValue, Int& integerValue, Float& floatingPointValue, std::string& stringValue, Containers::ArrayView<const char>& referenceValue, Type& typeValue, std::string& buffer, ParseError& error) {
+std::pair<const char*, InternalPropertyType> propertyValue(const Containers::ArrayView<const char> data, bool& boolValue, Int& integerValue, Float& floatingPointValue, std::string& stringValue, Containers::ArrayView<const char>& referenceValue, Type& typeValue, ParseError& error) {
     /* Propagate errors */
     if(!data) return {};
 
@@ -761,7 +1051,7 @@ std::pair<const char*, InternalPropertyType> propertyValue(const Containers::Arr
         /* Float literal if there is dot */
         for(const char* j = i; j != data.end(); ++j) {
             if(*j == '.') {
-                std::tie(i, floatingPointValue) = floatingPointLiteral<Float>(data, buffer, error);
+                std::tie(i, floatingPointValue) = floatingPointLiteral<Float>(data, error);
                 return {i, InternalPropertyType::Float};
             }
 
@@ -770,7 +1060,7 @@ std::pair<const char*, InternalPropertyType> propertyValue(const Containers::Arr
 
         /* Integer literal otherwise */
         Int base;
-        std::tie(i, integerValue, base) = integralLiteral<Int>(data, buffer, error);
+        std::tie(i, integerValue, base) = integralLiteral<Int>(data, error);
         switch(base) {
             case 2:
             case 8:
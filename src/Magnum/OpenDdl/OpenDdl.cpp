@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <tuple>
+#include <unordered_map>
 #include <Corrade/Utility/Debug.h>
 #include <Corrade/Utility/DebugStl.h>
 
@@ -160,7 +161,7 @@ bool checkReferencePrefix(Containers::Optional<Structure> s, Containers::ArrayVi
 
 }
 
-std::size_t Document::dereference(const std::size_t originatingStructure, const Containers::ArrayView<const char> reference) const {
+std::size_t Document::dereference(const std::size_t originatingStructure, const Containers::ArrayView<const char> reference, const Containers::ArrayView<const std::size_t> candidates) const {
     CORRADE_INTERNAL_ASSERT(!reference.empty());
 
     const Containers::ArrayView<const char> leafName = reference.suffix(Implementation::findLastOf(reference, "$%"));
@@ -174,11 +175,12 @@ std::size_t Document::dereference(const std::size_t originatingStructure, const
     }
 
     /* The element which has leaf name is the result if also the rest of the
-       reference prefix matches in parent structures */
+       reference prefix matches in parent structures. The candidates are all
+       structures with given leaf name, in order. */
     const Containers::ArrayView<const char> referencePrefix = reference.prefix(leafName.begin());
-    for(std::size_t i = 0; i != _structures.size(); ++i) {
+    for(const std::size_t i: candidates) {
         const Structure s{*this, _structures[i]};
-        if(s.hasName() && Implementation::equals(leafName, {s.name().data(), s.name().size()}) && checkReferencePrefix(s.parent(), referencePrefix))
+        if(checkReferencePrefix(s.parent(), referencePrefix))
             return i;
     }
 
@@ -190,11 +192,9 @@ bool Document::parse(Containers::ArrayView<const char> data, const std::initiali
     _propertyIdentifiers = {propertyIdentifiers.begin(), propertyIdentifiers.size()};
 
     Implementation::ParseError error;
-    std::string buffer;
-
     const char* i = Implementation::whitespace(data);
     std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>> references;
-    i = parseStructureList(NoParent, data.suffix(i), references, buffer, error);
+    i = parseStructureList(NoParent, data.suffix(i), references, error);
 
     if(!i) {
         /* Calculate line number */
@@ -297,7 +297,15 @@ bool Document::parse(Containers::ArrayView<const char> data, const std::initiali
         return false;
     }
 
-    /* Everything parsed, dereference references */
+    /* Everything parsed, index named structures so dereferencing doesn't
+       need to go through all of them for each reference */
+    std::unordered_map<std::string, std::vector<std::size_t>> structuresForName;
+    if(!references.empty()) for(std::size_t i = 0; i != _structures.size(); ++i) {
+        if(_structures[i].name)
+            structuresForName[_strings[_structures[i].name]].push_back(i);
+    }
+
+    /* Dereference references */
     for(const std::pair<std::size_t, Containers::ArrayView<const char>>& reference: references) {
         /* Null reference */
         if(reference.second.empty())
@@ -305,7 +313,12 @@ bool Document::parse(Containers::ArrayView<const char> data, const std::initiali
 
         /* Non-null, try to dereference */
         else {
-            std::size_t r = dereference(reference.first, reference.second);
+            const Containers::ArrayView<const char> leafName = reference.second.suffix(Implementation::findLastOf(reference.second, "$%"));
+            const auto found = structuresForName.find(std::string{leafName, leafName.size()});
+            Containers::ArrayView<const std::size_t> candidates;
+            if(found != structuresForName.end())
+                candidates = {found->second.data(), found->second.size()};
+            std::size_t r = dereference(reference.first, reference.second, candidates);
             if(r == NullReference) {
                 Error() << "OpenDdl::Document::parse(): reference" << std::string{reference.second, reference.second.size()} << "was not found";
                 return false;
@@ -317,7 +330,7 @@ bool Document::parse(Containers::ArrayView<const char> data, const std::initiali
     return true;
 }
 
-const char* Document::parseProperty(const Containers::ArrayView<const char> data, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, std::string& buffer, const Int identifier, Implementation::ParseError& error) {
+const char* Document::parseProperty(const Containers::ArrayView<const char> data, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, const Int identifier, Implementation::ParseError& error) {
     bool boolValue;
     Int integerValue;
     Float floatValue;
@@ -327,7 +340,7 @@ const char* Document::parseProperty(const Containers::ArrayView<const char> data
 
     const char* i;
     Implementation::InternalPropertyType type;
-    std::tie(i, type) = Implementation::propertyValue(data, boolValue, integerValue, floatValue, stringValue, referenceValue, typeValue, buffer, error);
+    std::tie(i, type) = Implementation::propertyValue(data, boolValue, integerValue, floatValue, stringValue, referenceValue, typeValue, error);
 
     if(!i) return nullptr;
 
@@ -370,7 +383,7 @@ const char* Document::parseProperty(const Containers::ArrayView<const char> data
 namespace Implementation {
 
 template<> struct ExtractDataListItem<Type::Bool> {
-    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>&, std::string&, Implementation::ParseError& error) {
+    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>&, Implementation::ParseError& error) {
         const char* i;
         bool value;
         std::tie(i, value) = Implementation::boolLiteral(data, error);
@@ -380,10 +393,10 @@ template<> struct ExtractDataListItem<Type::Bool> {
 };
 
 template<class T> struct ExtractIntegralDataListItem {
-    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>&, std::string& buffer, Implementation::ParseError& error) {
+    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>&, Implementation::ParseError& error) {
         const char* i;
         T value;
-        std::tie(i, value, std::ignore) = Implementation::integralLiteral<T>(data, buffer, error);
+        std::tie(i, value, std::ignore) = Implementation::integralLiteral<T>(data, error);
         document.data<T>().push_back(value);
         return i;
     }
@@ -403,10 +416,10 @@ _c(Long)
 #undef _c
 
 template<class T> struct ExtractFloatingPointDataListItem {
-    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>&, std::string& buffer, Implementation::ParseError& error) {
+    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>&, Implementation::ParseError& error) {
         const char* i;
         T value;
-        std::tie(i, value) = Implementation::floatingPointLiteral<T>(data, buffer, error);
+        std::tie(i, value) = Implementation::floatingPointLiteral<T>(data, error);
         document.data<T>().push_back(value);
         return i;
     }
@@ -419,7 +432,7 @@ _c(Double)
 #undef _c
 
 template<> struct ExtractDataListItem<Type::String> {
-    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>&, std::string&, Implementation::ParseError& error) {
+    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>&, Implementation::ParseError& error) {
         const char* i;
         std::string value;
         std::tie(i, value) = Implementation::stringLiteral(data, error);
@@ -429,7 +442,7 @@ template<> struct ExtractDataListItem<Type::String> {
 };
 
 template<> struct ExtractDataListItem<Type::Reference> {
-    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, std::string&, Implementation::ParseError& error) {
+    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, Implementation::ParseError& error) {
         const char* i;
         Containers::ArrayView<const char> value;
         std::tie(i, value) = Implementation::referenceLiteral(data, error);
@@ -441,7 +454,7 @@ template<> struct ExtractDataListItem<Type::Reference> {
 };
 
 template<> struct ExtractDataListItem<Type::Type> {
-    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>&, std::string&, Implementation::ParseError& error) {
+    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>&, Implementation::ParseError& error) {
         const char* i;
         Type value;
         std::tie(i, value) = Implementation::typeLiteral(data, error);
@@ -454,7 +467,7 @@ template<> struct ExtractDataListItem<Type::Type> {
 
 namespace {
 
-template<Type type> std::pair<const char*, std::size_t> dataList(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, std::string& buffer, Implementation::ParseError& error) {
+template<Type type> std::pair<const char*, std::size_t> dataList(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, Implementation::ParseError& error) {
     const char* i = data;
     std::size_t j = 0;
     for(; i && i != data.end() && *i != '}'; ) {
@@ -467,7 +480,7 @@ template<Type type> std::pair<const char*, std::size_t> dataList(const Container
             i = Implementation::whitespace(data.suffix(i + 1));
         }
 
-        i = Implementation::ExtractDataListItem<type>::extract(data.suffix(i), document, references, buffer, error);
+        i = Implementation::ExtractDataListItem<type>::extract(data.suffix(i), document, references, error);
 
         i = Implementation::whitespace(data.suffix(i));
 
@@ -477,8 +490,8 @@ template<Type type> std::pair<const char*, std::size_t> dataList(const Container
     return {i, j};
 }
 
-template<Type type> std::pair<const char*, std::size_t> dataArrayList(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, std::string& buffer, const std::size_t subArraySize, Implementation::ParseError& error) {
-    if(!subArraySize) return dataList<type>(data, document, references, buffer, error);
+template<Type type> std::pair<const char*, std::size_t> dataArrayList(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, const std::size_t subArraySize, Implementation::ParseError& error) {
+    if(!subArraySize) return dataList<type>(data, document, references, error);
 
     const char* i = data;
     std::size_t j = 0;
@@ -509,7 +522,7 @@ template<Type type> std::pair<const char*, std::size_t> dataArrayList(const Cont
                 i = Implementation::whitespace(data.suffix(i + 1));
             }
 
-            i = Implementation::ExtractDataListItem<type>::extract(data.suffix(i), document, references, buffer, error);
+            i = Implementation::ExtractDataListItem<type>::extract(data.suffix(i), document, references, error);
 
             i = Implementation::whitespace(data.suffix(i));
         }
@@ -541,7 +554,7 @@ Int identifierId(const Containers::ArrayView<const char> data, Containers::Array
 
 }
 
-std::pair<const char*, std::size_t> Document::parseStructure(const std::size_t parent, const Containers::ArrayView<const char> data, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, std::string& buffer, Implementation::ParseError& error) {
+std::pair<const char*, std::size_t> Document::parseStructure(const std::size_t parent, const Containers::ArrayView<const char> data, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, Implementation::ParseError& error) {
     /* Identifier */
     const char* const structureIdentifier = Implementation::identifier(data, error);
     if(!structureIdentifier) return {};
@@ -560,7 +573,7 @@ std::pair<const char*, std::size_t> Document::parseStructure(const std::size_t p
         if(i != data.end() && *i == '[') {
             i = Implementation::whitespace(data.suffix(i + 1));
 
-            std::tie(i, subArraySize, std::ignore) = Implementation::integralLiteral<std::size_t>(data.suffix(i), buffer, error);
+            std::tie(i, subArraySize, std::ignore) = Implementation::integralLiteral<std::size_t>(data.suffix(i), error);
 
             if(subArraySize == 0) {
                 error = {Implementation::ParseErrorType::InvalidSubArraySize, i};
@@ -606,7 +619,7 @@ std::pair<const char*, std::size_t> Document::parseStructure(const std::size_t p
             #define _c(type) \
             case Type::type: \
                 dataBegin = dataPosition<Type::type>(); \
-                std::tie(i, dataSize) = dataArrayList<Type::type>(data.suffix(i), *this, references, buffer, subArraySize, error); break;
+                std::tie(i, dataSize) = dataArrayList<Type::type>(data.suffix(i), *this, references, subArraySize, error); break;
             _c(Bool)
             _c(UnsignedByte)
             _c(Byte)
@@ -626,7 +639,7 @@ std::pair<const char*, std::size_t> Document::parseStructure(const std::size_t p
             #undef _c
             case Type::Reference:
                 dataBegin = references.size();
-                std::tie(i, dataSize) = dataArrayList<Type::Reference>(data.suffix(i), *this, references, buffer, subArraySize, error);
+                std::tie(i, dataSize) = dataArrayList<Type::Reference>(data.suffix(i), *this, references, subArraySize, error);
                 break;
             case Type::Custom:
                 CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
@@ -696,7 +709,7 @@ std::pair<const char*, std::size_t> Document::parseStructure(const std::size_t p
 
                 i = Implementation::whitespace(data.suffix(i + 1));
 
-                i = parseProperty(data.suffix(i), references, buffer, propertyIdentifierId, error);
+                i = parseProperty(data.suffix(i), references, propertyIdentifierId, error);
 
                 i = Implementation::whitespace(data.suffix(i));
 
@@ -726,7 +739,7 @@ std::pair<const char*, std::size_t> Document::parseStructure(const std::size_t p
         _structures.emplace_back();
 
         /* Substructure */
-        i = parseStructureList(position, data.suffix(i), references, buffer, error);
+        i = parseStructureList(position, data.suffix(i), references, error);
 
         /* Propagate errors */
         if(!i) return {};
@@ -752,14 +765,14 @@ std::pair<const char*, std::size_t> Document::parseStructure(const std::size_t p
     }
 }
 
-const char* Document::parseStructureList(const std::size_t parent, const Containers::ArrayView<const char> data, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, std::string& buffer, Implementation::ParseError& error) {
+const char* Document::parseStructureList(const std::size_t parent, const Containers::ArrayView<const char> data, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, Implementation::ParseError& error) {
     const std::size_t listStart = _structures.size();
 
     /* Parse all structures in the list */
     const char* i = data;
     std::size_t last;
     while(i && i != data.end() && *i != '}') {
-        std::tie(i, last) = parseStructure(parent, data.suffix(i), references, buffer, error);
+        std::tie(i, last) = parseStructure(parent, data.suffix(i), references, error);
         i = Implementation::whitespace(data.suffix(i));
     }
 
@@ -71,6 +71,17 @@ class MAGNUM_OPENDDL_EXPORT Structure {
         /** @brief Non-equality operator */
         bool operator!=(const Structure& other) const { return !operator==(other); }
 
+        /**
+         * @brief Structure index
+         *
+         * Unique index of the structure in the originating document, less
+         * than @ref Document::structureCount(). Useful for associating
+         * external data with structures in constant time.
+         */
+        std::size_t index() const {
+            return &_data.get() - _document.get()._structures.data();
+        }
+
         /**
          * @brief Whether the structure is custom
          *
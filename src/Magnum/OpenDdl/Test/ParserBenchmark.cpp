@@ -0,0 +1,129 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/OpenDdl/Document.h"
+
+namespace Magnum { namespace OpenDdl { namespace Test { namespace {
+
+struct ParserBenchmark: TestSuite::Tester {
+    explicit ParserBenchmark();
+
+    void parse();
+
+    std::string _data[3];
+};
+
+/* A subset of OpenGEX, enough for a mesh */
+const std::initializer_list<CharacterLiteral> Structures{
+    "GeometryObject",
+    "IndexArray",
+    "Mesh",
+    "VertexArray"
+};
+
+const std::initializer_list<CharacterLiteral> Properties{
+    "attrib",
+    "primitive"
+};
+
+constexpr std::size_t VertexCount = 250000;
+
+constexpr struct {
+    const char* name;
+    bool positions, indices;
+    bool underscores;
+} ParseData[]{
+    {"float[3] positions and normals", true, false, false},
+    {"unsigned_int32[3] indices", false, true, false},
+    {"float[3] positions and normals with digit separators", true, false, true}
+};
+
+/* Floats printed with as many digits as an exporter would, spread over a few
+   orders of magnitude */
+void appendFloat(std::string& out, std::size_t i, bool underscores) {
+    const Float value = (Float(i%2000) - 1000.0f)*Float(1 + i%3)*0.012345678f;
+    std::string formatted = Utility::formatString("{:.8}", value);
+    if(underscores) {
+        const std::size_t dot = formatted.find('.');
+        if(dot != std::string::npos && formatted.size() > dot + 4)
+            formatted.insert(dot + 4, 1, '_');
+    }
+    out += formatted;
+}
+
+std::string generateMesh(bool positions, bool indices, bool underscores) {
+    std::string out = "GeometryObject {\n    Mesh (primitive = \"triangles\") {\n";
+    if(positions) for(const char* attrib: {"position", "normal"}) {
+        out += Utility::formatString("        VertexArray (attrib = \"{}\") {{\n            float[3] {{\n", attrib);
+        for(std::size_t i = 0; i != VertexCount; ++i) {
+            out += "                {";
+            for(std::size_t j = 0; j != 3; ++j) {
+                if(j) out += ", ";
+                appendFloat(out, i*3 + j, underscores);
+            }
+            out += i + 1 == VertexCount ? "}\n" : "},\n";
+        }
+        out += "            }\n        }\n";
+    }
+    if(indices) {
+        out += "        IndexArray {\n            unsigned_int32[3] {\n";
+        for(std::size_t i = 0; i != VertexCount; ++i)
+            out += Utility::formatString(i + 1 == VertexCount ?
+                "                {{{}, {}, {}}}\n" :
+                "                {{{}, {}, {}}},\n", (i*7)%VertexCount, (i*7 + 1)%VertexCount, (i*13 + 2)%VertexCount);
+        out += "            }\n        }\n";
+    }
+    out += "    }\n}\n";
+    return out;
+}
+
+ParserBenchmark::ParserBenchmark() {
+    addInstancedBenchmarks({&ParserBenchmark::parse}, 5,
+        Containers::arraySize(ParseData));
+
+    for(std::size_t i = 0; i != Containers::arraySize(ParseData); ++i)
+        _data[i] = generateMesh(ParseData[i].positions, ParseData[i].indices, ParseData[i].underscores);
+}
+
+void ParserBenchmark::parse() {
+    auto&& data = ParseData[testCaseInstanceId()];
+    setTestCaseDescription(Utility::formatString("{}, {:.1f} MB", data.name, _data[testCaseInstanceId()].size()/1000000.0));
+
+    Document d;
+    bool parsed = false;
+    CORRADE_BENCHMARK(1)
+        parsed = d.parse({_data[testCaseInstanceId()].data(), _data[testCaseInstanceId()].size()}, Structures, Properties);
+
+    CORRADE_VERIFY(parsed);
+    CORRADE_VERIFY(!d.isEmpty());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::OpenDdl::Test::ParserBenchmark)
@@ -64,10 +64,14 @@ struct ParsersTest: TestSuite::Tester {
     void integerLiteral();
     void integerLiteralChar();
     void integerLiteralBinary();
+    void integerLiteralLong();
 
     void floatLiteralInvalid();
     void floatLiteral();
     void floatLiteralBinary();
+    void floatLiteralManyDigits();
+    void floatLiteralDouble();
+    void floatLiteralCorrectlyRounded();
 
     void stringLiteralInvalid();
     void stringLiteralEmpty();
@@ -126,10 +130,14 @@ ParsersTest::ParsersTest() {
               &ParsersTest::integerLiteral,
               &ParsersTest::integerLiteralChar,
               &ParsersTest::integerLiteralBinary,
+              &ParsersTest::integerLiteralLong,
 
               &ParsersTest::floatLiteralInvalid,
               &ParsersTest::floatLiteral,
               &ParsersTest::floatLiteralBinary,
+              &ParsersTest::floatLiteralManyDigits,
+              &ParsersTest::floatLiteralDouble,
+              &ParsersTest::floatLiteralCorrectlyRounded,
 
               &ParsersTest::stringLiteralInvalid,
               &ParsersTest::stringLiteralEmpty,
@@ -372,27 +380,32 @@ void ParsersTest::characterLiteralEscaped() {
 
 void ParsersTest::integerLiteralInvalid() {
     Implementation::ParseError error;
-    std::string buffer;
 
-    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{""}, buffer, error)));
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{""}, error)));
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::ExpectedLiteral);
 
-    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"+"}, buffer, error)));
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"+"}, error)));
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidLiteral);
 
-    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"A"}, buffer, error)));
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"A"}, error)));
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidLiteral);
 
-    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"_1"}, buffer, error)));
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"_1"}, error)));
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidLiteral);
 
-    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"0b_1"}, buffer, error)));
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"0b_1"}, error)));
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidLiteral);
 
-    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"32768"}, buffer, error)));
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"32768"}, error)));
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::LiteralOutOfRange);
 
-    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<UnsignedShort>(CharacterLiteral{"-1"}, buffer, error)));
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<UnsignedShort>(CharacterLiteral{"-1"}, error)));
+    CORRADE_COMPARE(error.error, Implementation::ParseErrorType::LiteralOutOfRange);
+
+    /* Overflowing even the 64-bit accumulator */
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<UnsignedInt>(CharacterLiteral{"0x1_0000_0000_0000_0000"}, error)));
+    CORRADE_COMPARE(error.error, Implementation::ParseErrorType::LiteralOutOfRange);
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<UnsignedInt>(CharacterLiteral{"123456789012345678901234567890"}, error)));
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::LiteralOutOfRange);
 }
 
@@ -400,11 +413,10 @@ void ParsersTest::integerLiteral() {
     CharacterLiteral a{"-3_7X"};
 
     Implementation::ParseError error;
-    std::string buffer;
     const char* ai;
     Short value;
     Int base;
-    std::tie(ai, value, base) = Implementation::integralLiteral<Short>(a, buffer, error);
+    std::tie(ai, value, base) = Implementation::integralLiteral<Short>(a, error);
     VERIFY_PARSED(error, a, ai, "-3_7");
     CORRADE_COMPARE(value, -37);
     CORRADE_COMPARE(base, 10);
@@ -414,11 +426,10 @@ void ParsersTest::integerLiteralChar() {
     CharacterLiteral a{"+'a'X"};
 
     Implementation::ParseError error;
-    std::string buffer;
     const char* ai;
     Short value;
     Int base;
-    std::tie(ai, value, base) = Implementation::integralLiteral<Short>(a, buffer, error);
+    std::tie(ai, value, base) = Implementation::integralLiteral<Short>(a, error);
     VERIFY_PARSED(error, a, ai, "+'a'");
     CORRADE_COMPARE(value, 'a');
     CORRADE_COMPARE(base, 256);
@@ -428,47 +439,73 @@ void ParsersTest::integerLiteralBinary() {
     CharacterLiteral a{"-0o7_5"};
 
     Implementation::ParseError error;
-    std::string buffer;
     const char* ai;
     Short value;
     Int base;
-    std::tie(ai, value, base) = Implementation::integralLiteral<Short>(a, buffer, error);
+    std::tie(ai, value, base) = Implementation::integralLiteral<Short>(a, error);
     VERIFY_PARSED(error, a, ai, "-0o7_5");
     CORRADE_COMPARE(value, -075);
     CORRADE_COMPARE(base, 8);
 }
 
+void ParsersTest::integerLiteralLong() {
+    CharacterLiteral a{"4_294_967_295X"};
+
+    Implementation::ParseError error;
+    const char* ai;
+    UnsignedInt value;
+    Int base;
+    std::tie(ai, value, base) = Implementation::integralLiteral<UnsignedInt>(a, error);
+    VERIFY_PARSED(error, a, ai, "4_294_967_295");
+    CORRADE_COMPARE(value, 4294967295u);
+    CORRADE_COMPARE(base, 10);
+
+    /* One more is out of range */
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<UnsignedInt>(CharacterLiteral{"4_294_967_296"}, error)));
+    CORRADE_COMPARE(error.error, Implementation::ParseErrorType::LiteralOutOfRange);
+}
+
 void ParsersTest::floatLiteralInvalid() {
     Implementation::ParseError error;
-    std::string buffer;
 
-    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Float>(CharacterLiteral{""}, buffer, error).first);
+    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Float>(CharacterLiteral{""}, error).first);
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::ExpectedLiteral);
 
-    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Float>(CharacterLiteral{"+"}, buffer, error).first);
+    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Float>(CharacterLiteral{"+"}, error).first);
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidLiteral);
 
-    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Float>(CharacterLiteral{"A"}, buffer, error).first);
+    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Float>(CharacterLiteral{"A"}, error).first);
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidLiteral);
 
-    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Float>(CharacterLiteral{"_1"}, buffer, error).first);
+    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Float>(CharacterLiteral{"_1"}, error).first);
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidLiteral);
 
-    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Float>(CharacterLiteral{"."}, buffer, error).first);
+    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Float>(CharacterLiteral{"."}, error).first);
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidLiteral);
 
-    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Float>(CharacterLiteral{"0.e-"}, buffer, error).first);
+    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Float>(CharacterLiteral{"0.e-"}, error).first);
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidLiteral);
+
+    /* The error points to the literal start, not the exponent */
+    CharacterLiteral exponent{"1.0e"};
+    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Float>(exponent, error).first);
+    CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidLiteral);
+    CORRADE_VERIFY(error.position == exponent.data());
+
+    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Float>(CharacterLiteral{"1.0e39"}, error).first);
+    CORRADE_COMPARE(error.error, Implementation::ParseErrorType::LiteralOutOfRange);
+
+    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Double>(CharacterLiteral{"-1.0e309"}, error).first);
+    CORRADE_COMPARE(error.error, Implementation::ParseErrorType::LiteralOutOfRange);
 }
 
 void ParsersTest::floatLiteral() {
     CharacterLiteral a{"-1_.0_0e+5X"};
 
     Implementation::ParseError error;
-    std::string buffer;
     const char* ai;
     Float value;
-    std::tie(ai, value) = Implementation::floatingPointLiteral<Float>(a, buffer, error);
+    std::tie(ai, value) = Implementation::floatingPointLiteral<Float>(a, error);
     VERIFY_PARSED(error, a, ai, "-1_.0_0e+5");
     CORRADE_COMPARE(value, -1.0e+5);
 }
@@ -477,15 +514,76 @@ void ParsersTest::floatLiteralBinary() {
     CharacterLiteral a{"-0xbad_cafe_X"};
 
     Implementation::ParseError error;
-    std::string buffer;
     const char* ai;
     Float value;
-    std::tie(ai, value) = Implementation::floatingPointLiteral<Float>(a, buffer, error);
+    std::tie(ai, value) = Implementation::floatingPointLiteral<Float>(a, error);
     VERIFY_PARSED(error, a, ai, "-0xbad_cafe_");
     UnsignedInt v = 0xbadcafe;
     CORRADE_COMPARE(value, -reinterpret_cast<Float&>(v));
 }
 
+void ParsersTest::floatLiteralManyDigits() {
+    /* More digits than what fits into 64 bits, both before and after the
+       decimal point, with leading zeros that shouldn't count towards that */
+    CharacterLiteral a{"000123_456_789_012_345_678_901.000_000_000_000_000_001_5,"};
+
+    Implementation::ParseError error;
+    const char* ai;
+    Float value;
+    std::tie(ai, value) = Implementation::floatingPointLiteral<Float>(a, error);
+    VERIFY_PARSED(error, a, ai, "000123_456_789_012_345_678_901.000_000_000_000_000_001_5");
+    CORRADE_COMPARE(value, 1.23456789012345678901e20f);
+
+    CharacterLiteral b{"0.000_000_000_000_000_000_000_001_234_567_89}"};
+    std::tie(ai, value) = Implementation::floatingPointLiteral<Float>(b, error);
+    VERIFY_PARSED(error, b, ai, "0.000_000_000_000_000_000_000_001_234_567_89");
+    CORRADE_COMPARE(value, 1.23456789e-27f);
+}
+
+void ParsersTest::floatLiteralDouble() {
+    CharacterLiteral a{"3.141592653589793238462643383279 "};
+
+    Implementation::ParseError error;
+    const char* ai;
+    Double value;
+    std::tie(ai, value) = Implementation::floatingPointLiteral<Double>(a, error);
+    VERIFY_PARSED(error, a, ai, "3.141592653589793238462643383279");
+    CORRADE_COMPARE(value, 3.141592653589793);
+
+    /* This one fits into the exact fast path */
+    CharacterLiteral c{"-0.000_123_4"};
+    std::tie(ai, value) = Implementation::floatingPointLiteral<Double>(c, error);
+    VERIFY_PARSED(error, c, ai, "-0.000_123_4");
+    CORRADE_VERIFY(value == -0.0001234);
+
+    CharacterLiteral b{"12345678.87654321e-300"};
+    std::tie(ai, value) = Implementation::floatingPointLiteral<Double>(b, error);
+    VERIFY_PARSED(error, b, ai, "12345678.87654321e-300");
+    CORRADE_COMPARE(value, 12345678.87654321e-300);
+}
+
+void ParsersTest::floatLiteralCorrectlyRounded() {
+    Implementation::ParseError error;
+
+    /* Rounding to a double first lands exactly halfway between 1.0f and the
+       next float, which would then round to even, but the literal is slightly
+       above the halfway point */
+    CORRADE_VERIFY(Implementation::floatingPointLiteral<Float>(CharacterLiteral{"1.000_000_059_604_644_8"}, error).second == 1.00000012f);
+    CORRADE_VERIFY(Implementation::floatingPointLiteral<Float>(CharacterLiteral{"1.000_000_059_604_644_6"}, error).second == 1.0f);
+
+    /* Exactly halfway rounds to even, anything above to the next value, even
+       if it's past the digits that fit into 64 bits */
+    CORRADE_VERIFY(Implementation::floatingPointLiteral<Double>(CharacterLiteral{"9007199254740993"}, error).second == 9007199254740992.0);
+    CORRADE_VERIFY(Implementation::floatingPointLiteral<Double>(CharacterLiteral{"9007199254740993.000_000_000_1"}, error).second == 9007199254740994.0);
+
+    /* Known hard cases around the smallest normal, smallest denormal and
+       largest double */
+    CORRADE_VERIFY(Implementation::floatingPointLiteral<Double>(CharacterLiteral{"2.2250738585072011e-308"}, error).second == 2.2250738585072009e-308);
+    CORRADE_VERIFY(Implementation::floatingPointLiteral<Double>(CharacterLiteral{"2.4703282292062328e-324"}, error).second == 4.9406564584124654e-324);
+    CORRADE_VERIFY(Implementation::floatingPointLiteral<Double>(CharacterLiteral{"2.4703282292062327e-324"}, error).second == 0.0);
+    CORRADE_VERIFY(Implementation::floatingPointLiteral<Double>(CharacterLiteral{"1.7976931348623158e308"}, error).second == 1.7976931348623157e308);
+}
+
 void ParsersTest::stringLiteralInvalid() {
     Implementation::ParseError error;
 
@@ -628,7 +726,6 @@ void ParsersTest::typeLiteral() {
 
 void ParsersTest::propertyValueInvalid() {
     Implementation::ParseError error;
-    std::string buffer;
 
     bool boolValue = {};
     Int integerValue = {};
@@ -637,10 +734,10 @@ void ParsersTest::propertyValueInvalid() {
     Containers::ArrayView<const char> referenceValue;
     Type typeValue = {};
 
-    CORRADE_VERIFY(!Implementation::propertyValue(CharacterLiteral{""}, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, buffer, error).first);
+    CORRADE_VERIFY(!Implementation::propertyValue(CharacterLiteral{""}, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, error).first);
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::ExpectedPropertyValue);
 
-    CORRADE_VERIFY(!Implementation::propertyValue(CharacterLiteral{"bleh"}, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, buffer, error).first);
+    CORRADE_VERIFY(!Implementation::propertyValue(CharacterLiteral{"bleh"}, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, error).first);
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidPropertyValue);
 }
 
@@ -648,7 +745,6 @@ void ParsersTest::propertyValueBool() {
     CharacterLiteral a{"true,"};
 
     Implementation::ParseError error;
-    std::string buffer;
     bool boolValue = {};
     Int integerValue = {};
     Float floatingPointValue = {};
@@ -657,7 +753,7 @@ void ParsersTest::propertyValueBool() {
     Type typeValue = {};
     const char* ai;
     Implementation::InternalPropertyType type;
-    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, buffer, error);
+    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, error);
     VERIFY_PARSED(error, a, ai, "true");
     CORRADE_COMPARE(type, Implementation::InternalPropertyType::Bool);
     CORRADE_COMPARE(boolValue, true);
@@ -667,7 +763,6 @@ void ParsersTest::propertyValueIntegral() {
     CharacterLiteral a{"17, 0.0"};
 
     Implementation::ParseError error;
-    std::string buffer;
     bool boolValue = {};
     Int integerValue = {};
     Float floatingPointValue = {};
@@ -676,7 +771,7 @@ void ParsersTest::propertyValueIntegral() {
     Type typeValue = {};
     const char* ai;
     Implementation::InternalPropertyType type;
-    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, buffer, error);
+    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, error);
     VERIFY_PARSED(error, a, ai, "17");
     CORRADE_COMPARE(type, Implementation::InternalPropertyType::Integral);
     CORRADE_COMPARE(integerValue, 17);
@@ -686,7 +781,6 @@ void ParsersTest::propertyValueCharacter() {
     CharacterLiteral a{"'a', 0.0"};
 
     Implementation::ParseError error;
-    std::string buffer;
     bool boolValue = {};
     Int integerValue = {};
     Float floatingPointValue = {};
@@ -695,7 +789,7 @@ void ParsersTest::propertyValueCharacter() {
     Type typeValue = {};
     const char* ai;
     Implementation::InternalPropertyType type;
-    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, buffer, error);
+    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, error);
     VERIFY_PARSED(error, a, ai, "'a'");
     CORRADE_COMPARE(type, Implementation::InternalPropertyType::Character);
     CORRADE_COMPARE(integerValue, 'a');
@@ -705,7 +799,6 @@ void ParsersTest::propertyValueBinary() {
     CharacterLiteral a{"0xff, 0.0"};
 
     Implementation::ParseError error;
-    std::string buffer;
     bool boolValue = {};
     Int integerValue = {};
     Float floatingPointValue = {};
@@ -714,7 +807,7 @@ void ParsersTest::propertyValueBinary() {
     Type typeValue = {};
     const char* ai;
     Implementation::InternalPropertyType type;
-    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, buffer, error);
+    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, error);
     VERIFY_PARSED(error, a, ai, "0xff");
     CORRADE_COMPARE(type, Implementation::InternalPropertyType::Binary);
     CORRADE_COMPARE(integerValue, 0xff);
@@ -724,7 +817,6 @@ void ParsersTest::propertyValueFloatingPoint() {
     CharacterLiteral a{"15.0_0,"};
 
     Implementation::ParseError error;
-    std::string buffer;
     bool boolValue = {};
     Int integerValue = {};
     Float floatingPointValue = {};
@@ -733,7 +825,7 @@ void ParsersTest::propertyValueFloatingPoint() {
     Type typeValue = {};
     const char* ai;
     Implementation::InternalPropertyType type;
-    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, buffer, error);
+    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, error);
     VERIFY_PARSED(error, a, ai, "15.0_0");
     CORRADE_COMPARE(type, Implementation::InternalPropertyType::Float);
     CORRADE_COMPARE(floatingPointValue, 15.0f);
@@ -743,7 +835,6 @@ void ParsersTest::propertyValueString() {
     CharacterLiteral a{"\"hello\","};
 
     Implementation::ParseError error;
-    std::string buffer;
     bool boolValue = {};
     Int integerValue = {};
     Float floatingPointValue = {};
@@ -752,7 +843,7 @@ void ParsersTest::propertyValueString() {
     Type typeValue = {};
     const char* ai;
     Implementation::InternalPropertyType type;
-    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, buffer, error);
+    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, error);
     VERIFY_PARSED(error, a, ai, "\"hello\"");
     CORRADE_COMPARE(type, Implementation::InternalPropertyType::String);
     CORRADE_COMPARE(stringValue, "hello");
@@ -762,7 +853,6 @@ void ParsersTest::propertyValueReference() {
     CharacterLiteral a{"%my_array2,"};
 
     Implementation::ParseError error;
-    std::string buffer;
     bool boolValue = {};
     Int integerValue = {};
     Float floatingPointValue = {};
@@ -771,7 +861,7 @@ void ParsersTest::propertyValueReference() {
     Type typeValue = {};
     const char* ai;
     Implementation::InternalPropertyType type;
-    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, buffer, error);
+    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, error);
     VERIFY_PARSED(error, a, ai, "%my_array2");
     CORRADE_COMPARE(type, Implementation::InternalPropertyType::Reference);
     CORRADE_COMPARE((std::string{referenceValue, referenceValue.size()}), "%my_array2");
@@ -781,7 +871,6 @@ void ParsersTest::propertyValueReferenceNull() {
     CharacterLiteral a{"null,"};
 
     Implementation::ParseError error;
-    std::string buffer;
     bool boolValue = {};
     Int integerValue = {};
     Float floatingPointValue = {};
@@ -790,7 +879,7 @@ void ParsersTest::propertyValueReferenceNull() {
     Type typeValue = {};
     const char* ai;
     Implementation::InternalPropertyType type;
-    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, buffer, error);
+    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, error);
     VERIFY_PARSED(error, a, ai, "null");
     CORRADE_COMPARE(type, Implementation::InternalPropertyType::Reference);
     CORRADE_VERIFY(referenceValue.empty());
@@ -800,7 +889,6 @@ void ParsersTest::propertyValueType() {
     CharacterLiteral a{"float,"};
 
     Implementation::ParseError error;
-    std::string buffer;
     bool boolValue = {};
     Int integerValue = {};
     Float floatingPointValue = {};
@@ -809,7 +897,7 @@ void ParsersTest::propertyValueType() {
     Type typeValue = {};
     const char* ai;
     Implementation::InternalPropertyType type;
-    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, buffer, error);
+    std::tie(ai, type) = Implementation::propertyValue(a, boolValue, integerValue, floatingPointValue, stringValue, referenceValue, typeValue, error);
     VERIFY_PARSED(error, a, ai, "float");
     CORRADE_COMPARE(type, Implementation::InternalPropertyType::Type);
     CORRADE_COMPARE(typeValue, Type::Float);
@@ -57,6 +57,8 @@ struct Test: TestSuite::Tester {
     void primitiveSubArrayExpectedSubListEnd();
     void primitiveSubArrayExpectedSeparator();
 
+    void primitiveMultiple();
+
     void custom();
     void customEmpty();
     void customUnknown();
@@ -81,6 +83,7 @@ struct Test: TestSuite::Tester {
     void structureProperties();
 
     void structureEquality();
+    void structureIndex();
 
     void validate();
 
@@ -127,6 +130,8 @@ Test::Test() {
               &Test::primitiveSubArrayExpectedSubListEnd,
               &Test::primitiveSubArrayExpectedSeparator,
 
+              &Test::primitiveMultiple,
+
               &Test::custom,
               &Test::customEmpty,
               &Test::customUnknown,
@@ -151,6 +156,7 @@ Test::Test() {
               &Test::structureProperties,
 
               &Test::structureEquality,
+              &Test::structureIndex,
 
               &Test::validate,
 
@@ -376,6 +382,48 @@ const std::initializer_list<CharacterLiteral> propertyIdentifiers {
     "reference"
 };
 
+void Test::primitiveMultiple() {
+    /* Data of all lists of the same type are stored in a single array, each
+       structure should see only its own part of it, unaffected by commas and
+       braces in comments and strings */
+    Document d;
+    CORRADE_VERIFY(d.parse(CharacterLiteral{
+        "int16 { 1, 2 /* , , , , */ }\n"
+        "int16[2] { {3, 4}, /* } */ {5, 6}, {7, 8} }\n"
+        "float { 0.5 }\n"
+        "string { \"{\", \"a,b\" }\n"
+        "int16 { 9 }"}, {}, {}));
+
+    Structure a = d.firstChild();
+    CORRADE_COMPARE_AS(a.asArray<Short>(),
+        (Containers::Array<Short>{InPlaceInit, {1, 2}}),
+        TestSuite::Compare::Container);
+
+    Containers::Optional<Structure> b = a.findNext();
+    CORRADE_VERIFY(b);
+    CORRADE_COMPARE(b->subArraySize(), 2);
+    CORRADE_COMPARE_AS(b->asArray<Short>(),
+        (Containers::Array<Short>{InPlaceInit, {3, 4, 5, 6, 7, 8}}),
+        TestSuite::Compare::Container);
+
+    Containers::Optional<Structure> c = b->findNext();
+    CORRADE_VERIFY(c);
+    CORRADE_COMPARE(c->as<Float>(), 0.5f);
+
+    Containers::Optional<Structure> s = c->findNext();
+    CORRADE_VERIFY(s);
+    CORRADE_COMPARE_AS(s->asArray<std::string>(),
+        (Containers::Array<std::string>{InPlaceInit, {"{", "a,b"}}),
+        TestSuite::Compare::Container);
+
+    Containers::Optional<Structure> e = s->findNext();
+    CORRADE_VERIFY(e);
+    CORRADE_COMPARE_AS(e->asArray<Short>(),
+        (Containers::Array<Short>{InPlaceInit, {9}}),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(!e->findNext());
+}
+
 void Test::custom() {
     Document d;
     CORRADE_VERIFY(d.parse(CharacterLiteral{"Root { string {\"hello\"} }"}, structureIdentifiers, {}));
@@ -778,6 +826,31 @@ Some {}
     CORRADE_VERIFY(a != b && b != a);
 }
 
+void Test::structureIndex() {
+    Document d;
+    /* GCC < 4.9 cannot handle multiline raw string literals inside macros */
+    auto s = CharacterLiteral{R"oddl(
+Root { int32 { 1 } }
+Some {}
+    )oddl"};
+    CORRADE_VERIFY(d.parse(s, structureIdentifiers, propertyIdentifiers));
+    CORRADE_COMPARE(d.structureCount(), 3);
+
+    Structure a = d.firstChildOf(RootStructure);
+    Structure b = a.firstChild();
+    Structure c = d.firstChildOf(SomeStructure);
+    CORRADE_VERIFY(a.index() < d.structureCount());
+    CORRADE_VERIFY(b.index() < d.structureCount());
+    CORRADE_VERIFY(c.index() < d.structureCount());
+    CORRADE_VERIFY(a.index() != b.index());
+    CORRADE_VERIFY(a.index() != c.index());
+    CORRADE_VERIFY(b.index() != c.index());
+
+    /* A different instance referring to the same structure has the same
+       index */
+    CORRADE_COMPARE(d.firstChild().index(), a.index());
+}
+
 void Test::validate() {
     using namespace Validation;
 
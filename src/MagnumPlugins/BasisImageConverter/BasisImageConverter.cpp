@@ -35,38 +35,167 @@
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/DebugStl.h>
 #include <Magnum/ImageView.h>
-#include <Magnum/Math/Color.h>
-#include <Magnum/Math/Swizzle.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Vector3.h>
 #include <Magnum/PixelFormat.h>
 #include <basisu_enc.h>
 #include <basisu_comp.h>
 #include <basisu_file_headers.h>
 
+#ifdef CORRADE_TARGET_SSSE3
+#include <tmmintrin.h>
+#endif
+
 namespace Magnum { namespace Trade {
 
-BasisImageConverter::BasisImageConverter() = default;
+namespace {
+
+#ifdef CORRADE_TARGET_SSSE3
+/* Expands four pixels at a time to RGBA with a byte shuffle, in the same way
+   as the scalar loop in copyLayer() below. Returns the count of pixels done,
+   stopping early enough to not load past the end of the input row. */
+template<std::size_t channelCount> std::size_t expandRowSsse3(const UnsignedByte* const in, UnsignedByte* const out, const std::size_t width) {
+    /* Input byte for each output byte, -1 produces a zero */
+    alignas(16) static const char masks[3][16]{
+        {0, 0, 0, -1, 1, 1, 1, -1, 2, 2, 2, -1, 3, 3, 3, -1},
+        {0, 0, 0, 1, 2, 2, 2, 3, 4, 4, 4, 5, 6, 6, 6, 7},
+        {0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1}
+    };
+    const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(masks[channelCount - 1]));
+    /* RG has alpha in the second channel, R and RGB get it set to 255 */
+    const __m128i alpha = channelCount == 2 ? _mm_setzero_si128() : _mm_set1_epi32(Int(0xff000000u));
+
+    std::size_t x = 0;
+    for(; x*channelCount + 16 <= width*channelCount; x += 4) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x*channelCount));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x*4), _mm_or_si128(_mm_shuffle_epi8(pixels, mask), alpha));
+    }
+    return x;
+}
+#endif
+
+/* Copies one layer of the input into a tightly packed RGBA basis image,
+   flipping Y. Rows are contiguous both in the input and the output, so the
+   loops work directly on byte pointers instead of going through strided
+   views. Basis images are always RGBA, missing channels are expanded the same
+   way as BasisImporter expects them on the other side -- R to RRR1 and RG to
+   RRRG. Where available, the expansion is done with SSSE3 for most of the
+   row. */
+template<std::size_t channelCount> void copyLayer(const Containers::StridedArrayView3D<const char>& src, basisu::image& dst) {
+    const std::size_t height = src.size()[0];
+    const std::size_t width = src.size()[1];
+    for(std::size_t y = 0; y != height; ++y) {
+        const UnsignedByte* in = static_cast<const UnsignedByte*>(src[y].data());
+        UnsignedByte* out = reinterpret_cast<UnsignedByte*>(dst.get_ptr() + (height - y - 1)*dst.get_pitch());
+        std::size_t x = 0;
+        #ifdef CORRADE_TARGET_SSSE3
+        x = expandRowSsse3<channelCount>(in, out, width);
+        #endif
+        for(; x != width; ++x) {
+            const UnsignedByte* pixelIn = in + x*channelCount;
+            UnsignedByte* pixelOut = out + x*4;
+            if(channelCount == 3) {
+                pixelOut[0] = pixelIn[0];
+                pixelOut[1] = pixelIn[1];
+                pixelOut[2] = pixelIn[2];
+            } else {
+                pixelOut[0] = pixelOut[1] = pixelOut[2] = pixelIn[0];
+            }
+            pixelOut[3] = channelCount == 2 ? pixelIn[1] : 255;
+        }
+    }
+}
 
-BasisImageConverter::BasisImageConverter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImageConverter{manager, plugin} {}
+/* RGBA rows need no expansion */
+template<> void copyLayer<4>(const Containers::StridedArrayView3D<const char>& src, basisu::image& dst) {
+    const std::size_t height = src.size()[0];
+    const std::size_t width = src.size()[1];
+    for(std::size_t y = 0; y != height; ++y)
+        std::memcpy(dst.get_ptr() + (height - y - 1)*dst.get_pitch(), src[y].data(), width*4);
+}
 
-ImageConverterFeatures BasisImageConverter::doFeatures() const { return ImageConverterFeature::Convert2DToData; }
+bool copyLayer(const PixelFormat format, const Containers::StridedArrayView3D<const char>& src, basisu::image& dst) {
+    switch(format) {
+        case PixelFormat::R8Unorm: copyLayer<1>(src, dst); return true;
+        case PixelFormat::RG8Unorm: copyLayer<2>(src, dst); return true;
+        case PixelFormat::RGB8Unorm: copyLayer<3>(src, dst); return true;
+        case PixelFormat::RGBA8Unorm: copyLayer<4>(src, dst); return true;
+        default: return false;
+    }
+}
 
-Containers::Array<char> BasisImageConverter::doConvertToData(const ImageView2D& image) {
-    /* Check input */
-    if(image.format() != PixelFormat::RGB8Unorm &&
-       image.format() != PixelFormat::RGBA8Unorm &&
-       image.format() != PixelFormat::RG8Unorm &&
-       image.format() != PixelFormat::R8Unorm)
+Containers::StridedArrayView3D<const char> layerPixels(const ImageView2D& image, std::size_t) {
+    return image.pixels();
+}
+
+Containers::StridedArrayView3D<const char> layerPixels(const ImageView3D& image, const std::size_t layer) {
+    return image.pixels()[layer];
+}
+
+template<UnsignedInt dimensions> Containers::Array<char> convertLevels(const Containers::ArrayView<const ImageView<dimensions, const char>> imageLevels, const Utility::ConfigurationGroup& configuration) {
+    /* Check input. All levels are expected to have the same format, the 2D
+       sizes halving each level and the layer count staying the same, since
+       Basis stores each layer with its own mip chain. */
+    const PixelFormat format = imageLevels.front().format();
+    if(format != PixelFormat::RGB8Unorm &&
+       format != PixelFormat::RGBA8Unorm &&
+       format != PixelFormat::RG8Unorm &&
+       format != PixelFormat::R8Unorm)
     {
-        Error{} << "Trade::BasisImageConverter::convertToData(): unsupported format" << image.format();
+        Error{} << "Trade::BasisImageConverter::convertToData(): unsupported format" << format;
+        return {};
+    }
+
+    const Vector3i size = Vector3i::pad(imageLevels.front().size(), 1);
+    const UnsignedInt maxLevelCount = Math::log2(size.xy().max()) + 1;
+    if(imageLevels.size() > maxLevelCount) {
+        Error{} << "Trade::BasisImageConverter::convertToData(): there can be only" << maxLevelCount << "levels with base image size" << imageLevels.front().size() << "but got" << imageLevels.size();
         return {};
     }
 
+    for(std::size_t i = 1; i != imageLevels.size(); ++i) {
+        if(imageLevels[i].format() != format) {
+            Error{} << "Trade::BasisImageConverter::convertToData(): expected format" << format << "for level" << i << "but got" << imageLevels[i].format();
+            return {};
+        }
+
+        const Vector3i expectedSize{Math::max(size.xy() >> Int(i), 1), size.z()};
+        if(Vector3i::pad(imageLevels[i].size(), 1) != expectedSize) {
+            Error{} << "Trade::BasisImageConverter::convertToData(): expected size" << Math::Vector<dimensions, Int>::pad(expectedSize) << "for level" << i << "but got" << imageLevels[i].size();
+            return {};
+        }
+    }
+
+    /* Texture type is taken into account only for 3D images, 2D images are
+       always 2D */
+    basist::basis_texture_type textureType = basist::cBASISTexType2D;
+    if(dimensions == 3) {
+        const std::string type = configuration.value("texture_type");
+        if(type == "2darray")
+            textureType = basist::cBASISTexType2DArray;
+        else if(type == "cubemap") {
+            if(size.x() != size.y() || size.z() % 6 != 0) {
+                Error{} << "Trade::BasisImageConverter::convertToData(): expected square faces and a multiple of 6 layers for a cube map but got" << imageLevels.front().size();
+                return {};
+            }
+            textureType = basist::cBASISTexTypeCubemapArray;
+        } else if(type == "video")
+            textureType = basist::cBASISTexTypeVideoFrames;
+        else if(type == "3d")
+            textureType = basist::cBASISTexTypeVolume;
+        else {
+            Error{} << "Trade::BasisImageConverter::convertToData(): invalid texture type" << type << Debug::nospace << ", expected 2darray, cubemap, video or 3d";
+            return {};
+        }
+    }
+
     /* To retain sanity, keep this in the same order and grouping as in the
        conf file */
     basisu::basis_compressor_params params;
-    #define PARAM_CONFIG(name, type) params.m_##name = configuration().value<type>(#name)
-    #define PARAM_CONFIG_FIX_NAME(name, type, fixed) params.m_##name = configuration().value<type>(fixed)
+    #define PARAM_CONFIG(name, type) params.m_##name = configuration.value<type>(#name)
+    #define PARAM_CONFIG_FIX_NAME(name, type, fixed) params.m_##name = configuration.value<type>(fixed)
     /* Options */
     PARAM_CONFIG(quality_level, int);
     PARAM_CONFIG(perceptual, bool);
@@ -83,7 +212,7 @@ Containers::Array<char> BasisImageConverter::doConvertToData(const ImageView2D&
     PARAM_CONFIG(force_alpha, bool);
     PARAM_CONFIG_FIX_NAME(seperate_rg_to_color_alpha, bool, "separate_rg_to_color_alpha");
 
-    UnsignedInt threadCount = configuration().value<Int>("threads");
+    UnsignedInt threadCount = configuration.value<Int>("threads");
     if(threadCount == 0) threadCount = std::thread::hardware_concurrency();
     const bool multithreading = threadCount > 1;
     params.m_multithreading = multithreading;
@@ -129,39 +258,47 @@ Containers::Array<char> BasisImageConverter::doConvertToData(const ImageView2D&
     basist::etc1_global_selector_codebook sel_codebook(basist::g_global_selector_cb_size, basist::g_global_selector_cb);
     params.m_pSel_codebook = &sel_codebook;
 
-    /* Copy image data into the basis image. There is no way to construct a
-       basis image from existing data as it is based on a std::vector, moreover
-       we need to tightly pack it and flip Y. The `dst` is an Y-flipped view
-       already to make the following loops simpler. */
-    params.m_source_images.emplace_back(image.size().x(), image.size().y());
-    auto dst = Containers::arrayCast<Color4ub>(Containers::StridedArrayView2D<basisu::color_rgba>({params.m_source_images.back().get_ptr(), params.m_source_images.back().get_total_pixels()}, {std::size_t(image.size().y()), std::size_t(image.size().x())})).flipped<0>();
-
-    /* basis image is always RGBA, fill in alpha if necessary */
-    if(image.format() == PixelFormat::RGBA8Unorm) {
-        auto src = image.pixels<Math::Vector4<UnsignedByte>>();
-        for(std::size_t y = 0; y != src.size()[0]; ++y)
-            for(std::size_t x = 0; x != src.size()[1]; ++x)
-                dst[y][x] = src[y][x];
-
-    } else if(image.format() == PixelFormat::RGB8Unorm) {
-        auto src = image.pixels<Math::Vector3<UnsignedByte>>();
-        for(std::size_t y = 0; y != src.size()[0]; ++y)
-            for(std::size_t x = 0; x != src.size()[1]; ++x)
-                dst[y][x] = src[y][x]; /* Alpha implicitly 255 */
-
-    } else if(image.format() == PixelFormat::RG8Unorm) {
-        auto src = image.pixels<Math::Vector2<UnsignedByte>>();
-        for(std::size_t y = 0; y != src.size()[0]; ++y)
-            for(std::size_t x = 0; x != src.size()[1]; ++x)
-                dst[y][x] = Math::gather<'r', 'r', 'r', 'g'>(src[y][x]);
-
-    } else if(image.format() == PixelFormat::R8Unorm) {
-        auto src = image.pixels<Math::Vector<1, UnsignedByte>>();
-        for(std::size_t y = 0; y != src.size()[0]; ++y)
-            for(std::size_t x = 0; x != src.size()[1]; ++x)
-                dst[y][x] = Math::gather<'r', 'r', 'r'>(src[y][x]);
-
-    } else CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+    params.m_tex_type = textureType;
+
+    /* Mip levels supplied by the user are put into a separate list, which
+       exists only since Basis 1.16 */
+    if(imageLevels.size() > 1) {
+        #if defined(BASISU_LIB_VERSION) && BASISU_LIB_VERSION >= 116
+        if(params.m_mip_gen) {
+            Warning{} << "Trade::BasisImageConverter::convertToData(): found user-supplied mip levels, ignoring mip_gen config value";
+            params.m_mip_gen = false;
+        }
+        params.m_source_mipmap_images.resize(size.z());
+        #else
+        Error{} << "Trade::BasisImageConverter::convertToData(): custom mip levels require Basis Universal 1.16 or newer";
+        return {};
+        #endif
+    }
+
+    /* Copy image data into the basis images, one for each layer. There is no
+       way to construct a basis image from existing data as it is based on a
+       std::vector, moreover we need to tightly pack it and flip Y. */
+    for(std::size_t level = 0; level != imageLevels.size(); ++level) {
+        const ImageView<dimensions, const char>& image = imageLevels[level];
+        const Vector2i levelSize = Vector3i::pad(image.size(), 1).xy();
+        for(std::size_t layer = 0; layer != std::size_t(size.z()); ++layer) {
+            basisu::image* dst{};
+            if(level == 0) {
+                params.m_source_images.emplace_back(levelSize.x(), levelSize.y());
+                dst = &params.m_source_images.back();
+            }
+            #if defined(BASISU_LIB_VERSION) && BASISU_LIB_VERSION >= 116
+            else {
+                params.m_source_mipmap_images[layer].emplace_back(levelSize.x(), levelSize.y());
+                dst = &params.m_source_mipmap_images[layer].back();
+            }
+            #else
+            else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+            #endif
+
+            CORRADE_INTERNAL_ASSERT_OUTPUT(copyLayer(format, layerPixels(image, layer), *dst));
+        }
+    }
 
     basisu::basis_compressor basis;
     basis.init(params);
@@ -207,6 +344,25 @@ Containers::Array<char> BasisImageConverter::doConvertToData(const ImageView2D&
     return fileData;
 }
 
+}
+
+BasisImageConverter::BasisImageConverter() = default;
+
+BasisImageConverter::BasisImageConverter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImageConverter{manager, plugin} {}
+
+ImageConverterFeatures BasisImageConverter::doFeatures() const {
+    return ImageConverterFeature::ConvertLevels2DToData|
+        ImageConverterFeature::ConvertLevels3DToData;
+}
+
+Containers::Array<char> BasisImageConverter::doConvertToData(const Containers::ArrayView<const ImageView2D> imageLevels) {
+    return convertLevels(imageLevels, configuration());
+}
+
+Containers::Array<char> BasisImageConverter::doConvertToData(const Containers::ArrayView<const ImageView3D> imageLevels) {
+    return convertLevels(imageLevels, configuration());
+}
+
 }}
 
 CORRADE_PLUGIN_REGISTER(BasisImageConverter, Magnum::Trade::BasisImageConverter,
@@ -58,7 +58,8 @@ namespace Magnum { namespace Trade {
 @m_since_{plugins,2019,10}
 
 Creates [Basis Universal](https://github.com/binomialLLC/basis_universal)
-(`*.basis`) files from images with format @ref PixelFormat::R8Unorm,
+(`*.basis`) files from 2D images, 2D array images and cube maps with optional
+mip levels, with format @ref PixelFormat::R8Unorm,
 @ref PixelFormat::RG8Unorm, @ref PixelFormat::RGB8Unorm or
 @ref PixelFormat::RGBA8Unorm. Use @ref BasisImporter to import images in this
 format.
@@ -112,29 +113,37 @@ See @ref building-plugins, @ref cmake-plugins, @ref plugins and
 
 @section Trade-BasisImageConverter-behavior Behavior and limitations
 
-@subsection Trade-BasisImageConverter-behavior-multiple-images Multiple images in one file
-
-Due to limitations in the @ref AbstractImageConverter API, it's currently not
-possible to create a Basis file containing multiple images --- you'd need to
-use the upstream `basisu` tool for that instead.
-
-Supplying custom mip levels will be possible when the converter gets updated to
-[the upcoming version 1.16](https://github.com/BinomialLLC/basis_universal/commit/ee626cec19e8e2d206bfc127296dfd9519352dc6). Right now, there's only a
-possibility to generate the mip levels from the top-level image using the
-@cb{.ini} mip_gen @ce @ref Trade-BasisImageConverter-configuration "configuration option".
+@subsection Trade-BasisImageConverter-behavior-multiple-images Multiple images and mip levels
+
+Passing an @ref ImageView3D creates a file with one image for each slice of
+the input. By default it's marked as a 2D array texture, the
+@cb{.ini} texture_type @ce @ref Trade-BasisImageConverter-configuration "configuration option"
+can change it to a cube map, video frames or a 3D texture. A cube map requires
+square slices and their count being a multiple of six, with faces in order
++X, -X, +Y, -Y, +Z and -Z. For 2D images the option is ignored.
+
+Both 2D and 3D images can be saved with multiple levels by using the list
+variants of @ref convertToData() / @ref convertToFile(). Each level is
+expected to have the same format and its width and height being the previous
+level divided by two, rounded down, while the slice count stays the same, as
+Basis stores a separate mip chain for each slice. If multiple levels are
+supplied, the @cb{.ini} mip_gen @ce option is ignored. Supplying custom mip
+levels requires Basis Universal 1.16 or newer, with older versions the
+conversion fails. With a single level, it's still possible to generate the mip
+levels from the top-level image using the @cb{.ini} mip_gen @ce option.
 
 @subsection Trade-BasisImageConverter-behavior-loading Loading the plugin fails with undefined symbol: pthread_create
 
 On Linux it may happen that loading the plugin will fail with
-`undefined symbol: pthread_create`. The Basis encoder is optionally
-multithreaded and while linking the dynamic plugin library to `pthread` would
-resolve this particular error, the actual thread creation (if the
+`undefined symbol: pthread_create`. The Basis encoder is multithreaded and
+while linking the dynamic plugin library to `pthread` would resolve this
+particular error, the actual thread creation (unless the
 @cb{.ini} threads @ce @ref Trade-BasisImageConverter-configuration "configuration option"
-is set to something else than `1`) later would cause @ref std::system_error to
-be thrown (or, worst case, crashing on a null function pointer call on some
-systems). Unfortunately there's no portable way to detect this case at runtime
-and fail gracefully, so the plugin requires *the application* to link to
-`pthread` instead. With CMake it can be done like this:
+is set to `1`) later would cause @ref std::system_error to be thrown (or,
+worst case, crashing on a null function pointer call on some systems).
+Unfortunately there's no portable way to detect this case at runtime and fail
+gracefully, so the plugin requires *the application* to link to `pthread`
+instead. With CMake it can be done like this:
 
 @code{.cmake}
 find_package(Threads REQUIRED)
@@ -162,7 +171,8 @@ class MAGNUM_BASISIMAGECONVERTER_EXPORT BasisImageConverter: public AbstractImag
 
     private:
         MAGNUM_BASISIMAGECONVERTER_LOCAL ImageConverterFeatures doFeatures() const override;
-        MAGNUM_BASISIMAGECONVERTER_LOCAL Containers::Array<char> doConvertToData(const ImageView2D& image) override;
+        MAGNUM_BASISIMAGECONVERTER_LOCAL Containers::Array<char> doConvertToData(Containers::ArrayView<const ImageView2D> imageLevels) override;
+        MAGNUM_BASISIMAGECONVERTER_LOCAL Containers::Array<char> doConvertToData(Containers::ArrayView<const ImageView3D> imageLevels) override;
 };
 
 }}
@@ -30,6 +30,7 @@
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -38,6 +39,7 @@
 #include <Magnum/Image.h>
 #include <Magnum/ImageView.h>
 #include <Magnum/Math/Color.h>
+#include <Magnum/Math/Functions.h>
 #include <Magnum/PixelFormat.h>
 #include <Magnum/Trade/AbstractImageConverter.h>
 #include <Magnum/Trade/AbstractImporter.h>
@@ -52,12 +54,20 @@ struct BasisImageConverterTest: TestSuite::Tester {
 
     void wrongFormat();
     void processError();
+    void levelWrongFormat();
+    void levelWrongSize();
+    void tooManyLevels();
+    void invalidTextureType();
+    void cubeMapInvalidSize();
 
     void r();
     void rg();
     void rgb();
     void rgba();
 
+    void levels();
+    void array();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImageConverter> _converterManager{"nonexistent"};
 
@@ -71,12 +81,42 @@ constexpr struct {
 } ThreadsData[] {
     {"", nullptr},
     {"2 threads", "2"},
-    {"all threads", "0"}
+    {"all threads", "0"},
+    /* The default is all threads, so the single-threaded case has to be
+       tested explicitly */
+    {"1 thread", "1"}
 };
 
+/* Returns a copy of the image with red and blue channels swapped */
+Image2D swapRedBlue(const ImageView2D& image) {
+    Image2D swapped{PixelFormat::RGBA8Unorm, image.size(),
+        Containers::Array<char>{ValueInit, std::size_t(image.size().product()*4)}};
+    for(std::size_t y = 0; y != std::size_t(image.size().y()); ++y) for(std::size_t x = 0; x != std::size_t(image.size().x()); ++x) {
+        const Color4ub pixel = image.pixels<Color4ub>()[y][x];
+        swapped.pixels<Color4ub>()[y][x] = {pixel.b(), pixel.g(), pixel.r(), pixel.a()};
+    }
+    return swapped;
+}
+
+/* Average absolute difference per channel. Used to check which of two
+   candidate images a lossy decode is closer to, as opposed to comparing with
+   thresholds that depend on the Basis Universal version. */
+Float meanDifference(const Containers::StridedArrayView2D<const Color4ub>& a, const Containers::StridedArrayView2D<const Color4ub>& b) {
+    CORRADE_INTERNAL_ASSERT(a.size() == b.size());
+    Float sum = 0.0f;
+    for(std::size_t y = 0; y != a.size()[0]; ++y) for(std::size_t x = 0; x != a.size()[1]; ++x)
+        sum += Math::abs(Vector4i{a[y][x]} - Vector4i{b[y][x]}).sum();
+    return sum/(a.size()[0]*a.size()[1]*4);
+}
+
 BasisImageConverterTest::BasisImageConverterTest() {
     addTests({&BasisImageConverterTest::wrongFormat,
               &BasisImageConverterTest::processError,
+              &BasisImageConverterTest::levelWrongFormat,
+              &BasisImageConverterTest::levelWrongSize,
+              &BasisImageConverterTest::tooManyLevels,
+              &BasisImageConverterTest::invalidTextureType,
+              &BasisImageConverterTest::cubeMapInvalidSize,
 
               &BasisImageConverterTest::r,
               &BasisImageConverterTest::rg,
@@ -86,6 +126,9 @@ BasisImageConverterTest::BasisImageConverterTest() {
     addInstancedTests({&BasisImageConverterTest::rgba},
         Containers::arraySize(ThreadsData));
 
+    addTests({&BasisImageConverterTest::levels,
+              &BasisImageConverterTest::array});
+
     /* Pull in the AnyImageImporter dependency for image comparison, load
        StbImageImporter from the build tree, if defined. Otherwise it's static
        and already loaded. */
@@ -131,6 +174,74 @@ void BasisImageConverterTest::processError() {
         "Trade::BasisImageConverter::convertToData(): frontend processing failed\n");
 }
 
+void BasisImageConverterTest::levelWrongFormat() {
+    Containers::Pointer<AbstractImageConverter> converter =
+        _converterManager.instantiate("BasisImageConverter");
+
+    const char data[16*16*4]{};
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->convertToData({
+        ImageView2D{PixelFormat::RGBA8Unorm, {16, 16}, data},
+        ImageView2D{PixelFormat::RGB8Unorm, {8, 8}, data}}));
+    CORRADE_COMPARE(out.str(), "Trade::BasisImageConverter::convertToData(): expected format PixelFormat::RGBA8Unorm for level 1 but got PixelFormat::RGB8Unorm\n");
+}
+
+void BasisImageConverterTest::levelWrongSize() {
+    Containers::Pointer<AbstractImageConverter> converter =
+        _converterManager.instantiate("BasisImageConverter");
+
+    const char data[16*16*4*2]{};
+    std::ostringstream out;
+    Error redirectError{&out};
+    /* The slice count has to stay the same */
+    CORRADE_VERIFY(!converter->convertToData({
+        ImageView3D{PixelFormat::RGBA8Unorm, {16, 16, 2}, data},
+        ImageView3D{PixelFormat::RGBA8Unorm, {8, 8, 1}, data}}));
+    CORRADE_COMPARE(out.str(), "Trade::BasisImageConverter::convertToData(): expected size Vector(8, 8, 2) for level 1 but got Vector(8, 8, 1)\n");
+}
+
+void BasisImageConverterTest::tooManyLevels() {
+    Containers::Pointer<AbstractImageConverter> converter =
+        _converterManager.instantiate("BasisImageConverter");
+
+    const char data[4*4]{};
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->convertToData({
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 1}, data},
+        ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data},
+        ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data}}));
+    CORRADE_COMPARE(out.str(), "Trade::BasisImageConverter::convertToData(): there can be only 2 levels with base image size Vector(2, 1) but got 3\n");
+}
+
+void BasisImageConverterTest::invalidTextureType() {
+    Containers::Pointer<AbstractImageConverter> converter =
+        _converterManager.instantiate("BasisImageConverter");
+    converter->configuration().setValue("texture_type", "1darray");
+
+    const char data[16*16*4*2]{};
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->convertToData(ImageView3D{PixelFormat::RGBA8Unorm, {16, 16, 2}, data}));
+    CORRADE_COMPARE(out.str(), "Trade::BasisImageConverter::convertToData(): invalid texture type 1darray, expected 2darray, cubemap, video or 3d\n");
+}
+
+void BasisImageConverterTest::cubeMapInvalidSize() {
+    Containers::Pointer<AbstractImageConverter> converter =
+        _converterManager.instantiate("BasisImageConverter");
+    converter->configuration().setValue("texture_type", "cubemap");
+
+    const char data[16*16*4*6]{};
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->convertToData(ImageView3D{PixelFormat::RGBA8Unorm, {16, 16, 5}, data}));
+    CORRADE_VERIFY(!converter->convertToData(ImageView3D{PixelFormat::RGBA8Unorm, {16, 8, 6}, data}));
+    CORRADE_COMPARE(out.str(),
+        "Trade::BasisImageConverter::convertToData(): expected square faces and a multiple of 6 layers for a cube map but got Vector(16, 16, 5)\n"
+        "Trade::BasisImageConverter::convertToData(): expected square faces and a multiple of 6 layers for a cube map but got Vector(16, 8, 6)\n");
+}
+
 void BasisImageConverterTest::r() {
     if(_manager.loadState("PngImporter") == PluginManager::LoadState::NotFound)
         CORRADE_SKIP("PngImporter plugin not found, cannot test contents");
@@ -299,6 +410,104 @@ void BasisImageConverterTest::rgba() {
         (DebugTools::CompareImageToFile{_manager, 78.3f, 8.302f}));
 }
 
+void BasisImageConverterTest::levels() {
+    if(_manager.loadState("PngImporter") == PluginManager::LoadState::NotFound)
+        CORRADE_SKIP("PngImporter plugin not found, cannot test contents");
+
+    Containers::Pointer<AbstractImporter> pngImporter =
+        _manager.instantiate("PngImporter");
+    CORRADE_VERIFY(pngImporter->openFile(Utility::Directory::join(BASISIMPORTER_TEST_DIR, "rgba-63x27.png")));
+    const auto level0 = pngImporter->image2D(0);
+    CORRADE_VERIFY(level0);
+    CORRADE_VERIFY(pngImporter->openFile(Utility::Directory::join(BASISIMPORTER_TEST_DIR, "rgba-31x13.png")));
+    const auto originalLevel1 = pngImporter->image2D(0);
+    CORRADE_VERIFY(originalLevel1);
+
+    /* Swapping the channels makes the level clearly different from one that
+       would be generated from the base level */
+    const Image2D level1 = swapRedBlue(*originalLevel1);
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("BasisImageConverter");
+
+    std::ostringstream out;
+    Containers::Array<char> compressedData;
+    {
+        Error redirectError{&out};
+        compressedData = converter->convertToData({ImageView2D{*level0}, ImageView2D{level1}});
+    }
+    if(!compressedData && out.str() == "Trade::BasisImageConverter::convertToData(): custom mip levels require Basis Universal 1.16 or newer\n")
+        CORRADE_SKIP("Basis Universal is too old to support custom mip levels");
+    CORRADE_VERIFY(compressedData);
+
+    if(_manager.loadState("BasisImporter") == PluginManager::LoadState::NotFound)
+        CORRADE_SKIP("BasisImporter plugin not found, cannot test");
+
+    Containers::Pointer<AbstractImporter> importer =
+        _manager.instantiate("BasisImporterRGBA8");
+    CORRADE_VERIFY(importer->openData(compressedData));
+    CORRADE_COMPARE(importer->image2DCount(), 1);
+    CORRADE_COMPARE(importer->image2DLevelCount(0), 2);
+
+    Containers::Optional<Trade::ImageData2D> image0 = importer->image2D(0, 0);
+    Containers::Optional<Trade::ImageData2D> image1 = importer->image2D(0, 1);
+    CORRADE_VERIFY(image0);
+    CORRADE_VERIFY(image1);
+    CORRADE_COMPARE(image0->size(), (Vector2i{63, 27}));
+    CORRADE_COMPARE(image1->size(), (Vector2i{31, 13}));
+
+    /* The levels should be closer to the images that were passed in than to
+       their swapped variants */
+    CORRADE_COMPARE_AS(meanDifference(image0->pixels<Color4ub>(), level0->pixels<Color4ub>()),
+        meanDifference(image0->pixels<Color4ub>(), swapRedBlue(*level0).pixels<Color4ub>()),
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(meanDifference(image1->pixels<Color4ub>(), level1.pixels<Color4ub>()),
+        meanDifference(image1->pixels<Color4ub>(), originalLevel1->pixels<Color4ub>()),
+        TestSuite::Compare::Less);
+}
+
+void BasisImageConverterTest::array() {
+    if(_manager.loadState("PngImporter") == PluginManager::LoadState::NotFound)
+        CORRADE_SKIP("PngImporter plugin not found, cannot test contents");
+
+    Containers::Pointer<AbstractImporter> pngImporter =
+        _manager.instantiate("PngImporter");
+    CORRADE_VERIFY(pngImporter->openFile(Utility::Directory::join(BASISIMPORTER_TEST_DIR, "rgba-63x27.png")));
+    const auto originalImage = pngImporter->image2D(0);
+    CORRADE_VERIFY(originalImage);
+
+    /* Two slices, the second one being the first with R and B swapped */
+    const Image2D swapped = swapRedBlue(*originalImage);
+    Image3D image{PixelFormat::RGBA8Unorm, {63, 27, 2},
+        Containers::Array<char>{ValueInit, 63*27*2*4}};
+    Utility::copy(originalImage->pixels<Color4ub>(), image.pixels<Color4ub>()[0]);
+    Utility::copy(swapped.pixels<Color4ub>(), image.pixels<Color4ub>()[1]);
+
+    const auto compressedData = _converterManager.instantiate("BasisImageConverter")->convertToData(image);
+    CORRADE_VERIFY(compressedData);
+
+    if(_manager.loadState("BasisImporter") == PluginManager::LoadState::NotFound)
+        CORRADE_SKIP("BasisImporter plugin not found, cannot test");
+
+    Containers::Pointer<AbstractImporter> importer =
+        _manager.instantiate("BasisImporterRGBA8");
+    CORRADE_VERIFY(importer->openData(compressedData));
+    CORRADE_COMPARE(importer->image2DCount(), 2);
+
+    Containers::Optional<Trade::ImageData2D> image0 = importer->image2D(0);
+    Containers::Optional<Trade::ImageData2D> image1 = importer->image2D(1);
+    CORRADE_VERIFY(image0);
+    CORRADE_VERIFY(image1);
+
+    /* Each slice should be closer to the image it was made from than to the
+       other one */
+    CORRADE_COMPARE_AS(meanDifference(image0->pixels<Color4ub>(), originalImage->pixels<Color4ub>()),
+        meanDifference(image0->pixels<Color4ub>(), swapped.pixels<Color4ub>()),
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(meanDifference(image1->pixels<Color4ub>(), swapped.pixels<Color4ub>()),
+        meanDifference(image1->pixels<Color4ub>(), originalImage->pixels<Color4ub>()),
+        TestSuite::Compare::Less);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::BasisImageConverterTest)
@@ -28,16 +28,22 @@
 
 #include <basisu_transcoder.h>
 
+#include <atomic>
+#include <thread>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/ScopeGuard.h>
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/ConfigurationValue.h>
 #include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/String.h>
 #include <Magnum/PixelFormat.h>
+#include <Magnum/Math/Functions.h>
 #include <Magnum/Trade/ImageData.h>
 
+#include "MagnumPlugins/Implementation/ImporterFileData.h"
+
 namespace Magnum { namespace Trade { namespace {
 
 /* Map BasisImporter::TargetFormat to CompressedPixelFormat. See the
@@ -122,11 +128,73 @@ template<> struct ConfigurationValue<Magnum::Trade::BasisImporter::TargetFormat>
 
 namespace Magnum { namespace Trade {
 
-struct BasisImporter::State {
+namespace {
+
+Containers::Optional<BasisImporter::TargetFormat> targetFormatFromConfiguration(const Utility::ConfigurationGroup& configuration, bool& noTranscodeFormatWarningPrinted, const char* const prefix) {
+    std::string targetFormatStr = configuration.value<std::string>("format");
+    if(targetFormatStr.empty()) {
+        if(!noTranscodeFormatWarningPrinted)
+            Warning{} << prefix << "no format to transcode to was specified, falling back to uncompressed RGBA8. To get rid of this warning either load the plugin via one of its BasisImporterEtc1RGB, ... aliases, or explicitly set the format option in plugin configuration.";
+        noTranscodeFormatWarningPrinted = true;
+        return BasisImporter::TargetFormat::RGBA8;
+    }
+
+    const auto targetFormat = configuration.value<BasisImporter::TargetFormat>("format");
+    if(UnsignedInt(targetFormat) == ~UnsignedInt{}) {
+        Error() << prefix << "invalid transcoding target format"
+            << targetFormatStr.data() << Debug::nospace << ", expected to be one of EacR, EacRG, Etc1RGB, Etc2RGBA, Bc1RGB, Bc3RGBA, Bc4R, Bc5RG, Bc7RGB, Bc7RGBA, Pvrtc1RGB4bpp, Pvrtc1RGBA4bpp, Astc4x4RGBA, RGBA8";
+        return Containers::NullOpt;
+    }
+
+    return targetFormat;
+}
+
+/* Parameters of a transcode_image_level() call for given image level */
+struct LevelInfo {
+    Vector2i size;
+    UnsignedInt dataSize, rowStride, outputSizeInBlocksOrPixels, outputRowsInPixels;
+};
+
+LevelInfo levelInfo(const basist::basisu_transcoder& transcoder, const Containers::ArrayView<const char> data, const BasisImporter::TargetFormat targetFormat, const UnsignedInt id, const UnsignedInt level) {
+    basist::basisu_image_info info;
+    /* Header validation etc. is already done in doOpenData() and id is
+       bounds-checked against doImage2DCount() by AbstractImporter, so by
+       looking at the code there's nothing else that could fail and wasn't
+       already caught before. That means we also can't craft any file to cover
+       an error path, so turning this into an assert. When this blows up for
+       someome, we'd most probably need to harden doOpenData() to catch that,
+       not turning this into a graceful error. */
+    CORRADE_INTERNAL_ASSERT_OUTPUT(transcoder.get_image_info(data.data(), data.size(), info, id));
+
+    UnsignedInt origWidth, origHeight, totalBlocks;
+    /* Same as above, it checks for state we already verified before. If this
+       blows up for someone, we can reconsider. */
+    CORRADE_INTERNAL_ASSERT_OUTPUT(transcoder.get_image_level_desc(data.data(), data.size(), id, level, origWidth, origHeight, totalBlocks));
+
+    LevelInfo out;
+    out.size = {Int(origWidth), Int(origHeight)};
+    if(targetFormat == BasisImporter::TargetFormat::RGBA8) {
+        out.rowStride = out.size.x();
+        out.outputRowsInPixels = out.size.y();
+        out.outputSizeInBlocksOrPixels = out.size.product();
+        out.dataSize = 4*out.outputSizeInBlocksOrPixels;
+    } else {
+        out.rowStride = 0; /* left up to Basis to calculate */
+        out.outputRowsInPixels = 0; /* not used for compressed data */
+        out.outputSizeInBlocksOrPixels = totalBlocks;
+        out.dataSize = basis_get_bytes_per_block(basist::transcoder_texture_format(Int(targetFormat)))*totalBlocks;
+    }
+
+    return out;
+}
+
+}
+
+/* The file data are never memory-mapped, as there's no memoryMapFile option */
+struct BasisImporter::State: Implementation::ImporterFileData {
     /* There is only this type of codebook */
     basist::etc1_global_selector_codebook codebook;
     Containers::Optional<basist::basisu_transcoder> transcoder;
-    Containers::Array<char> in;
     basist::basisu_file_info fileInfo;
 
     bool noTranscodeFormatWarningPrinted = false;
@@ -143,6 +211,8 @@ BasisImporter::BasisImporter(): _state{InPlaceInit} {
     /* Initialize default configuration values */
     /** @todo horrible workaround, fix this properly */
     configuration().setValue("format", "");
+    configuration().setValue("borrowData", false);
+    configuration().setValue("threads", 1);
 }
 
 BasisImporter::BasisImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {
@@ -164,26 +234,44 @@ ImporterFeatures BasisImporter::doFeatures() const { return ImporterFeature::Ope
 bool BasisImporter::doIsOpened() const {
     /* Both the transcoder and then input data have to be present or both
        have to be empty */
-    CORRADE_INTERNAL_ASSERT(!_state->transcoder == !_state->in);
-    return _state->in;
+    CORRADE_INTERNAL_ASSERT(!_state->transcoder == _state->data.empty());
+    return !_state->data.empty();
 }
 
 void BasisImporter::doClose() {
     _state->transcoder = Containers::NullOpt;
-    _state->in = nullptr;
+    _state->ownedData = nullptr;
+    _state->data = nullptr;
+}
+
+void BasisImporter::doOpenFile(const std::string& filename) {
+    /* The default implementation would read the file into a temporary array
+       and pass it to doOpenData(), which would then either make a second copy
+       of it or, with borrowData enabled, reference memory that's gone right
+       after. Read it directly into the owned array instead. */
+    if(!_state->openFile(filename, false, "Trade::BasisImporter::openFile():"))
+        return;
+    if(!openDataInternal(_state->data, "Trade::BasisImporter::openFile():"))
+        doClose();
 }
 
 void BasisImporter::doOpenData(const Containers::ArrayView<const char> data) {
-    /* Because here we're copying the data and using the _in to check if file
-       is opened, having them nullptr would mean openData() would fail without
-       any error message. It's not possible to do this check on the importer
+    if(!openDataInternal(data, "Trade::BasisImporter::openData():")) return;
+
+    _state->openData(data, configuration().value<bool>("borrowData"));
+}
+
+bool BasisImporter::openDataInternal(const Containers::ArrayView<const char> data, const char* const prefix) {
+    /* Because here we're using the data view to check if file is opened,
+       having it empty would mean openData() would fail without any error
+       message. It's not possible to do this check on the importer
        side, because empty file is valid in some formats (OBJ or glTF). We also
        can't do the full import here because then doImage2D() would need to
        copy the imported data instead anyway (and the uncompressed size is much
        larger). This way it'll also work nicely with a future openMemory(). */
     if(data.empty()) {
-        Error{} << "Trade::BasisImporter::openData(): the file is empty";
-        return;
+        Error{} << prefix << "the file is empty";
+        return false;
     }
 
     _state->transcoder.emplace(&_state->codebook);
@@ -191,22 +279,22 @@ void BasisImporter::doOpenData(const Containers::ArrayView<const char> data) {
         *o = Containers::NullOpt;
     }};
     if(!_state->transcoder->validate_header(data.data(), data.size())) {
-        Error() << "Trade::BasisImporter::openData(): invalid header";
-        return;
+        Error() << prefix << "invalid header";
+        return false;
     }
 
     /* Save the global file info to avoid calling that again each time we check
        for image count and whatnot; start transcoding */
     if(!_state->transcoder->get_file_info(data.data(), data.size(), _state->fileInfo) ||
        !_state->transcoder->start_transcoding(data.data(), data.size())) {
-        Error() << "Trade::BasisImporter::openData(): bad basis file";
-        return;
+        Error() << prefix << "bad basis file";
+        return false;
     }
 
-    /* All good, release the transcoder guard and keep a copy of the data */
+    /* All good, release the transcoder guard, the caller then saves the
+       data */
     transcoderGuard.release();
-    _state->in = Containers::Array<char>{NoInit, data.size()};
-    Utility::copy(data, _state->in);
+    return true;
 }
 
 UnsignedInt BasisImporter::doImage2DCount() const {
@@ -218,37 +306,11 @@ UnsignedInt BasisImporter::doImage2DLevelCount(const UnsignedInt id) {
 }
 
 Containers::Optional<ImageData2D> BasisImporter::doImage2D(const UnsignedInt id, const UnsignedInt level) {
-    std::string targetFormatStr = configuration().value<std::string>("format");
-    TargetFormat targetFormat;
-    if(targetFormatStr.empty()) {
-        if(!_state->noTranscodeFormatWarningPrinted)
-            Warning{} << "Trade::BasisImporter::image2D(): no format to transcode to was specified, falling back to uncompressed RGBA8. To get rid of this warning either load the plugin via one of its BasisImporterEtc1RGB, ... aliases, or explicitly set the format option in plugin configuration.";
-        targetFormat = TargetFormat::RGBA8;
-        _state->noTranscodeFormatWarningPrinted = true;
-    } else {
-        targetFormat = configuration().value<TargetFormat>("format");
-        if(UnsignedInt(targetFormat) == ~UnsignedInt{}) {
-            Error() << "Trade::BasisImporter::image2D(): invalid transcoding target format"
-                << targetFormatStr.data() << Debug::nospace << ", expected to be one of EacR, EacRG, Etc1RGB, Etc2RGBA, Bc1RGB, Bc3RGBA, Bc4R, Bc5RG, Bc7RGB, Bc7RGBA, Pvrtc1RGB4bpp, Pvrtc1RGBA4bpp, Astc4x4RGBA, RGBA8";
-            return Containers::NullOpt;
-        }
-    }
-    const auto format = basist::transcoder_texture_format(Int(targetFormat));
+    const Containers::Optional<TargetFormat> targetFormat = targetFormatFromConfiguration(configuration(), _state->noTranscodeFormatWarningPrinted, "Trade::BasisImporter::image2D():");
+    if(!targetFormat) return Containers::NullOpt;
+    const auto format = basist::transcoder_texture_format(Int(*targetFormat));
 
-    basist::basisu_image_info info;
-    /* Header validation etc. is already done in doOpenData() and id is
-       bounds-checked against doImage2DCount() by AbstractImporter, so by
-       looking at the code there's nothing else that could fail and wasn't
-       already caught before. That means we also can't craft any file to cover
-       an error path, so turning this into an assert. When this blows up for
-       someome, we'd most probably need to harden doOpenData() to catch that,
-       not turning this into a graceful error. */
-    CORRADE_INTERNAL_ASSERT_OUTPUT(_state->transcoder->get_image_info(_state->in.data(), _state->in.size(), info, id));
-
-    UnsignedInt origWidth, origHeight, totalBlocks;
-    /* Same as above, it checks for state we already verified before. If this
-       blows up for someone, we can reconsider. */
-    CORRADE_INTERNAL_ASSERT_OUTPUT(_state->transcoder->get_image_level_desc(_state->in.data(), _state->in.size(), id, level, origWidth, origHeight, totalBlocks));
+    const LevelInfo info = levelInfo(*_state->transcoder, _state->data, *targetFormat, id, level);
 
     /* No flags used by transcode_image_level() by default */
     const std::uint32_t flags = 0;
@@ -258,29 +320,118 @@ Containers::Optional<ImageData2D> BasisImporter::doImage2D(const UnsignedInt id,
         //flags |= basist::basisu_transcoder::cDecodeFlagsFlipY;
     }
 
-    Vector2i size{Int(origWidth), Int(origHeight)};
-    UnsignedInt dataSize, rowStride, outputSizeInBlocksOrPixels, outputRowsInPixels;
-    if(targetFormat == BasisImporter::TargetFormat::RGBA8) {
-        rowStride = size.x();
-        outputRowsInPixels = size.y();
-        outputSizeInBlocksOrPixels = size.product();
-        dataSize = 4*outputSizeInBlocksOrPixels;
-    } else {
-        rowStride = 0; /* left up to Basis to calculate */
-        outputRowsInPixels = 0; /* not used for compressed data */
-        outputSizeInBlocksOrPixels = totalBlocks;
-        dataSize = basis_get_bytes_per_block(format)*totalBlocks;
-    }
-    Containers::Array<char> dest{DefaultInit, dataSize};
-    if(!_state->transcoder->transcode_image_level(_state->in.data(), _state->in.size(), id, level, dest.data(), outputSizeInBlocksOrPixels, basist::transcoder_texture_format(format), flags, rowStride, nullptr, outputRowsInPixels)) {
+    /* The transcoder writes all blocks or pixels, no need to zero-init */
+    Containers::Array<char> dest{NoInit, info.dataSize};
+    if(!_state->transcoder->transcode_image_level(_state->data.data(), _state->data.size(), id, level, dest.data(), info.outputSizeInBlocksOrPixels, format, flags, info.rowStride, nullptr, info.outputRowsInPixels)) {
         Error{} << "Trade::BasisImporter::image2D(): transcoding failed";
         return Containers::NullOpt;
     }
 
-    if(targetFormat == BasisImporter::TargetFormat::RGBA8)
-        return Trade::ImageData2D{PixelFormat::RGBA8Unorm, size, std::move(dest)};
+    if(*targetFormat == BasisImporter::TargetFormat::RGBA8)
+        return Trade::ImageData2D{PixelFormat::RGBA8Unorm, info.size, std::move(dest)};
     else
-        return Trade::ImageData2D{compressedPixelFormat(targetFormat), size, std::move(dest)};
+        return Trade::ImageData2D{compressedPixelFormat(*targetFormat), info.size, std::move(dest)};
+}
+
+Vector2i BasisImporter::image2DSize(const UnsignedInt id, const UnsignedInt level) {
+    CORRADE_ASSERT(isOpened(),
+        "Trade::BasisImporter::image2DSize(): no file opened", {});
+    CORRADE_ASSERT(id < image2DCount(),
+        "Trade::BasisImporter::image2DSize(): index" << id << "out of range for" << image2DCount() << "entries", {});
+    CORRADE_ASSERT(level < image2DLevelCount(id),
+        "Trade::BasisImporter::image2DSize(): level" << level << "out of range for" << image2DLevelCount(id) << "entries", {});
+
+    /* The size doesn't depend on the target format */
+    return levelInfo(*_state->transcoder, _state->data, TargetFormat::RGBA8, id, level).size;
+}
+
+std::size_t BasisImporter::image2DTranscodedDataSize(const UnsignedInt id, const UnsignedInt level) {
+    CORRADE_ASSERT(isOpened(),
+        "Trade::BasisImporter::image2DTranscodedDataSize(): no file opened", {});
+    CORRADE_ASSERT(id < image2DCount(),
+        "Trade::BasisImporter::image2DTranscodedDataSize(): index" << id << "out of range for" << image2DCount() << "entries", {});
+    CORRADE_ASSERT(level < image2DLevelCount(id),
+        "Trade::BasisImporter::image2DTranscodedDataSize(): level" << level << "out of range for" << image2DLevelCount(id) << "entries", {});
+
+    const Containers::Optional<TargetFormat> targetFormat = targetFormatFromConfiguration(configuration(), _state->noTranscodeFormatWarningPrinted, "Trade::BasisImporter::image2DTranscodedDataSize():");
+    if(!targetFormat) return 0;
+
+    return levelInfo(*_state->transcoder, _state->data, *targetFormat, id, level).dataSize;
+}
+
+bool BasisImporter::transcodeImage2DInto(const UnsignedInt id, const UnsignedInt level, const Containers::ArrayView<char> data) {
+    const TranscodeJob job{id, level, data};
+    return transcodeImage2DInto({&job, 1});
+}
+
+bool BasisImporter::transcodeImage2DInto(const Containers::ArrayView<const TranscodeJob> jobs) {
+    CORRADE_ASSERT(isOpened(),
+        "Trade::BasisImporter::transcodeImage2DInto(): no file opened", {});
+
+    const Containers::Optional<TargetFormat> targetFormat = targetFormatFromConfiguration(configuration(), _state->noTranscodeFormatWarningPrinted, "Trade::BasisImporter::transcodeImage2DInto():");
+    if(!targetFormat) return false;
+    const auto format = basist::transcoder_texture_format(Int(*targetFormat));
+
+    /* Check all jobs upfront so we don't fail in the middle with half of the
+       output written */
+    Containers::Array<LevelInfo> infos{ValueInit, jobs.size()};
+    for(std::size_t i = 0; i != jobs.size(); ++i) {
+        const TranscodeJob& job = jobs[i];
+        CORRADE_ASSERT(job.id < image2DCount(),
+            "Trade::BasisImporter::transcodeImage2DInto(): index" << job.id << "out of range for" << image2DCount() << "entries", {});
+        CORRADE_ASSERT(job.level < image2DLevelCount(job.id),
+            "Trade::BasisImporter::transcodeImage2DInto(): level" << job.level << "out of range for" << image2DLevelCount(job.id) << "entries", {});
+
+        infos[i] = levelInfo(*_state->transcoder, _state->data, *targetFormat, job.id, job.level);
+        if(job.data.size() < infos[i].dataSize) {
+            Error{} << "Trade::BasisImporter::transcodeImage2DInto(): expected at least" << infos[i].dataSize << "bytes for image" << job.id << "level" << job.level << "but got" << job.data.size();
+            return false;
+        }
+    }
+
+    /* No flags used by transcode_image_level() by default */
+    const std::uint32_t flags = 0;
+    if(!_state->fileInfo.m_y_flipped) {
+        /** @todo replace with the flag once the PR is submitted */
+        Warning{} << "Trade::BasisImporter::transcodeImage2DInto(): the image was not encoded Y-flipped, transcoded data will have wrong orientation";
+        //flags |= basist::basisu_transcoder::cDecodeFlagsFlipY;
+    }
+
+    /* The levels in a mip chain differ in size a lot, so instead of splitting
+       the jobs into equal ranges each thread picks the next unprocessed job
+       once it's done with the previous one. The transcoder itself is
+       read-only during transcoding, the only mutable state is in
+       basisu_transcoder_state, which is thus created for every thread. */
+    const basist::basisu_transcoder& transcoder = *_state->transcoder;
+    const Containers::ArrayView<const char> in = _state->data;
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> failed{false};
+    auto transcode = [&]() {
+        basist::basisu_transcoder_state state;
+        for(std::size_t i; (i = next++) < jobs.size(); ) {
+            const TranscodeJob& job = jobs[i];
+            const LevelInfo& info = infos[i];
+            if(!transcoder.transcode_image_level(in.data(), in.size(), job.id, job.level, job.data.data(), info.outputSizeInBlocksOrPixels, format, flags, info.rowStride, &state, info.outputRowsInPixels))
+                failed = true;
+        }
+    };
+
+    /* There's no point in having more threads than jobs */
+    std::size_t threadCount = configuration().value<UnsignedInt>("threads");
+    if(threadCount == 0) threadCount = std::thread::hardware_concurrency();
+    threadCount = Math::max(std::size_t{1}, Math::min(threadCount, jobs.size()));
+
+    Containers::Array<std::thread> threads{threadCount - 1};
+    for(std::thread& thread: threads) thread = std::thread{transcode};
+    transcode();
+    for(std::thread& thread: threads) thread.join();
+
+    if(failed) {
+        Error{} << "Trade::BasisImporter::transcodeImage2DInto(): transcoding failed";
+        return false;
+    }
+
+    return true;
 }
 
 void BasisImporter::setTargetFormat(TargetFormat format) {
@@ -31,6 +31,7 @@
 * @m_since_{plugins,2019,10}
 */
 
+#include <Corrade/Containers/ArrayView.h>
 #include <Magnum/Trade/AbstractImporter.h>
 
 #include "MagnumPlugins/BasisImporter/configure.h"
@@ -168,6 +169,46 @@ OpenGL, OpenGL ES and WebGL extensions, in its full ugly glory:
     To account for this on the application side for files that you don't have a
     control of, flip texture coordinates of the mesh or patch texture data
     loading in the shader.
+
+@subsection Trade-BasisImporter-transcode-into Transcoding into existing memory
+
+Every @ref image2D() call allocates a new array for the transcoded data. When
+the data are meant to be copied somewhere else anyway, such as into a GPU
+staging buffer, it's possible to transcode them there directly using
+@ref transcodeImage2DInto(). The required size for given image level is
+returned by @ref image2DTranscodedDataSize(), the image size by
+@ref image2DSize(). As these functions aren't a part of the
+@ref AbstractImporter interface, they're accessible only if the application
+links to the plugin, for example when using it as a static plugin:
+
+@snippet BasisImporter.cpp transcode-into
+
+Passing a list of @ref TranscodeJob instances to
+@ref transcodeImage2DInto(Containers::ArrayView<const TranscodeJob>)
+transcodes a whole mip chain or multiple images in one call. With the
+@cb{.ini} threads @ce @ref Trade-BasisImporter-configuration "configuration option"
+set to a value other than `1`, the jobs are distributed across multiple
+threads, each thread picking the next job once it's done with the previous
+one. Similarly to @ref Trade-StanfordImporter-behavior-multithreading "StanfordImporter",
+the plugin doesn't link to `pthread` on its own and it's the application that
+needs to link to it instead if multithreading is enabled. With CMake it can be
+done like this:
+
+@code{.cmake}
+find_package(Threads REQUIRED)
+target_link_libraries(your-application PRIVATE Threads::Threads)
+@endcode
+
+@subsection Trade-BasisImporter-borrowed-data Borrowed data
+
+By default, @ref openData() makes a copy of the passed data, as the file has
+to be kept around for transcoding. The @cb{.ini} borrowData @ce
+@ref Trade-BasisImporter-configuration "configuration option" makes it
+reference the passed memory instead --- in that case it's the caller's
+responsibility to keep the memory alive and unchanged until the importer is
+closed. The option doesn't affect @ref openFile(), which reads the file into
+memory owned by the importer. The returned @ref ImageData2D always own their
+data, so they can outlive the importer.
 */
 class MAGNUM_BASISIMPORTER_EXPORT BasisImporter: public AbstractImporter {
     public:
@@ -289,6 +330,74 @@ class MAGNUM_BASISIMPORTER_EXPORT BasisImporter: public AbstractImporter {
 
         ~BasisImporter();
 
+        /**
+         * @brief Transcoding job
+         *
+         * @see @ref transcodeImage2DInto(Containers::ArrayView<const TranscodeJob>)
+         */
+        struct TranscodeJob {
+            /** @brief Image ID */
+            UnsignedInt id;
+
+            /** @brief Image level */
+            UnsignedInt level;
+
+            /**
+             * @brief Output data
+             *
+             * Has to be at least @ref image2DTranscodedDataSize() bytes large.
+             */
+            Containers::ArrayView<char> data;
+        };
+
+        /**
+         * @brief Image size
+         *
+         * Equivalent to @ref ImageData2D::size() of the image returned by
+         * @ref image2D(), but without transcoding the data. Expects that a
+         * file is opened, @p id is less than @ref image2DCount() and
+         * @p level is less than @ref image2DLevelCount().
+         */
+        Vector2i image2DSize(UnsignedInt id, UnsignedInt level = 0);
+
+        /**
+         * @brief Size of transcoded image data
+         *
+         * Size of the data @ref transcodeImage2DInto() writes for given
+         * image and level with the currently set target format. Same
+         * expectations as with @ref image2DSize() apply. If the target format
+         * set in the configuration is invalid, prints a message to
+         * @relativeref{Magnum,Error} and returns @cpp 0 @ce.
+         * @see @ref Trade-BasisImporter-transcode-into
+         */
+        std::size_t image2DTranscodedDataSize(UnsignedInt id, UnsignedInt level = 0);
+
+        /**
+         * @brief Transcode an image into an existing memory
+         *
+         * Like @ref image2D(), but writes the transcoded data into @p data
+         * instead of allocating a new array. The @p data is expected to be at
+         * least @ref image2DTranscodedDataSize() bytes large, the layout and
+         * format is the same as with @ref image2D(). Same expectations as
+         * with @ref image2DSize() apply. On failure prints a message to
+         * @relativeref{Magnum,Error} and returns @cpp false @ce.
+         * @see @ref Trade-BasisImporter-transcode-into
+         */
+        bool transcodeImage2DInto(UnsignedInt id, UnsignedInt level, Containers::ArrayView<char> data);
+
+        /**
+         * @brief Transcode multiple images into an existing memory
+         *
+         * Like @ref transcodeImage2DInto(UnsignedInt, UnsignedInt, Containers::ArrayView<char>),
+         * but for a batch of images or levels, distributed across the count
+         * of threads set by the @cb{.ini} threads @ce
+         * @ref Trade-BasisImporter-configuration "configuration option". All
+         * jobs are checked before any transcoding is done, so if a job output
+         * is too small, nothing is written.
+         * @see @ref Trade-BasisImporter-transcode-into
+         */
+        bool transcodeImage2DInto(Containers::ArrayView<const TranscodeJob> jobs);
+
         /** @brief Target format */
         TargetFormat targetFormat() const;
 
@@ -305,7 +414,9 @@ class MAGNUM_BASISIMPORTER_EXPORT BasisImporter: public AbstractImporter {
         MAGNUM_BASISIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
         MAGNUM_BASISIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_BASISIMPORTER_LOCAL void doClose() override;
+        MAGNUM_BASISIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
         MAGNUM_BASISIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        MAGNUM_BASISIMPORTER_LOCAL bool openDataInternal(Containers::ArrayView<const char> data, const char* prefix);
 
         MAGNUM_BASISIMPORTER_LOCAL UnsignedInt doImage2DCount() const override;
         MAGNUM_BASISIMPORTER_LOCAL UnsignedInt doImage2DLevelCount(UnsignedInt id) override;
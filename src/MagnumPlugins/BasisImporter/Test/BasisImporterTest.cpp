@@ -46,6 +46,7 @@ struct BasisImporterTest: TestSuite::Tester {
     explicit BasisImporterTest();
 
     void empty();
+    void fileNotFound();
     void invalid();
     void unconfigured();
     void invalidConfiguredFormat();
@@ -63,6 +64,7 @@ struct BasisImporterTest: TestSuite::Tester {
     void openSameTwice();
     void openDifferent();
     void importMultipleFormats();
+    void borrowData();
 
     /* Needs to load AnyImageImporter from system-wide location */
     PluginManager::Manager<AbstractImporter> _manager;
@@ -103,6 +105,7 @@ constexpr struct {
 
 BasisImporterTest::BasisImporterTest() {
     addTests({&BasisImporterTest::empty,
+              &BasisImporterTest::fileNotFound,
               &BasisImporterTest::invalid,
               &BasisImporterTest::unconfigured,
               &BasisImporterTest::invalidConfiguredFormat,
@@ -120,7 +123,8 @@ BasisImporterTest::BasisImporterTest() {
 
     addTests({&BasisImporterTest::openSameTwice,
               &BasisImporterTest::openDifferent,
-              &BasisImporterTest::importMultipleFormats});
+              &BasisImporterTest::importMultipleFormats,
+              &BasisImporterTest::borrowData});
 
     /* Pull in the AnyImageImporter dependency for image comparison, load
        StbImageImporter from the build tree, if defined. Otherwise it's static
@@ -148,6 +152,15 @@ void BasisImporterTest::empty() {
     CORRADE_COMPARE(out.str(), "Trade::BasisImporter::openData(): the file is empty\n");
 }
 
+void BasisImporterTest::fileNotFound() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("BasisImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openFile("nonexistent.basis"));
+    CORRADE_COMPARE(out.str(), "Trade::BasisImporter::openFile(): cannot open file nonexistent.basis\n");
+}
+
 void BasisImporterTest::invalid() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("BasisImporter");
     std::ostringstream out;
@@ -508,6 +521,26 @@ void BasisImporterTest::importMultipleFormats() {
     }
 }
 
+void BasisImporterTest::borrowData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("BasisImporterEtc2RGBA");
+    importer->configuration().setValue("borrowData", true);
+
+    Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(BASISIMPORTER_TEST_DIR, "rgb.basis"));
+    CORRADE_VERIFY(importer->openData(data));
+
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->compressedFormat(), CompressedPixelFormat::Etc2RGBA8Unorm);
+    CORRADE_COMPARE(image->size(), (Vector2i{63, 27}));
+
+    /* The returned image owns its data, so it's still valid after closing
+       the importer and freeing the memory */
+    importer->close();
+    data = nullptr;
+    CORRADE_COMPARE(image->size(), (Vector2i{63, 27}));
+    CORRADE_VERIFY(!image->data().empty());
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::BasisImporterTest)
@@ -0,0 +1,205 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/Math/Vector2.h>
+#include <Magnum/Trade/ImageData.h>
+
+#include "MagnumPlugins/BasisImporter/BasisImporter.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct BasisImporterTranscodeTest: TestSuite::Tester {
+    explicit BasisImporterTranscodeTest();
+
+    void size();
+    void into();
+    void intoMultiple();
+    void intoTooSmall();
+    void intoInvalidConfiguredFormat();
+};
+
+constexpr struct {
+    const char* name;
+    const char* format;
+    std::size_t dataSize;
+} SizeData[] {
+    /* 63x27 pixels */
+    {"RGBA8", "RGBA8", 63*27*4},
+    /* 16x7 blocks, 8 bytes each */
+    {"BC1", "Bc1RGB", 16*7*8},
+    /* 16x7 blocks, 16 bytes each */
+    {"BC3", "Bc3RGBA", 16*7*16}
+};
+
+constexpr struct {
+    const char* name;
+    const char* format;
+    UnsignedInt threads;
+} IntoData[] {
+    {"RGBA8", "RGBA8", 1},
+    {"RGBA8, 3 threads", "RGBA8", 3},
+    {"BC3, 3 threads", "Bc3RGBA", 3},
+    {"BC3, all threads", "Bc3RGBA", 0},
+    /* More threads than jobs */
+    {"BC3, 100 threads", "Bc3RGBA", 100}
+};
+
+BasisImporterTranscodeTest::BasisImporterTranscodeTest() {
+    addInstancedTests({&BasisImporterTranscodeTest::size},
+        Containers::arraySize(SizeData));
+
+    addTests({&BasisImporterTranscodeTest::into});
+
+    addInstancedTests({&BasisImporterTranscodeTest::intoMultiple},
+        Containers::arraySize(IntoData));
+
+    addTests({&BasisImporterTranscodeTest::intoTooSmall,
+              &BasisImporterTranscodeTest::intoInvalidConfiguredFormat});
+
+    /* Not going through a plugin manager, so the global state has to be
+       initialized explicitly */
+    BasisImporter::initialize();
+}
+
+void BasisImporterTranscodeTest::size() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    BasisImporter importer;
+    importer.configuration().setValue("format", data.format);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(BASISIMPORTER_TEST_DIR, "rgba-2images-mips.basis")));
+
+    CORRADE_COMPARE(importer.image2DSize(0), (Vector2i{63, 27}));
+    CORRADE_COMPARE(importer.image2DSize(0, 2), (Vector2i{15, 6}));
+    CORRADE_COMPARE(importer.image2DSize(1, 1), (Vector2i{13, 31}));
+    CORRADE_COMPARE(importer.image2DTranscodedDataSize(0), data.dataSize);
+
+    /* The size should match what image2D() returns */
+    Containers::Optional<ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), importer.image2DSize(0));
+    CORRADE_COMPARE(image->data().size(), importer.image2DTranscodedDataSize(0));
+}
+
+void BasisImporterTranscodeTest::into() {
+    BasisImporter importer;
+    importer.configuration().setValue("format", "Bc1RGB");
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(BASISIMPORTER_TEST_DIR, "rgb.basis")));
+
+    Containers::Optional<ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+
+    /* Larger than needed, the rest should be left untouched */
+    Containers::Array<char> out{DirectInit, image->data().size() + 4, '\xcd'};
+    CORRADE_VERIFY(importer.transcodeImage2DInto(0, 0, out));
+    CORRADE_COMPARE_AS(out.prefix(image->data().size()),
+        image->data(),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.suffix(image->data().size()),
+        Containers::arrayView<char>({'\xcd', '\xcd', '\xcd', '\xcd'}),
+        TestSuite::Compare::Container);
+}
+
+void BasisImporterTranscodeTest::intoMultiple() {
+    auto&& data = IntoData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    BasisImporter importer;
+    importer.configuration().setValue("format", data.format);
+    importer.configuration().setValue("threads", data.threads);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(BASISIMPORTER_TEST_DIR, "rgba-2images-mips.basis")));
+
+    /* All levels of both images into a single buffer */
+    BasisImporter::TranscodeJob jobs[6];
+    std::size_t offsets[7]{};
+    for(UnsignedInt i = 0; i != 6; ++i)
+        offsets[i + 1] = offsets[i] + importer.image2DTranscodedDataSize(i/3, i%3);
+    Containers::Array<char> out{NoInit, offsets[6]};
+    for(UnsignedInt i = 0; i != 6; ++i)
+        jobs[i] = {i/3, i%3, out.slice(offsets[i], offsets[i + 1])};
+    CORRADE_VERIFY(importer.transcodeImage2DInto(jobs));
+
+    /* Should be the same as importing the levels one by one */
+    for(UnsignedInt i = 0; i != 6; ++i) {
+        CORRADE_ITERATION(i);
+        Containers::Optional<ImageData2D> image = importer.image2D(i/3, i%3);
+        CORRADE_VERIFY(image);
+        CORRADE_COMPARE_AS(jobs[i].data,
+            image->data(),
+            TestSuite::Compare::Container);
+    }
+}
+
+void BasisImporterTranscodeTest::intoTooSmall() {
+    BasisImporter importer;
+    importer.configuration().setValue("format", "RGBA8");
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(BASISIMPORTER_TEST_DIR, "rgba-2images-mips.basis")));
+
+    Containers::Array<char> out0{DirectInit, 15*6*4, '\xcd'};
+    Containers::Array<char> out1{DirectInit, 6*15*4 - 1, '\xcd'};
+    const BasisImporter::TranscodeJob jobs[]{
+        {0, 2, out0},
+        {1, 2, out1}
+    };
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.transcodeImage2DInto(jobs));
+    CORRADE_COMPARE(out.str(), "Trade::BasisImporter::transcodeImage2DInto(): expected at least 360 bytes for image 1 level 2 but got 359\n");
+
+    /* Nothing should be written, not even the job that was large enough */
+    for(char c: out0) CORRADE_COMPARE(c, '\xcd');
+}
+
+void BasisImporterTranscodeTest::intoInvalidConfiguredFormat() {
+    BasisImporter importer;
+    importer.configuration().setValue("format", "Banana");
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(BASISIMPORTER_TEST_DIR, "rgb.basis")));
+
+    Containers::Array<char> data{ValueInit, 63*27*4};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.transcodeImage2DInto(0, 0, data));
+    CORRADE_COMPARE(importer.image2DTranscodedDataSize(0), 0);
+    CORRADE_COMPARE(out.str(),
+        "Trade::BasisImporter::transcodeImage2DInto(): invalid transcoding target format Banana, expected to be one of EacR, EacRG, Etc1RGB, Etc2RGBA, Bc1RGB, Bc3RGBA, Bc4R, Bc5RG, Bc7RGB, Bc7RGBA, Pvrtc1RGB4bpp, Pvrtc1RGBA4bpp, Astc4x4RGBA, RGBA8\n"
+        "Trade::BasisImporter::image2DTranscodedDataSize(): invalid transcoding target format Banana, expected to be one of EacR, EacRG, Etc1RGB, Etc2RGBA, Bc1RGB, Bc3RGBA, Bc4R, Bc5RG, Bc7RGB, Bc7RGBA, Pvrtc1RGB4bpp, Pvrtc1RGBA4bpp, Astc4x4RGBA, RGBA8\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::BasisImporterTranscodeTest)
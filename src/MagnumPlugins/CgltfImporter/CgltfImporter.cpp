@@ -27,6 +27,10 @@
 #include "CgltfImporter.h"
 
 #include <algorithm> /* std::stable_sort() */
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include <thread>
 #include <unordered_map>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayView.h>
@@ -45,6 +49,7 @@
 #include <Magnum/Mesh.h>
 #include <Magnum/PixelFormat.h>
 #include <Magnum/Math/CubicHermite.h>
+#include <Magnum/Math/Functions.h>
 #include <Magnum/Math/Matrix3.h>
 #include <Magnum/Math/Matrix4.h>
 #include <Magnum/Math/Quaternion.h>
@@ -60,6 +65,7 @@
 #include <Magnum/Trade/TextureData.h>
 
 #include "MagnumPlugins/AnyImageImporter/AnyImageImporter.h"
+#include "MagnumPlugins/CgltfImporter/defaultConfiguration.h"
 
 /* Cgltf doesn't load .glb on big-endian correctly:
    https://github.com/jkuhlmann/cgltf/issues/150
@@ -146,7 +152,51 @@ std::size_t elementSize(const cgltf_accessor* accessor) {
     return cgltf_calc_size(accessor->type, accessor->component_type);
 }
 
-bool checkAccessor(const cgltf_data* data, const char* const function, const cgltf_accessor* accessor) {
+bool checkBufferViewRange(const cgltf_data* data, const char* const function, const cgltf_buffer_view* bufferView) {
+    const std::size_t requiredBufferSize = bufferView->offset + bufferView->size;
+    if(bufferView->buffer->size < requiredBufferSize) {
+        const UnsignedInt bufferViewId = bufferView - data->buffer_views;
+        const UnsignedInt bufferId = bufferView->buffer - data->buffers;
+        Error{} << "Trade::CgltfImporter::" << Debug::nospace << function << Debug::nospace << "(): buffer view" << bufferViewId << "needs" << requiredBufferSize << "bytes but buffer" << bufferId << "has only" << bufferView->buffer->size;
+        return false;
+    }
+
+    return true;
+}
+
+bool checkSparseAccessor(const cgltf_data* data, const char* const function, const cgltf_accessor* accessor) {
+    const UnsignedInt accessorId = accessor - data->accessors;
+    const cgltf_accessor_sparse& sparse = accessor->sparse;
+
+    if(sparse.indices_component_type != cgltf_component_type_r_8u &&
+       sparse.indices_component_type != cgltf_component_type_r_16u &&
+       sparse.indices_component_type != cgltf_component_type_r_32u) {
+        Error{} << "Trade::CgltfImporter::" << Debug::nospace << function << Debug::nospace << "(): accessor" << accessorId << "has an unexpected sparse index component type" << gltfComponentTypeName(sparse.indices_component_type);
+        return false;
+    }
+
+    /* Both indices and values are tightly packed, the buffer view stride is
+       ignored */
+    const std::size_t requiredIndicesSize = sparse.indices_byte_offset + sparse.count*cgltf_component_size(sparse.indices_component_type);
+    if(sparse.indices_buffer_view->size < requiredIndicesSize) {
+        Error{} << "Trade::CgltfImporter::" << Debug::nospace << function << Debug::nospace << "(): accessor" << accessorId << "sparse indices need" << requiredIndicesSize << "bytes but buffer view" << UnsignedInt(sparse.indices_buffer_view - data->buffer_views) << "has only" << sparse.indices_buffer_view->size;
+        return false;
+    }
+
+    const std::size_t requiredValuesSize = sparse.values_byte_offset + sparse.count*elementSize(accessor);
+    if(sparse.values_buffer_view->size < requiredValuesSize) {
+        Error{} << "Trade::CgltfImporter::" << Debug::nospace << function << Debug::nospace << "(): accessor" << accessorId << "sparse values need" << requiredValuesSize << "bytes but buffer view" << UnsignedInt(sparse.values_buffer_view - data->buffer_views) << "has only" << sparse.values_buffer_view->size;
+        return false;
+    }
+
+    return checkBufferViewRange(data, function, sparse.indices_buffer_view) &&
+           checkBufferViewRange(data, function, sparse.values_buffer_view);
+}
+
+/* Sparse accessors are accepted only if allowSparse is set. The caller is
+   then responsible for applying the sparse values, and for filling the data
+   with zeros if there's no buffer view. */
+bool checkAccessor(const cgltf_data* data, const char* const function, const cgltf_accessor* accessor, const bool allowSparse = false) {
     CORRADE_INTERNAL_ASSERT(accessor);
     const UnsignedInt accessorId = accessor - data->accessors;
 
@@ -154,12 +204,20 @@ bool checkAccessor(const cgltf_data* data, const char* const function, const cgl
         https://www.khronos.org/registry/glTF/specs/2.0/glTF-2.0.html#data-alignment */
 
     if(accessor->is_sparse) {
-        Error{} << "Trade::CgltfImporter::" << Debug::nospace << function << Debug::nospace << "(): accessor" << accessorId << "is using sparse storage, which is unsupported";
-        return false;
+        if(!allowSparse) {
+            Error{} << "Trade::CgltfImporter::" << Debug::nospace << function << Debug::nospace << "(): accessor" << accessorId << "is using sparse storage, which is unsupported";
+            return false;
+        }
+
+        if(!checkSparseAccessor(data, function, accessor))
+            return false;
+
+        /* Buffer views are optional in accessors, we're supposed to fill the
+           view with zeros. Only makes sense with sparse data. */
+        if(!accessor->buffer_view)
+            return true;
     }
-    /* Buffer views are optional in accessors, we're supposed to fill the view
-       with zeros. Only makes sense with sparse data and we don't support
-       that. */
+
     if(!accessor->buffer_view) {
         Error{} << "Trade::CgltfImporter::" << Debug::nospace << function << Debug::nospace << "(): accessor" << accessorId << "has no buffer view";
         return false;
@@ -167,7 +225,6 @@ bool checkAccessor(const cgltf_data* data, const char* const function, const cgl
 
     const cgltf_buffer_view* bufferView = accessor->buffer_view;
     const UnsignedInt bufferViewId = bufferView - data->buffer_views;
-    const cgltf_buffer* buffer = bufferView->buffer;
 
     const std::size_t typeSize = elementSize(accessor);
     const std::size_t requiredBufferViewSize = accessor->offset + accessor->stride*(accessor->count - 1) + typeSize;
@@ -176,12 +233,8 @@ bool checkAccessor(const cgltf_data* data, const char* const function, const cgl
         return false;
     }
 
-    const std::size_t requiredBufferSize = bufferView->offset + bufferView->size;
-    if(buffer->size < requiredBufferSize) {
-        const UnsignedInt bufferId = buffer - data->buffers;
-        Error{} << "Trade::CgltfImporter::" << Debug::nospace << function << Debug::nospace << "(): buffer view" << bufferViewId << "needs" << requiredBufferSize << "bytes but buffer" << bufferId << "has only" << buffer->size;
+    if(!checkBufferViewRange(data, function, bufferView))
         return false;
-    }
 
     /* Cgltf copies the bufferview stride into the accessor. If that's zero, it
        copies the element size into the stride. */
@@ -198,6 +251,75 @@ bool isDataUri(Containers::StringView uri) {
     return uri.hasPrefix("data:"_s);
 }
 
+/* Size of decoded base64 data. Same as cgltf_load_buffer_base64(), any
+   trailing characters not forming a complete byte are ignored. Excessive
+   padding is clamped so the = characters end up being decoded and fail the
+   validity check in decodeBase64(). */
+std::size_t base64DecodedSize(Containers::StringView base64) {
+    const std::size_t size = base64.size()/4*3;
+    const std::size_t padding = Math::min(base64.size() - base64.trimmedSuffix("="_s).size(), std::size_t{2});
+    return size < padding ? 0 : size - padding;
+}
+
+/* Base64 character values, 0xff for invalid characters including the =
+   padding */
+constexpr UnsignedByte Base64Values[256]{
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3e, 0xff, 0xff, 0xff, 0x3f,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+    0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+
+/* Decodes base64 data into a pre-sized output, which is expected to be
+   base64DecodedSize() large. Four input characters are combined into three
+   output bytes at a time, with validity of the whole input checked only at
+   the end to keep the loop branchless. Returns false if the input contains
+   an invalid character. */
+bool decodeBase64(Containers::StringView base64, Containers::ArrayView<char> out) {
+    const UnsignedByte* in = reinterpret_cast<const UnsignedByte*>(base64.data());
+    char* o = out.data();
+    UnsignedInt invalid = 0;
+
+    const std::size_t groupCount = out.size()/3;
+    for(std::size_t i = 0; i != groupCount; ++i, in += 4, o += 3) {
+        const UnsignedInt a = Base64Values[in[0]];
+        const UnsignedInt b = Base64Values[in[1]];
+        const UnsignedInt c = Base64Values[in[2]];
+        const UnsignedInt d = Base64Values[in[3]];
+        invalid |= a|b|c|d;
+        const UnsignedInt value = a << 18|b << 12|c << 6|d;
+        o[0] = char(value >> 16);
+        o[1] = char(value >> 8);
+        o[2] = char(value);
+    }
+
+    /* Remaining one or two bytes, encoded in two or three characters */
+    const std::size_t remaining = out.size() - groupCount*3;
+    if(remaining) {
+        const UnsignedInt a = Base64Values[in[0]];
+        const UnsignedInt b = Base64Values[in[1]];
+        const UnsignedInt c = remaining == 2 ? Base64Values[in[2]] : 0;
+        invalid |= a|b|c;
+        const UnsignedInt value = a << 18|b << 12|c << 6;
+        o[0] = char(value >> 16);
+        if(remaining == 2) o[1] = char(value >> 8);
+    }
+
+    return !(invalid & 0x80);
+}
+
 /* Decode percent-encoded characters in URIs:
    https://datatracker.ietf.org/doc/html/rfc3986#section-2.1 */
 std::string decodeUri(Containers::StringView uri) {
@@ -249,7 +371,9 @@ struct CgltfImporter::Document {
 
     Containers::Optional<Containers::ArrayView<const char>> loadUri(Containers::StringView uri, Containers::Array<char>& storage, const char* const function);
     bool loadBuffer(UnsignedInt id, const char* const function);
+    void prefetchBuffers(UnsignedInt threadCount);
     Containers::Optional<Containers::StridedArrayView2D<const char>> accessorView(const cgltf_accessor* accessor, const char* const function);
+    bool applySparseAccessor(const cgltf_accessor* accessor, const Containers::StridedArrayView2D<char>& dst, const char* const function);
 
     /* Storage for buffer content if the user set no file callback or a buffer
        is embedded as base64. These are filled on demand. We don't check for
@@ -355,23 +479,12 @@ Containers::Optional<Containers::ArrayView<const char>> CgltfImporter::Document:
             return Containers::NullOpt;
         }
 
-        /* Decoded size. For some reason cgltf_load_buffer_base64 doesn't take
-           the string length as input, and fails if it finds a padding
-           character. */
-        const std::size_t padding = base64.size() - base64.trimmedSuffix("="_s).size();
-        const std::size_t size = base64.size()/4*3 - padding;
-
-        /* cgltf_load_buffer_base64 will allocate using the memory callbacks
-           set in doOpenData() which use new char[] and delete[]. We can wrap
-           that memory in an Array with the default deleter. */
-        void* decoded = nullptr;
-        const cgltf_result result = cgltf_load_buffer_base64(&options, size, base64.data(), &decoded);
-        if(result != cgltf_result_success) {
+        Containers::Array<char> decoded{NoInit, base64DecodedSize(base64)};
+        if(!decodeBase64(base64, decoded)) {
             Error{} << "Trade::CgltfImporter::" << Debug::nospace << function << Debug::nospace << "(): invalid base64 string in data URI";
             return Containers::NullOpt;
         }
-        CORRADE_INTERNAL_ASSERT(decoded);
-        storage = Containers::Array<char>{static_cast<char*>(decoded), size};
+        storage = std::move(decoded);
         return Containers::arrayCast<const char>(storage);
     } else if(importer.fileCallback()) {
         const std::string fullPath = Utility::Directory::join(filePath ? *filePath : "", decodeUri(decodeString(uri)));
@@ -435,6 +548,92 @@ bool CgltfImporter::Document::loadBuffer(UnsignedInt id, const char* const funct
     return true;
 }
 
+void CgltfImporter::Document::prefetchBuffers(const UnsignedInt threadCount) {
+    /* Gather buffers that need to be read from the filesystem or decoded from
+       base64. All validation is done later in loadBuffer() on first use,
+       failed jobs are just skipped here. Buffers referencing the GLB binary
+       chunk are already in memory, and user file callbacks are not assumed to
+       be thread-safe, so these are left to loadBuffer() as well. */
+    struct Job {
+        UnsignedInt id;
+        Containers::StringView base64;
+        std::string path;
+        Containers::Array<char> data;
+        /* Output of a failed Directory::read() */
+        std::string error;
+        bool loaded = false;
+    };
+    const AbstractImporter& importer = *static_cast<AbstractImporter*>(options.file.user_data);
+    Containers::Array<Job> jobs;
+    for(UnsignedInt i = 0; i != data->buffers_count; ++i) {
+        const cgltf_buffer& buffer = data->buffers[i];
+        if(buffer.data || !buffer.uri) continue;
+
+        const Containers::StringView uri = buffer.uri;
+        if(isDataUri(uri)) {
+            const Containers::Array3<Containers::StringView> parts = uri.partition(',');
+            if(!parts.front().hasSuffix(";base64"_s) || parts.back().isEmpty())
+                continue;
+            Job job;
+            job.id = i;
+            job.base64 = parts.back();
+            arrayAppend(jobs, std::move(job));
+        } else if(!importer.fileCallback() && filePath) {
+            Job job;
+            job.id = i;
+            job.path = Utility::Directory::join(*filePath, decodeUri(decodeString(uri)));
+            arrayAppend(jobs, std::move(job));
+        }
+    }
+
+    if(jobs.empty()) return;
+
+    /* Each thread picks the next job until there are none left. Just file
+       reading and decoding happens here. Errors from Directory::read() are
+       captured and printed on the calling thread after, as the output
+       redirection is thread-local and the messages would otherwise go
+       unredirected and interleaved. */
+    std::atomic<std::size_t> next{0};
+    auto work = [&jobs, &next]() {
+        for(std::size_t i; (i = next++) < jobs.size(); ) {
+            Job& job = jobs[i];
+            if(!job.base64.isEmpty()) {
+                job.data = Containers::Array<char>{NoInit, base64DecodedSize(job.base64)};
+                job.loaded = decodeBase64(job.base64, job.data);
+            } else if(Utility::Directory::exists(job.path)) {
+                std::ostringstream out;
+                {
+                    Error redirectError{&out};
+                    job.data = Utility::Directory::read(job.path);
+                }
+                job.error = out.str();
+                job.loaded = true;
+            }
+        }
+    };
+
+    /* Run also on the calling thread */
+    Containers::Array<std::thread> threads{std::size_t(Math::min(threadCount, UnsignedInt(jobs.size())) - 1)};
+    for(std::thread& thread: threads) thread = std::thread{work};
+    work();
+    for(std::thread& thread: threads) thread.join();
+
+    /* Make the buffers available to loadBuffer(). Too short buffers are
+       skipped and their error reported on first use. */
+    for(Job& job: jobs) {
+        if(!job.error.empty())
+            Error{Error::Flag::NoNewlineAtTheEnd} << Containers::StringView{job.error};
+
+        cgltf_buffer& buffer = data->buffers[job.id];
+        if(!job.loaded || job.data.size() < buffer.size) continue;
+
+        bufferData[job.id] = std::move(job.data);
+        buffer.data = bufferData[job.id].data();
+        /* Tell cgltf not to free buffer.data in cgltf_free */
+        buffer.data_free_method = cgltf_data_free_method_none;
+    }
+}
+
 Containers::Optional<Containers::StridedArrayView2D<const char>> CgltfImporter::Document::accessorView(const cgltf_accessor* accessor, const char* const function) {
     /* All this assumes the accessor was checked using checkAccessor() */
     const cgltf_buffer_view* bufferView = accessor->buffer_view;
@@ -449,6 +648,68 @@ Containers::Optional<Containers::StridedArrayView2D<const char>> CgltfImporter::
         {std::ptrdiff_t(accessor->stride), 1}};
 }
 
+namespace {
+
+/* Returns the position of the first out-of-range index, or the index count if
+   all were in range */
+template<class T> std::size_t scatterSparseValues(const Containers::ArrayView<const T> indices, const Containers::StridedArrayView2D<const char>& values, const Containers::StridedArrayView2D<char>& dst) {
+    const std::size_t size = values.size()[1];
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        if(indices[i] >= dst.size()[0]) return i;
+        std::memcpy(dst[indices[i]].data(), values[i].data(), size);
+    }
+
+    return indices.size();
+}
+
+}
+
+bool CgltfImporter::Document::applySparseAccessor(const cgltf_accessor* accessor, const Containers::StridedArrayView2D<char>& dst, const char* const function) {
+    /* All this assumes the accessor was checked using checkAccessor() with
+       sparse accessors allowed */
+    const cgltf_accessor_sparse& sparse = accessor->sparse;
+    const cgltf_buffer_view* indicesView = sparse.indices_buffer_view;
+    const cgltf_buffer_view* valuesView = sparse.values_buffer_view;
+    if(!loadBuffer(indicesView->buffer - data->buffers, function) ||
+       !loadBuffer(valuesView->buffer - data->buffers, function))
+        return false;
+
+    /* Values are tightly packed */
+    const std::size_t typeSize = elementSize(accessor);
+    CORRADE_INTERNAL_ASSERT(dst.size()[1] == typeSize);
+    const Containers::StridedArrayView2D<const char> values{
+        Containers::arrayView(valuesView->buffer->data, valuesView->buffer->size),
+        reinterpret_cast<const char*>(valuesView->buffer->data) + valuesView->offset + sparse.values_byte_offset,
+        {sparse.count, typeSize},
+        {std::ptrdiff_t(typeSize), 1}};
+
+    /* Values are written directly at their destination, dispatching on the
+       index type just once */
+    const char* const indices = reinterpret_cast<const char*>(indicesView->buffer->data) + indicesView->offset + sparse.indices_byte_offset;
+    std::size_t invalid;
+    UnsignedInt invalidIndex{};
+    if(sparse.indices_component_type == cgltf_component_type_r_8u) {
+        const auto typed = Containers::arrayView(reinterpret_cast<const UnsignedByte*>(indices), sparse.count);
+        invalid = scatterSparseValues(typed, values, dst);
+        if(invalid != sparse.count) invalidIndex = typed[invalid];
+    } else if(sparse.indices_component_type == cgltf_component_type_r_16u) {
+        const auto typed = Containers::arrayView(reinterpret_cast<const UnsignedShort*>(indices), sparse.count);
+        invalid = scatterSparseValues(typed, values, dst);
+        if(invalid != sparse.count) invalidIndex = typed[invalid];
+    } else if(sparse.indices_component_type == cgltf_component_type_r_32u) {
+        const auto typed = Containers::arrayView(reinterpret_cast<const UnsignedInt*>(indices), sparse.count);
+        invalid = scatterSparseValues(typed, values, dst);
+        if(invalid != sparse.count) invalidIndex = typed[invalid];
+    } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    if(invalid != sparse.count) {
+        Error{} << "Trade::CgltfImporter::" << Debug::nospace << function << Debug::nospace << "(): sparse index" << invalidIndex << "out of bounds for" << accessor->count << "elements in accessor" << UnsignedInt(accessor - data->accessors);
+        return false;
+    }
+
+    return true;
+}
+
 Containers::StringView CgltfImporter::Document::decodeString(Containers::StringView str) {
     if(str.isEmpty())
         return str;
@@ -477,30 +738,16 @@ Containers::StringView CgltfImporter::Document::decodeString(Containers::StringV
     return decodedStrings.emplace(str.data(), Containers::String{decoded.prefix(decodedSize)}).first->second;
 }
 
-namespace {
-
-void fillDefaultConfiguration(Utility::ConfigurationGroup& conf) {
-    /** @todo horrible workaround, fix this properly */
-    conf.setValue("ignoreRequiredExtensions", false);
-    conf.setValue("optimizeQuaternionShortestPath", true);
-    conf.setValue("normalizeQuaternions", true);
-    conf.setValue("mergeAnimationClips", false);
-    conf.setValue("phongMaterialFallback", true);
-    conf.setValue("objectIdAttribute", "_OBJECT_ID");
-}
-
-}
-
 CgltfImporter::CgltfImporter() {
     /** @todo horrible workaround, fix this properly */
-    fillDefaultConfiguration(configuration());
+    Implementation::cgltfImporterDefaultConfiguration(configuration());
 }
 
 CgltfImporter::CgltfImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
 CgltfImporter::CgltfImporter(PluginManager::Manager<AbstractImporter>& manager): AbstractImporter{manager} {
     /** @todo horrible workaround, fix this properly */
-    fillDefaultConfiguration(configuration());
+    Implementation::cgltfImporterDefaultConfiguration(configuration());
 }
 
 CgltfImporter::~CgltfImporter() = default;
@@ -777,6 +1024,13 @@ void CgltfImporter::doOpenData(const Containers::ArrayView<const char> data) {
     /* Buffers are loaded on demand, but we need to prepare the storage array */
     _d->bufferData = Containers::Array<Containers::Array<char>>{_d->data->buffers_count};
 
+    /* Or load them all upfront, if desired */
+    if(configuration().value<bool>("prefetchBuffers")) {
+        UnsignedInt threadCount = configuration().value<UnsignedInt>("threads");
+        if(!threadCount) threadCount = Math::max(std::thread::hardware_concurrency(), 1u);
+        _d->prefetchBuffers(threadCount);
+    }
+
     /* Name maps are lazy-loaded because these might not be needed every time */
 }
 
@@ -1585,13 +1839,16 @@ Containers::Optional<MeshData> CgltfImporter::doMesh(const UnsignedInt id, Unsig
     }
 
     /* Gather all (whitelisted) attributes and the total buffer range spanning
-       them */
+       them. If they're sparse or come from more than one buffer, they're
+       gathered into a new interleaved buffer instead. */
     cgltf_buffer* buffer = nullptr;
     UnsignedInt vertexCount = 0;
     std::size_t attributeId = 0;
     cgltf_attribute lastAttribute{};
     Math::Range1D<std::size_t> bufferRange;
+    bool gather = false;
     Containers::Array<MeshAttributeData> attributeData{attributeCount};
+    Containers::Array<const cgltf_accessor*> attributeAccessors{attributeCount};
     for(UnsignedInt a: attributeOrder) {
         /* Duplicate attribute, skip */
         if(a == ~0u)
@@ -1617,7 +1874,7 @@ Containers::Optional<MeshData> CgltfImporter::doMesh(const UnsignedInt id, Unsig
         lastAttribute = attribute;
 
         const cgltf_accessor* accessor = attribute.data;
-        if(!checkAccessor(_d->data, "mesh", accessor))
+        if(!checkAccessor(_d->data, "mesh", accessor, true))
             return Containers::NullOpt;
 
         /* Convert to our vertex format */
@@ -1842,68 +2099,133 @@ Containers::Optional<MeshData> CgltfImporter::doMesh(const UnsignedInt id, Unsig
             name = _d->meshAttributesForName.at(nameString);
         }
 
-        /* Remember which buffer the attribute is in and the range, for
-           consecutive attribs expand the range */
-        const cgltf_buffer_view* bufferView = accessor->buffer_view;
         if(attributeId == 0) {
-            buffer = bufferView->buffer;
-            bufferRange = Math::Range1D<std::size_t>::fromSize(bufferView->offset, bufferView->size);
             vertexCount = accessor->count;
-        } else {
-            /* ... and probably never will be */
-            if(bufferView->buffer != buffer) {
-                Error{} << "Trade::CgltfImporter::mesh(): meshes spanning multiple buffers are not supported";
-                return Containers::NullOpt;
-            }
-
-            bufferRange = Math::join(bufferRange, Math::Range1D<std::size_t>::fromSize(bufferView->offset, bufferView->size));
-
-            if(accessor->count != vertexCount) {
-                Error{} << "Trade::CgltfImporter::mesh(): mismatched vertex count for attribute" << semantic << Debug::nospace << ", expected" << vertexCount << "but got" << accessor->count;
-                return Containers::NullOpt;
-            }
+        } else if(accessor->count != vertexCount) {
+            Error{} << "Trade::CgltfImporter::mesh(): mismatched vertex count for attribute" << semantic << Debug::nospace << ", expected" << vertexCount << "but got" << accessor->count;
+            return Containers::NullOpt;
         }
 
+        /* Remember which buffer the attribute is in and the range, for
+           consecutive attribs expand the range. Sparse attributes need their
+           values applied and thus can't be copied as a whole. */
+        const cgltf_buffer_view* bufferView = accessor->buffer_view;
+        if(accessor->is_sparse || bufferView->buffer != buffer) {
+            if(!buffer && !accessor->is_sparse) {
+                buffer = bufferView->buffer;
+                bufferRange = Math::Range1D<std::size_t>::fromSize(bufferView->offset, bufferView->size);
+            } else gather = true;
+        } else bufferRange = Math::join(bufferRange, Math::Range1D<std::size_t>::fromSize(bufferView->offset, bufferView->size));
+
         /** @todo Check that accessor stride >= vertexFormatSize(format)? */
 
         /* Fill in an attribute. Offset-only, will be patched to be relative to
            the actual output buffer once we know how large it is and where it
-           is allocated. */
+           is allocated. Sparse accessors don't need to have a buffer view. */
+        attributeAccessors[attributeId] = accessor;
         attributeData[attributeId++] = MeshAttributeData{name, format,
-            UnsignedInt(accessor->offset + bufferView->offset), vertexCount,
-            std::ptrdiff_t(accessor->stride)};
+            bufferView ? UnsignedInt(accessor->offset + bufferView->offset) : 0,
+            vertexCount, std::ptrdiff_t(accessor->stride)};
     }
 
     /* Verify we really filled all attributes */
     CORRADE_INTERNAL_ASSERT(attributeId == attributeData.size());
 
-    /* Allocate & copy vertex data (if any) */
-    Containers::Array<char> vertexData{NoInit, bufferRange.size()};
-    if(vertexData.size()) {
-        const UnsignedInt bufferId = buffer - _d->data->buffers;
-        if(!_d->loadBuffer(bufferId, "mesh"))
-            return {};
-
-        Utility::copy(Containers::arrayView(static_cast<char*>(buffer->data), buffer->size)
-            .slice(bufferRange.min(), bufferRange.max()),
-        vertexData);
+    /* If the data don't need any patching, the mesh can reference the buffer
+       data directly instead of copying them. Texture coordinates get
+       Y-flipped unless it's done in the material. */
+    bool zeroCopy = !gather && configuration().value<bool>("zeroCopyMeshes");
+    if(zeroCopy && !_d->textureCoordinateYFlipInMaterial) {
+        for(const MeshAttributeData& attribute: attributeData) {
+            if(attribute.name() == MeshAttribute::TextureCoordinates) {
+                zeroCopy = false;
+                break;
+            }
+        }
     }
 
-    /* Convert the attributes from relative to absolute, copy them to a
-       non-growable array and do additional patching */
-    for(std::size_t i = 0; i != attributeData.size(); ++i) {
-        Containers::StridedArrayView1D<char> data{vertexData,
+    Containers::ArrayView<const char> bufferData;
+    Containers::Array<char> vertexData;
+
+    /* Gather the attributes into a new interleaved buffer, each copied
+       directly from its source buffer and sparse values applied in place.
+       Attributes are aligned to four bytes, as glTF requires. */
+    if(gather) {
+        std::size_t stride = 0;
+        Containers::Array<std::size_t> offsets{NoInit, attributeData.size()};
+        for(std::size_t i = 0; i != attributeData.size(); ++i) {
+            offsets[i] = stride;
+            stride += (elementSize(attributeAccessors[i]) + 3) & ~std::size_t{3};
+        }
+
+        /* Zero-initialized, as that's what sparse accessors without a buffer
+           view are based on */
+        vertexData = Containers::Array<char>{ValueInit, stride*vertexCount};
+        for(std::size_t i = 0; i != attributeData.size(); ++i) {
+            const cgltf_accessor* accessor = attributeAccessors[i];
+            const Containers::StridedArrayView2D<char> dst{vertexData,
+                vertexData + offsets[i],
+                {vertexCount, elementSize(accessor)},
+                {std::ptrdiff_t(stride), 1}};
+
+            if(accessor->buffer_view) {
+                Containers::Optional<Containers::StridedArrayView2D<const char>> src = _d->accessorView(accessor, "mesh");
+                if(!src)
+                    return Containers::NullOpt;
+                Utility::copy(*src, dst);
+            }
+
+            if(accessor->is_sparse && !_d->applySparseAccessor(accessor, dst, "mesh"))
+                return Containers::NullOpt;
+
+            attributeData[i] = MeshAttributeData{attributeData[i].name(),
+                attributeData[i].format(),
+                Containers::StridedArrayView1D<const char>{vertexData,
+                    vertexData + offsets[i], vertexCount, std::ptrdiff_t(stride)}};
+        }
+
+    /* Otherwise all attributes are in a single buffer range */
+    } else {
+        /* Load the buffer (if there are any vertex data) */
+        if(bufferRange.size()) {
+            const UnsignedInt bufferId = buffer - _d->data->buffers;
+            if(!_d->loadBuffer(bufferId, "mesh"))
+                return {};
+
+            bufferData = Containers::arrayView(static_cast<const char*>(buffer->data), buffer->size)
+                .slice(bufferRange.min(), bufferRange.max());
+        }
+
+        /* Allocate & copy vertex data, unless referencing the buffer
+           directly */
+        if(!zeroCopy) {
+            vertexData = Containers::Array<char>{NoInit, bufferRange.size()};
+            Utility::copy(bufferData, vertexData);
+        }
+
+        /* Convert the attributes from relative to absolute */
+        for(std::size_t i = 0; i != attributeData.size(); ++i) {
             /* Offset is what with the range min subtracted, as we copied
                without the prefix */
-            vertexData + attributeData[i].offset(vertexData) - bufferRange.min(),
-            vertexCount, attributeData[i].stride()};
-
-        attributeData[i] = MeshAttributeData{attributeData[i].name(),
-            attributeData[i].format(), data};
+            const Containers::ArrayView<const char> data = zeroCopy ?
+                bufferData : Containers::ArrayView<const char>{vertexData};
+            attributeData[i] = MeshAttributeData{attributeData[i].name(),
+                attributeData[i].format(),
+                Containers::StridedArrayView1D<const char>{data,
+                    data + attributeData[i].offset(data) - bufferRange.min(),
+                    vertexCount, attributeData[i].stride()}};
+        }
+    }
 
+    /* Do additional patching. When referencing the buffer directly, there's
+       nothing to patch. */
+    if(!zeroCopy) for(std::size_t i = 0; i != attributeData.size(); ++i) {
         /* Flip Y axis of texture coordinates, unless it's done in the material
            instead */
         if(attributeData[i].name() == MeshAttribute::TextureCoordinates && !_d->textureCoordinateYFlipInMaterial) {
+            const Containers::StridedArrayView1D<char> data{vertexData,
+                vertexData + attributeData[i].offset(vertexData),
+                vertexCount, attributeData[i].stride()};
            if(attributeData[i].format() == VertexFormat::Vector2)
                 for(auto& c: Containers::arrayCast<Vector2>(data))
                     c.y() = 1.0f - c.y();
@@ -1932,6 +2254,7 @@ Containers::Optional<MeshData> CgltfImporter::doMesh(const UnsignedInt id, Unsig
     /* Indices */
     MeshIndexData indices;
     Containers::Array<char> indexData;
+    Containers::ArrayView<const char> indexView;
     if(primitive.indices) {
         const cgltf_accessor* accessor = primitive.indices;
         if(!checkAccessor(_d->data, "mesh", accessor))
@@ -1969,9 +2292,14 @@ Containers::Optional<MeshData> CgltfImporter::doMesh(const UnsignedInt id, Unsig
         }
 
         Containers::ArrayView<const char> srcContiguous = src->asContiguous();
-        indexData = Containers::Array<char>{srcContiguous.size()};
-        Utility::copy(srcContiguous, indexData);
-        indices = MeshIndexData{type, indexData};
+        if(zeroCopy) {
+            indexView = srcContiguous;
+            indices = MeshIndexData{type, indexView};
+        } else {
+            indexData = Containers::Array<char>{srcContiguous.size()};
+            Utility::copy(srcContiguous, indexData);
+            indices = MeshIndexData{type, indexData};
+        }
     }
 
     /* If we have an index-less attribute-less mesh, glTF has no way to supply
@@ -1979,6 +2307,14 @@ Containers::Optional<MeshData> CgltfImporter::doMesh(const UnsignedInt id, Unsig
     if(!indices.data().size() && !attributeData.size())
         return MeshData{meshPrimitive, 0};
 
+    /* Non-owned views on the buffer data, valid for as long as the file is
+       opened */
+    if(zeroCopy)
+        return MeshData{meshPrimitive,
+            {}, indexView, indices,
+            {}, bufferData, std::move(attributeData),
+            vertexCount};
+
     return MeshData{meshPrimitive,
         std::move(indexData), indices,
         std::move(vertexData), std::move(attributeData),
@@ -269,6 +269,11 @@ Import of morph data is not supported at the moment.
 -   Attribute-less meshes either with or without an index buffer are supported,
     however since glTF has no way of specifying vertex count for those,
     returned @ref Trade::MeshData::vertexCount() is set to @cpp 0 @ce
+-   Vertex attributes using
+    [sparse accessors](https://www.khronos.org/registry/glTF/specs/2.0/glTF-2.0.html#sparse-accessors)
+    are supported, including sparse accessors without a buffer view, which
+    are zero-initialized. Sparse index buffers and sparse accessors in skins
+    and animations are not supported.
 
 Custom and unrecognized vertex attributes of allowed types are present in the
 imported meshes as well. Their mapping to/from a string can be queried using
@@ -276,6 +281,23 @@ imported meshes as well. Their mapping to/from a string can be queried using
 unsupported types (such as non-normalized integer matrices) cause the import to
 fail.
 
+By default, vertex and index data of each mesh are copied out of the buffer.
+Enabling the @cb{.ini} zeroCopyMeshes @ce
+@ref Trade-CgltfImporter-configuration "configuration option" makes the
+returned @ref MeshData reference the buffer data directly instead, with both
+@ref MeshData::indexDataFlags() and @ref MeshData::vertexDataFlags() being
+empty. Such meshes are valid only for as long as the file stays opened. This
+is useful mainly for files that are already in memory, such as embedded GLB
+buffers. Meshes that need patching --- currently only texture coordinates
+that get Y-flipped if @cb{.ini} textureCoordinateYFlipInMaterial @ce isn't
+enabled --- are always copied.
+
+If the vertex attributes of a mesh come from more than one buffer or if any of
+them is sparse, they're put into a newly allocated interleaved vertex buffer
+instead, with each attribute copied straight from its source buffer and sparse
+values written directly to their destination. Such meshes are always copied,
+regardless of the @cb{.ini} zeroCopyMeshes @ce option.
+
 @subsection Trade-CgltfImporter-behavior-materials Material import
 
 -   If present, builtin [metallic/roughness](https://www.khronos.org/registry/glTF/specs/2.0/glTF-2.0.html#metallic-roughness-material) material is imported,
@@ -367,6 +389,29 @@ following defaults have been chosen for this importer:
 </li>
 </ul>
 
+@subsection Trade-CgltfImporter-behavior-buffers Buffer loading
+
+Buffers are by default loaded on first use, i.e. when the first mesh, image,
+animation or skin referencing them gets imported. External buffers are read
+from the filesystem (or through a file callback, if set) and buffers embedded
+as base64 data URIs are decoded. Enabling the @cb{.ini} prefetchBuffers @ce
+@ref Trade-CgltfImporter-configuration "configuration option" loads all
+external and base64-encoded buffers already in @ref openFile() or
+@ref openData(), distributed across the count of threads given by the
+@cb{.ini} threads @ce option. Buffers that go through a file callback and the
+GLB binary chunk are still loaded on first use. If a buffer fails to load, the
+failure isn't reported when opening --- it's reported the same way as without
+prefetching when the buffer is used for the first time.
+
+Similarly to @ref Trade-StanfordImporter-behavior-multithreading "StanfordImporter",
+the plugin doesn't link to `pthread` on its own and on Linux it's the
+application that needs to link to it instead if prefetching is enabled:
+
+@code{.cmake}
+find_package(Threads REQUIRED)
+target_link_libraries(your-application PRIVATE Threads::Threads)
+@endcode
+
 @section Trade-CgltfImporter-configuration Plugin-specific config
 
 It's possible to tune various output options through @ref configuration(). See
@@ -0,0 +1,162 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Magnum/Math/Vector3.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/MeshData.h>
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct CgltfImporterBenchmark: TestSuite::Tester {
+    explicit CgltfImporterBenchmark();
+
+    void openFirstMesh();
+
+    std::string _filename, _filenameEmbedded;
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+constexpr std::size_t BufferCount = 16;
+constexpr std::size_t VertexCount = 1 << 16;
+
+constexpr struct {
+    const char* name;
+    bool embedded;
+    bool prefetch;
+} OpenFirstMeshData[]{
+    {"external buffers, on demand", false, false},
+    {"external buffers, prefetched", false, true},
+    {"embedded buffers, on demand", true, false},
+    {"embedded buffers, prefetched", true, true}
+};
+
+std::string base64Encode(Containers::ArrayView<const char> data) {
+    const char Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    std::string out;
+    out.reserve((data.size() + 2)/3*4);
+    for(std::size_t i = 0; i < data.size(); i += 3) {
+        const std::size_t remaining = data.size() - i;
+        const UnsignedInt value =
+            UnsignedByte(data[i]) << 16 |
+            (remaining > 1 ? UnsignedByte(data[i + 1]) << 8 : 0) |
+            (remaining > 2 ? UnsignedByte(data[i + 2]) : 0);
+        out += Alphabet[(value >> 18) & 0x3f];
+        out += Alphabet[(value >> 12) & 0x3f];
+        out += remaining > 1 ? Alphabet[(value >> 6) & 0x3f] : '=';
+        out += remaining > 2 ? Alphabet[value & 0x3f] : '=';
+    }
+
+    return out;
+}
+
+CgltfImporterBenchmark::CgltfImporterBenchmark() {
+    addInstancedBenchmarks({&CgltfImporterBenchmark::openFirstMesh}, 5,
+        Containers::arraySize(OpenFirstMeshData));
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef CGLTFIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(CGLTFIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::mkpath(CGLTFIMPORTER_TEST_OUTPUT_DIR));
+
+    /* Generate a file with a point cloud mesh in each of the buffers, once
+       with the buffers as external files and once embedded as base64 */
+    std::string buffers, buffersEmbedded, bufferViews, accessors, meshes;
+    Containers::Array<Vector3> positions{NoInit, VertexCount};
+    for(std::size_t i = 0; i != BufferCount; ++i) {
+        for(std::size_t j = 0; j != VertexCount; ++j)
+            positions[j] = {Float(j%256), Float(j/256), Float(i)};
+        const Containers::ArrayView<const char> bytes = Containers::arrayCast<const char>(positions);
+
+        const std::string binFilename = Utility::formatString("benchmark-{}.bin", i);
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::write(Utility::Directory::join(CGLTFIMPORTER_TEST_OUTPUT_DIR, binFilename), bytes));
+
+        const char* const separator = i ? ",\n" : "";
+        buffers += Utility::formatString(R"({}{{"byteLength": {}, "uri": "{}"}})", separator, bytes.size(), binFilename);
+        buffersEmbedded += Utility::formatString(R"({}{{"byteLength": {}, "uri": "data:application/octet-stream;base64,{}"}})", separator, bytes.size(), base64Encode(bytes));
+        bufferViews += Utility::formatString(R"({}{{"buffer": {}, "byteLength": {}}})", separator, i, bytes.size());
+        accessors += Utility::formatString(R"({}{{"bufferView": {}, "componentType": 5126, "count": {}, "type": "VEC3"}})", separator, i, VertexCount);
+        meshes += Utility::formatString(R"({}{{"primitives": [{{"mode": 0, "attributes": {{"POSITION": {}}}}}]}})", separator, i);
+    }
+
+    const char* const format = R"({{
+  "asset": {{"version": "2.0"}},
+  "buffers": [
+{}
+  ],
+  "bufferViews": [
+{}
+  ],
+  "accessors": [
+{}
+  ],
+  "meshes": [
+{}
+  ]
+}})";
+
+    _filename = Utility::Directory::join(CGLTFIMPORTER_TEST_OUTPUT_DIR, "benchmark.gltf");
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::writeString(_filename, Utility::formatString(format, buffers, bufferViews, accessors, meshes)));
+    _filenameEmbedded = Utility::Directory::join(CGLTFIMPORTER_TEST_OUTPUT_DIR, "benchmark-embedded.gltf");
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::writeString(_filenameEmbedded, Utility::formatString(format, buffersEmbedded, bufferViews, accessors, meshes)));
+}
+
+void CgltfImporterBenchmark::openFirstMesh() {
+    auto&& data = OpenFirstMeshData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CgltfImporter");
+    importer->configuration().setValue("prefetchBuffers", data.prefetch);
+
+    /* Measures the time until the first mesh is available. With prefetching
+       all buffers are loaded in openFile() already, without it only the
+       buffer referenced by the first mesh gets loaded. */
+    std::size_t vertexCount = 0;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openFile(data.embedded ? _filenameEmbedded : _filename));
+        Containers::Optional<MeshData> mesh = importer->mesh(0);
+        CORRADE_VERIFY(mesh);
+        vertexCount += mesh->vertexCount();
+    }
+
+    CORRADE_COMPARE(vertexCount, VertexCount);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::CgltfImporterBenchmark)
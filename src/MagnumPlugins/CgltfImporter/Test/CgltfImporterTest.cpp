@@ -62,6 +62,12 @@
 
 #include "configure.h"
 
+/* The plugin class is accessible only when linking to the plugin directly */
+#ifndef CGLTFIMPORTER_PLUGIN_FILENAME
+#include "MagnumPlugins/CgltfImporter/CgltfImporter.h"
+#endif
+#include "MagnumPlugins/CgltfImporter/defaultConfiguration.h"
+
 namespace Magnum { namespace Trade { namespace Test { namespace {
 
 struct CgltfImporterTest: TestSuite::Tester {
@@ -76,6 +82,9 @@ struct CgltfImporterTest: TestSuite::Tester {
     void openExternalDataTooShort();
     void openExternalDataNoUri();
     void openExternalDataInvalidUri();
+    void openExternalDataBase64();
+    void openExternalDataPrefetch();
+    void openExternalDataPrefetchNotFound();
 
     void requiredExtensions();
     void requiredExtensionsUnsupported();
@@ -132,6 +141,7 @@ struct CgltfImporterTest: TestSuite::Tester {
     void meshAttributeless();
     void meshIndexed();
     void meshIndexedAttributeless();
+    void meshZeroCopy();
     void meshColors();
     void meshSkinAttributes();
     void meshCustomAttributes();
@@ -143,6 +153,9 @@ struct CgltfImporterTest: TestSuite::Tester {
     void meshOutOfBounds();
     void meshInvalid();
     void meshInvalidIndicesBufferNotFound();
+    void meshSparse();
+    void meshSparseInvalid();
+    void meshMultipleBuffers();
     void meshInvalidTypes();
 
     void materialPbrMetallicRoughness();
@@ -188,6 +201,8 @@ struct CgltfImporterTest: TestSuite::Tester {
     void versionSupported();
     void versionUnsupported();
 
+    void defaultConfiguration();
+
     /* Needs to load AnyImageImporter from system-wide location */
     PluginManager::Manager<AbstractImporter> _manager;
 };
@@ -242,6 +257,20 @@ constexpr struct {
     {"invalid base64", "invalid base64 string in data URI"}
 };
 
+constexpr struct {
+    const char* name;
+    const char* base64;
+    UnsignedByte expected[3];
+    UnsignedInt size;
+    bool prefetch;
+} Base64Data[]{
+    {"three bytes", "AQID", {1, 2, 3}, 3, false},
+    {"two bytes", "AQI=", {1, 2}, 2, false},
+    {"one byte", "AQ==", {1}, 1, false},
+    {"high bits", "//79", {255, 254, 253}, 3, false},
+    {"prefetched", "AQID", {1, 2, 3}, 3, true}
+};
+
 constexpr struct {
     const char* name;
     const char* file;
@@ -423,14 +452,22 @@ constexpr struct {
     {"normalized float", "attribute _THING component type FLOAT (5126) can't be normalized"},
     {"normalized int", "attribute _THING component type UNSIGNED_INT (5125) can't be normalized"},
     {"non-normalized byte matrix", "attribute _THING has an unsupported matrix component type unnormalized BYTE (5120)"},
-    {"sparse accessor", "accessor 14 is using sparse storage, which is unsupported"},
     {"no bufferview", "accessor 15 has no buffer view"},
     {"accessor range out of bounds", "accessor 18 needs 48 bytes but buffer view 0 has only 36"},
     {"buffer view range out of bounds", "buffer view 3 needs 164 bytes but buffer 1 has only 160"},
-    {"multiple buffers", "meshes spanning multiple buffers are not supported"},
     {"invalid index accessor", "accessor 17 needs 40 bytes but buffer view 0 has only 36"}
 };
 
+constexpr struct {
+    const char* name;
+    const char* message;
+} MeshSparseInvalidData[]{
+    {"sparse index out of bounds", "sparse index 5 out of bounds for 3 elements in accessor 4"},
+    {"sparse indices out of bounds", "accessor 5 sparse indices need 6 bytes but buffer view 1 has only 4"},
+    {"sparse values out of bounds", "accessor 7 sparse values need 24 bytes but buffer view 1 has only 4"},
+    {"invalid sparse index type", "accessor 6 has an unexpected sparse index component type SHORT (5122)"}
+};
+
 constexpr struct {
     const char* name;
     const char* message;
@@ -630,6 +667,15 @@ CgltfImporterTest::CgltfImporterTest() {
     addInstancedTests({&CgltfImporterTest::openExternalDataInvalidUri},
                       Containers::arraySize(InvalidUriData));
 
+    addInstancedTests({&CgltfImporterTest::openExternalDataBase64},
+                      Containers::arraySize(Base64Data));
+
+    addInstancedTests({&CgltfImporterTest::openExternalDataPrefetch},
+                      Containers::arraySize(MultiFileData));
+
+    addInstancedTests({&CgltfImporterTest::openExternalDataPrefetchNotFound},
+                      Containers::arraySize(SingleFileData));
+
     addTests({&CgltfImporterTest::requiredExtensions,
               &CgltfImporterTest::requiredExtensionsUnsupported,
               &CgltfImporterTest::requiredExtensionsUnsupportedDisabled});
@@ -732,6 +778,9 @@ CgltfImporterTest::CgltfImporterTest() {
               &CgltfImporterTest::meshUnorderedAttributes,
               &CgltfImporterTest::meshMultiplePrimitives});
 
+    addInstancedTests({&CgltfImporterTest::meshZeroCopy},
+                      Containers::arraySize(MultiFileData));
+
     addInstancedTests({&CgltfImporterTest::meshPrimitivesTypes},
         Containers::arraySize(MeshPrimitivesTypesData));
 
@@ -741,7 +790,13 @@ CgltfImporterTest::CgltfImporterTest() {
     addInstancedTests({&CgltfImporterTest::meshInvalid},
         Containers::arraySize(MeshInvalidData));
 
-    addTests({&CgltfImporterTest::meshInvalidIndicesBufferNotFound});
+    addTests({&CgltfImporterTest::meshInvalidIndicesBufferNotFound,
+              &CgltfImporterTest::meshSparse});
+
+    addInstancedTests({&CgltfImporterTest::meshSparseInvalid},
+        Containers::arraySize(MeshSparseInvalidData));
+
+    addTests({&CgltfImporterTest::meshMultipleBuffers});
 
     addInstancedTests({&CgltfImporterTest::meshInvalidTypes},
         Containers::arraySize(MeshInvalidTypesData));
@@ -812,6 +867,8 @@ CgltfImporterTest::CgltfImporterTest() {
     addInstancedTests({&CgltfImporterTest::versionUnsupported},
                       Containers::arraySize(UnsupportedVersionData));
 
+    addTests({&CgltfImporterTest::defaultConfiguration});
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. It also pulls in the AnyImageImporter dependency. Reset
        the plugin dir after so it doesn't load anything else from the filesystem. */
@@ -1059,6 +1116,79 @@ void CgltfImporterTest::openExternalDataInvalidUri() {
     CORRADE_COMPARE(out.str(), Utility::formatString("Trade::CgltfImporter::image2D(): {}\n", data.message));
 }
 
+void CgltfImporterTest::openExternalDataBase64() {
+    auto&& data = Base64Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CgltfImporter");
+    importer->configuration().setValue("prefetchBuffers", data.prefetch);
+
+    /* An attribute-less mesh with just indices coming from the buffer */
+    const std::string file = Utility::formatString(R"({{
+        "asset": {{"version": "2.0"}},
+        "buffers": [{{"byteLength": {1}, "uri": "data:application/octet-stream;base64,{0}"}}],
+        "bufferViews": [{{"buffer": 0, "byteLength": {1}}}],
+        "accessors": [{{"bufferView": 0, "componentType": 5121, "count": {1}, "type": "SCALAR"}}],
+        "meshes": [{{"primitives": [{{"attributes": {{}}, "indices": 0}}]}}]
+    }})", data.base64, data.size);
+    CORRADE_VERIFY(importer->openData({file.data(), file.size()}));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedByte>(),
+        Containers::arrayView(data.expected).prefix(data.size),
+        TestSuite::Compare::Container);
+}
+
+void CgltfImporterTest::openExternalDataPrefetch() {
+    auto&& data = MultiFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CgltfImporter");
+    importer->configuration().setValue("prefetchBuffers", true);
+    importer->configuration().setValue("threads", 2);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
+        "mesh" + std::string{data.suffix})));
+
+    /* The data should be the same as when loading on demand */
+    auto mesh = importer->mesh("Indexed mesh");
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedByte>(),
+        Containers::arrayView<UnsignedByte>({0, 1, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.5f, -1.0f, -0.5f},
+            {-0.5f, 2.5f, 0.75f},
+            {-2.0f, 1.0f, 0.3f}
+        }), TestSuite::Compare::Container);
+}
+
+void CgltfImporterTest::openExternalDataPrefetchNotFound() {
+    auto&& data = SingleFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CgltfImporter");
+    importer->configuration().setValue("prefetchBuffers", true);
+
+    auto filename = Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
+        "buffer-notfound" + std::string{data.suffix});
+
+    /* Opening should succeed and print nothing, the error is reported only
+       once the buffer is used */
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(importer->openFile(filename));
+    }
+    CORRADE_COMPARE(out.str(), "");
+    CORRADE_COMPARE(importer->meshCount(), 1);
+
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), "Trade::CgltfImporter::mesh(): error opening file: /nonexistent.bin : file not found\n");
+}
+
 void CgltfImporterTest::requiredExtensions() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CgltfImporter");
     CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
@@ -2554,6 +2684,65 @@ void CgltfImporterTest::meshIndexedAttributeless() {
     CORRADE_COMPARE(mesh->attributeCount(), 0);
 }
 
+void CgltfImporterTest::meshZeroCopy() {
+    auto&& data = MultiFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CgltfImporter");
+    importer->configuration().setValue("zeroCopyMeshes", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
+        "mesh" + std::string{data.suffix})));
+
+    /* The indexed mesh has nothing to patch, so it references the buffer */
+    auto mesh = importer->mesh("Indexed mesh");
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indexDataFlags(), DataFlags{});
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlags{});
+    CORRADE_COMPARE(mesh->indexType(), MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedByte>(),
+        Containers::arrayView<UnsignedByte>({0, 1, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(mesh->attributeCount(), 4);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.5f, -1.0f, -0.5f},
+            {-0.5f, 2.5f, 0.75f},
+            {-2.0f, 1.0f, 0.3f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector4>(MeshAttribute::Tangent),
+        Containers::arrayView<Vector4>({
+            {-0.1f, -0.2f, -0.3f, 1.0f},
+            {-0.4f, -0.5f, -0.6f, -1.0f},
+            {-0.7f, -0.8f, -0.9f, 1.0f}
+        }), TestSuite::Compare::Container);
+
+    /* The non-indexed mesh has texture coordinates that need to be Y-flipped,
+       so it's copied */
+    auto texturedMesh = importer->mesh("Non-indexed mesh");
+    CORRADE_VERIFY(texturedMesh);
+    CORRADE_COMPARE(texturedMesh->vertexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE_AS(texturedMesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        Containers::arrayView<Vector2>({
+            {0.3f, 1.0f},
+            {0.0f, 0.5f},
+            {0.3f, 0.7f}
+        }), TestSuite::Compare::Container);
+
+    /* Flipping in the material means nothing to patch in the mesh */
+    importer->configuration().setValue("textureCoordinateYFlipInMaterial", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
+        "mesh" + std::string{data.suffix})));
+    texturedMesh = importer->mesh("Non-indexed mesh");
+    CORRADE_VERIFY(texturedMesh);
+    CORRADE_COMPARE(texturedMesh->vertexDataFlags(), DataFlags{});
+    CORRADE_COMPARE_AS(texturedMesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        Containers::arrayView<Vector2>({
+            {0.3f, 0.0f},
+            {0.0f, 0.5f},
+            {0.3f, 0.3f}
+        }), TestSuite::Compare::Container);
+}
+
 void CgltfImporterTest::meshColors() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CgltfImporter");
     CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TINYGLTFIMPORTER_TEST_DIR,
@@ -3267,6 +3456,99 @@ void CgltfImporterTest::meshInvalidIndicesBufferNotFound() {
     CORRADE_COMPARE(out.str(), "Trade::CgltfImporter::mesh(): error opening file: /nonexistent.bin : file not found\n");
 }
 
+void CgltfImporterTest::meshSparse() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CgltfImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(CGLTFIMPORTER_TEST_DIR,
+        "mesh-sparse.gltf")));
+
+    {
+        auto mesh = importer->mesh("sparse");
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->attributeCount(), 1);
+        CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+            Containers::arrayView<Vector3>({
+                {13.0f, 14.0f, 15.0f},
+                {4.0f, 5.0f, 6.0f},
+                {10.0f, 11.0f, 12.0f}
+            }), TestSuite::Compare::Container);
+    } {
+        /* Values not overridden by the sparse data are zero */
+        auto mesh = importer->mesh("sparse without buffer view");
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->attributeCount(), 1);
+        CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+            Containers::arrayView<Vector3>({
+                {13.0f, 14.0f, 15.0f},
+                {},
+                {10.0f, 11.0f, 12.0f}
+            }), TestSuite::Compare::Container);
+    } {
+        /* The texture coordinates get Y-flipped after applying the sparse
+           values */
+        auto mesh = importer->mesh("sparse texture coordinates");
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->attributeCount(), 2);
+        CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+            Containers::arrayView<Vector3>({
+                {1.0f, 2.0f, 3.0f},
+                {4.0f, 5.0f, 6.0f},
+                {7.0f, 8.0f, 9.0f}
+            }), TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(mesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+            Containers::arrayView<Vector2>({
+                {12.0f, -12.0f},
+                {1.0f, 1.0f},
+                {10.0f, -10.0f}
+            }), TestSuite::Compare::Container);
+    }
+}
+
+void CgltfImporterTest::meshSparseInvalid() {
+    auto&& data = MeshSparseInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CgltfImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(CGLTFIMPORTER_TEST_DIR,
+        "mesh-sparse.gltf")));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(data.name));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::CgltfImporter::mesh(): {}\n", data.message));
+}
+
+void CgltfImporterTest::meshMultipleBuffers() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("CgltfImporter");
+    /* Gathering from multiple buffers always makes a copy */
+    importer->configuration().setValue("zeroCopyMeshes", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(CGLTFIMPORTER_TEST_DIR,
+        "mesh-sparse.gltf")));
+
+    auto mesh = importer->mesh("multiple buffers");
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->attributeCount(), 2);
+
+    /* The attributes are interleaved in a single buffer */
+    CORRADE_COMPARE(mesh->attributeStride(MeshAttribute::Position), 20);
+    CORRADE_COMPARE(mesh->attributeStride(MeshAttribute::TextureCoordinates), 20);
+    CORRADE_COMPARE(mesh->vertexData().size(), 60);
+
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f},
+            {7.0f, 8.0f, 9.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        Containers::arrayView<Vector2>({
+            {0.0f, 1.0f},
+            {1.0f, 1.0f},
+            {0.0f, 0.0f}
+        }), TestSuite::Compare::Container);
+}
+
 void CgltfImporterTest::meshInvalidTypes() {
     auto&& data = MeshInvalidTypesData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -4598,6 +4880,42 @@ void CgltfImporterTest::versionUnsupported() {
     CORRADE_COMPARE(out.str(), Utility::formatString("Trade::CgltfImporter::openData(): {}\n", data.message));
 }
 
+void CgltfImporterTest::defaultConfiguration() {
+    /* The default constructor doesn't get the configuration from the plugin
+       metadata, so it has to fill it itself. Verify the values match the conf
+       file, and that no option is missing from them. */
+    Containers::Pointer<AbstractImporter> instantiated = _manager.instantiate("CgltfImporter");
+    Utility::ConfigurationGroup defaults;
+    Implementation::cgltfImporterDefaultConfiguration(defaults);
+    CORRADE_COMPARE(defaults.valueCount(), instantiated->configuration().valueCount());
+
+    /* The plugin class is accessible only when linking to the plugin
+       directly, in that case verify the constructor uses the values */
+    #ifndef CGLTFIMPORTER_PLUGIN_FILENAME
+    CgltfImporter importer;
+    #endif
+
+    for(const char* key: {
+        "ignoreRequiredExtensions",
+        "optimizeQuaternionShortestPath",
+        "normalizeQuaternions",
+        "mergeAnimationClips",
+        "textureCoordinateYFlipInMaterial",
+        "zeroCopyMeshes",
+        "prefetchBuffers",
+        "threads",
+        "objectIdAttribute",
+        "phongMaterialFallback"
+    }) {
+        CORRADE_ITERATION(key);
+        CORRADE_VERIFY(defaults.hasValue(key));
+        CORRADE_COMPARE(defaults.value(key), instantiated->configuration().value(key));
+        #ifndef CGLTFIMPORTER_PLUGIN_FILENAME
+        CORRADE_COMPARE(importer.configuration().value(key), defaults.value(key));
+        #endif
+    }
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::CgltfImporterTest)
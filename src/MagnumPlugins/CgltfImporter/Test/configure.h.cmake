@@ -29,3 +29,4 @@
 #cmakedefine STBIMAGEIMPORTER_PLUGIN_FILENAME "${STBIMAGEIMPORTER_PLUGIN_FILENAME}"
 #define TINYGLTFIMPORTER_TEST_DIR "${TINYGLTFIMPORTER_TEST_DIR}"
 #define CGLTFIMPORTER_TEST_DIR "${CGLTFIMPORTER_TEST_DIR}"
+#define CGLTFIMPORTER_TEST_OUTPUT_DIR "${CGLTFIMPORTER_TEST_OUTPUT_DIR}"
@@ -0,0 +1,54 @@
+#ifndef Magnum_Trade_CgltfImporter_defaultConfiguration_h
+#define Magnum_Trade_CgltfImporter_defaultConfiguration_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* The default constructor doesn't get the configuration from the plugin
+   metadata, so it has to fill it itself. Kept in a header so the test can
+   verify the values match CgltfImporter.conf even if the plugin is built as
+   dynamic and the class isn't available to it. */
+
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Magnum/Magnum.h>
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+inline void cgltfImporterDefaultConfiguration(Utility::ConfigurationGroup& conf) {
+    /** @todo horrible workaround, fix this properly */
+    conf.setValue("ignoreRequiredExtensions", false);
+    conf.setValue("optimizeQuaternionShortestPath", true);
+    conf.setValue("normalizeQuaternions", true);
+    conf.setValue("mergeAnimationClips", false);
+    conf.setValue("textureCoordinateYFlipInMaterial", false);
+    conf.setValue("zeroCopyMeshes", false);
+    conf.setValue("prefetchBuffers", false);
+    conf.setValue("threads", 0);
+    conf.setValue("objectIdAttribute", "_OBJECT_ID");
+    conf.setValue("phongMaterialFallback", true);
+}
+
+}}}
+
+#endif
@@ -27,20 +27,22 @@
 #include "DdsImporter.h"
 
 #include <cstring>
-#include <algorithm>
 #include <vector>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Debug.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
 #include <Magnum/PixelFormat.h>
 #include <Magnum/Math/Functions.h>
 #include <Magnum/Math/Vector3.h>
-#include <Magnum/Math/Vector4.h>
-#include <Magnum/Math/Swizzle.h>
 #include <Magnum/Trade/ImageData.h>
 
+#include "MagnumPlugins/Implementation/ImporterFileData.h"
+#include "MagnumPlugins/Implementation/PixelTransform.h"
+
 namespace Magnum { namespace Trade {
 
 namespace {
@@ -299,20 +301,24 @@ inline std::string fourcc(UnsignedInt enc) {
     return c;
 }
 
-void swizzlePixels(const PixelFormat format, Containers::Array<char>& data, const char* verbosePrefix) {
+/* Copies the pixels and converts them from BGR(A) to RGB(A) in a single
+   pass. The data are tightly packed, so they're treated as a single row. */
+Containers::Array<char> swizzlePixels(const PixelFormat format, const Containers::ArrayView<const char> in, const char* verbosePrefix) {
+    std::size_t size;
     if(format == PixelFormat::RGB8Unorm) {
         if(verbosePrefix) Debug{} << verbosePrefix << "converting from BGR to RGB";
-        auto pixels = reinterpret_cast<Math::Vector3<UnsignedByte>*>(data.data());
-        std::transform(pixels, pixels + data.size()/sizeof(Math::Vector3<UnsignedByte>), pixels,
-            [](Math::Vector3<UnsignedByte> pixel) { return Math::gather<'b', 'g', 'r'>(pixel); });
-
+        size = 3;
     } else if(format == PixelFormat::RGBA8Unorm) {
         if(verbosePrefix) Debug{} << verbosePrefix << "converting from BGRA to RGBA";
-        auto pixels = reinterpret_cast<Math::Vector4<UnsignedByte>*>(data.data());
-        std::transform(pixels, pixels + data.size()/sizeof(Math::Vector4<UnsignedByte>), pixels,
-            [](Math::Vector4<UnsignedByte> pixel) { return Math::gather<'b', 'g', 'r', 'a'>(pixel); });
-
+        size = 4;
     } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    Containers::Array<char> out{NoInit, in.size()};
+    const Containers::StridedArrayView4D<const char>::Size viewSize{1, 1, in.size()/size, size};
+    Implementation::transformPixels(Implementation::PixelTransform{size, 1, true, false},
+        Containers::StridedArrayView4D<const char>{in, viewSize},
+        Containers::StridedArrayView4D<char>{out, viewSize});
+    return out;
 }
 
 PixelFormat dxgiToGl(DxgiFormat format) {
@@ -437,10 +443,10 @@ struct DdsHeaderDxt10 {
 
 }
 
-struct DdsImporter::File {
+struct DdsImporter::File: Implementation::ImporterFileData {
     struct ImageDataOffset {
         Vector3i dimensions;
-        Containers::ArrayView<char> data;
+        Containers::ArrayView<const char> data;
     };
 
     /* Returns the new offset of an image in an array for current pixel type
@@ -448,8 +454,6 @@ struct DdsImporter::File {
        (Offset is always at least sizeof(DdsHeader) in healthy cases.) */
     std::size_t addImageDataOffset(const Vector3i& dims, std::size_t offset);
 
-    Containers::Array<char> in;
-
     bool compressed;
     bool volume;
     bool needsSwizzle;
@@ -468,16 +472,21 @@ std::size_t DdsImporter::File::addImageDataOffset(const Vector3i& dims, const st
         dims.product()*pixelSize(pixelFormat.uncompressed);
 
     const size_t end = offset + size;
-    if(in.size() < end) {
+    if(data.size() < end) {
         return 0;
     }
 
-    imageData.push_back({dims, in.slice(offset, end)});
+    imageData.push_back({dims, data.slice(offset, end)});
 
     return end;
 }
 
-DdsImporter::DdsImporter() = default;
+DdsImporter::DdsImporter() {
+    /** @todo horrible workaround, fix this properly */
+    configuration().setValue("memoryMapFile", false);
+    configuration().setValue("borrowData", false);
+    configuration().setValue("zeroCopyImages", false);
+}
 
 DdsImporter::DdsImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
@@ -489,23 +498,32 @@ bool DdsImporter::doIsOpened() const { return !!_f; }
 
 void DdsImporter::doClose() { _f = nullptr; }
 
+void DdsImporter::doOpenFile(const std::string& filename) {
+    Containers::Pointer<File> f{new File};
+    if(!f->openFile(filename, configuration().value<bool>("memoryMapFile"), "Trade::DdsImporter::openFile():"))
+        return;
+
+    openDataInternal(std::move(f));
+}
+
 void DdsImporter::doOpenData(const Containers::ArrayView<const char> data) {
     Containers::Pointer<File> f{new File};
+    f->openData(data, configuration().value<bool>("borrowData"));
 
-    /* clear previous data */
-    f->in = Containers::Array<char>{NoInit, data.size()};
-    Utility::copy(data, f->in);
+    openDataInternal(std::move(f));
+}
 
+void DdsImporter::openDataInternal(Containers::Pointer<File>&& f) {
     constexpr size_t MagicNumberSize = 4;
     /* read magic number to verify this is a dds file. */
-    if(strncmp(f->in.prefix(MagicNumberSize).data(), "DDS ", MagicNumberSize) != 0) {
+    if(f->data.size() < MagicNumberSize || strncmp(f->data.prefix(MagicNumberSize).data(), "DDS ", MagicNumberSize) != 0) {
         Error() << "Trade::DdsImporter::openData(): wrong file signature";
         return;
     }
     std::size_t offset = MagicNumberSize;
 
     /* read in DDS header */
-    const DdsHeader& ddsh = *reinterpret_cast<const DdsHeader*>(f->in.suffix(offset).data());
+    const DdsHeader& ddsh = *reinterpret_cast<const DdsHeader*>(f->data.suffix(offset).data());
     offset += sizeof(DdsHeader);
 
     bool hasDxt10Extension = false;
@@ -531,11 +549,11 @@ void DdsImporter::doOpenData(const Containers::ArrayView<const char> data) {
             case DdsCompressionType::DXT10: {
                     hasDxt10Extension = true;
 
-                    if(f->in.suffix(offset).size() < sizeof(DdsHeaderDxt10)) {
+                    if(f->data.suffix(offset).size() < sizeof(DdsHeaderDxt10)) {
                         Error() << "Trade::DdsImporter::openData(): fourcc was DX10 but file is too short to contain DXT10 header";
                         return;
                     }
-                    const DdsHeaderDxt10& dxt10 = *reinterpret_cast<const DdsHeaderDxt10*>(f->in.suffix(offset).data());
+                    const DdsHeaderDxt10& dxt10 = *reinterpret_cast<const DdsHeaderDxt10*>(f->data.suffix(offset).data());
                     offset += sizeof(DdsHeaderDxt10);
 
                     f->pixelFormat.uncompressed = dxgiToGl(dxt10.dxgiFormat);
@@ -640,23 +658,37 @@ UnsignedInt DdsImporter::doImage2DLevelCount(UnsignedInt) {  return _f->imageDat
 Containers::Optional<ImageData2D> DdsImporter::doImage2D(UnsignedInt, const UnsignedInt level) {
     const File::ImageDataOffset& dataOffset = _f->imageData[level];
 
-    /* copy image data */
-    Containers::Array<char> data{NoInit, dataOffset.data.size()};
-    Utility::copy(dataOffset.data, data);
+    /* Reference the file data directly if desired and if they don't need to
+       be swizzled */
+    const bool zeroCopy = configuration().value<bool>("zeroCopyImages") && !_f->needsSwizzle;
 
     /* Compressed image */
-    if(_f->compressed)
-        return ImageData2D(_f->pixelFormat.compressed, dataOffset.dimensions.xy(), std::move(data));
+    if(_f->compressed) {
+        if(zeroCopy)
+            return ImageData2D(_f->pixelFormat.compressed, dataOffset.dimensions.xy(), DataFlags{}, dataOffset.data);
 
-    /* Uncompressed */
-    if(_f->needsSwizzle) swizzlePixels(_f->pixelFormat.uncompressed, data,
-        flags() & ImporterFlag::Verbose ? "Trade::DdsImporter::image2D():" : nullptr);
+        Containers::Array<char> data{NoInit, dataOffset.data.size()};
+        Utility::copy(dataOffset.data, data);
+        return ImageData2D(_f->pixelFormat.compressed, dataOffset.dimensions.xy(), std::move(data));
+    }
 
     /* Adjust pixel storage if row size is not four byte aligned */
     PixelStorage storage;
     if((dataOffset.dimensions.x()*pixelSize(_f->pixelFormat.uncompressed))%4 != 0)
         storage.setAlignment(1);
 
+    if(zeroCopy)
+        return ImageData2D{storage, _f->pixelFormat.uncompressed, dataOffset.dimensions.xy(), DataFlags{}, dataOffset.data};
+
+    /* Copy image data, swizzling them on the way if needed */
+    Containers::Array<char> data;
+    if(_f->needsSwizzle) data = swizzlePixels(_f->pixelFormat.uncompressed, dataOffset.data,
+        flags() & ImporterFlag::Verbose ? "Trade::DdsImporter::image2D():" : nullptr);
+    else {
+        data = Containers::Array<char>{NoInit, dataOffset.data.size()};
+        Utility::copy(dataOffset.data, data);
+    }
+
     return ImageData2D{storage, _f->pixelFormat.uncompressed, dataOffset.dimensions.xy(), std::move(data)};
 }
 
@@ -667,23 +699,37 @@ UnsignedInt DdsImporter::doImage3DLevelCount(UnsignedInt) {  return _f->imageDat
 Containers::Optional<ImageData3D> DdsImporter::doImage3D(UnsignedInt, const UnsignedInt level) {
     const File::ImageDataOffset& dataOffset = _f->imageData[level];
 
-    /* copy image data */
-    Containers::Array<char> data{NoInit, dataOffset.data.size()};
-    Utility::copy(dataOffset.data, data);
+    /* Reference the file data directly if desired and if they don't need to
+       be swizzled */
+    const bool zeroCopy = configuration().value<bool>("zeroCopyImages") && !_f->needsSwizzle;
 
     /* Compressed image */
-    if(_f->compressed)
-        return ImageData3D(_f->pixelFormat.compressed, dataOffset.dimensions, std::move(data));
+    if(_f->compressed) {
+        if(zeroCopy)
+            return ImageData3D(_f->pixelFormat.compressed, dataOffset.dimensions, DataFlags{}, dataOffset.data);
 
-    /* Uncompressed */
-    if(_f->needsSwizzle) swizzlePixels(_f->pixelFormat.uncompressed, data,
-        flags() & ImporterFlag::Verbose ? "Trade::DdsImporter::image3D():" : nullptr);
+        Containers::Array<char> data{NoInit, dataOffset.data.size()};
+        Utility::copy(dataOffset.data, data);
+        return ImageData3D(_f->pixelFormat.compressed, dataOffset.dimensions, std::move(data));
+    }
 
     /* Adjust pixel storage if row size is not four byte aligned */
     PixelStorage storage;
     if((dataOffset.dimensions.x()*pixelSize(_f->pixelFormat.uncompressed))%4 != 0)
         storage.setAlignment(1);
 
+    if(zeroCopy)
+        return ImageData3D{storage, _f->pixelFormat.uncompressed, dataOffset.dimensions, DataFlags{}, dataOffset.data};
+
+    /* Copy image data, swizzling them on the way if needed */
+    Containers::Array<char> data;
+    if(_f->needsSwizzle) data = swizzlePixels(_f->pixelFormat.uncompressed, dataOffset.data,
+        flags() & ImporterFlag::Verbose ? "Trade::DdsImporter::image3D():" : nullptr);
+    else {
+        data = Containers::Array<char>{NoInit, dataOffset.data.size()};
+        Utility::copy(dataOffset.data, data);
+    }
+
     return ImageData3D{storage, _f->pixelFormat.uncompressed, dataOffset.dimensions, std::move(data)};
 }
 
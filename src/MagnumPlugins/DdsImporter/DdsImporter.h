@@ -143,6 +143,30 @@ The importer recognizes @ref ImporterFlag::Verbose, printing additional info
 when the flag is enabled.
 
 BC6h, BC7 and other compressed formats are currently not imported correctly.
+
+@subsection Trade-DdsImporter-behavior-memory Memory-mapped, borrowed and zero-copy data
+
+Enabling the @cb{.ini} memoryMapFile @ce
+@ref Trade-DdsImporter-configuration "configuration option" makes
+@ref openFile() memory-map the file instead of reading it into memory, while
+the @cb{.ini} borrowData @ce option makes @ref openData() reference the passed
+memory instead of copying it. With @cb{.ini} zeroCopyImages @ce enabled,
+compressed images and uncompressed images that don't need a BGR(A) swizzle
+are returned as views on the file data instead of being copied. Such images
+have empty @ref ImageData::dataFlags() and are valid only for as long as the
+importer is opened. See the
+@ref Trade-KtxImporter-behavior-memory "KtxImporter documentation" for
+details, the behavior is the same here.
+
+@section Trade-DdsImporter-configuration Plugin-specific config
+
+It's possible to tune various import options through @ref configuration(). See
+below for all options and their default values:
+
+@snippet MagnumPlugins/DdsImporter/DdsImporter.conf config
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
 */
 class MAGNUM_DDSIMPORTER_EXPORT DdsImporter: public AbstractImporter {
     public:
@@ -158,6 +182,7 @@ class MAGNUM_DDSIMPORTER_EXPORT DdsImporter: public AbstractImporter {
         MAGNUM_DDSIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
         MAGNUM_DDSIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_DDSIMPORTER_LOCAL void doClose() override;
+        MAGNUM_DDSIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
         MAGNUM_DDSIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
 
         MAGNUM_DDSIMPORTER_LOCAL UnsignedInt doImage2DCount() const override;
@@ -171,6 +196,8 @@ class MAGNUM_DDSIMPORTER_EXPORT DdsImporter: public AbstractImporter {
     private:
         struct File;
         Containers::Pointer<File> _f;
+
+        MAGNUM_DDSIMPORTER_LOCAL void openDataInternal(Containers::Pointer<File>&& f);
 };
 
 }}
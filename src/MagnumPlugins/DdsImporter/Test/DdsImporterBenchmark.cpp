@@ -0,0 +1,284 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/Directory.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/ImageData.h>
+
+#include "MagnumPlugins/Implementation/anonymousResidentMemory.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct DdsImporterBenchmark: TestSuite::Tester {
+    explicit DdsImporterBenchmark();
+
+    void openFile();
+    void openData();
+
+    #ifdef __linux__
+    void openFileMemory();
+    void openDataMemory();
+
+    void memoryBegin();
+    std::uint64_t memoryEnd();
+    #endif
+
+    std::string _filenames[2];
+    Containers::Array<char> _data[2];
+    #ifdef __linux__
+    std::uint64_t _memoryBaseline;
+    #endif
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+constexpr Int Size = 2048;
+
+constexpr struct {
+    const char* filename;
+    /* FourCC for DXT1, zero for uncompressed RGBA */
+    UnsignedInt fourCC;
+    /* Block size in pixels and bytes per block */
+    Int blockSize;
+    std::size_t blockDataSize;
+} FormatData[]{
+    {"benchmark-dxt1.dds", 0x31545844, 4, 8},
+    {"benchmark-rgba8.dds", 0, 1, 4}
+};
+
+constexpr struct {
+    const char* name;
+    std::size_t format;
+    const char* option;
+    bool zeroCopy;
+} OpenFileData[]{
+    {"DXT1, copy", 0, nullptr, false},
+    {"DXT1, memory-mapped, zero-copy", 0, "memoryMapFile", true},
+    {"RGBA8, copy", 1, nullptr, false},
+    {"RGBA8, memory-mapped, zero-copy", 1, "memoryMapFile", true}
+};
+
+constexpr struct {
+    const char* name;
+    std::size_t format;
+    const char* option;
+    bool zeroCopy;
+} OpenDataData[]{
+    {"DXT1, copy", 0, nullptr, false},
+    {"DXT1, borrowed", 0, "borrowData", false},
+    {"DXT1, borrowed, zero-copy", 0, "borrowData", true},
+    {"RGBA8, copy", 1, nullptr, false},
+    {"RGBA8, borrowed", 1, "borrowData", false},
+    {"RGBA8, borrowed, zero-copy", 1, "borrowData", true}
+};
+
+/* A square 2D texture with a full mip chain and the data filled with a
+   repeating pattern. The uncompressed variant is RGBA, which doesn't need to
+   be swizzled on import. */
+Containers::Array<char> generateDds(UnsignedInt fourCC, Int blockSize, std::size_t blockDataSize) {
+    const UnsignedInt levelCount = Math::log2(Size) + 1;
+
+    /* Magic number and a 124-byte header, followed directly by the data */
+    std::size_t dataSize = 0;
+    for(UnsignedInt i = 0; i != levelCount; ++i) {
+        const std::size_t blockCount = (Math::max(Size >> i, 1) + blockSize - 1)/blockSize;
+        dataSize += blockCount*blockCount*blockDataSize;
+    }
+    Containers::Array<char> out{ValueInit, 4 + 124 + dataSize};
+
+    UnsignedInt header[31]{};
+    header[0] = 124;                        /* size */
+    header[1] = 0x00021007;                 /* caps, height, width,
+                                               pixel format, mip count */
+    header[2] = Size;                       /* height */
+    header[3] = Size;                       /* width */
+    header[6] = levelCount;                 /* mip count */
+    header[18] = 32;                        /* pixel format size */
+    if(fourCC) {
+        header[19] = 0x00000004;            /* FourCC */
+        header[20] = fourCC;
+    } else {
+        header[19] = 0x00000041;            /* RGBA */
+        header[21] = 32;                    /* bit count */
+        header[22] = 0x000000ff;            /* R, G, B, A masks */
+        header[23] = 0x0000ff00;
+        header[24] = 0x00ff0000;
+        header[25] = 0xff000000;
+    }
+    header[26] = 0x00401008;                /* complex, texture, mipmap */
+
+    std::memcpy(out, "DDS ", 4);
+    std::memcpy(out + 4, header, sizeof(header));
+    for(std::size_t i = 0; i != dataSize; ++i)
+        out[4 + 124 + i] = char(i*37);
+
+    return out;
+}
+
+DdsImporterBenchmark::DdsImporterBenchmark() {
+    addInstancedBenchmarks({&DdsImporterBenchmark::openFile}, 5,
+        Containers::arraySize(OpenFileData));
+    addInstancedBenchmarks({&DdsImporterBenchmark::openData}, 5,
+        Containers::arraySize(OpenDataData));
+
+    #ifdef __linux__
+    addCustomInstancedBenchmarks({&DdsImporterBenchmark::openFileMemory}, 1,
+        Containers::arraySize(OpenFileData),
+        &DdsImporterBenchmark::memoryBegin,
+        &DdsImporterBenchmark::memoryEnd,
+        BenchmarkUnits::Bytes);
+    addCustomInstancedBenchmarks({&DdsImporterBenchmark::openDataMemory}, 1,
+        Containers::arraySize(OpenDataData),
+        &DdsImporterBenchmark::memoryBegin,
+        &DdsImporterBenchmark::memoryEnd,
+        BenchmarkUnits::Bytes);
+    #endif
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef DDSIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(DDSIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::mkpath(DDSIMPORTER_TEST_OUTPUT_DIR));
+    for(std::size_t i = 0; i != Containers::arraySize(FormatData); ++i) {
+        _data[i] = generateDds(FormatData[i].fourCC, FormatData[i].blockSize, FormatData[i].blockDataSize);
+        _filenames[i] = Utility::Directory::join(DDSIMPORTER_TEST_OUTPUT_DIR, FormatData[i].filename);
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::write(_filenames[i], _data[i]));
+    }
+}
+
+/* Imports all levels of the image, the result is kept alive so the memory
+   benchmarks account for it */
+Containers::Array<ImageData2D> importAllLevels(AbstractImporter& importer) {
+    Containers::Array<ImageData2D> images;
+    for(UnsignedInt i = 0, max = importer.image2DLevelCount(0); i != max; ++i) {
+        Containers::Optional<ImageData2D> image = importer.image2D(0, i);
+        if(!image) return {};
+        arrayAppend(images, std::move(*image));
+    }
+
+    return images;
+}
+
+void DdsImporterBenchmark::openFile() {
+    auto&& data = OpenFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("DdsImporter");
+    if(data.option) importer->configuration().setValue(data.option, true);
+    importer->configuration().setValue("zeroCopyImages", data.zeroCopy);
+
+    Containers::Array<ImageData2D> images;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openFile(_filenames[data.format]));
+        images = importAllLevels(*importer);
+    }
+
+    CORRADE_COMPARE(images.size(), std::size_t(Math::log2(Size) + 1));
+    CORRADE_COMPARE(images[0].size(), Vector2i{Size});
+}
+
+void DdsImporterBenchmark::openData() {
+    auto&& data = OpenDataData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("DdsImporter");
+    if(data.option) importer->configuration().setValue(data.option, true);
+    importer->configuration().setValue("zeroCopyImages", data.zeroCopy);
+
+    Containers::Array<ImageData2D> images;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData(_data[data.format]));
+        images = importAllLevels(*importer);
+    }
+
+    CORRADE_COMPARE(images.size(), std::size_t(Math::log2(Size) + 1));
+    CORRADE_COMPARE(images[0].size(), Vector2i{Size});
+}
+
+#ifdef __linux__
+void DdsImporterBenchmark::memoryBegin() {
+    _memoryBaseline = Implementation::anonymousResidentMemory();
+}
+
+std::uint64_t DdsImporterBenchmark::memoryEnd() {
+    return Implementation::anonymousResidentMemory() - _memoryBaseline;
+}
+
+void DdsImporterBenchmark::openFileMemory() {
+    auto&& data = OpenFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("DdsImporter");
+    if(data.option) importer->configuration().setValue(data.option, true);
+    importer->configuration().setValue("zeroCopyImages", data.zeroCopy);
+
+    /* The importer is kept opened and the images alive until the measurement
+       ends, so the value is the memory needed to get all levels of the
+       texture */
+    Containers::Array<ImageData2D> images;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openFile(_filenames[data.format]));
+        images = importAllLevels(*importer);
+    }
+
+    CORRADE_VERIFY(!images.empty());
+}
+
+void DdsImporterBenchmark::openDataMemory() {
+    auto&& data = OpenDataData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("DdsImporter");
+    if(data.option) importer->configuration().setValue(data.option, true);
+    importer->configuration().setValue("zeroCopyImages", data.zeroCopy);
+
+    /* The importer is kept opened and the images alive until the measurement
+       ends, so the value is the memory needed to get all levels of the
+       texture */
+    Containers::Array<ImageData2D> images;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData(_data[data.format]));
+        images = importAllLevels(*importer);
+    }
+
+    CORRADE_VERIFY(!images.empty());
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::DdsImporterBenchmark)
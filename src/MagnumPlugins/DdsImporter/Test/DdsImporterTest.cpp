@@ -28,6 +28,7 @@
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Resource.h>
@@ -62,6 +63,11 @@ struct DdsImporterTest: TestSuite::Tester {
     void dxt10TooShort();
     void dxt10UnsupportedFormat();
 
+    void fileNotFound();
+    void memoryMapFile();
+    void borrowData();
+    void zeroCopyImages();
+
     void useTwice();
 
     /* Explicitly forbid system-wide plugin dependencies */
@@ -150,6 +156,17 @@ constexpr struct {
     {"3D_R32G32B32_UINT.dds", PixelFormat::RGB32UI}
 };
 
+constexpr struct {
+    const char* name;
+    const char* filename;
+    bool zeroCopy;
+} ZeroCopyImagesData[]{
+    {"compressed", "rgba_dxt1.dds", true},
+    {"uncompressed", "Dxt10TestFiles/2D_R8G8B8A8_UNORM.dds", true},
+    /* Needs to be converted from BGR, thus copied */
+    {"uncompressed, swizzled", "rgb_uncompressed.dds", false}
+};
+
 DdsImporterTest::DdsImporterTest() {
     addTests({&DdsImporterTest::wrongSignature,
               &DdsImporterTest::unknownFormat,
@@ -175,7 +192,14 @@ DdsImporterTest::DdsImporterTest() {
               &DdsImporterTest::dxt10TooShort,
               &DdsImporterTest::dxt10UnsupportedFormat,
 
-              &DdsImporterTest::useTwice});
+              &DdsImporterTest::fileNotFound,
+              &DdsImporterTest::memoryMapFile,
+              &DdsImporterTest::borrowData});
+
+    addInstancedTests({&DdsImporterTest::zeroCopyImages},
+        Containers::arraySize(ZeroCopyImagesData));
+
+    addTests({&DdsImporterTest::useTwice});
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
@@ -492,6 +516,86 @@ void DdsImporterTest::dxt10UnsupportedFormat() {
     CORRADE_COMPARE(out.str(), "Trade::DdsImporter::openData(): unsupported DXGI format 100\n");
 }
 
+void DdsImporterTest::fileNotFound() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("DdsImporter");
+    CORRADE_VERIFY(!importer->openFile("nonexistent.dds"));
+    CORRADE_COMPARE(out.str(), "Trade::DdsImporter::openFile(): cannot open file nonexistent.dds\n");
+}
+
+void DdsImporterTest::memoryMapFile() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("DdsImporter");
+    importer->configuration().setValue("memoryMapFile", true);
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(DDSIMPORTER_TEST_DIR, "rgba_dxt1.dds")));
+
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+
+    /* The image owns its data, so it should be usable even after the file
+       gets unmapped */
+    importer->close();
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView<char>({
+        '\x76', '\xdd', '\xee', '\xcf', '\x04', '\x51', '\x04', '\x51'
+    }), TestSuite::Compare::Container);
+}
+
+void DdsImporterTest::borrowData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("DdsImporter");
+    importer->configuration().setValue("borrowData", true);
+
+    Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(DDSIMPORTER_TEST_DIR, "rgba_dxt1.dds"));
+    CORRADE_VERIFY(importer->openData(data));
+
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+
+    /* The image owns its data, so it should stay intact even if the borrowed
+       memory gets changed */
+    importer->close();
+    for(char& i: data) i = 0;
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView<char>({
+        '\x76', '\xdd', '\xee', '\xcf', '\x04', '\x51', '\x04', '\x51'
+    }), TestSuite::Compare::Container);
+}
+
+void DdsImporterTest::zeroCopyImages() {
+    auto&& data = ZeroCopyImagesData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("DdsImporter");
+    importer->configuration().setValue("borrowData", true);
+    importer->configuration().setValue("zeroCopyImages", true);
+
+    const Containers::Array<char> fileData = Utility::Directory::read(Utility::Directory::join(DDSIMPORTER_TEST_DIR, data.filename));
+    CORRADE_VERIFY(importer->openData(fileData));
+
+    /* Compare to the output without zero-copy */
+    Containers::Pointer<AbstractImporter> expectedImporter = _manager.instantiate("DdsImporter");
+    CORRADE_VERIFY(expectedImporter->openData(fileData));
+
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    Containers::Optional<ImageData2D> expected = expectedImporter->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(expected);
+    CORRADE_COMPARE(image->isCompressed(), expected->isCompressed());
+    CORRADE_COMPARE(image->size(), expected->size());
+    CORRADE_COMPARE_AS(image->data(), expected->data(), TestSuite::Compare::Container);
+
+    const bool pointsToFile = image->data().begin() >= fileData.begin() && image->data().end() <= fileData.end();
+    if(data.zeroCopy) {
+        CORRADE_COMPARE(image->dataFlags(), DataFlags{});
+        CORRADE_VERIFY(pointsToFile);
+    } else {
+        CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+        CORRADE_VERIFY(!pointsToFile);
+    }
+}
+
 void DdsImporterTest::useTwice() {
     Utility::Resource resource{"DdsTestFiles"};
 
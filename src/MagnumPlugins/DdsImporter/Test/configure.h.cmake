@@ -26,3 +26,4 @@
 
 #cmakedefine DDSIMPORTER_PLUGIN_FILENAME "${DDSIMPORTER_PLUGIN_FILENAME}"
 #define DDSIMPORTER_TEST_DIR "${DDSIMPORTER_TEST_DIR}"
+#define DDSIMPORTER_TEST_OUTPUT_DIR "${DDSIMPORTER_TEST_OUTPUT_DIR}"
@@ -27,11 +27,16 @@
 #include "DrFlacImporter.h"
 
 #include <Corrade/Containers/ScopeGuard.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Debug.h>
 #include <Corrade/Utility/Endianness.h>
 
-#include <Magnum/Math/Packing.h>
+#include <Magnum/Math/Functions.h>
+
+#include "MagnumPlugins/Implementation/AudioStream.h"
+#include "MagnumPlugins/Implementation/PcmConversion.h"
 
 #define DR_FLAC_IMPLEMENTATION
 #define DR_FLAC_NO_STDIO /* Otherwise it includes windows.h, ugh */
@@ -55,35 +60,71 @@ const BufferFormat flacFormatTable[8][3] = {
 };
 #undef _v
 
-/* Converts 32-bit PCM into lower bit levels by skipping bytes */
-Containers::Array<char> convert32PCM(const Containers::Array<char>& container, const UnsignedInt samples, const UnsignedInt size) {
-    Containers::Array<char> convertData{NoInit, samples*size};
-
-    UnsignedInt skip = -1, index = 0;
-    for(char item: container) {
-        ++skip;
-
-        if(skip > 3) skip = 0;
-        if(skip < 4 - size) continue;
+/* Size of a single imported sample, 24-bit data are imported as floats */
+UnsignedInt outputSampleSize(const UnsignedInt bytesPerSample) {
+    return bytesPerSample == 3 ? sizeof(Float) : bytesPerSample;
+}
 
-        convertData[index] = item;
-        ++index;
+/* Decodes up to given count of samples into the imported format, returns the
+   count of samples actually decoded. DrFlac always gives us 32-bit samples,
+   which go through a fixed-size buffer, so the memory use doesn't depend on
+   the sample count. */
+std::size_t readSamples(drflac* const handle, const UnsignedInt bytesPerSample, char* const out, const std::size_t samples) {
+    Int buffer[4096];
+    /* Reading a count of samples that isn't a multiple of channel count goes
+       through a slow path that's broken in some versions of dr_libs, so
+       ensure the chunks contain only whole frames */
+    const std::size_t chunkSize = Containers::arraySize(buffer) - Containers::arraySize(buffer) % handle->channels;
+    std::size_t done = 0;
+    while(done != samples) {
+        const std::size_t count = Math::min(samples - done, chunkSize);
+        const std::size_t read = drflac_read_s32(handle, count, buffer);
+
+        /* 32-bit PCM can be sliced down to 8 or 16 bits, 8-bit additionally
+           needs to become unsigned. 24-bit needs to become float. */
+        if(bytesPerSample == 1)
+            Implementation::s32ToU8(buffer, out + done, read);
+        else if(bytesPerSample == 2)
+            Implementation::s32ToS16(buffer, out + done*2, read);
+        else
+            Implementation::s32ToFloat(buffer, out + done*4, read);
+
+        done += read;
+        if(read != count) break;
     }
 
-    return convertData;
+    return done;
 }
 
 }
 
+struct DrFlacImporter::Stream: Implementation::AudioStream {
+    using AudioStream::AudioStream;
+
+    ~Stream() { drflac_close(handle); }
+
+    drflac* handle{};
+    UnsignedInt bytesPerSample;
+};
+
 DrFlacImporter::DrFlacImporter() = default;
 
 DrFlacImporter::DrFlacImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
+DrFlacImporter::~DrFlacImporter() = default;
+
 ImporterFeatures DrFlacImporter::doFeatures() const { return ImporterFeature::OpenData; }
 
-bool DrFlacImporter::doIsOpened() const { return !!_data; }
+bool DrFlacImporter::doIsOpened() const { return _data || _stream; }
 
 void DrFlacImporter::doOpenData(Containers::ArrayView<const char> data) {
+    /* When streaming, the handle operates on a copy owned by the stream */
+    Containers::Pointer<Stream> stream;
+    if(configuration().value<bool>("streaming")) {
+        stream.reset(new Stream{data});
+        data = stream->data;
+    }
+
     drflac* const handle = drflac_open_memory(data.data(), data.size());
     if(!handle) {
         Error() << "Audio::DrFlacImporter::openData(): failed to open and decode FLAC data";
@@ -120,45 +161,75 @@ void DrFlacImporter::doOpenData(Containers::ArrayView<const char> data) {
     _format = flacFormatTable[numChannels-1][normalizedBytesPerSample-1];
     CORRADE_INTERNAL_ASSERT(_format != BufferFormat{});
 
-    Containers::Array<char> tempData{NoInit, std::size_t(samples*sizeof(Int))};
-    drflac_read_s32(handle, samples, reinterpret_cast<Int*>(tempData.begin()));
-
-    _data = convert32PCM(tempData, samples, normalizedBytesPerSample);
-
-    /* 8-bit needs to become unsigned */
-    if(normalizedBytesPerSample == 1) {
-        for(char& item: *_data) item = item - 128;
-
-    /* 24-bit needs to become float */
-    } else if(normalizedBytesPerSample == 3) {
-        Containers::Array<char> floatData{NoInit, std::size_t(samples*sizeof(Float))};
-
-        const Containers::ArrayView<Float> floats = Containers::arrayCast<Float>(floatData);
-        for(std::size_t i = 0; i != samples; ++i) {
-            const UnsignedInt s0 = (*_data)[i*3 + 0];
-            const UnsignedInt s1 = (*_data)[i*3 + 1];
-            const UnsignedInt s2 = (*_data)[i*3 + 2];
-
-            const Int intData = Int((s0 << 8) | (s1 << 16) | (s2 << 24));
-            floats[i] = Math::unpack<Float>(intData);
-        }
-
-        _data = std::move(floatData);
+    /* In streaming mode keep the handle open and decode only on demand */
+    if(stream) {
+        drflacClose.release();
+        stream->handle = handle;
+        stream->channels = numChannels;
+        stream->sampleSize = outputSampleSize(normalizedBytesPerSample);
+        stream->frameCount = samples/numChannels;
+        stream->bytesPerSample = normalizedBytesPerSample;
+        _stream = std::move(stream);
+        return;
     }
+
+    Containers::Array<char> decodedData{NoInit, std::size_t(samples*outputSampleSize(normalizedBytesPerSample))};
+    readSamples(handle, normalizedBytesPerSample, decodedData, samples);
+    _data = std::move(decodedData);
 }
 
-void DrFlacImporter::doClose() { _data = Containers::NullOpt; }
+void DrFlacImporter::doClose() {
+    _data = Containers::NullOpt;
+    _stream = nullptr;
+}
 
 BufferFormat DrFlacImporter::doFormat() const { return _format; }
 
 UnsignedInt DrFlacImporter::doFrequency() const { return _frequency; }
 
 Containers::Array<char> DrFlacImporter::doData() {
+    /* In streaming mode decode the whole file through a new handle so the
+       current stream position isn't affected */
+    if(_stream) {
+        drflac* const handle = drflac_open_memory(_stream->data.data(), _stream->data.size());
+        CORRADE_INTERNAL_ASSERT(handle);
+        Containers::ScopeGuard drflacClose{handle, drflac_close};
+
+        const std::uint64_t samples = handle->totalSampleCount;
+        Containers::Array<char> out{NoInit, std::size_t(samples*outputSampleSize(_stream->bytesPerSample))};
+        readSamples(handle, _stream->bytesPerSample, out, samples);
+        return out;
+    }
+
+    /* Give up the ownership if requested. An empty array is left behind, so
+       the importer stays opened. */
+    if(configuration().value<bool>("releaseData"))
+        return std::move(*_data);
+
     Containers::Array<char> copy{NoInit, _data->size()};
-    std::copy(_data->begin(), _data->end(), copy.begin());
+    Utility::copy(*_data, copy);
     return copy;
 }
 
+std::size_t DrFlacImporter::decodeInto(const Containers::ArrayView<char> data) {
+    const std::size_t frameCount = Implementation::streamFrameCountFor(_stream.get(), data, "Audio::DrFlacImporter::decodeInto():");
+    if(!frameCount) return 0; /* LCOV_EXCL_LINE */
+
+    return readSamples(_stream->handle, _stream->bytesPerSample, data, frameCount*_stream->channels)*_stream->sampleSize;
+}
+
+bool DrFlacImporter::seek(const UnsignedLong frame) {
+    if(!Implementation::streamSeekInRange(_stream.get(), frame, "Audio::DrFlacImporter::seek():"))
+        return false;
+
+    if(!drflac_seek_to_sample(_stream->handle, frame*_stream->channels)) {
+        Error{} << "Audio::DrFlacImporter::seek(): can't seek to frame" << frame;
+        return false;
+    }
+
+    return true;
+}
+
 }}
 
 CORRADE_PLUGIN_REGISTER(DrFlacAudioImporter, Magnum::Audio::DrFlacImporter,
@@ -32,6 +32,7 @@
 
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Magnum/Audio/AbstractImporter.h>
 
 #include "MagnumPlugins/DrFlacAudioImporter/configure.h"
@@ -125,6 +126,30 @@ target_link_libraries(your-app PRIVATE MagnumPlugins::DrFlacAudioImporter)
 
 See @ref building-plugins, @ref cmake-plugins and @ref plugins for more
 information.
+
+@section Audio-DrFlacImporter-data-ownership Data ownership
+
+By default, @ref data() returns a copy of the decoded data. If the
+@cb{.ini} releaseData @ce @ref Audio-DrFlacImporter-configuration "configuration option"
+is enabled, the first call moves the data out of the importer instead. See
+@ref audio-importer-data-ownership for more information.
+
+@section Audio-DrFlacImporter-streaming Streaming decoding
+
+If the @cb{.ini} streaming @ce @ref Audio-DrFlacImporter-configuration "configuration option"
+is enabled, the audio is decoded on demand using @ref decodeInto() and
+@ref seek() instead of when opening the file. See @ref audio-importer-streaming
+for more information.
+
+@section Audio-DrFlacImporter-configuration Plugin-specific configuration
+
+It's possible to tune various import options through @ref configuration().
+See below for all options and their default values:
+
+@snippet MagnumPlugins/DrFlacAudioImporter/DrFlacAudioImporter.conf config
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
 */
 class MAGNUM_DRFLACAUDIOIMPORTER_EXPORT DrFlacImporter: public AbstractImporter {
     public:
@@ -134,7 +159,38 @@ class MAGNUM_DRFLACAUDIOIMPORTER_EXPORT DrFlacImporter: public AbstractImporter
         /** @brief Plugin manager constructor */
         explicit DrFlacImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        ~DrFlacImporter();
+
+        /**
+         * @brief Decode next chunk of audio data
+         * @m_since_latest_{plugins}
+         *
+         * Expects that a file is opened with the @cb{.ini} streaming @ce
+         * @ref Audio-DrFlacImporter-configuration "configuration option" enabled
+         * and that @p data is large enough to fit at least one frame. Decodes
+         * as many whole frames as fit into @p data, in the @ref format() the
+         * file is imported as, and returns count of bytes written. Returns
+         * @cpp 0 @ce when the end of the stream is reached.
+         * @see @ref Audio-DrFlacImporter-streaming
+         */
+        std::size_t decodeInto(Containers::ArrayView<char> data);
+
+        /**
+         * @brief Seek to given frame
+         * @m_since_latest_{plugins}
+         *
+         * Expects that a file is opened with the @cb{.ini} streaming @ce
+         * @ref Audio-DrFlacImporter-configuration "configuration option" enabled.
+         * The next @ref decodeInto() call continues from @p frame. If
+         * @p frame is out of range or the seek fails, prints a message to
+         * @relativeref{Magnum,Error} and returns @cpp false @ce.
+         * @see @ref Audio-DrFlacImporter-streaming
+         */
+        bool seek(UnsignedLong frame);
+
     private:
+        struct Stream;
+
         MAGNUM_DRFLACAUDIOIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
         MAGNUM_DRFLACAUDIOIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_DRFLACAUDIOIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
@@ -147,6 +203,7 @@ class MAGNUM_DRFLACAUDIOIMPORTER_EXPORT DrFlacImporter: public AbstractImporter
         Containers::Optional<Containers::Array<char>> _data;
         BufferFormat _format;
         UnsignedInt _frequency;
+        Containers::Pointer<Stream> _stream;
 };
 
 }}
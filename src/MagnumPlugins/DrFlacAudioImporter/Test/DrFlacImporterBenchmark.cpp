@@ -0,0 +1,92 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Magnum/Audio/AbstractImporter.h>
+
+#include "configure.h"
+#include "generateFlac.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct DrFlacImporterBenchmark: TestSuite::Tester {
+    explicit DrFlacImporterBenchmark();
+
+    void openData();
+
+    Containers::Array<char> _data[5];
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+/* 64 frames of 4096 samples each, which is about six seconds at 44.1 kHz */
+constexpr std::size_t BlockCount = 64;
+
+constexpr struct {
+    const char* name;
+    UnsignedInt channels;
+    UnsignedInt bitsPerSample;
+    BufferFormat format;
+} FormatData[]{
+    {"8-bit stereo", 2, 8, BufferFormat::Stereo8},
+    {"16-bit stereo", 2, 16, BufferFormat::Stereo16},
+    {"24-bit stereo, converted to float", 2, 24, BufferFormat::StereoFloat},
+    {"16-bit 5.1", 6, 16, BufferFormat::Surround51Channel16},
+    {"24-bit 7.1, converted to float", 8, 24, BufferFormat::Surround71Channel32}
+};
+
+DrFlacImporterBenchmark::DrFlacImporterBenchmark() {
+    addInstancedBenchmarks({&DrFlacImporterBenchmark::openData}, 10,
+        Containers::arraySize(FormatData));
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef DRFLACAUDIOIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(DRFLACAUDIOIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    for(std::size_t i = 0; i != Containers::arraySize(FormatData); ++i)
+        _data[i] = generateFlac(FormatData[i].channels, FormatData[i].bitsPerSample, BlockCount);
+}
+
+void DrFlacImporterBenchmark::openData() {
+    auto&& data = FormatData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("DrFlacAudioImporter");
+
+    /* The whole file is decoded on opening */
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData(_data[testCaseInstanceId()]));
+    }
+
+    CORRADE_COMPARE(importer->format(), data.format);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::DrFlacImporterBenchmark)
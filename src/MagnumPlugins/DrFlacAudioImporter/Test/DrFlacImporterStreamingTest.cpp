@@ -0,0 +1,109 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+
+#include "MagnumPlugins/DrFlacAudioImporter/DrFlacImporter.h"
+#include "MagnumPlugins/Implementation/Test/AudioImporterTester.h"
+
+#include "generateFlac.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct DrFlacImporterStreamingTest: AudioImporterTester {
+    explicit DrFlacImporterStreamingTest();
+
+    void decode();
+    void seek();
+    void seekOutOfRange();
+};
+
+/* Most of the test files are truncated, so use generated ones instead */
+constexpr struct {
+    const char* name;
+    UnsignedInt channels;
+    UnsignedInt bitsPerSample;
+    std::size_t frameSize;
+} DecodeData[]{
+    {"8-bit stereo", 2, 8, 2},
+    {"16-bit 5.1", 6, 16, 12},
+    {"24-bit stereo, converted to float", 2, 24, 8}
+};
+
+DrFlacImporterStreamingTest::DrFlacImporterStreamingTest() {
+    addInstancedTests({&DrFlacImporterStreamingTest::decode,
+                       &DrFlacImporterStreamingTest::seek},
+        Containers::arraySize(DecodeData));
+
+    addTests({&DrFlacImporterStreamingTest::seekOutOfRange});
+}
+
+void DrFlacImporterStreamingTest::decode() {
+    auto&& data = DecodeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Containers::Array<char> file = generateFlac(data.channels, data.bitsPerSample, 2);
+
+    DrFlacImporter reference;
+    CORRADE_VERIFY(reference.openData(file));
+
+    DrFlacImporter importer;
+    importer.configuration().setValue("streaming", true);
+    CORRADE_VERIFY(importer.openData(file));
+    CORRADE_COMPARE(importer.format(), reference.format());
+    CORRADE_COMPARE(importer.frequency(), reference.frequency());
+
+    verifyDecode(importer, reference.data(), data.frameSize);
+}
+
+void DrFlacImporterStreamingTest::seek() {
+    auto&& data = DecodeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Containers::Array<char> file = generateFlac(data.channels, data.bitsPerSample, 2);
+
+    DrFlacImporter reference;
+    CORRADE_VERIFY(reference.openData(file));
+
+    DrFlacImporter importer;
+    importer.configuration().setValue("streaming", true);
+    CORRADE_VERIFY(importer.openData(file));
+
+    /* Into the second FLAC frame */
+    verifySeek(importer, reference.data(), data.frameSize, 5000);
+}
+
+void DrFlacImporterStreamingTest::seekOutOfRange() {
+    DrFlacImporter importer;
+    importer.configuration().setValue("streaming", true);
+    CORRADE_VERIFY(importer.openData(generateFlac(2, 16, 2)));
+
+    verifySeekOutOfRange(importer, "DrFlacImporter", 2*BlockSize);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::DrFlacImporterStreamingTest)
@@ -29,14 +29,19 @@
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Magnum/Audio/AbstractImporter.h>
+#include <Magnum/Math/Packing.h>
+
+#include "MagnumPlugins/Implementation/Test/AudioImporterTester.h"
 
 #include "configure.h"
+#include "generateFlac.h"
 
 namespace Magnum { namespace Audio { namespace Test { namespace {
 
-struct DrFlacImporterTest: TestSuite::Tester {
+struct DrFlacImporterTest: AudioImporterTester {
     explicit DrFlacImporterTest();
 
     void empty();
@@ -60,10 +65,27 @@ struct DrFlacImporterTest: TestSuite::Tester {
 
     void surround71Channel24();
 
+    void verbatim();
+
+    void releaseData();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
 
+constexpr struct {
+    const char* name;
+    UnsignedInt channels;
+    UnsignedInt bitsPerSample;
+    BufferFormat format;
+} VerbatimData[]{
+    {"8-bit stereo", 2, 8, BufferFormat::Stereo8},
+    {"16-bit stereo", 2, 16, BufferFormat::Stereo16},
+    {"24-bit stereo", 2, 24, BufferFormat::StereoFloat},
+    {"16-bit 5.1", 6, 16, BufferFormat::Surround51Channel16},
+    {"24-bit 7.1", 8, 24, BufferFormat::Surround71Channel32}
+};
+
 DrFlacImporterTest::DrFlacImporterTest() {
     addTests({&DrFlacImporterTest::empty,
 
@@ -86,6 +108,11 @@ DrFlacImporterTest::DrFlacImporterTest() {
 
               &DrFlacImporterTest::surround71Channel24});
 
+    addInstancedTests({&DrFlacImporterTest::verbatim},
+        Containers::arraySize(VerbatimData));
+
+    addTests({&DrFlacImporterTest::releaseData});
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
     #ifdef DRFLACAUDIOIMPORTER_PLUGIN_FILENAME
@@ -151,7 +178,7 @@ void DrFlacImporterTest::mono24() {
     CORRADE_COMPARE(importer->data().size(), 3696);
     CORRADE_COMPARE_AS(Containers::arrayCast<Float>(importer->data()).prefix(4),
         Containers::arrayView<Float>({
-            -0.000548482f, -3.45707e-06f, -0.00179672f, 0.000154614f
+            -0.000548482f, -0.00143778f, -0.00179672f, 0.000154614f
         }), TestSuite::Compare::Container);
 }
 
@@ -248,6 +275,50 @@ void DrFlacImporterTest::surround71Channel24() {
     CORRADE_COMPARE(importer->frequency(), 48000);
 }
 
+void DrFlacImporterTest::verbatim() {
+    auto&& data = VerbatimData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* The files in the repository are too short to exercise the vectorized
+       sample conversion, so check it against a generated file with a known
+       sample pattern */
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("DrFlacAudioImporter");
+    CORRADE_VERIFY(importer->openData(generateFlac(data.channels, data.bitsPerSample, 2)));
+    CORRADE_COMPARE(importer->format(), data.format);
+    CORRADE_COMPARE(importer->frequency(), 44100);
+
+    /* 8-bit samples are unsigned, 24-bit converted to float */
+    const std::size_t count = BlockSize*2*data.channels;
+    const Containers::Array<char> out = importer->data();
+    if(data.bitsPerSample == 8) {
+        Containers::Array<UnsignedByte> expected{NoInit, count};
+        for(std::size_t i = 0; i != count; ++i)
+            expected[i] = UnsignedByte(sampleValue(i, 8) ^ 0x80);
+        CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(out),
+            Containers::arrayView(expected), TestSuite::Compare::Container);
+    } else if(data.bitsPerSample == 16) {
+        Containers::Array<Short> expected{NoInit, count};
+        for(std::size_t i = 0; i != count; ++i)
+            expected[i] = Short(sampleValue(i, 16));
+        CORRADE_COMPARE_AS(Containers::arrayCast<Short>(out),
+            Containers::arrayView(expected), TestSuite::Compare::Container);
+    } else {
+        Containers::Array<Float> expected{NoInit, count};
+        for(std::size_t i = 0; i != count; ++i)
+            expected[i] = Math::unpack<Float>(Int(UnsignedInt(sampleValue(i, 24)) << 8));
+        CORRADE_COMPARE_AS(Containers::arrayCast<Float>(out),
+            Containers::arrayView(expected), TestSuite::Compare::Container);
+    }
+}
+
+void DrFlacImporterTest::releaseData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("DrFlacAudioImporter");
+    importer->configuration().setValue("releaseData", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(DRFLACAUDIOIMPORTER_TEST_DIR, "mono8.flac")));
+
+    verifyReleaseData(*importer, Utility::Directory::join(DRFLACAUDIOIMPORTER_TEST_DIR, "mono8.flac"));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::DrFlacImporterTest)
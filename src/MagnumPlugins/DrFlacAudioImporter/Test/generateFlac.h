@@ -0,0 +1,130 @@
+#ifndef Magnum_Audio_Test_generateFlac_h
+#define Magnum_Audio_Test_generateFlac_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Magnum/Magnum.h>
+
+/* Shared by DrFlacImporterTest and DrFlacImporterBenchmark */
+
+namespace Magnum { namespace Audio { namespace Test {
+
+/* Samples in a single frame of the generated file */
+constexpr std::size_t BlockSize = 4096;
+
+/* A deterministic pseudo-random value spanning the whole range of given bit
+   depth */
+inline Int sampleValue(std::size_t i, UnsignedInt bitsPerSample) {
+    return Int(UnsignedInt(i*2654435761u)) >> (32 - bitsPerSample);
+}
+
+inline UnsignedByte crc8(const char* data, std::size_t size) {
+    UnsignedByte crc = 0;
+    for(std::size_t i = 0; i != size; ++i) {
+        crc ^= UnsignedByte(data[i]);
+        for(std::size_t j = 0; j != 8; ++j)
+            crc = UnsignedByte(crc & 0x80 ? (crc << 1) ^ 0x07 : crc << 1);
+    }
+    return crc;
+}
+
+inline UnsignedShort crc16(const char* data, std::size_t size) {
+    UnsignedShort crc = 0;
+    for(std::size_t i = 0; i != size; ++i) {
+        crc ^= UnsignedShort(UnsignedByte(data[i]) << 8);
+        for(std::size_t j = 0; j != 8; ++j)
+            crc = UnsignedShort(crc & 0x8000 ? (crc << 1) ^ 0x8005 : crc << 1);
+    }
+    return crc;
+}
+
+/* There's no FLAC encoder to make the file with, so it's a STREAMINFO block
+   followed by fixed-size frames with verbatim (i.e., uncompressed) subframes.
+   That makes the decoding itself cheap and the sample conversion a
+   significant part of the measured time. */
+inline Containers::Array<char> generateFlac(UnsignedInt channels, UnsignedInt bitsPerSample, std::size_t blockCount) {
+    const std::size_t bytesPerSample = bitsPerSample/8;
+    /* Frame header, a one-byte header and the samples for each subframe and
+       a CRC-16 footer */
+    const std::size_t frameSize = 7 + channels*(1 + BlockSize*bytesPerSample) + 2;
+    Containers::Array<char> out{ValueInit, 4 + 4 + 34 + blockCount*frameSize};
+
+    /* Magic, STREAMINFO block header marked as last, block size, unknown
+       frame size, sample rate, channel count, bit depth and total sample
+       count packed into 64 bits. MD5 is left zeroed, meaning unknown. */
+    std::memcpy(out, "fLaC", 4);
+    char* const streamInfo = out + 4;
+    streamInfo[0] = char(0x80);
+    streamInfo[3] = 34;
+    streamInfo[4] = streamInfo[6] = char(BlockSize >> 8);
+    const UnsignedLong packed =
+        UnsignedLong(44100) << 44 |
+        UnsignedLong(channels - 1) << 41 |
+        UnsignedLong(bitsPerSample - 1) << 36 |
+        UnsignedLong(BlockSize*blockCount);
+    for(std::size_t i = 0; i != 8; ++i)
+        streamInfo[14 + i] = char(packed >> (56 - i*8));
+
+    std::size_t sample = 0;
+    for(std::size_t block = 0; block != blockCount; ++block) {
+        char* const frame = out + 4 + 4 + 34 + block*frameSize;
+
+        /* Sync code with a fixed block size, 4096-sample blocks, 44.1 kHz,
+           independent channels, bit depth, frame number as a two-byte UTF-8
+           and a CRC-8 of all that */
+        frame[0] = char(0xff);
+        frame[1] = char(0xf8);
+        frame[2] = char(0xc9);
+        frame[3] = char((channels - 1) << 4 | (bitsPerSample == 8 ? 1 : bitsPerSample == 16 ? 4 : 6) << 1);
+        frame[4] = char(0xc0 | block >> 6);
+        frame[5] = char(0x80 | (block & 0x3f));
+        frame[6] = char(crc8(frame, 6));
+
+        /* Verbatim subframes with big-endian samples, channels are
+           interleaved in the decoded output */
+        char* subframe = frame + 7;
+        for(UnsignedInt c = 0; c != channels; ++c) {
+            *subframe++ = 0x02;
+            for(std::size_t i = 0; i != BlockSize; ++i) {
+                const Int value = sampleValue(sample + i*channels + c, bitsPerSample);
+                for(std::size_t b = 0; b != bytesPerSample; ++b)
+                    *subframe++ = char(value >> ((bytesPerSample - b - 1)*8));
+            }
+        }
+        sample += BlockSize*channels;
+
+        const UnsignedShort crc = crc16(frame, subframe - frame);
+        subframe[0] = char(crc >> 8);
+        subframe[1] = char(crc);
+    }
+
+    return out;
+}
+
+}}}
+
+#endif
@@ -28,10 +28,13 @@
 
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Debug.h>
 #include <Corrade/Utility/Endianness.h>
 
-#include <Magnum/Math/Packing.h>
+#include <Magnum/Math/Functions.h>
+
+#include "MagnumPlugins/Implementation/AudioStream.h"
 
 #define DR_MP3_IMPLEMENTATION
 #include "dr_mp3.h"
@@ -43,70 +46,180 @@ namespace {
 #define _v(value) BufferFormat::value
 /* number of channels = 1-8, number of bytes = 1-4 */
 const BufferFormat mp3FormatTable[8][4] = {
-    {BufferFormat{}, _v(Mono16),   BufferFormat{}, BufferFormat{}}, /* Mono */
-    {BufferFormat{}, _v(Stereo16), BufferFormat{}, BufferFormat{}}, /* Stereo */
+    {BufferFormat{}, _v(Mono16),   BufferFormat{}, _v(MonoFloat)},   /* Mono */
+    {BufferFormat{}, _v(Stereo16), BufferFormat{}, _v(StereoFloat)}, /* Stereo */
     {BufferFormat{}, BufferFormat{}, BufferFormat{}, BufferFormat{}}, /* Not a thing */
-    {BufferFormat{}, _v(Quad16), BufferFormat{}, BufferFormat{}},    /* Quad */
+    {BufferFormat{}, _v(Quad16), BufferFormat{}, _v(Quad32)},        /* Quad */
     {BufferFormat{}, BufferFormat{}, BufferFormat{}, BufferFormat{}}, /* Also not a thing */
-    {BufferFormat{}, _v(Surround51Channel16), BufferFormat{}, BufferFormat{}}, /* 5.1 */
-    {BufferFormat{}, _v(Surround61Channel16), BufferFormat{}, BufferFormat{}}, /* 6.1 */
-    {BufferFormat{}, _v(Surround71Channel16), BufferFormat{}, BufferFormat{}}  /* 7.1 */
+    {BufferFormat{}, _v(Surround51Channel16), BufferFormat{}, _v(Surround51Channel32)}, /* 5.1 */
+    {BufferFormat{}, _v(Surround61Channel16), BufferFormat{}, _v(Surround61Channel32)}, /* 6.1 */
+    {BufferFormat{}, _v(Surround71Channel16), BufferFormat{}, _v(Surround71Channel32)}  /* 7.1 */
 };
 #undef _v
 
+/* Decodes the whole file to 16-bit integers or floats, returns a null
+   optional on failure or if the file has no frames */
+Containers::Optional<Containers::Array<char>> decodeAll(const Containers::ArrayView<const char> data, drmp3_config& config, const bool floatingPoint) {
+    config.outputChannels = config.outputSampleRate = 0;
+    drmp3_uint64 frameCount;
+
+    void* const decodedPointer = floatingPoint ?
+        static_cast<void*>(drmp3_open_memory_and_read_f32(data.data(), data.size(), &config, &frameCount)) :
+        static_cast<void*>(drmp3_open_memory_and_read_s16(data.data(), data.size(), &config, &frameCount));
+    if(!decodedPointer) return {};
+
+    return Containers::Array<char>{static_cast<char*>(decodedPointer), std::size_t(frameCount*config.outputChannels*(floatingPoint ? sizeof(Float) : sizeof(Short))), [](char* data, std::size_t) {
+        drmp3_free(data);
+    }};
+}
+
 }
 
+struct DrMp3Importer::Stream: Implementation::AudioStream {
+    using AudioStream::AudioStream;
+
+    /* The handle is zero-initialized, so this is safe to call even if the
+       initialization failed */
+    ~Stream() { drmp3_uninit(&handle); }
+
+    drmp3 handle{};
+    /* Referenced by the handle */
+    Containers::Array<drmp3_seek_point> seekPoints;
+    bool floatingPoint;
+};
+
 DrMp3Importer::DrMp3Importer() = default;
 
 DrMp3Importer::DrMp3Importer(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
+DrMp3Importer::~DrMp3Importer() = default;
+
 ImporterFeatures DrMp3Importer::doFeatures() const { return ImporterFeature::OpenData; }
 
-bool DrMp3Importer::doIsOpened() const { return !!_data; }
+bool DrMp3Importer::doIsOpened() const { return _data || _stream; }
 
 void DrMp3Importer::doOpenData(Containers::ArrayView<const char> data) {
-    drmp3_config config;
-    config.outputChannels = config.outputSampleRate = 0;
-    drmp3_uint64 frameCount;
-
-    drmp3_int16* const decodedPointer = drmp3_open_memory_and_read_s16(data.data(), data.size(), &config, &frameCount);
-    if(!decodedPointer) {
-        Error() << "Audio::DrMp3Importer::openData(): failed to open and decode MP3 data";
-        return;
+    const bool floatingPoint = configuration().value<bool>("floatOutput");
+    UnsignedInt numChannels, frequency;
+    Containers::Optional<Containers::Array<char>> decodedData;
+    Containers::Pointer<Stream> stream;
+
+    /* In streaming mode only initialize the decoder, operating on a copy
+       owned by the stream */
+    if(configuration().value<bool>("streaming")) {
+        stream.reset(new Stream{data});
+
+        drmp3_config config{};
+        if(!drmp3_init_memory(&stream->handle, stream->data.data(), stream->data.size(), &config)) {
+            Error() << "Audio::DrMp3Importer::openData(): failed to open and decode MP3 data";
+            return;
+        }
+
+        numChannels = stream->handle.channels;
+        frequency = stream->handle.sampleRate;
+        stream->floatingPoint = floatingPoint;
+
+    } else {
+        drmp3_config config;
+        decodedData = decodeAll(data, config, floatingPoint);
+        if(!decodedData) {
+            Error() << "Audio::DrMp3Importer::openData(): failed to open and decode MP3 data";
+            return;
+        }
+
+        numChannels = config.outputChannels;
+        frequency = config.outputSampleRate;
     }
 
-    Containers::Array<char> decodedData{reinterpret_cast<char*>(decodedPointer), std::size_t(frameCount*sizeof(Short)), [](char* data, std::size_t) {
-        drmp3_free(data);
-    }};
-
-    const std::uint32_t numChannels = config.outputChannels;
-
     if(numChannels == 0 || numChannels == 3 || numChannels == 5 || numChannels > 8) {
         Error() << "Audio::DrMp3Importer::openData(): unsupported channel count"
                 << numChannels;
         return;
     }
 
-    _frequency = config.outputSampleRate;
-    _format = mp3FormatTable[numChannels - 1][1];
+    /* Without a seek table, dr_mp3 seeks by decoding everything from the
+       start of the file, so calculate it upfront. Both the frame count and
+       the seek points are calculated by going through just the MP3 frame
+       headers, which is fast. One seek point for every 16 MP3 frames is
+       about every 0.4 seconds at 44.1 kHz. If the calculation fails, the
+       seeking falls back to decoding from the start. */
+    if(stream) {
+        drmp3_uint64 mp3FrameCount, pcmFrameCount;
+        if(!drmp3_get_mp3_and_pcm_frame_count(&stream->handle, &mp3FrameCount, &pcmFrameCount)) {
+            Error() << "Audio::DrMp3Importer::openData(): failed to open and decode MP3 data";
+            return;
+        }
+
+        stream->channels = numChannels;
+        stream->sampleSize = floatingPoint ? sizeof(Float) : sizeof(Short);
+        stream->frameCount = pcmFrameCount;
+
+        drmp3_uint32 seekPointCount = drmp3_uint32(Math::max<drmp3_uint64>(mp3FrameCount/16, 1));
+        stream->seekPoints = Containers::Array<drmp3_seek_point>{NoInit, seekPointCount};
+        if(drmp3_calculate_seek_points(&stream->handle, &seekPointCount, stream->seekPoints))
+            drmp3_bind_seek_table(&stream->handle, seekPointCount, stream->seekPoints);
+    }
+
+    _frequency = frequency;
+    _format = mp3FormatTable[numChannels - 1][floatingPoint ? 3 : 1];
     CORRADE_INTERNAL_ASSERT(_format != BufferFormat{});
 
-    /* All good, save the data */
+    /* All good, save the data or the stream */
     _data = std::move(decodedData);
+    _stream = std::move(stream);
 }
 
-void DrMp3Importer::doClose() { _data = Containers::NullOpt; }
+void DrMp3Importer::doClose() {
+    _data = Containers::NullOpt;
+    _stream = nullptr;
+}
 
 BufferFormat DrMp3Importer::doFormat() const { return _format; }
 
 UnsignedInt DrMp3Importer::doFrequency() const { return _frequency; }
 
 Containers::Array<char> DrMp3Importer::doData() {
+    /* In streaming mode decode the whole file from scratch so the current
+       stream position isn't affected */
+    if(_stream) {
+        drmp3_config config;
+        Containers::Optional<Containers::Array<char>> decodedData = decodeAll(_stream->data, config, _stream->floatingPoint);
+        if(!decodedData) return {};
+        return *std::move(decodedData);
+    }
+
+    /* Give up the ownership if requested. An empty array is left behind, so
+       the importer stays opened. */
+    if(configuration().value<bool>("releaseData"))
+        return std::move(*_data);
+
     Containers::Array<char> copy{NoInit, _data->size()};
     Utility::copy(*_data, copy);
     return copy;
 }
 
+std::size_t DrMp3Importer::decodeInto(const Containers::ArrayView<char> data) {
+    const std::size_t frameCount = Implementation::streamFrameCountFor(_stream.get(), data, "Audio::DrMp3Importer::decodeInto():");
+    if(!frameCount) return 0; /* LCOV_EXCL_LINE */
+
+    const std::size_t frameSize = _stream->channels*_stream->sampleSize;
+    if(_stream->floatingPoint)
+        return drmp3_read_pcm_frames_f32(&_stream->handle, frameCount, reinterpret_cast<Float*>(data.data()))*frameSize;
+    return drmp3_read_pcm_frames_s16(&_stream->handle, frameCount, reinterpret_cast<drmp3_int16*>(data.data()))*frameSize;
+}
+
+bool DrMp3Importer::seek(const UnsignedLong frame) {
+    if(!Implementation::streamSeekInRange(_stream.get(), frame, "Audio::DrMp3Importer::seek():"))
+        return false;
+
+    if(!drmp3_seek_to_pcm_frame(&_stream->handle, frame)) {
+        Error{} << "Audio::DrMp3Importer::seek(): can't seek to frame" << frame;
+        return false;
+    }
+
+    return true;
+}
+
 }}
 
 CORRADE_PLUGIN_REGISTER(DrMp3AudioImporter, Magnum::Audio::DrMp3Importer,
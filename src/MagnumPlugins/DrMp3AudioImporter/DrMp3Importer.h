@@ -33,6 +33,7 @@
 
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Magnum/Audio/AbstractImporter.h>
 
 #include "MagnumPlugins/DrMp3AudioImporter/configure.h"
@@ -69,6 +70,15 @@ the [dr_mp3](https://github.com/mackron/dr_libs) library:
     @ref BufferFormat::Surround51Channel16, @ref BufferFormat::Surround61Channel16
     or @ref BufferFormat::Surround71Channel16
 
+If the @cb{.ini} floatOutput @ce @ref Audio-DrMp3Importer-configuration "configuration option"
+is enabled, the files are decoded directly to @ref BufferFormat::MonoFloat,
+@ref BufferFormat::StereoFloat, @ref BufferFormat::Quad32,
+@ref BufferFormat::Surround51Channel32, @ref BufferFormat::Surround61Channel32
+and @ref BufferFormat::Surround71Channel32 instead. Note that the decoder is
+built to produce 16-bit samples, which are then converted to floats, so this
+doesn't give a higher precision. It however saves a separate conversion pass
+in applications that work with floats.
+
 This plugins provides `Mp3AudioImporter`.
 
 @m_class{m-block m-primary}
@@ -116,6 +126,33 @@ target_link_libraries(your-app PRIVATE MagnumPlugins::DrMp3AudioImporter)
 
 See @ref building-plugins, @ref cmake-plugins and @ref plugins for more
 information.
+
+@section Audio-DrMp3Importer-data-ownership Data ownership
+
+By default, @ref data() returns a copy of the decoded data. If the
+@cb{.ini} releaseData @ce @ref Audio-DrMp3Importer-configuration "configuration option"
+is enabled, the first call moves the data out of the importer instead. See
+@ref audio-importer-data-ownership for more information.
+
+@section Audio-DrMp3Importer-streaming Streaming decoding
+
+If the @cb{.ini} streaming @ce @ref Audio-DrMp3Importer-configuration "configuration option"
+is enabled, the audio is decoded on demand using @ref decodeInto() and
+@ref seek() instead of when opening the file. See @ref audio-importer-streaming
+for more information.
+
+Seeking uses a seek table that's calculated from the MP3 frame headers when
+opening the file.
+
+@section Audio-DrMp3Importer-configuration Plugin-specific configuration
+
+It's possible to tune various import options through @ref configuration().
+See below for all options and their default values:
+
+@snippet MagnumPlugins/DrMp3AudioImporter/DrMp3AudioImporter.conf config
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
 */
 class MAGNUM_DRMP3AUDIOIMPORTER_EXPORT DrMp3Importer: public AbstractImporter {
     public:
@@ -125,7 +162,38 @@ class MAGNUM_DRMP3AUDIOIMPORTER_EXPORT DrMp3Importer: public AbstractImporter {
         /** @brief Plugin manager constructor */
         explicit DrMp3Importer(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        ~DrMp3Importer();
+
+        /**
+         * @brief Decode next chunk of audio data
+         * @m_since_latest_{plugins}
+         *
+         * Expects that a file is opened with the @cb{.ini} streaming @ce
+         * @ref Audio-DrMp3Importer-configuration "configuration option" enabled
+         * and that @p data is large enough to fit at least one frame. Decodes
+         * as many whole frames as fit into @p data, in the @ref format() the
+         * file is imported as, and returns count of bytes written. Returns
+         * @cpp 0 @ce when the end of the stream is reached.
+         * @see @ref Audio-DrMp3Importer-streaming
+         */
+        std::size_t decodeInto(Containers::ArrayView<char> data);
+
+        /**
+         * @brief Seek to given frame
+         * @m_since_latest_{plugins}
+         *
+         * Expects that a file is opened with the @cb{.ini} streaming @ce
+         * @ref Audio-DrMp3Importer-configuration "configuration option" enabled.
+         * The next @ref decodeInto() call continues from @p frame. If
+         * @p frame is out of range or the seek fails, prints a message to
+         * @relativeref{Magnum,Error} and returns @cpp false @ce.
+         * @see @ref Audio-DrMp3Importer-streaming
+         */
+        bool seek(UnsignedLong frame);
+
     private:
+        struct Stream;
+
         MAGNUM_DRMP3AUDIOIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
         MAGNUM_DRMP3AUDIOIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_DRMP3AUDIOIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
@@ -138,6 +206,7 @@ class MAGNUM_DRMP3AUDIOIMPORTER_EXPORT DrMp3Importer: public AbstractImporter {
         Containers::Optional<Containers::Array<char>> _data;
         BufferFormat _format;
         UnsignedInt _frequency;
+        Containers::Pointer<Stream> _stream;
 };
 
 }}
@@ -0,0 +1,133 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "MagnumPlugins/DrMp3AudioImporter/DrMp3Importer.h"
+#include "MagnumPlugins/Implementation/Test/AudioImporterTester.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct DrMp3ImporterStreamingTest: AudioImporterTester {
+    explicit DrMp3ImporterStreamingTest();
+
+    void decode();
+    void seek();
+    void seekSeekTable();
+    void seekOutOfRange();
+};
+
+constexpr struct {
+    const char* name;
+    const char* filename;
+    bool floatOutput;
+    std::size_t frameSize;
+} DecodeData[]{
+    {"mono", "mono16.mp3", false, 2},
+    {"stereo", "stereo16.mp3", false, 4},
+    {"mono, float output", "mono16.mp3", true, 4},
+    {"stereo, float output", "stereo16.mp3", true, 8}
+};
+
+DrMp3ImporterStreamingTest::DrMp3ImporterStreamingTest() {
+    addInstancedTests({&DrMp3ImporterStreamingTest::decode,
+                       &DrMp3ImporterStreamingTest::seek},
+        Containers::arraySize(DecodeData));
+
+    addTests({&DrMp3ImporterStreamingTest::seekSeekTable,
+              &DrMp3ImporterStreamingTest::seekOutOfRange});
+}
+
+void DrMp3ImporterStreamingTest::decode() {
+    auto&& data = DecodeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    DrMp3Importer reference;
+    reference.configuration().setValue("floatOutput", data.floatOutput);
+    CORRADE_VERIFY(reference.openFile(Utility::Directory::join(DRMP3AUDIOIMPORTER_TEST_DIR, data.filename)));
+
+    DrMp3Importer importer;
+    importer.configuration().setValue("streaming", true);
+    importer.configuration().setValue("floatOutput", data.floatOutput);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(DRMP3AUDIOIMPORTER_TEST_DIR, data.filename)));
+    CORRADE_COMPARE(importer.format(), reference.format());
+    CORRADE_COMPARE(importer.frequency(), reference.frequency());
+
+    verifyDecode(importer, reference.data(), data.frameSize);
+}
+
+void DrMp3ImporterStreamingTest::seek() {
+    auto&& data = DecodeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    DrMp3Importer reference;
+    reference.configuration().setValue("floatOutput", data.floatOutput);
+    CORRADE_VERIFY(reference.openFile(Utility::Directory::join(DRMP3AUDIOIMPORTER_TEST_DIR, data.filename)));
+
+    DrMp3Importer importer;
+    importer.configuration().setValue("streaming", true);
+    importer.configuration().setValue("floatOutput", data.floatOutput);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(DRMP3AUDIOIMPORTER_TEST_DIR, data.filename)));
+
+    verifySeek(importer, reference.data(), data.frameSize, 100);
+}
+
+void DrMp3ImporterStreamingTest::seekSeekTable() {
+    /* The test files are just six MP3 frames, which is too little for the
+       seek table to have more than one point. Concatenating the file a few
+       times makes a valid stream of 48 frames with three seek points. */
+    const Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(DRMP3AUDIOIMPORTER_TEST_DIR, "mono16.mp3"));
+    CORRADE_VERIFY(file);
+    Containers::Array<char> concatenated;
+    for(std::size_t i = 0; i != 8; ++i)
+        arrayAppend(concatenated, file);
+
+    DrMp3Importer reference;
+    CORRADE_VERIFY(reference.openData(concatenated));
+
+    DrMp3Importer importer;
+    importer.configuration().setValue("streaming", true);
+    CORRADE_VERIFY(importer.openData(concatenated));
+
+    /* Past the last seek point, in the middle of an MP3 frame */
+    verifySeek(importer, reference.data(), 2, 6*6912 + 500);
+}
+
+void DrMp3ImporterStreamingTest::seekOutOfRange() {
+    DrMp3Importer importer;
+    importer.configuration().setValue("streaming", true);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(DRMP3AUDIOIMPORTER_TEST_DIR, "mono16.mp3")));
+
+    verifySeekOutOfRange(importer, "DrMp3Importer", 6912);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::DrMp3ImporterStreamingTest)
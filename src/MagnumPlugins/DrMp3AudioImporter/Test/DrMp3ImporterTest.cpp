@@ -29,15 +29,18 @@
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Magnum/Audio/AbstractImporter.h>
 
+#include "MagnumPlugins/Implementation/Test/AudioImporterTester.h"
+
 #include "configure.h"
 
 namespace Magnum { namespace Audio { namespace Test { namespace {
 
-struct DrMp3ImporterTest: TestSuite::Tester {
+struct DrMp3ImporterTest: AudioImporterTester {
     explicit DrMp3ImporterTest();
 
     void empty();
@@ -47,6 +50,11 @@ struct DrMp3ImporterTest: TestSuite::Tester {
     void mono16();
     void stereo16();
 
+    void mono16Float();
+    void stereo16Float();
+
+    void releaseData();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
@@ -57,7 +65,12 @@ DrMp3ImporterTest::DrMp3ImporterTest() {
               &DrMp3ImporterTest::zeroSamples,
 
               &DrMp3ImporterTest::mono16,
-              &DrMp3ImporterTest::stereo16});
+              &DrMp3ImporterTest::stereo16,
+
+              &DrMp3ImporterTest::mono16Float,
+              &DrMp3ImporterTest::stereo16Float,
+
+              &DrMp3ImporterTest::releaseData});
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
@@ -119,6 +132,46 @@ void DrMp3ImporterTest::stereo16() {
         }), TestSuite::Compare::Container);
 }
 
+void DrMp3ImporterTest::mono16Float() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("DrMp3AudioImporter");
+    importer->configuration().setValue("floatOutput", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(DRMP3AUDIOIMPORTER_TEST_DIR, "mono16.mp3")));
+
+    /* Same samples as in mono16() */
+    CORRADE_COMPARE(importer->format(), BufferFormat::MonoFloat);
+    CORRADE_COMPARE(importer->frequency(), 44100);
+    CORRADE_COMPARE_AS(importer->data().size(), 13448,
+        TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(Containers::arrayCast<Float>(importer->data().slice(13440, 13448)),
+        Containers::arrayView<Float>({
+            0.0249634f, 0.0750732f
+        }), TestSuite::Compare::Container);
+}
+
+void DrMp3ImporterTest::stereo16Float() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("DrMp3AudioImporter");
+    importer->configuration().setValue("floatOutput", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(DRMP3AUDIOIMPORTER_TEST_DIR, "stereo16.mp3")));
+
+    /* Same samples as in stereo16() */
+    CORRADE_COMPARE(importer->format(), BufferFormat::StereoFloat);
+    CORRADE_COMPARE(importer->frequency(), 44100);
+    CORRADE_COMPARE_AS(importer->data().size(), 19468,
+        TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(Containers::arrayCast<Float>(importer->data().slice(19460, 19468)),
+        Containers::arrayView<Float>({
+            -0.799622f, -0.799286f
+        }), TestSuite::Compare::Container);
+}
+
+void DrMp3ImporterTest::releaseData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("DrMp3AudioImporter");
+    importer->configuration().setValue("releaseData", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(DRMP3AUDIOIMPORTER_TEST_DIR, "stereo16.mp3")));
+
+    verifyReleaseData(*importer, Utility::Directory::join(DRMP3AUDIOIMPORTER_TEST_DIR, "stereo16.mp3"));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::DrMp3ImporterTest)
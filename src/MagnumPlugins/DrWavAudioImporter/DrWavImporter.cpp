@@ -29,8 +29,13 @@
 #include <Corrade/Containers/ScopeGuard.h>
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Debug.h>
 #include <Corrade/Utility/Endianness.h>
+#include <Magnum/Math/Functions.h>
+
+#include "MagnumPlugins/Implementation/AudioStream.h"
+#include "MagnumPlugins/Implementation/PcmConversion.h"
 
 #define DR_WAV_IMPLEMENTATION
 #include "dr_wav.h"
@@ -77,53 +82,88 @@ constexpr const BufferFormat MuLawFormatTable[2][1] = {
 };
 #undef _v
 
-/* Converts 32-bit PCM into lower bit levels by skipping bytes */
-Containers::Array<char> convert32Pcm(const Containers::ArrayView<const char> container, const UnsignedInt samples, const UnsignedInt size) {
-    Containers::Array<char> convertData{NoInit, samples*size};
-
-    UnsignedInt skip = -1, index = 0;
-    for(char item: container) {
-        ++skip;
+/* How the samples are read from the file to end up in the imported format */
+enum class Conversion: UnsignedByte {
+    /* Read as-is, for formats that map directly to a BufferFormat */
+    Raw,
+    /* Read as 32-bit floats, for everything else */
+    Float,
+    /* Read as 32-bit integers and sliced down to 8 or 16 bits */
+    Slice
+};
 
-        if(skip > 3) skip = 0;
-        if(skip < 4 - size) continue;
+/* Size of a single imported sample */
+UnsignedInt outputSampleSize(const Conversion conversion, const UnsignedInt bytesPerSample) {
+    return conversion == Conversion::Float ? sizeof(Float) : bytesPerSample;
+}
 
-        convertData[index] = item;
-        ++index;
+/* Decodes up to given count of samples into the imported format, returns the
+   count of samples actually decoded. Sliced data go through a fixed-size
+   buffer, so the memory use doesn't depend on the sample count. */
+std::size_t readSamples(drwav* const handle, const Conversion conversion, const UnsignedInt bytesPerSample, char* const out, const std::size_t samples) {
+    if(conversion == Conversion::Raw)
+        return drwav_read_raw(handle, samples*bytesPerSample, out)/bytesPerSample;
+
+    if(conversion == Conversion::Float)
+        return drwav_read_f32(handle, samples, reinterpret_cast<Float*>(out));
+
+    CORRADE_INTERNAL_ASSERT(conversion == Conversion::Slice);
+
+    /* 16-bit output can be read directly, without going through 32 bits */
+    if(bytesPerSample == 2)
+        return drwav_read_s16(handle, samples, reinterpret_cast<drwav_int16*>(out));
+
+    CORRADE_INTERNAL_ASSERT(bytesPerSample == 1);
+    Int buffer[4096];
+    /* Reading a count of samples that isn't a multiple of channel count goes
+       through a slow path that's broken in some versions of dr_libs, so
+       ensure the chunks contain only whole frames */
+    const std::size_t chunkSize = Containers::arraySize(buffer) - Containers::arraySize(buffer) % handle->channels;
+    std::size_t done = 0;
+    while(done != samples) {
+        const std::size_t count = Math::min(samples - done, chunkSize);
+        const std::size_t read = drwav_read_s32(handle, count, buffer);
+
+        /* 32-bit PCM sliced down to 8 bits needs to become unsigned */
+        Implementation::s32ToU8(buffer, out + done, read);
+
+        done += read;
+        if(read != count) break;
     }
 
-    return convertData;
+    return done;
 }
 
-/* Reads generic audio into most compatible format; also adjusts format */
-Containers::Array<char> read32fPcm(drwav* const handle, const UnsignedInt samples, const UnsignedInt numChannels, BufferFormat& format) {
-    format = IeeeFormatTable[numChannels-1][0];
-
-    Containers::Array<char> tempData(samples*sizeof(Float));
-    drwav_read_f32(handle, samples, reinterpret_cast<float*>(tempData.begin()));
-
-    return tempData;
 }
 
-/* Reads raw data; be sure size is exact! */
-Containers::Array<char> readRaw(drwav* const handle, const UnsignedInt samples, const UnsignedInt size) {
-    Containers::Array<char> tempData(samples*size);
-    drwav_read_raw(handle, samples*size, reinterpret_cast<void*>(tempData.begin()));
+struct DrWavImporter::Stream: Implementation::AudioStream {
+    using AudioStream::AudioStream;
 
-    return tempData;
-}
+    ~Stream() { drwav_close(handle); }
 
-}
+    drwav* handle{};
+    Conversion conversion;
+    UnsignedInt bytesPerSample;
+};
 
 DrWavImporter::DrWavImporter() = default;
 
 DrWavImporter::DrWavImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
+DrWavImporter::~DrWavImporter() = default;
+
 ImporterFeatures DrWavImporter::doFeatures() const { return ImporterFeature::OpenData; }
 
-bool DrWavImporter::doIsOpened() const { return !!_data; }
+bool DrWavImporter::doIsOpened() const { return _data || _stream; }
+
+void DrWavImporter::doOpenData(Containers::ArrayView<const char> data) {
+    /* When streaming, the handle operates on a copy owned by the stream */
+    Containers::Pointer<Stream> stream;
+    if(configuration().value<bool>("streaming")) {
+        stream.reset(new Stream{data});
+        data = stream->data;
+    }
 
-void DrWavImporter::doOpenData(const Containers::ArrayView<const char> data) {
     drwav* const handle = drwav_open_memory(data.data(), data.size());
     if(!handle) {
         Error() << "Audio::DrWavImporter::openData(): failed to open and decode WAV data";
@@ -150,80 +190,125 @@ void DrWavImporter::doOpenData(const Containers::ArrayView<const char> data) {
         return;
     }
 
-    _frequency = frequency;
+    /* If we don't know what the format is, read it out as 32 bit float for
+       compatibility. The special cases below override it. */
+    BufferFormat format = IeeeFormatTable[numChannels-1][0];
+    Conversion conversion = Conversion::Float;
 
     /* PCM has a lot of special cases, as we can read many formats directly */
     if(handle->translatedFormatTag == DR_WAVE_FORMAT_PCM) {
-        _format = PcmFormatTable[numChannels-1][normalizedBytesPerSample-1];
-        CORRADE_INTERNAL_ASSERT(_format != BufferFormat{});
-
         /* If the data is exactly 8 or 16 bits, we can read it raw */
         if(!notExactBitsPerSample && normalizedBytesPerSample < 3) {
-            _data = readRaw(handle, samples, normalizedBytesPerSample);
-            return;
-
-        /* If the data is approximately 24 bits or has many channels, a float is more than enough */
-        } else if(normalizedBytesPerSample == 3 || (normalizedBytesPerSample > 3 && numChannels > 3)) {
-            _data = read32fPcm(handle, samples, numChannels, _format);
-            return;
+            format = PcmFormatTable[numChannels-1][normalizedBytesPerSample-1];
+            conversion = Conversion::Raw;
 
-        /* If the data is close to 8 or 16 bits, we can convert it from 32-bit PCM */
+        /* If the data is approximately 24 bits or has many channels, a float
+           is more than enough, which is the default. Otherwise, if the data
+           is close to 8 or 16 bits, we can convert it from 32-bit PCM. */
         } else if(normalizedBytesPerSample == 1 || normalizedBytesPerSample == 2) {
-            Containers::Array<char> tempData(samples*sizeof(Int));
-            drwav_read_s32(handle, samples, reinterpret_cast<Int*>(tempData.begin()));
-
-            /* 32-bit PCM can be sliced down to 8 or 16 for direct reading */
-            _data = convert32Pcm(tempData, samples, normalizedBytesPerSample);
-
-            /* Convert 8 bit data to unsigned */
-            if(normalizedBytesPerSample == 1)
-                for(char& item: *_data) item = item - 128;
-            return;
+            format = PcmFormatTable[numChannels-1][normalizedBytesPerSample-1];
+            conversion = Conversion::Slice;
         }
 
+        CORRADE_INTERNAL_ASSERT(format != BufferFormat{});
+
         /** @todo Allow loading of 32/64 bit streams to Double format to preserve all information */
 
     /* ALaw of 8/16 bits with 1/2 channels can be loaded directly */
     } else if(handle->translatedFormatTag == DR_WAVE_FORMAT_ALAW) {
         if(numChannels < 3 && !notExactBitsPerSample && (bitsPerSample == 8 || bitsPerSample == 16) ) {
-            _format = ALawFormatTable[numChannels-1][normalizedBytesPerSample-1];
-            _data = readRaw(handle, samples, normalizedBytesPerSample);
-            return;
+            format = ALawFormatTable[numChannels-1][normalizedBytesPerSample-1];
+            conversion = Conversion::Raw;
         }
 
     /* MuLaw of 8/16 bits with 1/2 channels can be loaded directly */
     } else if(handle->translatedFormatTag == DR_WAVE_FORMAT_MULAW) {
         if(numChannels < 3 && !notExactBitsPerSample && (bitsPerSample == 8 || bitsPerSample == 16) ) {
-            _format = MuLawFormatTable[numChannels-1][normalizedBytesPerSample-1];
-            _data = readRaw(handle, samples, normalizedBytesPerSample);
-            return;
+            format = MuLawFormatTable[numChannels-1][normalizedBytesPerSample-1];
+            conversion = Conversion::Raw;
         }
 
     /* IEEE float or double can be loaded directly */
     } else if(handle->translatedFormatTag == DR_WAVE_FORMAT_IEEE_FLOAT) {
         if(!notExactBitsPerSample && (bitsPerSample == 32 || bitsPerSample == 64)) {
-            _format = IeeeFormatTable[numChannels-1][(normalizedBytesPerSample / 4)-1];
-            _data = readRaw(handle, samples, normalizedBytesPerSample);
-            return;
+            format = IeeeFormatTable[numChannels-1][(normalizedBytesPerSample / 4)-1];
+            conversion = Conversion::Raw;
         }
     }
 
-    /* If we don't know what the format is, read it out as 32 bit float for compatibility */
-    _data = read32fPcm(handle, samples, numChannels, _format);
+    _frequency = frequency;
+    _format = format;
+
+    /* In streaming mode keep the handle open and decode only on demand */
+    if(stream) {
+        drwavClose.release();
+        stream->handle = handle;
+        stream->channels = numChannels;
+        stream->sampleSize = outputSampleSize(conversion, normalizedBytesPerSample);
+        stream->frameCount = samples/numChannels;
+        stream->conversion = conversion;
+        stream->bytesPerSample = normalizedBytesPerSample;
+        _stream = std::move(stream);
+        return;
+    }
+
+    Containers::Array<char> decodedData{NoInit, std::size_t(samples*outputSampleSize(conversion, normalizedBytesPerSample))};
+    readSamples(handle, conversion, normalizedBytesPerSample, decodedData, samples);
+    _data = std::move(decodedData);
 }
 
-void DrWavImporter::doClose() { _data = Containers::NullOpt; }
+void DrWavImporter::doClose() {
+    _data = Containers::NullOpt;
+    _stream = nullptr;
+}
 
 BufferFormat DrWavImporter::doFormat() const { return _format; }
 
 UnsignedInt DrWavImporter::doFrequency() const { return _frequency; }
 
 Containers::Array<char> DrWavImporter::doData() {
+    /* In streaming mode decode the whole file through a new handle so the
+       current stream position isn't affected */
+    if(_stream) {
+        drwav* const handle = drwav_open_memory(_stream->data.data(), _stream->data.size());
+        CORRADE_INTERNAL_ASSERT(handle);
+        Containers::ScopeGuard drwavClose{handle, drwav_close};
+
+        const std::uint64_t samples = handle->totalSampleCount;
+        Containers::Array<char> out{NoInit, std::size_t(samples*outputSampleSize(_stream->conversion, _stream->bytesPerSample))};
+        readSamples(handle, _stream->conversion, _stream->bytesPerSample, out, samples);
+        return out;
+    }
+
+    /* Give up the ownership if requested. An empty array is left behind, so
+       the importer stays opened. */
+    if(configuration().value<bool>("releaseData"))
+        return std::move(*_data);
+
     Containers::Array<char> copy{NoInit, _data->size()};
     Utility::copy(*_data, copy);
     return copy;
 }
 
+std::size_t DrWavImporter::decodeInto(const Containers::ArrayView<char> data) {
+    const std::size_t frameCount = Implementation::streamFrameCountFor(_stream.get(), data, "Audio::DrWavImporter::decodeInto():");
+    if(!frameCount) return 0; /* LCOV_EXCL_LINE */
+
+    return readSamples(_stream->handle, _stream->conversion, _stream->bytesPerSample, data, frameCount*_stream->channels)*_stream->sampleSize;
+}
+
+bool DrWavImporter::seek(const UnsignedLong frame) {
+    if(!Implementation::streamSeekInRange(_stream.get(), frame, "Audio::DrWavImporter::seek():"))
+        return false;
+
+    if(!drwav_seek_to_sample(_stream->handle, frame*_stream->channels)) {
+        Error{} << "Audio::DrWavImporter::seek(): can't seek to frame" << frame;
+        return false;
+    }
+
+    return true;
+}
+
 }}
 
 CORRADE_PLUGIN_REGISTER(DrWavAudioImporter, Magnum::Audio::DrWavImporter,
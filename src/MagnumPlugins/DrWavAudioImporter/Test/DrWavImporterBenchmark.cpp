@@ -0,0 +1,127 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Magnum/Audio/AbstractImporter.h>
+
+#include "configure.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct DrWavImporterBenchmark: TestSuite::Tester {
+    explicit DrWavImporterBenchmark();
+
+    void openData();
+
+    Containers::Array<char> _data[6];
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+/* About twelve seconds of stereo audio at 44.1 kHz */
+constexpr std::size_t FrameCount = 512*1024;
+
+constexpr struct {
+    const char* name;
+    /* 1 for integer PCM, 3 for IEEE float */
+    UnsignedShort formatTag;
+    UnsignedShort bitsPerSample;
+    UnsignedShort bytesPerSample;
+    BufferFormat format;
+    std::size_t outputSampleSize;
+} FormatData[]{
+    {"4-bit, sliced to 8-bit", 1, 4, 1, BufferFormat::Stereo8, 1},
+    {"8-bit", 1, 8, 1, BufferFormat::Stereo8, 1},
+    {"12-bit, sliced to 16-bit", 1, 12, 2, BufferFormat::Stereo16, 2},
+    {"16-bit", 1, 16, 2, BufferFormat::Stereo16, 2},
+    {"24-bit, converted to float", 1, 24, 3, BufferFormat::StereoFloat, 4},
+    {"32-bit float", 3, 32, 4, BufferFormat::StereoFloat, 4}
+};
+
+/* A canonical 44-byte RIFF header with a stereo fmt chunk followed by the
+   data chunk filled with a repeating pattern */
+Containers::Array<char> generateWav(UnsignedShort formatTag, UnsignedShort bitsPerSample, UnsignedShort bytesPerSample) {
+    const UnsignedShort blockAlign = UnsignedShort(2*bytesPerSample);
+    const UnsignedInt dataSize = UnsignedInt(FrameCount*blockAlign);
+    Containers::Array<char> out{NoInit, 44 + dataSize};
+
+    const UnsignedInt riffSize = 36 + dataSize;
+    const UnsignedInt fmtSize = 16;
+    const UnsignedShort channels = 2;
+    const UnsignedInt frequency = 44100;
+    const UnsignedInt byteRate = frequency*blockAlign;
+    std::memcpy(out + 0, "RIFF", 4);
+    std::memcpy(out + 4, &riffSize, 4);
+    std::memcpy(out + 8, "WAVEfmt ", 8);
+    std::memcpy(out + 16, &fmtSize, 4);
+    std::memcpy(out + 20, &formatTag, 2);
+    std::memcpy(out + 22, &channels, 2);
+    std::memcpy(out + 24, &frequency, 4);
+    std::memcpy(out + 28, &byteRate, 4);
+    std::memcpy(out + 32, &blockAlign, 2);
+    std::memcpy(out + 34, &bitsPerSample, 2);
+    std::memcpy(out + 36, "data", 4);
+    std::memcpy(out + 40, &dataSize, 4);
+    for(std::size_t i = 0; i != dataSize; ++i)
+        out[44 + i] = char(i*37);
+
+    return out;
+}
+
+DrWavImporterBenchmark::DrWavImporterBenchmark() {
+    addInstancedBenchmarks({&DrWavImporterBenchmark::openData}, 10,
+        Containers::arraySize(FormatData));
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef DRWAVAUDIOIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(DRWAVAUDIOIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    for(std::size_t i = 0; i != Containers::arraySize(FormatData); ++i)
+        _data[i] = generateWav(FormatData[i].formatTag, FormatData[i].bitsPerSample, FormatData[i].bytesPerSample);
+}
+
+void DrWavImporterBenchmark::openData() {
+    auto&& data = FormatData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("DrWavAudioImporter");
+
+    /* The whole file is decoded on opening */
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData(_data[testCaseInstanceId()]));
+    }
+
+    CORRADE_COMPARE(importer->format(), data.format);
+    CORRADE_COMPARE(importer->data().size(), FrameCount*2*data.outputSampleSize);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::DrWavImporterBenchmark)
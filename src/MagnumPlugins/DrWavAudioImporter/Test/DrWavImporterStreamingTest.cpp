@@ -0,0 +1,104 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "MagnumPlugins/DrWavAudioImporter/DrWavImporter.h"
+#include "MagnumPlugins/Implementation/Test/AudioImporterTester.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct DrWavImporterStreamingTest: AudioImporterTester {
+    explicit DrWavImporterStreamingTest();
+
+    void decode();
+    void seek();
+    void seekOutOfRange();
+};
+
+constexpr struct {
+    const char* name;
+    const char* filename;
+    std::size_t frameSize;
+} DecodeData[]{
+    {"8-bit", "mono8.wav", 1},
+    {"12-bit sliced to 16-bit", "stereo12.wav", 4},
+    {"24-bit converted to float", "mono24.wav", 4},
+    {"A-Law", "stereo8ALaw.wav", 2}
+};
+
+DrWavImporterStreamingTest::DrWavImporterStreamingTest() {
+    addInstancedTests({&DrWavImporterStreamingTest::decode,
+                       &DrWavImporterStreamingTest::seek},
+        Containers::arraySize(DecodeData));
+
+    addTests({&DrWavImporterStreamingTest::seekOutOfRange});
+}
+
+void DrWavImporterStreamingTest::decode() {
+    auto&& data = DecodeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    DrWavImporter reference;
+    CORRADE_VERIFY(reference.openFile(Utility::Directory::join(DRWAVAUDIOIMPORTER_TEST_DIR, data.filename)));
+
+    DrWavImporter importer;
+    importer.configuration().setValue("streaming", true);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(DRWAVAUDIOIMPORTER_TEST_DIR, data.filename)));
+    CORRADE_COMPARE(importer.format(), reference.format());
+    CORRADE_COMPARE(importer.frequency(), reference.frequency());
+
+    verifyDecode(importer, reference.data(), data.frameSize);
+}
+
+void DrWavImporterStreamingTest::seek() {
+    auto&& data = DecodeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    DrWavImporter reference;
+    CORRADE_VERIFY(reference.openFile(Utility::Directory::join(DRWAVAUDIOIMPORTER_TEST_DIR, data.filename)));
+
+    DrWavImporter importer;
+    importer.configuration().setValue("streaming", true);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(DRWAVAUDIOIMPORTER_TEST_DIR, data.filename)));
+
+    verifySeek(importer, reference.data(), data.frameSize, 100);
+}
+
+void DrWavImporterStreamingTest::seekOutOfRange() {
+    DrWavImporter importer;
+    importer.configuration().setValue("streaming", true);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(DRWAVAUDIOIMPORTER_TEST_DIR, "mono8.wav")));
+
+    verifySeekOutOfRange(importer, "DrWavImporter", 2136);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::DrWavImporterStreamingTest)
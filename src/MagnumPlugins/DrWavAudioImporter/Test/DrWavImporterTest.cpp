@@ -29,15 +29,18 @@
 #include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 #include <Magnum/Audio/AbstractImporter.h>
 
+#include "MagnumPlugins/Implementation/Test/AudioImporterTester.h"
+
 #include "configure.h"
 
 namespace Magnum { namespace Audio { namespace Test { namespace {
 
-struct DrWavImporterTest: TestSuite::Tester {
+struct DrWavImporterTest: AudioImporterTester {
     explicit DrWavImporterTest();
 
     void empty();
@@ -83,6 +86,8 @@ struct DrWavImporterTest: TestSuite::Tester {
     void extensions32f();
     void extensions64f();
 
+    void releaseData();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
@@ -130,7 +135,9 @@ DrWavImporterTest::DrWavImporterTest() {
               &DrWavImporterTest::extensions32,
 
               &DrWavImporterTest::extensions32f,
-              &DrWavImporterTest::extensions64f});
+              &DrWavImporterTest::extensions64f,
+
+              &DrWavImporterTest::releaseData});
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
@@ -581,6 +588,14 @@ void DrWavImporterTest::extensions64f() {
         }), TestSuite::Compare::Container);
 }
 
+void DrWavImporterTest::releaseData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("DrWavAudioImporter");
+    importer->configuration().setValue("releaseData", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(DRWAVAUDIOIMPORTER_TEST_DIR, "mono8.wav")));
+
+    verifyReleaseData(*importer, Utility::Directory::join(DRWAVAUDIOIMPORTER_TEST_DIR, "mono8.wav"));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::DrWavImporterTest)
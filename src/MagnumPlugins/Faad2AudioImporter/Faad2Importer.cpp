@@ -25,24 +25,38 @@
 
 #include "Faad2Importer.h"
 
-#include <cstring>
-#include <algorithm>
-#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/ScopeGuard.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Debug.h>
 
 #include <neaacdec.h>
 
 namespace Magnum { namespace Audio {
 
-Faad2Importer::Faad2Importer() = default;
+namespace {
+
+/* FAAD2 wants a mutable pointer even though it doesn't modify the data */
+unsigned char* dataAt(const Containers::ArrayView<const char> data, const std::size_t offset) {
+    return const_cast<unsigned char*>(reinterpret_cast<const unsigned char*>(data.data())) + offset;
+}
+
+}
+
+Faad2Importer::Faad2Importer() {
+    /** @todo horrible workaround, fix this properly */
+    configuration().setValue("releaseData", false);
+}
 
 Faad2Importer::Faad2Importer(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
 ImporterFeatures Faad2Importer::doFeatures() const { return ImporterFeature::OpenData; }
 
-bool Faad2Importer::doIsOpened() const { return !_samples.empty(); }
+/* Not checking for the data being non-empty, as that's also the case after
+   they get released in doData() */
+bool Faad2Importer::doIsOpened() const { return !!_data; }
 
 void Faad2Importer::doOpenData(Containers::ArrayView<const char> data) {
     /* Init the library */
@@ -59,7 +73,7 @@ void Faad2Importer::doOpenData(Containers::ArrayView<const char> data) {
        https://github.com/knik0/faad2/blob/7da4a83b230d069a9d731b1e64f6e6b52802576a/libfaad/decoder.c#L327-L339 */
     unsigned long samplerate = 0;
     unsigned char channels = 0;
-    long result = NeAACDecInit(decoder, const_cast<unsigned char*>(reinterpret_cast<const unsigned char*>(data.data())), data.size(), &samplerate, &channels);
+    long result = NeAACDecInit(decoder, dataAt(data, 0), data.size(), &samplerate, &channels);
     if(result < 0) {
         Error{} << "Audio::Faad2Importer::openData(): can't read file header";
         return;
@@ -78,38 +92,44 @@ void Faad2Importer::doOpenData(Containers::ArrayView<const char> data) {
         return;
     }
 
-    /** @todo do it not via a vector -- is there any way to get the sample
-        count beforehand? the faad fronted does it by manually parsing the
-        headers and NO WAY IN HELL i am doing that here. So be it.
+    /** @todo is there any way to get the sample count beforehand? the faad
+        frontend does it by manually parsing the headers:
         https://github.com/knik0/faad2/blob/7da4a83b230d069a9d731b1e64f6e6b52802576a/frontend/main.c#L613-L630 */
     std::size_t pos = result;
-    std::vector<UnsignedShort> samples;
+    Containers::Array<char> samples;
     while(pos < data.size()) {
         NeAACDecFrameInfo info;
-        void* sampleBuffer = NeAACDecDecode(decoder, &info, const_cast<unsigned char*>(reinterpret_cast<const unsigned char*>(data.data())) + pos, data.size() - pos);
+        void* sampleBuffer = NeAACDecDecode(decoder, &info, dataAt(data, pos), data.size() - pos);
         if(info.error) {
             Error{} << "Audio::Faad2Importer::openData(): decoding error";
             return;
         }
 
-        std::size_t end = samples.size();
-        samples.resize(samples.size() + info.samples);
-        std::copy_n(reinterpret_cast<UnsignedShort*>(sampleBuffer), info.samples, &samples[0] + end);
+        arrayAppend(samples, Containers::arrayView(static_cast<const char*>(sampleBuffer), info.samples*2));
         pos += info.bytesconsumed;
     }
 
-    _samples = std::move(samples);
+    /* Convert the growable array to one with an exact size and a default
+       deleter, so it doesn't waste memory and can be released from doData()
+       without depending on the plugin binary */
+    arrayShrink(samples);
+    _data = std::move(samples);
 }
 
-void Faad2Importer::doClose() { _samples.clear(); }
+void Faad2Importer::doClose() { _data = Containers::NullOpt; }
 
 BufferFormat Faad2Importer::doFormat() const { return _format; }
 
 UnsignedInt Faad2Importer::doFrequency() const { return _frequency; }
 
 Containers::Array<char> Faad2Importer::doData() {
-    Containers::Array<char> copy{NoInit, _samples.size()*2};
-    std::memcpy(copy.begin(), _samples.data(), copy.size());
+    /* Give up the ownership if requested. An empty array is left behind, so
+       the importer stays opened. */
+    if(configuration().value<bool>("releaseData"))
+        return std::move(*_data);
+
+    Containers::Array<char> copy{NoInit, _data->size()};
+    Utility::copy(*_data, copy);
     return copy;
 }
 
@@ -29,7 +29,8 @@
  * @brief Class @ref Magnum::Audio::Faad2Importer
  */
 
-#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
 #include <Magnum/Audio/AbstractImporter.h>
 
 #include "MagnumPlugins/Faad2AudioImporter/configure.h"
@@ -109,6 +110,23 @@ target_link_libraries(your-app PRIVATE MagnumPlugins::Faad2AudioImporter)
 
 See @ref building-plugins, @ref cmake-plugins and @ref plugins for more
 information.
+
+@section Audio-Faad2Importer-data-ownership Data ownership
+
+By default, @ref data() returns a copy of the decoded data. If the
+@cb{.ini} releaseData @ce @ref Audio-Faad2Importer-configuration "configuration option"
+is enabled, the first call moves the data out of the importer instead. See
+@ref audio-importer-data-ownership for more information.
+
+@section Audio-Faad2Importer-configuration Plugin-specific configuration
+
+It's possible to tune various import options through @ref configuration().
+See below for all options and their default values:
+
+@snippet MagnumPlugins/Faad2AudioImporter/Faad2AudioImporter.conf config
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
 */
 class MAGNUM_FAAD2AUDIOIMPORTER_EXPORT Faad2Importer: public AbstractImporter {
     public:
@@ -128,7 +146,7 @@ class MAGNUM_FAAD2AUDIOIMPORTER_EXPORT Faad2Importer: public AbstractImporter {
         MAGNUM_FAAD2AUDIOIMPORTER_LOCAL UnsignedInt doFrequency() const override;
         MAGNUM_FAAD2AUDIOIMPORTER_LOCAL Containers::Array<char> doData() override;
 
-        std::vector<UnsignedShort> _samples;
+        Containers::Optional<Containers::Array<char>> _data;
         BufferFormat _format;
         UnsignedInt _frequency;
 };
@@ -26,6 +26,7 @@
 #include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 #include <Magnum/ImageView.h>
@@ -33,11 +34,13 @@
 #include <Magnum/Audio/AbstractImporter.h>
 #include <Magnum/DebugTools/CompareImage.h>
 
+#include "MagnumPlugins/Implementation/Test/AudioImporterTester.h"
+
 #include "configure.h"
 
 namespace Magnum { namespace Audio { namespace Test { namespace {
 
-class Faad2ImporterTest: public TestSuite::Tester {
+class Faad2ImporterTest: public AudioImporterTester {
     public:
         explicit Faad2ImporterTest();
 
@@ -47,6 +50,8 @@ class Faad2ImporterTest: public TestSuite::Tester {
         void mono();
         void stereo();
 
+        void releaseData();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
@@ -56,7 +61,9 @@ Faad2ImporterTest::Faad2ImporterTest() {
 
               &Faad2ImporterTest::error,
               &Faad2ImporterTest::mono,
-              &Faad2ImporterTest::stereo});
+              &Faad2ImporterTest::stereo,
+
+              &Faad2ImporterTest::releaseData});
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
@@ -141,6 +148,14 @@ void Faad2ImporterTest::stereo() {
         (DebugTools::CompareImage{1.0f, 0.625f}));
 }
 
+void Faad2ImporterTest::releaseData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("Faad2AudioImporter");
+    importer->configuration().setValue("releaseData", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(FAAD2AUDIOIMPORTER_TEST_DIR, "stereo.aac")));
+
+    verifyReleaseData(*importer, Utility::Directory::join(FAAD2AUDIOIMPORTER_TEST_DIR, "stereo.aac"));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::Faad2ImporterTest)
@@ -0,0 +1,85 @@
+#ifndef Magnum_Audio_Implementation_AudioStream_h
+#define Magnum_Audio_Implementation_AudioStream_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Magnum/Magnum.h>
+
+/* Used by the streaming mode of DrFlacAudioImporter, DrMp3AudioImporter,
+   DrWavAudioImporter and StbVorbisAudioImporter. OTOH it doesn't need to be
+   exposed publicly, which is why it has no docblocks. */
+
+namespace Magnum { namespace Audio { namespace Implementation {
+
+/* The decoders keep referencing the file data after the open function exits,
+   so the stream owns a copy of it. The plugins derive from this, add the
+   decoder handle and fill the remaining fields once it's opened. */
+struct AudioStream {
+    explicit AudioStream(const Containers::ArrayView<const char> data): data{NoInit, data.size()} {
+        Utility::copy(data, this->data);
+    }
+
+    Containers::Array<char> data;
+    UnsignedInt channels{};
+    /* Size of a single imported sample */
+    UnsignedInt sampleSize{};
+    UnsignedLong frameCount{};
+};
+
+/* Checks common to all decodeInto() implementations. Returns count of whole
+   frames that fit into the output, or 0 if an assertion failed. */
+inline std::size_t streamFrameCountFor(const AudioStream* const stream, const Containers::ArrayView<char> data, const char* const function) {
+    #ifdef CORRADE_NO_ASSERT
+    static_cast<void>(function);
+    #endif
+    CORRADE_ASSERT(stream,
+        function << "no file opened for streaming", {});
+    const std::size_t frameSize = stream->channels*stream->sampleSize;
+    CORRADE_ASSERT(data.size() >= frameSize,
+        function << "expected at least" << frameSize << "bytes for a frame but got" << data.size(), {});
+    return data.size()/frameSize;
+}
+
+/* Checks common to all seek() implementations. The decoders either clamp
+   the position or fail without saying why, so the range is checked
+   explicitly. */
+inline bool streamSeekInRange(const AudioStream* const stream, const UnsignedLong frame, const char* const function) {
+    CORRADE_ASSERT(stream,
+        function << "no file opened for streaming", {});
+    if(frame >= stream->frameCount) {
+        Error{} << function << "frame" << frame << "out of range for" << stream->frameCount << "frames";
+        return false;
+    }
+
+    return true;
+}
+
+}}}
+
+#endif
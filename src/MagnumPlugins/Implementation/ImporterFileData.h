@@ -0,0 +1,96 @@
+#ifndef Magnum_Trade_Implementation_ImporterFileData_h
+#define Magnum_Trade_Implementation_ImporterFileData_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Directory.h>
+
+/* Used by BasisImporter, DdsImporter, KtxImporter, StanfordImporter and
+   StlImporter to implement the borrowData and memoryMapFile options. The
+   plugins derive their per-file state from this. */
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+/* The file is either copied into an owned array, memory-mapped or, if
+   borrowData is enabled, referenced directly. The data view always points to
+   whichever of these is used. */
+struct ImporterFileData {
+    /* Reads the file into ownedData or, if mapFile is set and memory mapping
+       is supported on given platform, maps it into mappedData. Prints a
+       message and returns false if the file doesn't exist. If the mapping
+       fails, Directory::mapRead() prints a message on its own and the empty
+       view is then caught by the importer. */
+    bool openFile(const std::string& filename, bool mapFile, const char* prefix);
+
+    /* References the memory directly if the user promised to keep it alive,
+       copies it otherwise */
+    void openData(Containers::ArrayView<const char> fileData, bool borrow);
+
+    Containers::Array<char> ownedData;
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Array<const char, Utility::Directory::MapDeleter> mappedData;
+    #endif
+    Containers::ArrayView<const char> data;
+};
+
+inline bool ImporterFileData::openFile(const std::string& filename, const bool mapFile, const char* const prefix) {
+    if(!Utility::Directory::exists(filename)) {
+        Error{} << prefix << "cannot open file" << filename;
+        return false;
+    }
+
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    if(mapFile) {
+        mappedData = Utility::Directory::mapRead(filename);
+        data = Containers::arrayView(mappedData);
+    } else
+    #else
+    static_cast<void>(mapFile);
+    #endif
+    {
+        ownedData = Utility::Directory::read(filename);
+        data = ownedData;
+    }
+
+    return true;
+}
+
+inline void ImporterFileData::openData(const Containers::ArrayView<const char> fileData, const bool borrow) {
+    if(borrow) {
+        data = fileData;
+    } else {
+        ownedData = Containers::Array<char>{NoInit, fileData.size()};
+        Utility::copy(fileData, ownedData);
+        data = ownedData;
+    }
+}
+
+}}}
+
+#endif
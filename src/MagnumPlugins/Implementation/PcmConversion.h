@@ -0,0 +1,109 @@
+#ifndef Magnum_Audio_Implementation_PcmConversion_h
+#define Magnum_Audio_Implementation_PcmConversion_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <Magnum/Magnum.h>
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
+
+/* Used by DrFlacAudioImporter and DrWavAudioImporter, which is why it isn't
+   directly inside a plugin directory. OTOH it doesn't need to be exposed
+   publicly, which is why it has no docblocks. */
+
+namespace Magnum { namespace Audio { namespace Implementation {
+
+/* The decoders produce signed 32-bit samples with the value in the top bits,
+   these convert them to the imported formats. The output doesn't need to be
+   aligned. */
+
+/* Slices 32-bit samples down to 8 bits, which are unsigned */
+inline void s32ToU8(const Int* const in, char* const out, const std::size_t count) {
+    std::size_t i = 0;
+
+    #ifdef CORRADE_TARGET_SSE2
+    /* After the shift the values fit into 8 bits, so the saturating packs
+       don't change them */
+    const __m128i bias = _mm_set1_epi8(char(0x80));
+    for(; i + 16 <= count; i += 16) {
+        const __m128i a = _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i +  0)), 24);
+        const __m128i b = _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i +  4)), 24);
+        const __m128i c = _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i +  8)), 24);
+        const __m128i d = _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12)), 24);
+        const __m128i packed = _mm_packs_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_xor_si128(packed, bias));
+    }
+    #endif
+
+    for(; i != count; ++i)
+        out[i] = char(UnsignedByte(in[i] >> 24) ^ 0x80);
+}
+
+/* Slices 32-bit samples down to 16 bits */
+inline void s32ToS16(const Int* const in, char* const out, const std::size_t count) {
+    std::size_t i = 0;
+
+    #ifdef CORRADE_TARGET_SSE2
+    for(; i + 8 <= count; i += 8) {
+        const __m128i a = _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 0)), 16);
+        const __m128i b = _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 4)), 16);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i*2), _mm_packs_epi32(a, b));
+    }
+    #endif
+
+    for(; i != count; ++i) {
+        const Short value = Short(in[i] >> 16);
+        std::memcpy(out + i*2, &value, 2);
+    }
+}
+
+/* Converts 32-bit samples to floats in the [-1, 1] range. The same as
+   Math::unpack<Float>(), which divides by the maximal value rounded to a
+   float, i.e. 2^31. That's a power of two, so the multiplication gives the
+   same result. */
+inline void s32ToFloat(const Int* const in, char* const out, const std::size_t count) {
+    constexpr Float Scale = 1.0f/2147483648.0f;
+    std::size_t i = 0;
+
+    #ifdef CORRADE_TARGET_SSE2
+    const __m128 scale = _mm_set1_ps(Scale);
+    for(; i + 4 <= count; i += 4) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_ps(reinterpret_cast<Float*>(out + i*4), _mm_mul_ps(_mm_cvtepi32_ps(a), scale));
+    }
+    #endif
+
+    for(; i != count; ++i) {
+        const Float value = Float(in[i])*Scale;
+        std::memcpy(out + i*4, &value, 4);
+    }
+}
+
+}}}
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef Magnum_Trade_Implementation_PixelTransform_h
+#define Magnum_Trade_Implementation_PixelTransform_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Endianness.h>
+#include <Magnum/Magnum.h>
+
+#ifdef CORRADE_TARGET_SSSE3
+#include <tmmintrin.h>
+#endif
+
+/* Used by KtxImporter, KtxImageConverter and DdsImporter, which is why it
+   isn't directly inside KtxImporter.cpp. OTOH it doesn't need to be exposed
+   publicly, which is why it has no docblocks. */
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+/* A BGR(A) to RGB(A) swizzle and/or an endian swap of each channel, applied
+   while copying pixels from one (possibly flipped or padded) view to another.
+   Each combination is a fixed permutation of bytes in a pixel, repeating with
+   a period of the pixel size if swizzling and of the channel type size
+   otherwise. */
+struct PixelTransform {
+    /* Swizzling is allowed only for three- and four-channel pixels */
+    explicit PixelTransform(std::size_t pixelSize, std::size_t typeSize, bool swizzle, bool endianSwap): pixelSize{UnsignedByte(pixelSize)}, typeSize{UnsignedByte(typeSize)}, swizzle{swizzle}, endianSwap{endianSwap && typeSize > 1} {
+        CORRADE_INTERNAL_ASSERT(pixelSize <= 32 && typeSize && pixelSize % typeSize == 0);
+        CORRADE_INTERNAL_ASSERT(!swizzle || pixelSize/typeSize == 3 || pixelSize/typeSize == 4);
+
+        period = UnsignedByte(swizzle ? pixelSize : typeSize);
+        for(std::size_t i = 0; i != period; ++i) {
+            const std::size_t channel = i/typeSize;
+            const std::size_t byte = i%typeSize;
+            permutation[i] = UnsignedByte(
+                (swizzle && channel < 3 ? 2 - channel : channel)*typeSize +
+                (this->endianSwap ? typeSize - 1 - byte : byte));
+        }
+
+        #ifdef CORRADE_TARGET_SSSE3
+        for(std::size_t i = 0; i != 16; ++i)
+            shuffleMask[i] = char(i/period*period + permutation[i%period]);
+        #endif
+    }
+
+    bool isIdentity() const { return !swizzle && !endianSwap; }
+
+    UnsignedByte pixelSize;
+    UnsignedByte typeSize;
+    bool swizzle;
+    bool endianSwap;
+    UnsignedByte period;
+    UnsignedByte permutation[32];
+    #ifdef CORRADE_TARGET_SSSE3
+    /* The permutation repeated over 16 bytes, usable only if the period
+       divides 16 */
+    alignas(16) char shuffleMask[16];
+    #endif
+};
+
+/* The per-pixel operation with everything known at compile time, so the
+   loops calling it get unrolled and, where the target allows, vectorized */
+template<class T, std::size_t channels, bool swizzle, bool endianSwap> inline void transformPixel(const char* const src, char* const dst) {
+    /* Going through a copy makes this work in-place as well */
+    T in[channels];
+    std::memcpy(in, src, sizeof(in));
+    T out[channels];
+    for(std::size_t i = 0; i != channels; ++i) {
+        out[i] = in[swizzle && i < 3 ? 2 - i : i];
+        if(endianSwap) out[i] = Utility::Endianness::swap(out[i]);
+    }
+    std::memcpy(dst, out, sizeof(out));
+}
+
+template<class T, std::size_t channels, bool swizzle, bool endianSwap> void transformPixelsRow(const char* src, const std::ptrdiff_t srcStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    constexpr std::size_t PixelSize = sizeof(T)*channels;
+
+    /* Tightly packed rows get a loop with a compile-time stride, which is
+       what allows the compiler to vectorize it */
+    if(srcStride == std::ptrdiff_t(PixelSize) && dstStride == std::ptrdiff_t(PixelSize)) {
+        for(std::size_t i = 0; i != count; ++i)
+            transformPixel<T, channels, swizzle, endianSwap>(src + i*PixelSize, dst + i*PixelSize);
+    } else for(std::size_t i = 0; i != count; ++i, src += srcStride, dst += dstStride)
+        transformPixel<T, channels, swizzle, endianSwap>(src, dst);
+}
+
+/* Returns the kernel for given transformation. Without a swizzle the pixel
+   is treated as a sequence of single-channel pixels of the type size, which
+   is what the endian swap operates on. */
+typedef void(*PixelsRowFunction)(const char*, std::ptrdiff_t, char*, std::ptrdiff_t, std::size_t);
+template<class T> PixelsRowFunction pixelsRowFunction(const PixelTransform& transform) {
+    const std::size_t channels = transform.pixelSize/sizeof(T);
+    if(!transform.swizzle) {
+        CORRADE_INTERNAL_ASSERT(transform.endianSwap);
+        return transformPixelsRow<T, 1, false, true>;
+    }
+    if(channels == 3) return transform.endianSwap ?
+        transformPixelsRow<T, 3, true, true> :
+        transformPixelsRow<T, 3, true, false>;
+    if(channels == 4) return transform.endianSwap ?
+        transformPixelsRow<T, 4, true, true> :
+        transformPixelsRow<T, 4, true, false>;
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+inline PixelsRowFunction pixelsRowFunction(const PixelTransform& transform) {
+    switch(transform.typeSize) {
+        case 1: return pixelsRowFunction<UnsignedByte>(transform);
+        case 2: return pixelsRowFunction<UnsignedShort>(transform);
+        case 4: return pixelsRowFunction<UnsignedInt>(transform);
+        case 8: return pixelsRowFunction<UnsignedLong>(transform);
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* Copies pixels from src to dst, applying the transformation on the fly. The
+   last dimension is bytes of a single pixel and has to be contiguous in both,
+   the other dimensions can have arbitrary (including negative) strides, so
+   an axis flip is done by passing a flipped src view. The views can also
+   point to the same memory for an in-place operation, as long as they aren't
+   flipped relative to each other. */
+inline void transformPixels(const PixelTransform& transform, const Containers::StridedArrayView4D<const char>& src, const Containers::StridedArrayView4D<char>& dst) {
+    CORRADE_INTERNAL_ASSERT(src.size() == dst.size());
+    CORRADE_INTERNAL_ASSERT(src.size()[3] == transform.pixelSize);
+    CORRADE_INTERNAL_ASSERT(src.stride()[3] == 1 && dst.stride()[3] == 1);
+
+    /* Nothing to transform, only copy. With no flips and no padding this is a
+       single memcpy(). */
+    if(transform.isIdentity()) {
+        if(src.data() != dst.data()) Utility::copy(src, dst);
+        return;
+    }
+
+    const PixelsRowFunction rowFunction = pixelsRowFunction(transform);
+    const std::size_t width = src.size()[2];
+    const std::size_t rowSize = width*transform.pixelSize;
+    const std::size_t pixelCount = width*transform.pixelSize/transform.period;
+
+    for(std::size_t z = 0; z != src.size()[0]; ++z) {
+        for(std::size_t y = 0; y != src.size()[1]; ++y) {
+            const char* const srcRow = static_cast<const char*>(src[z][y].data());
+            char* const dstRow = static_cast<char*>(dst[z][y].data());
+            const bool contiguous =
+                src.stride()[2] == std::ptrdiff_t(transform.pixelSize) &&
+                dst.stride()[2] == std::ptrdiff_t(transform.pixelSize);
+
+            std::size_t done = 0;
+            #ifdef CORRADE_TARGET_SSSE3
+            /* If the permutation repeats within 16 bytes, do the row 16 bytes
+               at a time with a single byte shuffle, the rest is done below */
+            if(contiguous && 16 % transform.period == 0) {
+                const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(transform.shuffleMask));
+                for(; done + 16 <= rowSize; done += 16) {
+                    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(srcRow + done));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dstRow + done), _mm_shuffle_epi8(in, mask));
+                }
+            }
+            #endif
+
+            if(contiguous) rowFunction(srcRow + done, transform.period,
+                dstRow + done, transform.period, pixelCount - done/transform.period);
+            else if(!transform.swizzle) {
+                /* Endian swap of a non-contiguous row, go pixel by pixel and
+                   swap all channels of each */
+                for(std::size_t x = 0; x != width; ++x)
+                    rowFunction(srcRow + x*src.stride()[2], transform.typeSize,
+                        dstRow + x*dst.stride()[2], transform.typeSize,
+                        transform.pixelSize/transform.typeSize);
+            } else rowFunction(srcRow, src.stride()[2],
+                dstRow, dst.stride()[2], width);
+        }
+    }
+}
+
+}}}
+
+#endif
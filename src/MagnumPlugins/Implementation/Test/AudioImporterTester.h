@@ -0,0 +1,133 @@
+#ifndef Magnum_Audio_Test_AudioImporterTester_h
+#define Magnum_Audio_Test_AudioImporterTester_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Magnum/Magnum.h>
+#include <Magnum/Audio/BufferFormat.h>
+#include <Magnum/Math/Functions.h>
+
+/* Shared by the tests of DrFlacAudioImporter, DrMp3AudioImporter,
+   DrWavAudioImporter, Faad2AudioImporter and StbVorbisAudioImporter. The
+   plugin-specific tests open the files and then pass the importers to
+   these. */
+
+namespace Magnum { namespace Audio { namespace Test {
+
+struct AudioImporterTester: TestSuite::Tester {
+    /* Decodes the whole stream in chunks and compares the result to data()
+       of a non-streaming importer */
+    template<class Importer> void verifyDecode(Importer& importer, Containers::ArrayView<const char> expected, std::size_t frameSize);
+
+    /* Decodes a chunk, seeks to given frame and then back to the start,
+       comparing what's decoded after each seek */
+    template<class Importer> void verifySeek(Importer& importer, Containers::ArrayView<const char> expected, std::size_t frameSize, UnsignedLong frame);
+
+    /* Seeking right past the end should fail */
+    template<class Importer> void verifySeekOutOfRange(Importer& importer, const char* name, UnsignedLong frameCount);
+
+    /* Calls data() on an importer with releaseData enabled and verifies that
+       it stays opened, with the data available again after reopening */
+    template<class Importer> void verifyReleaseData(Importer& importer, const std::string& filename);
+};
+
+template<class Importer> void AudioImporterTester::verifyDecode(Importer& importer, const Containers::ArrayView<const char> expected, const std::size_t frameSize) {
+    /* Chunk size deliberately not a multiple of the frame size, only whole
+       frames should be written */
+    Containers::Array<char> decoded;
+    char chunk[1001];
+    while(const std::size_t size = importer.decodeInto(chunk)) {
+        CORRADE_COMPARE(size % frameSize, 0);
+        arrayAppend(decoded, Containers::arrayView(chunk).prefix(size));
+    }
+
+    CORRADE_COMPARE_AS(Containers::arrayView(decoded), expected,
+        TestSuite::Compare::Container);
+
+    /* The stream position shouldn't affect data() */
+    CORRADE_COMPARE_AS(importer.data(), expected,
+        TestSuite::Compare::Container);
+}
+
+template<class Importer> void AudioImporterTester::verifySeek(Importer& importer, const Containers::ArrayView<const char> expected, const std::size_t frameSize, const UnsignedLong frame) {
+    const std::size_t frameCount = expected.size()/frameSize;
+    CORRADE_VERIFY(frame < frameCount);
+
+    char chunk[64];
+    const std::size_t chunkFrameCount = Containers::arraySize(chunk)/frameSize;
+    const std::size_t startSize = Math::min(chunkFrameCount, frameCount)*frameSize;
+
+    /* Decode something first so the seek isn't from the start */
+    CORRADE_COMPARE(importer.decodeInto(chunk), startSize);
+
+    CORRADE_VERIFY(importer.seek(frame));
+    const std::size_t size = Math::min<std::size_t>(chunkFrameCount, frameCount - frame)*frameSize;
+    CORRADE_COMPARE(importer.decodeInto(chunk), size);
+    CORRADE_COMPARE_AS(Containers::arrayView(chunk).prefix(size),
+        expected.slice(frame*frameSize, frame*frameSize + size),
+        TestSuite::Compare::Container);
+
+    /* Back to the start */
+    CORRADE_VERIFY(importer.seek(0));
+    CORRADE_COMPARE(importer.decodeInto(chunk), startSize);
+    CORRADE_COMPARE_AS(Containers::arrayView(chunk).prefix(startSize),
+        expected.prefix(startSize),
+        TestSuite::Compare::Container);
+}
+
+template<class Importer> void AudioImporterTester::verifySeekOutOfRange(Importer& importer, const char* const name, const UnsignedLong frameCount) {
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.seek(frameCount));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Audio::{0}::seek(): frame {1} out of range for {1} frames\n", name, frameCount));
+}
+
+template<class Importer> void AudioImporterTester::verifyReleaseData(Importer& importer, const std::string& filename) {
+    const BufferFormat format = importer.format();
+    const Containers::Array<char> data = importer.data();
+    CORRADE_VERIFY(!data.empty());
+
+    /* The data got moved out, but the importer stays opened */
+    CORRADE_VERIFY(importer.isOpened());
+    CORRADE_COMPARE(importer.format(), format);
+    CORRADE_VERIFY(importer.data().empty());
+
+    /* Opening the file again makes the same data available again */
+    CORRADE_VERIFY(importer.openFile(filename));
+    CORRADE_COMPARE_AS(importer.data(),
+        Containers::arrayView(data),
+        TestSuite::Compare::Container);
+}
+
+}}}
+
+#endif
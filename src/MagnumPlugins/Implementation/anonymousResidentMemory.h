@@ -0,0 +1,60 @@
+#ifndef Magnum_Trade_Implementation_anonymousResidentMemory_h
+#define Magnum_Trade_Implementation_anonymousResidentMemory_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Used by the importer benchmarks to compare memory use of the copying and
+   zero-copy code paths, which is why it isn't in any of them. Not used by the
+   plugins themselves. */
+
+#ifdef __linux__
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+/* Anonymous (i.e., heap-allocated) resident memory of the process, in bytes.
+   Memory-mapped file pages are accounted separately as RssFile and thus not
+   included. Returns 0 if the value can't be read. */
+inline std::uint64_t anonymousResidentMemory() {
+    std::ifstream in{"/proc/self/status"};
+    std::string line;
+    while(std::getline(in, line)) {
+        if(line.find("RssAnon:") != 0) continue;
+        std::istringstream value{line.substr(9)};
+        std::uint64_t kilobytes;
+        value >> kilobytes;
+        return kilobytes*1024;
+    }
+
+    return 0;
+}
+
+}}}
+#endif
+
+#endif
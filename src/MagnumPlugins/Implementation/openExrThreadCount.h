@@ -0,0 +1,56 @@
+#ifndef Magnum_Trade_Implementation_openExrThreadCount_h
+#define Magnum_Trade_Implementation_openExrThreadCount_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <thread>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Magnum/Magnum.h>
+
+/* See OpenExrImporter.cpp for why it's not <OpenEXR/ImfThreading.h> */
+#include <ImfThreading.h>
+
+/* Used by OpenExrImporter and OpenExrImageConverter, which is why it isn't
+   directly inside either of them */
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+/* OpenEXR decompresses and compresses lines or tiles in parallel using a
+   global thread pool, the thread count passed to a file only says how many of
+   them it can have in flight at once. The pool is grown if it isn't large
+   enough for the requested count, but never shrunk, to not affect other code
+   using the library at the same time. Returns the count to pass to the file
+   constructors, with 0 meaning everything is done on the calling thread. */
+inline int openExrThreadCount(const Utility::ConfigurationGroup& configuration) {
+    Int count = configuration.value<Int>("threads");
+    if(count == 0) count = std::thread::hardware_concurrency();
+    if(count <= 1) return 0;
+    if(Imf::globalThreadCount() < count) Imf::setGlobalThreadCount(count);
+    return count;
+}
+
+}}}
+
+#endif
@@ -27,6 +27,7 @@
 
 #include <csetjmp>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
 #include <Magnum/ImageView.h>
 #include <Magnum/PixelFormat.h>
@@ -56,12 +57,32 @@ namespace Magnum { namespace Trade {
 JpegImageConverter::JpegImageConverter() {
     /** @todo horrible workaround, fix this properly */
     configuration().setValue("jpegQuality", 0.8f);
+    configuration().setValue("fastDct", false);
+    configuration().setValue("optimizeHuffman", false);
+    configuration().setValue("progressive", false);
 }
 
 JpegImageConverter::JpegImageConverter(PluginManager::AbstractManager& manager, std::string plugin): AbstractImageConverter(manager, std::move(plugin)) {}
 
 ImageConverterFeatures JpegImageConverter::doFeatures() const { return ImageConverterFeature::Convert2DToData; }
 
+namespace {
+
+/* Initial size of the output buffer. Allocating the worst case, like
+   tjBufSize() in libjpeg-turbo does, would mean keeping around 10 to 50 times
+   more memory than the encoded image needs. An eighth of the input size plus
+   space for the headers is enough for typical images with the default
+   quality, anything that compresses worse grows the buffer while encoding. */
+std::size_t encodedSizeEstimate(const jpeg_compress_struct& info) {
+    /* The image is too large and jpeg_start_compress() will fail on it right
+       after, don't allocate anything huge in that case */
+    if(info.image_width > JPEG_MAX_DIMENSION || info.image_height > JPEG_MAX_DIMENSION)
+        return 1;
+
+    return std::size_t(info.image_width)*info.image_height*info.input_components/8 + 2048;
+}
+
+
 Containers::Array<char> JpegImageConverter::doConvertToData(const ImageView2D& image) {
     static_assert(BITS_IN_JSAMPLE == 8, "Only 8-bit JPEG is supported");
 
@@ -96,11 +117,11 @@ Containers::Array<char> JpegImageConverter::doConvertToData(const ImageView2D& i
     jpeg_compress_struct info;
     struct DestinationManager {
         jpeg_destination_mgr jpegDestinationManager;
-        std::string output;
+        Containers::Array<char> output;
+        std::size_t size;
     } destinationManager;
 
     Containers::Array<JSAMPROW> rows;
-    Containers::Array<char> data;
 
     /* Fugly error handling stuff */
     /** @todo Get rid of this crap */
@@ -126,19 +147,21 @@ Containers::Array<char> JpegImageConverter::doConvertToData(const ImageView2D& i
     info.dest = reinterpret_cast<jpeg_destination_mgr*>(&destinationManager);
     info.dest->init_destination = [](j_compress_ptr info) {
         auto& destinationManager = *reinterpret_cast<DestinationManager*>(info->dest);
-        destinationManager.output.resize(1); /* It crashes if the buffer has zero free space */
-        info->dest->next_output_byte = reinterpret_cast<JSAMPLE*>(&destinationManager.output[0]);
+        info->dest->next_output_byte = reinterpret_cast<JSAMPLE*>(destinationManager.output.data());
         info->dest->free_in_buffer = destinationManager.output.size()/sizeof(JSAMPLE);
     };
     info.dest->term_destination = [](j_compress_ptr info) {
         auto& destinationManager = *reinterpret_cast<DestinationManager*>(info->dest);
-        destinationManager.output.resize(destinationManager.output.size() - info->dest->free_in_buffer);
+        destinationManager.size = destinationManager.output.size() - info->dest->free_in_buffer;
     };
     info.dest->empty_output_buffer = [](j_compress_ptr info) -> boolean {
+        /* The whole buffer is full at this point, double the capacity */
         auto& destinationManager = *reinterpret_cast<DestinationManager*>(info->dest);
         const std::size_t oldSize = destinationManager.output.size();
-        destinationManager.output.resize(oldSize*2); /* Double capacity each time it is exceeded */
-        info->dest->next_output_byte = reinterpret_cast<JSAMPLE*>(&destinationManager.output[0] + oldSize);
+        Containers::Array<char> output{NoInit, oldSize*2};
+        Utility::copy(destinationManager.output, output.prefix(oldSize));
+        destinationManager.output = std::move(output);
+        info->dest->next_output_byte = reinterpret_cast<JSAMPLE*>(destinationManager.output.data() + oldSize);
         info->dest->free_in_buffer = (destinationManager.output.size() - oldSize)/sizeof(JSAMPLE);
         return boolean(true);
     };
@@ -151,6 +174,14 @@ Containers::Array<char> JpegImageConverter::doConvertToData(const ImageView2D& i
 
     jpeg_set_defaults(&info);
     jpeg_set_quality(&info, Int(configuration().value<Float>("jpegQuality")*100.0f), boolean(true));
+    if(configuration().value<bool>("fastDct"))
+        info.dct_method = JDCT_IFAST;
+    if(configuration().value<bool>("optimizeHuffman"))
+        info.optimize_coding = boolean(true);
+    if(configuration().value<bool>("progressive"))
+        jpeg_simple_progression(&info);
+
+    destinationManager.output = Containers::Array<char>{NoInit, encodedSizeEstimate(info)};
     jpeg_start_compress(&info, boolean(true));
 
     /* Get data properties and calculate the initial slice based on subimage
@@ -158,20 +189,34 @@ Containers::Array<char> JpegImageConverter::doConvertToData(const ImageView2D& i
     const std::pair<Math::Vector2<std::size_t>, Math::Vector2<std::size_t>> dataProperties = image.dataProperties();
     Containers::ArrayView<const char> inputData = image.data().suffix(dataProperties.first.sum());
 
-    while(info.next_scanline < info.image_height) {
-        /* libJPEG HAVE YOU EVER HEARD ABOUT CONST ARGUMENTS?! IT'S NOT 1978
-           ANYMORE */
-        JSAMPROW row = reinterpret_cast<JSAMPROW>(const_cast<char*>(inputData.suffix((image.size().y() - info.next_scanline - 1)*dataProperties.second.x()).data()));
-        jpeg_write_scanlines(&info, &row, 1);
-    }
+    /* Pointers to all input rows in the order they get encoded, i.e. from the
+       last to the first, as the image is Y-flipped. libJPEG HAVE YOU EVER
+       HEARD ABOUT CONST ARGUMENTS?! IT'S NOT 1978 ANYMORE */
+    rows = Containers::Array<JSAMPROW>{NoInit, std::size_t(image.size().y())};
+    for(std::size_t i = 0; i != rows.size(); ++i)
+        rows[i] = reinterpret_cast<JSAMPROW>(const_cast<char*>(inputData.suffix((image.size().y() - i - 1)*dataProperties.second.x()).data()));
+
+    /* Pass all rows at once, the encoder takes as many as it can in each
+       call */
+    while(info.next_scanline < info.image_height)
+        jpeg_write_scanlines(&info, rows + info.next_scanline, info.image_height - info.next_scanline);
 
     jpeg_finish_compress(&info);
     jpeg_destroy_compress(&info);
 
-    /* Copy the string into the output array (I would kill for having std::string::release()) */
-    Containers::Array<char> fileData{NoInit, destinationManager.output.size()};
-    std::copy(destinationManager.output.begin(), destinationManager.output.end(), fileData.data());
-    return fileData;
+    /* If at least half of the buffer got used, return it without copying,
+       only with the size cut to what was actually written. The deleter gets
+       the reduced size, which is fine for a trivial type. Otherwise copy to an
+       exactly sized array to not keep the unused part alive. */
+    const std::size_t size = destinationManager.size;
+    if(size >= destinationManager.output.size()/2) {
+        const auto deleter = destinationManager.output.deleter();
+        return Containers::Array<char>{destinationManager.output.release(), size, deleter};
+    }
+
+    Containers::Array<char> output{NoInit, size};
+    Utility::copy(destinationManager.output.prefix(size), output);
+    return output;
 }
 
 }}
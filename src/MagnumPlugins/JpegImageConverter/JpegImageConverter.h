@@ -122,6 +122,17 @@ implementations:
 -   [MozJPEG](https://github.com/mozilla/mozjpeg), optimized for quality/size
     ratio, though generally much slower than libjpeg-turbo
 
+@subsection Trade-JpegImageConverter-behavior-size-speed Size and speed tradeoffs
+
+The output is written into a buffer allocated upfront with an estimated size
+that grows if the image compresses worse, and all rows are passed to the
+encoder at once. The buffer is returned without copying if most of it got
+used, otherwise the output is copied into an exactly sized array. By default a baseline JPEG with the default Huffman tables
+and an accurate DCT is produced. The @cb{.ini} fastDct @ce,
+@cb{.ini} optimizeHuffman @ce and @cb{.ini} progressive @ce
+@ref Trade-JpegImageConverter-configuration "configuration options" make it
+possible to trade the output size against the encoding speed.
+
 @subsection Trade-JpegImageConverter-behavior-arithmetic-coding Arithmetic JPEG encoding
 
 Libjpeg has a switch to enable [arithmetic coding](https://en.wikipedia.org/wiki/Arithmetic_coding)
@@ -27,6 +27,7 @@
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Magnum/ImageView.h>
@@ -47,6 +48,20 @@
 
 namespace Magnum { namespace Trade { namespace Test { namespace {
 
+constexpr struct {
+    const char* name;
+    const char* option;
+    /* Start of frame marker, 0xc0 for baseline and 0xc2 for progressive */
+    char startOfFrame;
+    /* Huffman optimization is lossless, so the decoded data are exactly the
+       same as with the default setting */
+    bool sameAsDefault;
+} EncodingOptionsData[]{
+    {"fast DCT", "fastDct", '\xc0', false},
+    {"optimized Huffman", "optimizeHuffman", '\xc0', true},
+    {"progressive", "progressive", '\xc2', false}
+};
+
 struct JpegImageConverterTest: TestSuite::Tester {
     explicit JpegImageConverterTest();
 
@@ -61,6 +76,10 @@ struct JpegImageConverterTest: TestSuite::Tester {
     void grayscale80Percent();
     void grayscale100Percent();
 
+    void encodingOptions();
+
+    void outputBufferGrowth();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImageConverter> _converterManager{"nonexistent"};
     PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
@@ -78,6 +97,11 @@ JpegImageConverterTest::JpegImageConverterTest() {
               &JpegImageConverterTest::grayscale80Percent,
               &JpegImageConverterTest::grayscale100Percent});
 
+    addInstancedTests({&JpegImageConverterTest::encodingOptions},
+        Containers::arraySize(EncodingOptionsData));
+
+    addTests({&JpegImageConverterTest::outputBufferGrowth});
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
     #ifdef JPEGIMAGECONVERTER_PLUGIN_FILENAME
@@ -381,6 +405,92 @@ void JpegImageConverterTest::grayscale100Percent() {
         (DebugTools::CompareImage{1.0f, 0.085f}));
 }
 
+void JpegImageConverterTest::encodingOptions() {
+    auto&& data = EncodingOptionsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("JpegImageConverter");
+    const auto defaultData = converter->convertToData(OriginalRgb);
+    CORRADE_VERIFY(defaultData);
+
+    converter->configuration().setValue(data.option, true);
+    const auto optionData = converter->convertToData(OriginalRgb);
+    CORRADE_VERIFY(optionData);
+
+    /* Find the start of frame marker, which is after the quantization
+       tables */
+    char startOfFrame = 0;
+    for(std::size_t i = 0; i + 1 < optionData.size(); ++i) {
+        if(optionData[i] == '\xff' && (optionData[i + 1] == '\xc0' || optionData[i + 1] == '\xc2')) {
+            startOfFrame = optionData[i + 1];
+            break;
+        }
+    }
+    CORRADE_COMPARE(startOfFrame, data.startOfFrame);
+
+    /* Optimized Huffman tables can't make the file larger */
+    if(data.sameAsDefault)
+        CORRADE_COMPARE_AS(optionData.size(), defaultData.size(),
+            TestSuite::Compare::LessOrEqual);
+
+    if(_importerManager.loadState("JpegImporter") == PluginManager::LoadState::NotFound)
+        CORRADE_SKIP("JpegImporter plugin not found, cannot test");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("JpegImporter");
+    CORRADE_VERIFY(importer->openData(optionData));
+    Containers::Optional<Trade::ImageData2D> converted = importer->image2D(0);
+    CORRADE_VERIFY(converted);
+    CORRADE_COMPARE(converted->size(), Vector2i(6, 4));
+    CORRADE_COMPARE(converted->format(), PixelFormat::RGB8Unorm);
+
+    if(!data.sameAsDefault) return;
+
+    /* The image has four-byte aligned rows, clear the padding to deterministic
+       values */
+    CORRADE_COMPARE(converted->mutableData().size(), 80);
+    converted->mutableData()[18] = converted->mutableData()[19] =
+        converted->mutableData()[38] = converted->mutableData()[39] =
+            converted->mutableData()[58] = converted->mutableData()[59] =
+                converted->mutableData()[78] = converted->mutableData()[79] = 0;
+
+    CORRADE_COMPARE_AS(converted->data(), Containers::arrayView(ConvertedRgbData),
+        TestSuite::Compare::Container);
+}
+
+void JpegImageConverterTest::outputBufferGrowth() {
+    /* Noise doesn't compress well, with 100% quality it takes more than twice
+       the initial output buffer size, which is an eighth of the input plus
+       2 kB, so the buffer has to grow twice. Grayscale, as chroma subsampling
+       would make the noise unrecognizable after decoding. */
+    Containers::Array<char> noise{NoInit, 64*64};
+    UnsignedInt seed = 1;
+    for(char& i: noise) {
+        seed = seed*1103515245u + 12345u;
+        i = char(seed >> 24);
+    }
+    const ImageView2D image{PixelFormat::R8Unorm, {64, 64}, noise};
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("JpegImageConverter");
+    converter->configuration().setValue("jpegQuality", 1.0f);
+    const auto data = converter->convertToData(image);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE_AS(data.size(), 2*(64*64/8 + 2048),
+        TestSuite::Compare::Greater);
+
+    if(_importerManager.loadState("JpegImporter") == PluginManager::LoadState::NotFound)
+        CORRADE_SKIP("JpegImporter plugin not found, cannot test");
+
+    /* The whole output got preserved across the reallocations */
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("JpegImporter");
+    CORRADE_VERIFY(importer->openData(data));
+    Containers::Optional<Trade::ImageData2D> converted = importer->image2D(0);
+    CORRADE_VERIFY(converted);
+    CORRADE_COMPARE(converted->size(), Vector2i(64, 64));
+    CORRADE_COMPARE(converted->format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE_WITH(*converted, image,
+        (DebugTools::CompareImage{2.0f, 0.25f}));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::JpegImageConverterTest)
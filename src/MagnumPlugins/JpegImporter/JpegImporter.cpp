@@ -28,8 +28,12 @@
 #include <csetjmp>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Debug.h>
 #include <Magnum/PixelFormat.h>
+#include <Magnum/Math/ConfigurationValue.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Vector4.h>
 #include <Magnum/Trade/ImageData.h>
 
 #ifdef CORRADE_TARGET_WINDOWS
@@ -54,7 +58,11 @@
 
 namespace Magnum { namespace Trade {
 
-JpegImporter::JpegImporter() = default;
+JpegImporter::JpegImporter() {
+    /** @todo horrible workaround, fix this properly */
+    configuration().setValue("scale", 1);
+    configuration().setValue("crop", "");
+}
 
 JpegImporter::JpegImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
@@ -86,9 +94,18 @@ void JpegImporter::doOpenData(const Containers::ArrayView<const char> data) {
 UnsignedInt JpegImporter::doImage2DCount() const { return 1; }
 
 Containers::Optional<ImageData2D> JpegImporter::doImage2D(UnsignedInt, UnsignedInt) {
+    const UnsignedInt scale = configuration().value<UnsignedInt>("scale");
+    if(scale != 1 && scale != 2 && scale != 4 && scale != 8) {
+        Error{} << "Trade::JpegImporter::image2D(): expected scale to be 1, 2, 4 or 8 but got" << scale;
+        return Containers::NullOpt;
+    }
+
     /* Initialize structures */
     jpeg_decompress_struct file;
     Containers::Array<char> data;
+    Containers::Array<JSAMPROW> rows;
+    Containers::Array<char> scratch;
+    Containers::Array<JSAMPROW> scratchRows;
 
     /* Fugly error handling stuff */
     /** @todo Get rid of this crap */
@@ -116,12 +133,16 @@ Containers::Optional<ImageData2D> JpegImporter::doImage2D(UnsignedInt, UnsignedI
     /* Read file header, start decompression. On macOS (Travis, with Xcode 7.3)
        the compilation fails because "no known conversion from 'bool' to
        'boolean' for 2nd argument" (boolean is an enum instead of a typedef to
-       int there) so doing the conversion implicitly. */
+       int there) so doing the conversion implicitly. The scaling is done in
+       the DCT domain, the output size is calculated by
+       jpeg_start_decompress(). */
     jpeg_read_header(&file, boolean(true));
+    file.scale_num = 1;
+    file.scale_denom = scale;
     jpeg_start_decompress(&file);
 
     /* Image size and type */
-    const Vector2i size(file.output_width, file.output_height);
+    const Vector2i imageSize(file.output_width, file.output_height);
     static_assert(BITS_IN_JSAMPLE == 8, "Only 8-bit JPEG is supported");
 
     /* Image format */
@@ -140,21 +161,87 @@ Containers::Optional<ImageData2D> JpegImporter::doImage2D(UnsignedInt, UnsignedI
 
         default:
             Error() << "Trade::JpegImporter::image2D(): unsupported color space" << file.out_color_space;
+            jpeg_destroy_decompress(&file);
             return Containers::NullOpt;
     }
 
+    /* Region to decode. The offset is bottom-up as is usual in Magnum, while
+       JPEG scanlines go from the top. */
+    Vector2i offset;
+    Vector2i size = imageSize;
+    if(!configuration().value("crop").empty()) {
+        const Vector4i crop = configuration().value<Vector4i>("crop");
+        if((crop.xy() < Vector2i{0}).any() || (crop.zw() <= Vector2i{0}).any() || (crop.xy() + crop.zw() > imageSize).any()) {
+            Error{} << "Trade::JpegImporter::image2D(): crop rectangle" << crop << "out of bounds for an image of size" << imageSize;
+            jpeg_destroy_decompress(&file);
+            return Containers::NullOpt;
+        }
+
+        offset = crop.xy();
+        size = crop.zw();
+    }
+    const JDIMENSION firstScanline = imageSize.y() - offset.y() - size.y();
+    const JDIMENSION endScanline = firstScanline + size.y();
+
+    /* With libjpeg-turbo, make the decoder produce only the columns that are
+       needed. It widens the range to a multiple of the iMCU width, so the
+       decoded rows may still contain a few extra pixels on both sides.
+       Scanlines above the region are skipped, which avoids decoding them
+       where possible. The skip can end up shorter than requested, the
+       remaining scanlines are then decoded and thrown away below. */
+    JDIMENSION decodedOffsetX = 0;
+    JDIMENSION skippedScanlines = 0;
+    #if defined(LIBJPEG_TURBO_VERSION_NUMBER) && LIBJPEG_TURBO_VERSION_NUMBER >= 1005000
+    if(size.x() != imageSize.x()) {
+        decodedOffsetX = offset.x();
+        JDIMENSION decodedWidth = size.x();
+        jpeg_crop_scanline(&file, &decodedOffsetX, &decodedWidth);
+    }
+    if(firstScanline) skippedScanlines = jpeg_skip_scanlines(&file, firstScanline);
+    #endif
+
     /* Initialize data array, align rows to four bytes */
-    const std::size_t stride = ((size.x()*file.out_color_components*BITS_IN_JSAMPLE/8 + 3)/4)*4;
+    const std::size_t pixelSize = file.out_color_components*BITS_IN_JSAMPLE/8;
+    const std::size_t rowSize = size.x()*pixelSize;
+    const std::size_t stride = ((rowSize + 3)/4)*4;
     data = Containers::Array<char>{stride*std::size_t(size.y())};
 
-    /* Read image row by row */
-    while(file.output_scanline < file.output_height) {
-        JSAMPROW row = reinterpret_cast<JSAMPROW>(data.data() + (size.y() - file.output_scanline - 1)*stride);
-        jpeg_read_scanlines(&file, &row, 1);
+    /* Output rows in the order they get decoded, i.e. from the last to the
+       first, as the image is Y-flipped */
+    rows = Containers::Array<JSAMPROW>{NoInit, std::size_t(size.y())};
+    for(std::size_t i = 0; i != rows.size(); ++i)
+        rows[i] = reinterpret_cast<JSAMPROW>(data.data() + (size.y() - i - 1)*stride);
+
+    /* If the decoded rows are wider than the region or the scanlines above it
+       couldn't be skipped, decode to a scratch buffer first and copy just the
+       region from there. Otherwise decode directly to the output. */
+    const std::size_t decodedRowSize = file.output_width*pixelSize;
+    const std::size_t decodedRowOffset = (offset.x() - decodedOffsetX)*pixelSize;
+    if(decodedRowSize != rowSize || skippedScanlines != firstScanline) {
+        scratch = Containers::Array<char>{NoInit, decodedRowSize*file.rec_outbuf_height};
+        scratchRows = Containers::Array<JSAMPROW>{NoInit, std::size_t(file.rec_outbuf_height)};
+        for(std::size_t i = 0; i != scratchRows.size(); ++i)
+            scratchRows[i] = reinterpret_cast<JSAMPROW>(scratch.data() + i*decodedRowSize);
+    }
+
+    /* Read as many scanlines at once as the decoder can give */
+    while(file.output_scanline < endScanline) {
+        if(scratch) {
+            const JDIMENSION first = file.output_scanline;
+            const JDIMENSION count = jpeg_read_scanlines(&file, scratchRows, Math::min(JDIMENSION(scratchRows.size()), endScanline - first));
+            for(JDIMENSION i = 0; i != count; ++i) {
+                if(first + i < firstScanline) continue;
+                Utility::copy(scratch.slice(i*decodedRowSize + decodedRowOffset, i*decodedRowSize + decodedRowOffset + rowSize),
+                    Containers::arrayView(reinterpret_cast<char*>(rows[first + i - firstScanline]), rowSize));
+            }
+        } else jpeg_read_scanlines(&file, rows + (file.output_scanline - firstScanline), endScanline - file.output_scanline);
     }
 
-    /* Cleanup */
-    jpeg_finish_decompress(&file);
+    /* Cleanup. Finishing the decompression would fail if the region doesn't
+       include the last scanline, destroying the decompressor is enough in that
+       case. */
+    if(file.output_scanline == file.output_height)
+        jpeg_finish_decompress(&file);
     jpeg_destroy_decompress(&file);
 
     /* Always using the default 4-byte alignment */
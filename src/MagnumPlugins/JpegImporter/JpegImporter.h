@@ -104,11 +104,41 @@ target_link_libraries(your-app PRIVATE MagnumPlugins::JpegImporter)
 See @ref building-plugins, @ref cmake-plugins, @ref plugins and
 @ref file-formats for more information.
 
+@section Trade-JpegImporter-behavior Behavior and limitations
+
+@subsection Trade-JpegImporter-behavior-scaling Scaled and cropped decoding
+
+If only a preview of the image is needed, the image can be decoded at
+@f$ \frac{1}{2} @f$, @f$ \frac{1}{4} @f$ or @f$ \frac{1}{8} @f$ of its
+original size using the @cb{.ini} scale @ce
+@ref Trade-JpegImporter-configuration "configuration option". The scaling is
+done directly in the frequency domain as a part of the decoding, which makes
+it several times faster and proportionally less memory-hungry than decoding
+the whole image and scaling it down afterwards.
+
+The @cb{.ini} crop @ce option restricts the decoding to a rectangular region of
+the (possibly scaled) image, with the offset specified from the bottom left
+corner as is usual in Magnum. With [libjpeg-turbo](https://libjpeg-turbo.org/)
+1.5 and newer the scanlines above the region are skipped and the columns
+outside of it aren't decoded except for what's needed to fill a whole block.
+With other implementations the scanlines above the region are decoded and
+thrown away and the decoding stops after the last scanline of the region.
+
 @section Trade-JpegImporter-implementations libJPEG implementations
 
 While some systems (such as macOS) still ship only with the vanilla libJPEG,
 you can get a much better decoding performance by using
 [libjpeg-turbo](https://libjpeg-turbo.org/).
+
+@section Trade-JpegImporter-configuration Plugin-specific configuration
+
+It's possible to tune various import options through @ref configuration().
+See below for all options and their default values:
+
+@snippet MagnumPlugins/JpegImporter/JpegImporter.conf config
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
 */
 class MAGNUM_JPEGIMPORTER_EXPORT JpegImporter: public AbstractImporter {
     public:
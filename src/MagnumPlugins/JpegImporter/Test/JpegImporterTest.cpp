@@ -25,16 +25,26 @@
 
 #include <sstream>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
 #include <Magnum/PixelFormat.h>
+#include <Magnum/Math/ConfigurationValue.h>
+#include <Magnum/Math/Vector4.h>
 #include <Magnum/Trade/AbstractImporter.h>
 #include <Magnum/Trade/ImageData.h>
 
 #include "configure.h"
 
+/* The plugin class is accessible only when linking to the plugin directly */
+#ifndef JPEGIMPORTER_PLUGIN_FILENAME
+#include "MagnumPlugins/JpegImporter/JpegImporter.h"
+#endif
+
 namespace Magnum { namespace Trade { namespace Test { namespace {
 
 struct JpegImporterTest: TestSuite::Tester {
@@ -46,6 +56,16 @@ struct JpegImporterTest: TestSuite::Tester {
     void gray();
     void rgb();
 
+    void scaled();
+    void scaledInvalid();
+    void crop();
+    void cropOutOfBounds();
+    void cropMultipleBlocks();
+
+    #ifndef JPEGIMPORTER_PLUGIN_FILENAME
+    void defaultConstructed();
+    #endif
+
     void openTwice();
     void importTwice();
 
@@ -53,6 +73,51 @@ struct JpegImporterTest: TestSuite::Tester {
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
 
+constexpr struct {
+    const char* name;
+    const char* scale;
+    const char* crop;
+    Vector2i size;
+    /* Without row padding */
+    char data[3];
+} CropData[]{
+    {"whole image", "1", "0 0 3 2", {3, 2}, {}},
+    {"bottom row", "1", "0 0 3 1", {3, 1}, {'\xff', '\x88', '\x00'}},
+    {"top row", "1", "0 1 3 1", {3, 1}, {'\x88', '\x00', '\xff'}},
+    {"bottom right", "1", "1 0 2 1", {2, 1}, {'\x88', '\x00'}},
+    {"top middle", "1", "1 1 1 1", {1, 1}, {'\x00'}},
+    {"scaled", "2", "0 0 1 1", {1, 1}, {}}
+};
+
+constexpr struct {
+    const char* name;
+    const char* crop;
+    const char* message;
+} CropOutOfBoundsData[]{
+    {"negative offset", "-1 0 2 2",
+        "crop rectangle Vector(-1, 0, 2, 2) out of bounds for an image of size Vector(3, 2)"},
+    {"zero size", "0 0 3 0",
+        "crop rectangle Vector(0, 0, 3, 0) out of bounds for an image of size Vector(3, 2)"},
+    {"too wide", "1 0 3 2",
+        "crop rectangle Vector(1, 0, 3, 2) out of bounds for an image of size Vector(3, 2)"},
+    {"too high", "0 1 3 2",
+        "crop rectangle Vector(0, 1, 3, 2) out of bounds for an image of size Vector(3, 2)"}
+};
+
+constexpr struct {
+    const char* name;
+    UnsignedInt scale;
+    Vector2i imageSize;
+    Vector4i crop;
+} CropMultipleBlocksData[]{
+    {"bottom block row", 1, {40, 24}, {0, 0, 40, 8}},
+    {"top block row", 1, {40, 24}, {0, 16, 40, 8}},
+    {"block-aligned", 1, {40, 24}, {8, 8, 16, 8}},
+    {"unaligned", 1, {40, 24}, {9, 5, 13, 11}},
+    {"top right pixel", 1, {40, 24}, {39, 23, 1, 1}},
+    {"scaled, unaligned", 2, {20, 12}, {5, 2, 7, 4}}
+};
+
 JpegImporterTest::JpegImporterTest() {
     addTests({&JpegImporterTest::empty,
               &JpegImporterTest::invalid,
@@ -60,7 +125,23 @@ JpegImporterTest::JpegImporterTest() {
               &JpegImporterTest::gray,
               &JpegImporterTest::rgb,
 
-              &JpegImporterTest::openTwice,
+              &JpegImporterTest::scaled,
+              &JpegImporterTest::scaledInvalid});
+
+    addInstancedTests({&JpegImporterTest::crop},
+        Containers::arraySize(CropData));
+
+    addInstancedTests({&JpegImporterTest::cropOutOfBounds},
+        Containers::arraySize(CropOutOfBoundsData));
+
+    addInstancedTests({&JpegImporterTest::cropMultipleBlocks},
+        Containers::arraySize(CropMultipleBlocksData));
+
+    #ifndef JPEGIMPORTER_PLUGIN_FILENAME
+    addTests({&JpegImporterTest::defaultConstructed});
+    #endif
+
+    addTests({&JpegImporterTest::openTwice,
               &JpegImporterTest::importTwice});
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
@@ -146,6 +227,114 @@ void JpegImporterTest::rgb() {
     }), TestSuite::Compare::Container);
 }
 
+void JpegImporterTest::scaled() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("JpegImporter");
+    importer->configuration().setValue("scale", 2);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(JPEGIMPORTER_TEST_DIR, "rgb.jpg")));
+
+    /* The size is rounded up. The contents are not exactly defined, so not
+       checking those. */
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 1));
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image->data().size(), 8);
+}
+
+void JpegImporterTest::scaledInvalid() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("JpegImporter");
+    importer->configuration().setValue("scale", 3);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(JPEGIMPORTER_TEST_DIR, "rgb.jpg")));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->image2D(0));
+    CORRADE_COMPARE(out.str(), "Trade::JpegImporter::image2D(): expected scale to be 1, 2, 4 or 8 but got 3\n");
+}
+
+void JpegImporterTest::crop() {
+    auto&& data = CropData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("JpegImporter");
+    importer->configuration().setValue("scale", data.scale);
+    importer->configuration().setValue("crop", data.crop);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(JPEGIMPORTER_TEST_DIR, "gray.jpg")));
+
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), data.size);
+    CORRADE_COMPARE(image->format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(image->data().size(), 4*data.size.y());
+
+    /* Checking contents only of the single-row crops of the full-size image,
+       others are either the same as in gray() or not exactly defined */
+    if(data.size.y() != 1 || data.scale[0] != '1') return;
+
+    CORRADE_COMPARE_AS(image->data().prefix(data.size.x()),
+        Containers::arrayView(data.data).prefix(data.size.x()),
+        TestSuite::Compare::Container);
+}
+
+void JpegImporterTest::cropOutOfBounds() {
+    auto&& data = CropOutOfBoundsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("JpegImporter");
+    importer->configuration().setValue("crop", data.crop);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(JPEGIMPORTER_TEST_DIR, "gray.jpg")));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->image2D(0));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::JpegImporter::image2D(): {}\n", data.message));
+}
+
+void JpegImporterTest::cropMultipleBlocks() {
+    auto&& data = CropMultipleBlocksData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* A 5x3 grid of 8x8 blocks, so the crops go across iMCU boundaries and
+       the scanlines above the region can be skipped */
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("JpegImporter");
+    importer->configuration().setValue("scale", data.scale);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(JPEGIMPORTER_TEST_DIR, "gray-40x24.jpg")));
+
+    Containers::Optional<Trade::ImageData2D> full = importer->image2D(0);
+    CORRADE_VERIFY(full);
+    CORRADE_COMPARE(full->size(), data.imageSize);
+
+    importer->configuration().setValue("crop", data.crop);
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), data.crop.zw());
+    CORRADE_COMPARE(image->format(), PixelFormat::R8Unorm);
+
+    /* The region should be exactly the same as in the whole image */
+    for(Int y = 0; y != data.crop.w(); ++y) {
+        CORRADE_ITERATION(y);
+        CORRADE_COMPARE_AS(image->pixels<UnsignedByte>()[y],
+            full->pixels<UnsignedByte>()[data.crop.y() + y].slice(data.crop.x(), data.crop.x() + data.crop.z()),
+            TestSuite::Compare::Container);
+    }
+}
+
+#ifndef JPEGIMPORTER_PLUGIN_FILENAME
+void JpegImporterTest::defaultConstructed() {
+    /* Not going through the plugin manager, so the configuration isn't
+       loaded from the conf file. The defaults should still be there. */
+    JpegImporter importer;
+    CORRADE_COMPARE(importer.configuration().value<UnsignedInt>("scale"), 1);
+    CORRADE_COMPARE(importer.configuration().value("crop"), "");
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(JPEGIMPORTER_TEST_DIR, "gray.jpg")));
+
+    Containers::Optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), (Vector2i{3, 2}));
+    CORRADE_COMPARE(image->format(), PixelFormat::R8Unorm);
+}
+#endif
+
 void JpegImporterTest::openTwice() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("JpegImporter");
 
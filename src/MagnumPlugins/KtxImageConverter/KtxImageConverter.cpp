@@ -35,13 +35,20 @@
 #include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Endianness.h>
-#include <Corrade/Utility/EndiannessBatch.h>
 #include <Magnum/ImageView.h>
 #include <Magnum/PixelFormat.h>
 #include <Magnum/Math/Functions.h>
 #include <Magnum/Math/Vector3.h>
+#include "MagnumPlugins/Implementation/PixelTransform.h"
 #include "MagnumPlugins/KtxImporter/KtxHeader.h"
 
+#ifdef MAGNUM_KTXIMAGECONVERTER_WITH_ZSTD
+#include <zstd.h>
+#endif
+#ifdef MAGNUM_KTXIMAGECONVERTER_WITH_ZLIB
+#include <zlib.h>
+#endif
+
 namespace Magnum { namespace Trade {
 
 namespace {
@@ -524,7 +531,7 @@ Containers::Pair<UnsignedInt, UnsignedInt> channelMapping(Implementation::VkForm
 }
 
 template<typename Format>
-Containers::Array<char> fillDataFormatDescriptor(Format format, Implementation::VkFormatSuffix suffix) {
+Containers::Array<char> fillDataFormatDescriptor(Format format, Implementation::VkFormatSuffix suffix, bool supercompressed) {
     const auto sampleData = samples(format);
     CORRADE_INTERNAL_ASSERT(!sampleData.second().empty());
 
@@ -639,8 +646,11 @@ Containers::Array<char> fillDataFormatDescriptor(Format format, Implementation::
        an odd exception because as far as Vulkan is concerned, it's a packed
        type (_PACK32), so the byte count is 4, not 3. The check below works
        because Depth24Unorm is the only single-channel format where
-       extent/8 < unitDataSize. */
-    if(samples.size() > 1)
+       extent/8 < unitDataSize. With supercompression the byte count is
+       undefined and has to be 0. */
+    if(supercompressed)
+        header.bytesPlane[0] = 0;
+    else if(samples.size() > 1)
         header.bytesPlane[0] = extent/8;
     else
         header.bytesPlane[0] = unitDataSize;
@@ -669,41 +679,70 @@ UnsignedInt leastCommonMultiple(UnsignedInt a, UnsignedInt b) {
 }
 
 template<UnsignedInt dimensions>
-void copyPixels(const BasicImageView<dimensions>& image, Containers::ArrayView<char> pixels) {
-    /* Copy the pixels into output, dropping padding (if any) */
+void copyPixels(const BasicImageView<dimensions>& image, const UnsignedInt typeSize, Containers::ArrayView<char> pixels) {
+    /* Copy the pixels into output, dropping padding (if any) and converting
+       to little endian in the same pass. The pixel view is expanded to four
+       dimensions with the extra ones having a size of 1. */
     const Containers::StridedArrayView<dimensions + 1, const char> srcPixels = image.pixels();
-    Utility::copy(srcPixels, Containers::StridedArrayView<dimensions + 1, char>{pixels, srcPixels.size()});
+    Containers::StridedDimensions<4, std::size_t> size{1, 1, 1, 1};
+    Containers::StridedDimensions<4, std::ptrdiff_t> stride{0, 0, 0, 1};
+    for(UnsignedInt i = 0; i != dimensions + 1; ++i) {
+        size[3 - dimensions + i] = srcPixels.size()[i];
+        stride[3 - dimensions + i] = srcPixels.stride()[i];
+    }
+    const Containers::StridedArrayView4D<const char> src{image.data(), static_cast<const char*>(srcPixels.data()), size, stride};
+
+    const Implementation::PixelTransform transform{image.pixelSize(), typeSize, false,
+        #ifdef CORRADE_TARGET_BIG_ENDIAN
+        true
+        #else
+        false
+        #endif
+    };
+    Implementation::transformPixels(transform, src, Containers::StridedArrayView4D<char>{pixels, size});
 }
 
 template<UnsignedInt dimensions>
-void copyPixels(const BasicCompressedImageView<dimensions>& image, Containers::ArrayView<char> pixels) {
+void copyPixels(const BasicCompressedImageView<dimensions>& image, UnsignedInt, Containers::ArrayView<char> pixels) {
     /** @todo Support CompressedPixelStorage::skip */
     CORRADE_ASSERT(image.storage() == CompressedPixelStorage{}, "Trade::KtxImageConverter::convertToData(): non-default compressed storage is not supported", );
+    /* Block-compressed data have a type size of 1, nothing to swap */
     Utility::copy(image.data().prefix(pixels.size()), pixels);
 }
 
-template<std::size_t Size> struct TypeForSize {};
-template<> struct TypeForSize<1> { typedef UnsignedByte  Type; };
-template<> struct TypeForSize<2> { typedef UnsignedShort Type; };
-template<> struct TypeForSize<4> { typedef UnsignedInt   Type; };
-template<> struct TypeForSize<8> { typedef UnsignedLong  Type; };
-
-void endianSwap(Containers::ArrayView<char> data, UnsignedInt typeSize) {
-    switch(typeSize) {
-        case 1:
-            /* Single-byte or block-compressed format, nothing to do */
-            return;
-        case 2:
-            Utility::Endianness::littleEndianInPlace(Containers::arrayCast<TypeForSize<2>::Type>(data));
-            return;
-        case 4:
-            Utility::Endianness::littleEndianInPlace(Containers::arrayCast<TypeForSize<4>::Type>(data));
-            return;
-        case 8:
-            Utility::Endianness::littleEndianInPlace(Containers::arrayCast<TypeForSize<8>::Type>(data));
-            return;
+/* Compresses into a new array that's large enough for the worst case, returns
+   the actual compressed size or 0 on failure */
+std::size_t compressLevel(const Implementation::SuperCompressionScheme scheme, const Int level, const Containers::ArrayView<const char> in, Containers::Array<char>& out) {
+    #ifdef MAGNUM_KTXIMAGECONVERTER_WITH_ZSTD
+    if(scheme == Implementation::SuperCompressionScheme::Zstandard) {
+        out = Containers::Array<char>{NoInit, ZSTD_compressBound(in.size())};
+        const std::size_t size = ZSTD_compress(out.data(), out.size(), in.data(), in.size(), level ? level : ZSTD_CLEVEL_DEFAULT);
+        if(ZSTD_isError(size)) {
+            Error{} << "Trade::KtxImageConverter::convertToData(): Zstandard compression failed:" << ZSTD_getErrorName(size);
+            return 0;
+        }
+        return size;
+    }
+    #endif
+
+    #ifdef MAGNUM_KTXIMAGECONVERTER_WITH_ZLIB
+    if(scheme == Implementation::SuperCompressionScheme::ZLIB) {
+        uLongf size = compressBound(in.size());
+        out = Containers::Array<char>{NoInit, size};
+        const int result = compress2(reinterpret_cast<Bytef*>(out.data()), &size, reinterpret_cast<const Bytef*>(in.data()), in.size(), level ? level : Z_DEFAULT_COMPRESSION);
+        if(result != Z_OK) {
+            Error{} << "Trade::KtxImageConverter::convertToData(): zlib compression failed:" << zError(result);
+            return 0;
+        }
+        return size;
     }
+    #endif
 
+    /* Unsupported schemes are rejected in convertLevels() already */
+    static_cast<void>(scheme);
+    static_cast<void>(level);
+    static_cast<void>(in);
+    static_cast<void>(out);
     CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 }
 
@@ -730,8 +769,6 @@ Containers::Array<char> convertLevels(Containers::ArrayView<const View<dimension
         return {};
     }
 
-    const Containers::Array<char> dataFormatDescriptor = fillDataFormatDescriptor(format, vkFormat.second());
-
     /* Fill key/value data. Values can be any byte-string but we only write
        constant text strings. Keys must be sorted alphabetically.
        Entries with an empty value won't be written. */
@@ -769,6 +806,33 @@ Containers::Array<char> convertLevels(Containers::ArrayView<const View<dimension
         return {};
     }
 
+    const std::string supercompression = configuration.value("supercompression");
+    Implementation::SuperCompressionScheme supercompressionScheme;
+    if(supercompression.empty())
+        supercompressionScheme = Implementation::SuperCompressionScheme::None;
+    else if(supercompression == "zstd") {
+        #ifdef MAGNUM_KTXIMAGECONVERTER_WITH_ZSTD
+        supercompressionScheme = Implementation::SuperCompressionScheme::Zstandard;
+        #else
+        Error{} << "Trade::KtxImageConverter::convertToData(): Zstandard supercompression is not supported, the plugin was built without zstd";
+        return {};
+        #endif
+    } else if(supercompression == "zlib") {
+        #ifdef MAGNUM_KTXIMAGECONVERTER_WITH_ZLIB
+        supercompressionScheme = Implementation::SuperCompressionScheme::ZLIB;
+        #else
+        Error{} << "Trade::KtxImageConverter::convertToData(): zlib supercompression is not supported, the plugin was built without zlib";
+        return {};
+        #endif
+    } else {
+        Error{} << "Trade::KtxImageConverter::convertToData(): invalid supercompression" << supercompression << Debug::nospace << ", expected zstd, zlib or an empty string";
+        return {};
+    }
+    const bool isSupercompressed = supercompressionScheme != Implementation::SuperCompressionScheme::None;
+    const Int supercompressionLevel = configuration.value<Int>("supercompressionLevel");
+
+    const Containers::Array<char> dataFormatDescriptor = fillDataFormatDescriptor(format, vkFormat.second(), isSupercompressed);
+
     const Containers::Pair<Containers::StringView, Containers::StringView> keyValueMap[]{
         Containers::pair("KTXorientation"_s, Containers::StringView{orientation}.prefix(Math::min(size_t(dimensions), orientation.size()))),
         Containers::pair("KTXswizzle"_s, Containers::StringView{swizzle}),
@@ -825,6 +889,11 @@ Containers::Array<char> convertLevels(Containers::ArrayView<const View<dimension
     /* A "unit" is either a pixel or a block in a compressed format */
     const Vector3i unitSize = formatUnitSize(format);
     const UnsignedInt unitDataSize = formatUnitDataSize(format);
+    const UnsignedInt typeSize = formatTypeSize(format);
+
+    /* Supercompressed level sizes are known only after compressing, so the
+       levels are packed and compressed already here */
+    Containers::Array<Containers::Array<char>> supercompressedLevels{isSupercompressed ? numMipmaps : 0};
 
     for(UnsignedInt i = 0; i != levelIndex.size(); ++i) {
         /* Mip levels are required to be stored from smallest to largest for
@@ -840,19 +909,29 @@ Containers::Array<char> convertLevels(Containers::ArrayView<const View<dimension
             return {};
         }
 
-        /* Offset needs to be aligned to the least common multiple of the
-           texel/block size and 4. Not needed with supercompression. */
-        const std::size_t alignment = leastCommonMultiple(unitDataSize, 4);
-        levelOffset = (levelOffset + alignment - 1)/alignment*alignment;
-
         const Vector3i unitCount = (Vector3i::pad(mipSize, 1) + unitSize - Vector3i{1})/unitSize;
         const std::size_t levelSize = unitDataSize*unitCount.product();
 
+        std::size_t byteLength;
+        if(isSupercompressed) {
+            Containers::Array<char> pixels{NoInit, levelSize};
+            copyPixels(image, typeSize, pixels);
+
+            byteLength = compressLevel(supercompressionScheme, supercompressionLevel, pixels, supercompressedLevels[mip]);
+            if(!byteLength) return {};
+        } else {
+            /* Offset needs to be aligned to the least common multiple of the
+               texel/block size and 4. Not needed with supercompression. */
+            const std::size_t alignment = leastCommonMultiple(unitDataSize, 4);
+            levelOffset = (levelOffset + alignment - 1)/alignment*alignment;
+            byteLength = levelSize;
+        }
+
         levelIndex[mip].byteOffset = levelOffset;
-        levelIndex[mip].byteLength = levelSize;
+        levelIndex[mip].byteLength = byteLength;
         levelIndex[mip].uncompressedByteLength = levelSize;
 
-        levelOffset += levelSize;
+        levelOffset += byteLength;
     }
 
     const std::size_t dataSize = levelOffset;
@@ -866,22 +945,23 @@ Containers::Array<char> convertLevels(Containers::ArrayView<const View<dimension
     Utility::copy(Containers::arrayView(Implementation::KtxFileIdentifier), Containers::arrayView(header.identifier));
 
     header.vkFormat = vkFormat.first();
-    header.typeSize = formatTypeSize(format);
+    header.typeSize = typeSize;
     header.imageSize = Vector3ui{Vector3i::pad(size, 0u)};
     /** @todo Handle different image types (cube and/or array) once this can be
               queried from images */
     header.layerCount = 0;
     header.faceCount = 1;
     header.levelCount = levelIndex.size();
-    header.supercompressionScheme = Implementation::SuperCompressionScheme::None;
+    header.supercompressionScheme = supercompressionScheme;
 
     for(UnsignedInt i = 0; i != levelIndex.size(); ++i) {
         const Implementation::KtxLevel& level = levelIndex[i];
-        const auto& image = imageLevels[i];
         const auto pixels = data.suffix(level.byteOffset).prefix(level.byteLength);
-        copyPixels(image, pixels);
-
-        endianSwap(pixels, header.typeSize);
+        if(isSupercompressed)
+            Utility::copy(supercompressedLevels[i].prefix(level.byteLength), pixels);
+        else {
+            copyPixels(imageLevels[i], typeSize, pixels);
+        }
 
         Utility::Endianness::littleEndianInPlace(
             level.byteOffset, level.byteLength,
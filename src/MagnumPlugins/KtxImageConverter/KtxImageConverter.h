@@ -119,8 +119,14 @@ by two, rounded down. Incomplete mip chains are supported.
 
 @subsection Trade-KtxImageConverter-behavior-supercompression Supercompression
 
-Saving files with [supercompression](https://github.khronos.org/KTX-Specification/#supercompressionSchemes)
-is not supported.
+Each level can be compressed with [Zstandard or zlib supercompression](https://github.khronos.org/KTX-Specification/#supercompressionSchemes)
+by setting the @cb{.ini} supercompression @ce
+@ref Trade-KtxImageConverter-configuration "configuration option" to
+@cb{.ini} zstd @ce or @cb{.ini} zlib @ce, with the compression level
+controlled by @cb{.ini} supercompressionLevel @ce. These are available only if
+the plugin was built with [zstd](https://github.com/facebook/zstd) or
+[zlib](https://zlib.net), respectively, otherwise the conversion fails.
+BasisLZ supercompression is not supported.
 
 @section Trade-KtxImageConverter-configuration Plugin-specific configuration
 
@@ -110,6 +110,10 @@ struct KtxImageConverterTest: TestSuite::Tester {
     void configurationEmpty();
     void configurationSorted();
 
+    void supercompression();
+    void supercompressionInvalid();
+    void supercompressionNotSupported();
+
     void convertTwice();
 
     /* Explicitly forbid system-wide plugin dependencies */
@@ -265,6 +269,30 @@ const struct {
     {"invalid characters", "1012", "invalid characters in swizzle 1012"}
 };
 
+#ifdef MAGNUM_KTXIMAGECONVERTER_WITH_ZSTD
+constexpr bool ZstdSupported = true;
+#else
+constexpr bool ZstdSupported = false;
+#endif
+#ifdef MAGNUM_KTXIMAGECONVERTER_WITH_ZLIB
+constexpr bool ZlibSupported = true;
+#else
+constexpr bool ZlibSupported = false;
+#endif
+
+const struct {
+    const char* name;
+    const char* value;
+    Implementation::SuperCompressionScheme scheme;
+    bool supported;
+    const char* message;
+} SupercompressionData[]{
+    {"Zstandard", "zstd", Implementation::SuperCompressionScheme::Zstandard, ZstdSupported,
+        "Zstandard supercompression is not supported, the plugin was built without zstd"},
+    {"zlib", "zlib", Implementation::SuperCompressionScheme::ZLIB, ZlibSupported,
+        "zlib supercompression is not supported, the plugin was built without zlib"}
+};
+
 Containers::Array<char> readDataFormatDescriptor(Containers::ArrayView<const char> fileData) {
     CORRADE_INTERNAL_ASSERT(fileData.size() >= sizeof(Implementation::KtxHeader));
     const Implementation::KtxHeader& header = *reinterpret_cast<const Implementation::KtxHeader*>(fileData.data());
@@ -346,9 +374,17 @@ KtxImageConverterTest::KtxImageConverterTest() {
     addTests({&KtxImageConverterTest::configurationWriterName,
               &KtxImageConverterTest::configurationWriterNameEmpty,
               &KtxImageConverterTest::configurationEmpty,
-              &KtxImageConverterTest::configurationSorted,
+              &KtxImageConverterTest::configurationSorted});
+
+    addInstancedTests({&KtxImageConverterTest::supercompression},
+        Containers::arraySize(SupercompressionData));
 
-              &KtxImageConverterTest::convertTwice});
+    addTests({&KtxImageConverterTest::supercompressionInvalid});
+
+    addInstancedTests({&KtxImageConverterTest::supercompressionNotSupported},
+        Containers::arraySize(SupercompressionData));
+
+    addTests({&KtxImageConverterTest::convertTwice});
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
@@ -1119,6 +1155,96 @@ void KtxImageConverterTest::configurationSorted() {
     CORRADE_VERIFY(swizzleOffset.begin() < writerOffset.begin());
 }
 
+void KtxImageConverterTest::supercompression() {
+    auto&& data = SupercompressionData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!data.supported)
+        CORRADE_SKIP("The plugin was built without support for this scheme.");
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("KtxImageConverter");
+    CORRADE_VERIFY(converter->configuration().setValue("supercompression", data.value));
+
+    /* Same as convert2DMipmaps() */
+    constexpr Vector2i size{4, 3};
+    const auto mip0 = Containers::arrayCast<const Color3ub>(Containers::arrayView(
+        PatternRgbData[Containers::arraySize(PatternRgbData) - 1]));
+    const Color3ub mip1[2]{0xffffff_rgb, 0x007f7f_rgb};
+    const Color3ub mip2[1]{0x000000_rgb};
+    const Containers::ArrayView<const Color3ub> mipViews[3]{mip0, mip1, mip2};
+
+    PixelStorage storage;
+    storage.setAlignment(1);
+    const ImageView2D inputImages[3]{
+        ImageView2D{storage, PixelFormat::RGB8Srgb, Math::max(size >> 0, 1), mip0},
+        ImageView2D{storage, PixelFormat::RGB8Srgb, Math::max(size >> 1, 1), mip1},
+        ImageView2D{storage, PixelFormat::RGB8Srgb, Math::max(size >> 2, 1), mip2}
+    };
+
+    const auto output = converter->convertToData(inputImages);
+    CORRADE_VERIFY(output);
+
+    const Implementation::KtxHeader& header = *reinterpret_cast<const Implementation::KtxHeader*>(output.data());
+    CORRADE_COMPARE(Utility::Endianness::littleEndian(UnsignedInt(header.supercompressionScheme)), UnsignedInt(data.scheme));
+
+    /* Levels store the size before supercompression */
+    const auto levelIndex = Containers::arrayCast<const Implementation::KtxLevel>(output.suffix(sizeof(Implementation::KtxHeader)).prefix(3*sizeof(Implementation::KtxLevel)));
+    CORRADE_COMPARE(Utility::Endianness::littleEndian(levelIndex[0].uncompressedByteLength), 36);
+    CORRADE_COMPARE(Utility::Endianness::littleEndian(levelIndex[1].uncompressedByteLength), 6);
+    CORRADE_COMPARE(Utility::Endianness::littleEndian(levelIndex[2].uncompressedByteLength), 3);
+
+    /* The byte count is undefined for supercompressed data */
+    const Containers::Array<char> dfd = readDataFormatDescriptor(output);
+    const Implementation::KdfBasicBlockHeader& dfdHeader = *reinterpret_cast<const Implementation::KdfBasicBlockHeader*>(dfd.suffix(sizeof(UnsignedInt)).data());
+    CORRADE_COMPARE(dfdHeader.bytesPlane[0], 0);
+
+    if(_importerManager.loadState("KtxImporter") == PluginManager::LoadState::NotFound)
+        CORRADE_SKIP("KtxImporter plugin not found, cannot test");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("KtxImporter");
+    CORRADE_VERIFY(importer->openData(output));
+    CORRADE_COMPARE(importer->image2DLevelCount(0), 3);
+
+    for(UnsignedInt i = 0; i != importer->image2DLevelCount(0); ++i) {
+        CORRADE_ITERATION(i);
+
+        const auto image = importer->image2D(0, i);
+        CORRADE_VERIFY(image);
+        CORRADE_COMPARE(image->size(), inputImages[i].size());
+        CORRADE_COMPARE_AS(image->data(), Containers::arrayCast<const char>(mipViews[i]), TestSuite::Compare::Container);
+    }
+}
+
+void KtxImageConverterTest::supercompressionInvalid() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("KtxImageConverter");
+    CORRADE_VERIFY(converter->configuration().setValue("supercompression", "basislz"));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedByte bytes[4]{};
+    CORRADE_VERIFY(!converter->convertToData(ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, bytes}));
+    CORRADE_COMPARE(out.str(), "Trade::KtxImageConverter::convertToData(): invalid supercompression basislz, expected zstd, zlib or an empty string\n");
+}
+
+void KtxImageConverterTest::supercompressionNotSupported() {
+    auto&& data = SupercompressionData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(data.supported)
+        CORRADE_SKIP("The plugin was built with support for this scheme.");
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("KtxImageConverter");
+    CORRADE_VERIFY(converter->configuration().setValue("supercompression", data.value));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedByte bytes[4]{};
+    CORRADE_VERIFY(!converter->convertToData(ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, bytes}));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::KtxImageConverter::convertToData(): {}\n", data.message));
+}
+
 void KtxImageConverterTest::convertTwice() {
     Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("KtxImageConverter");
 
@@ -26,6 +26,9 @@
 
 #include "KtxImporter.h"
 
+#include <atomic>
+#include <cstring>
+#include <thread>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
@@ -33,48 +36,32 @@
 #include <Corrade/Containers/String.h>
 #include <Corrade/Containers/StringView.h>
 #include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Endianness.h>
-#include <Corrade/Utility/EndiannessBatch.h>
 #include <Magnum/PixelFormat.h>
 #include <Magnum/Math/BoolVector.h>
 #include <Magnum/Math/Functions.h>
-#include <Magnum/Math/Swizzle.h>
 #include <Magnum/Math/Vector3.h>
-#include <Magnum/Math/Vector4.h>
 #include <Magnum/Trade/ImageData.h>
 #include <Magnum/Trade/TextureData.h>
+#include "MagnumPlugins/Implementation/ImporterFileData.h"
+#include "MagnumPlugins/Implementation/PixelTransform.h"
 #include "MagnumPlugins/KtxImporter/KtxHeader.h"
 
+#ifdef MAGNUM_KTXIMPORTER_WITH_ZSTD
+#include <zstd.h>
+#endif
+#ifdef MAGNUM_KTXIMPORTER_WITH_ZLIB
+#include <zlib.h>
+#endif
+
 namespace Magnum { namespace Trade {
 
 namespace {
 
-template<std::size_t> struct TypeForSize {};
-template<> struct TypeForSize<1> { typedef UnsignedByte  Type; };
-template<> struct TypeForSize<2> { typedef UnsignedShort Type; };
-template<> struct TypeForSize<4> { typedef UnsignedInt   Type; };
-template<> struct TypeForSize<8> { typedef UnsignedLong  Type; };
-
-void endianSwap(Containers::ArrayView<char> data, UnsignedInt typeSize) {
-    switch(typeSize) {
-        case 1:
-            /* Single-byte or block-compressed format, nothing to do */
-            return;
-        case 2:
-            Utility::Endianness::littleEndianInPlace(Containers::arrayCast<TypeForSize<2>::Type>(data));
-            return;
-        case 4:
-            Utility::Endianness::littleEndianInPlace(Containers::arrayCast<TypeForSize<4>::Type>(data));
-            return;
-        case 8:
-            Utility::Endianness::littleEndianInPlace(Containers::arrayCast<TypeForSize<8>::Type>(data));
-            return;
-    }
-
-    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
-}
-
 enum SwizzleType: UnsignedByte {
     None = 0,
     BGR,
@@ -88,37 +75,6 @@ inline SwizzleType& operator^=(SwizzleType& a, SwizzleType b) {
     return a = SwizzleType(a ^ b);
 }
 
-/** @todo implement these in TextureTools(?) with proper optimizations,
-    together with an ability to endian-swap on the fly */
-template<typename T> void swizzlePixels(SwizzleType type, Containers::ArrayView<char> data) {
-    if(type == SwizzleType::BGR) {
-        for(auto& pixel: Containers::arrayCast<Math::Vector3<T>>(data))
-            pixel = Math::gather<'b', 'g', 'r'>(pixel);
-    } else if(type == SwizzleType::BGRA) {
-        for(auto& pixel: Containers::arrayCast<Math::Vector4<T>>(data))
-            pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
-    }
-}
-
-void swizzlePixels(SwizzleType type, UnsignedInt typeSize, Containers::ArrayView<char> data) {
-    switch(typeSize) {
-        case 1:
-            swizzlePixels<TypeForSize<1>::Type>(type, data);
-            return;
-        case 2:
-            swizzlePixels<TypeForSize<2>::Type>(type, data);
-            return;
-        case 4:
-            swizzlePixels<TypeForSize<4>::Type>(type, data);
-            return;
-        case 8:
-            swizzlePixels<TypeForSize<8>::Type>(type, data);
-            return;
-    }
-
-    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
-}
-
 struct Format {
     union {
         PixelFormat uncompressed;
@@ -251,16 +207,43 @@ Containers::Optional<Format> decodeFormat(Implementation::VkFormat vkFormat) {
     return {};
 }
 
+/* Returns an error string on failure. Called from multiple threads in
+   File::prefetchLevels(), so it can't print anything on its own. */
+const char* decompressLevel(const Implementation::SuperCompressionScheme scheme, const Containers::ArrayView<const char> in, const Containers::ArrayView<char> out) {
+    #ifdef MAGNUM_KTXIMPORTER_WITH_ZSTD
+    if(scheme == Implementation::SuperCompressionScheme::Zstandard) {
+        const std::size_t size = ZSTD_decompress(out.data(), out.size(), in.data(), in.size());
+        if(ZSTD_isError(size)) return ZSTD_getErrorName(size);
+        if(size != out.size()) return "size doesn't match the uncompressed byte length";
+        return nullptr;
+    }
+    #endif
+
+    #ifdef MAGNUM_KTXIMPORTER_WITH_ZLIB
+    if(scheme == Implementation::SuperCompressionScheme::ZLIB) {
+        uLongf size = out.size();
+        const int result = uncompress(reinterpret_cast<Bytef*>(out.data()), &size, reinterpret_cast<const Bytef*>(in.data()), in.size());
+        if(result != Z_OK) return zError(result);
+        if(size != out.size()) return "size doesn't match the uncompressed byte length";
+        return nullptr;
+    }
+    #endif
+
+    /* Unsupported schemes are rejected in doOpenData() already */
+    static_cast<void>(scheme);
+    static_cast<void>(in);
+    static_cast<void>(out);
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
 }
 
-struct KtxImporter::File {
+struct KtxImporter::File: Implementation::ImporterFileData {
     struct LevelData {
         Vector3i size;
-        Containers::ArrayView<char> data;
+        Containers::ArrayView<const char> data;
     };
 
-    Containers::Array<char> in;
-
     /* Dimensions of the source image (1-3) */
     UnsignedByte numDimensions;
     /* Dimensions of the imported image data, including extra dimensions for
@@ -274,8 +257,55 @@ struct KtxImporter::File {
     /* Usually only one image with n or n+1 dimensions, multiple images for
        3D array layers */
     Containers::Array<Containers::Array<LevelData>> imageData;
+
+    /* Supercompressed data of each level, empty if there's no
+       supercompression. Levels are decompressed in doImage() only for the
+       duration of the call, unless they were decompressed upfront with
+       prefetchLevels(). The LevelData views then point into `decompressed`,
+       otherwise they're empty. */
+    struct SupercompressedLevel {
+        Containers::ArrayView<const char> data;
+        std::size_t uncompressedSize;
+        std::size_t imageLength;
+        Containers::Array<char> decompressed;
+    };
+
+    Implementation::SuperCompressionScheme supercompressionScheme;
+    Containers::Array<SupercompressedLevel> supercompressedLevels;
+
+    void prefetchLevels(UnsignedInt threadCount);
 };
 
+void KtxImporter::File::prefetchLevels(const UnsignedInt threadCount) {
+    /* Each thread picks the next level until there are none left. Levels that
+       fail to decompress are left to be decompressed again on first use,
+       which then reports the error. */
+    std::atomic<std::size_t> next{0};
+    auto work = [this, &next]() {
+        for(std::size_t i; (i = next++) < supercompressedLevels.size(); ) {
+            SupercompressedLevel& level = supercompressedLevels[i];
+            Containers::Array<char> decompressed{NoInit, level.uncompressedSize};
+            if(!decompressLevel(supercompressionScheme, level.data, decompressed))
+                level.decompressed = std::move(decompressed);
+        }
+    };
+
+    /* Run also on the calling thread */
+    Containers::Array<std::thread> threads{std::size_t(Math::min(threadCount, UnsignedInt(supercompressedLevels.size())) - 1)};
+    for(std::thread& thread: threads) thread = std::thread{work};
+    work();
+    for(std::thread& thread: threads) thread.join();
+
+    /* Point the image views to the decompressed data */
+    for(std::size_t i = 0; i != supercompressedLevels.size(); ++i) {
+        const SupercompressedLevel& level = supercompressedLevels[i];
+        if(level.decompressed.empty()) continue;
+
+        for(std::size_t image = 0; image != imageData.size(); ++image)
+            imageData[image][i].data = level.decompressed.suffix(image*level.imageLength).prefix(level.imageLength);
+    }
+}
+
 KtxImporter::KtxImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
 KtxImporter::~KtxImporter() = default;
@@ -286,7 +316,24 @@ bool KtxImporter::doIsOpened() const { return !!_f; }
 
 void KtxImporter::doClose() { _f = nullptr; }
 
+void KtxImporter::doOpenFile(const std::string& filename) {
+    Containers::Pointer<File> f{InPlaceInit};
+    if(!f->openFile(filename, configuration().value<bool>("memoryMapFile"), "Trade::KtxImporter::openFile():"))
+        return;
+
+    openDataInternal(std::move(f));
+}
+
 void KtxImporter::doOpenData(const Containers::ArrayView<const char> data) {
+    Containers::Pointer<File> f{InPlaceInit};
+    f->openData(data, configuration().value<bool>("borrowData"));
+
+    openDataInternal(std::move(f));
+}
+
+void KtxImporter::openDataInternal(Containers::Pointer<File>&& f) {
+    const Containers::ArrayView<const char> data = f->data;
+
     /* Check if the file is long enough for the header */
     if(data.size() < sizeof(Implementation::KtxHeader)) {
         Error{} << "Trade::KtxImporter::openData(): file too short, expected"
@@ -295,7 +342,10 @@ void KtxImporter::doOpenData(const Containers::ArrayView<const char> data) {
         return;
     }
 
-    Implementation::KtxHeader header = *reinterpret_cast<const Implementation::KtxHeader*>(data.data());
+    /* The data can be borrowed from the user and thus arbitrarily aligned,
+       so the header and level index are copied out instead of cast */
+    Implementation::KtxHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
 
     /* KTX2 uses little-endian everywhere */
     Utility::Endianness::littleEndianInPlace(
@@ -333,10 +383,30 @@ void KtxImporter::doOpenData(const Containers::ArrayView<const char> data) {
         return;
     }
 
-    /** @todo Support supercompression */
-    if(header.supercompressionScheme != Implementation::SuperCompressionScheme::None) {
-        Error{} << "Trade::KtxImporter::openData(): supercompression is currently not supported";
-        return;
+    /** @todo Support BasisLZ together with Basis compression */
+    switch(header.supercompressionScheme) {
+        case Implementation::SuperCompressionScheme::None:
+            break;
+        case Implementation::SuperCompressionScheme::BasisLZ:
+            Error{} << "Trade::KtxImporter::openData(): BasisLZ supercompression is not supported";
+            return;
+        case Implementation::SuperCompressionScheme::Zstandard:
+            #ifndef MAGNUM_KTXIMPORTER_WITH_ZSTD
+            Error{} << "Trade::KtxImporter::openData(): Zstandard supercompression is not supported, the plugin was built without zstd";
+            return;
+            #else
+            break;
+            #endif
+        case Implementation::SuperCompressionScheme::ZLIB:
+            #ifndef MAGNUM_KTXIMPORTER_WITH_ZLIB
+            Error{} << "Trade::KtxImporter::openData(): zlib supercompression is not supported, the plugin was built without zlib";
+            return;
+            #else
+            break;
+            #endif
+        default:
+            Error{} << "Trade::KtxImporter::openData(): unsupported supercompression scheme" << UnsignedInt(header.supercompressionScheme);
+            return;
     }
 
     /* typeSize is the size of the format's underlying type, not the texel
@@ -354,8 +424,6 @@ void KtxImporter::doOpenData(const Containers::ArrayView<const char> data) {
         return;
     }
 
-    Containers::Pointer<File> f{InPlaceInit};
-
     /* Number of array layers, imported as extra image dimensions (except
        for 3D images, there it's one Image3D per layer).
 
@@ -457,16 +525,10 @@ void KtxImporter::doOpenData(const Containers::ArrayView<const char> data) {
     }
     f->pixelFormat.typeSize = header.typeSize;
 
-    /* Make an owned copy of the data */
-    f->in = Containers::Array<char>{NoInit, data.size()};
-    Utility::copy(data, f->in);
-
     /* The level index contains byte ranges for each mipmap, from largest to
        smallest. Each mipmap contains tightly packed images ordered by
        layers, faces/slices, rows, columns. */
-    const std::size_t levelIndexSize = numMipmaps*sizeof(Implementation::KtxLevel);
-    const auto levelIndex = Containers::arrayCast<Implementation::KtxLevel>(
-        f->in.suffix(sizeof(Implementation::KtxHeader)).prefix(levelIndexSize));
+    const char* const levelIndex = data.data() + sizeof(Implementation::KtxHeader);
 
     /* Extract image data views. Only one image with extra dimensions for array
        layers and/or cube map faces, except for 3D array images where it's one
@@ -477,16 +539,21 @@ void KtxImporter::doOpenData(const Containers::ArrayView<const char> data) {
     for(UnsignedInt image = 0; image != numImages; ++image)
         f->imageData[image] = Containers::Array<File::LevelData>{numMipmaps};
 
+    const bool isSupercompressed = header.supercompressionScheme != Implementation::SuperCompressionScheme::None;
+    f->supercompressionScheme = header.supercompressionScheme;
+    if(isSupercompressed)
+        f->supercompressedLevels = Containers::Array<File::SupercompressedLevel>{numMipmaps};
+
     Vector3i mipSize{size};
     for(UnsignedInt i = 0; i != numMipmaps; ++i) {
-        auto& level = levelIndex[i];
+        Implementation::KtxLevel level;
+        std::memcpy(&level, levelIndex + i*sizeof(level), sizeof(level));
         Utility::Endianness::littleEndianInPlace(level.byteOffset,
             level.byteLength, level.uncompressedByteLength);
 
         /* Both lengths should be equal without supercompression. Be lenient here
            and only emit a warning in case some shitty exporter gets this wrong. */
-        if(header.supercompressionScheme == Implementation::SuperCompressionScheme::None &&
-            level.byteLength != level.uncompressedByteLength)
+        if(!isSupercompressed && level.byteLength != level.uncompressedByteLength)
         {
             Warning{} << "Trade::KtxImporter::openData(): byte length" << level.byteLength
                 << "is not equal to uncompressed byte length" << level.uncompressedByteLength
@@ -516,15 +583,31 @@ void KtxImporter::doOpenData(const Containers::ArrayView<const char> data) {
             imageLength = levelSize.product()*f->pixelFormat.size;
         const std::size_t totalLength = imageLength*numImages;
 
-        if(level.byteLength < totalLength) {
+        /* For supercompressed levels only the size after decompression can
+           be checked here, the rest is checked when decompressing. It's used
+           to allocate the output, so it has to match exactly instead of
+           allowing arbitrarily large allocations. */
+        if(isSupercompressed) {
+            if(level.uncompressedByteLength != totalLength) {
+                Error{} << "Trade::KtxImporter::openData(): expected" << totalLength
+                    << "bytes of uncompressed level data but got" << level.uncompressedByteLength;
+                return;
+            }
+        } else if(level.byteLength < totalLength) {
             Error{} << "Trade::KtxImporter::openData(): level data too short, "
                 "expected at least" << totalLength << "bytes but got" << level.byteLength;
             return;
         }
 
-        for(UnsignedInt image = 0; image != numImages; ++image) {
+        if(isSupercompressed) {
+            f->supercompressedLevels[i].data = f->data.suffix(level.byteOffset).prefix(level.byteLength);
+            f->supercompressedLevels[i].uncompressedSize = level.uncompressedByteLength;
+            f->supercompressedLevels[i].imageLength = imageLength;
+            for(UnsignedInt image = 0; image != numImages; ++image)
+                f->imageData[image][i] = {levelSize, {}};
+        } else for(UnsignedInt image = 0; image != numImages; ++image) {
             const std::size_t offset = level.byteOffset + image*imageLength;
-            f->imageData[image][i] = {levelSize, f->in.suffix(offset).prefix(imageLength)};
+            f->imageData[image][i] = {levelSize, f->data.suffix(offset).prefix(imageLength)};
         }
 
         /* Halve each dimension, rounding down */
@@ -550,7 +633,7 @@ void KtxImporter::doOpenData(const Containers::ArrayView<const char> data) {
     };
 
     if(header.kvdByteLength > 0) {
-        Containers::ArrayView<const char> keyValueData{f->in.suffix(header.kvdByteOffset).prefix(header.kvdByteLength)};
+        Containers::ArrayView<const char> keyValueData{f->data.suffix(header.kvdByteOffset).prefix(header.kvdByteLength)};
         /* Loop through entries, each one consisting of:
 
            UnsignedInt length
@@ -721,14 +804,52 @@ void KtxImporter::doOpenData(const Containers::ArrayView<const char> data) {
 
     /** @todo Read KTXanimData and expose frame time between images */
 
+    /* Supercompressed levels are decompressed on demand, or all upfront if
+       desired */
+    if(isSupercompressed && configuration().value<bool>("prefetchLevels")) {
+        UnsignedInt threadCount = configuration().value<UnsignedInt>("threads");
+        if(!threadCount) threadCount = Math::max(std::thread::hardware_concurrency(), 1u);
+        f->prefetchLevels(threadCount);
+    }
+
     _f = std::move(f);
 }
 
 template<UnsignedInt dimensions>
-ImageData<dimensions> KtxImporter::doImage(UnsignedInt id, UnsignedInt level) {
-    const File::LevelData& levelData = _f->imageData[id][level];
+Containers::Optional<ImageData<dimensions>> KtxImporter::doImage(const UnsignedInt id, const UnsignedInt level, const char* const prefix) {
+    File::LevelData levelData = _f->imageData[id][level];
     const auto size = Math::Vector<dimensions, Int>::pad(levelData.size);
-    Containers::Array<char> data{NoInit, levelData.data.size()};
+
+    /* Decompress a supercompressed level if it wasn't prefetched. Only the
+       requested level is decompressed and it's discarded again after. */
+    Containers::Array<char> decompressed;
+    if(!_f->supercompressedLevels.empty() && _f->supercompressedLevels[level].decompressed.empty()) {
+        const File::SupercompressedLevel& supercompressed = _f->supercompressedLevels[level];
+        decompressed = Containers::Array<char>{NoInit, supercompressed.uncompressedSize};
+        if(const char* const error = decompressLevel(_f->supercompressionScheme, supercompressed.data, decompressed)) {
+            Error{} << prefix << "can't decompress level" << level << Debug::nospace << ":" << error;
+            return {};
+        }
+
+        levelData.data = decompressed.suffix(id*supercompressed.imageLength).prefix(supercompressed.imageLength);
+    }
+
+    /* If the decompressed level is exactly this image and there's nothing to
+       flip, take over the data instead of copying them */
+    Containers::Array<char> data;
+    if(decompressed.size() == levelData.data.size() && _f->flip.none())
+        data = std::move(decompressed);
+
+    /* Otherwise, if the data don't need any processing, reference them
+       directly if desired. That's always the case for block-compressed
+       formats. */
+    const bool zeroCopy = data.empty() && decompressed.empty() &&
+        configuration().value<bool>("zeroCopyImages") &&
+        _f->flip.none() && _f->pixelFormat.swizzle == SwizzleType::None
+        #ifdef CORRADE_TARGET_BIG_ENDIAN
+        && _f->pixelFormat.typeSize == 1
+        #endif
+        ;
 
     /* Block-compressed images don't have any flipping, swizzling or endian
        swapping performed on them. Special-casing this mainly to avoid having
@@ -739,38 +860,53 @@ ImageData<dimensions> KtxImporter::doImage(UnsignedInt id, UnsignedInt level) {
         CORRADE_INTERNAL_ASSERT(_f->pixelFormat.swizzle == SwizzleType::None);
         CORRADE_INTERNAL_ASSERT(_f->pixelFormat.typeSize == 1);
 
-        Utility::copy(levelData.data, data);
+        if(zeroCopy)
+            return ImageData<dimensions>(_f->pixelFormat.compressed, size, DataFlags{}, levelData.data);
+
+        if(data.empty()) {
+            data = Containers::Array<char>{NoInit, levelData.data.size()};
+            Utility::copy(levelData.data, data);
+        }
         return ImageData<dimensions>(_f->pixelFormat.compressed, size, std::move(data));
     }
 
     /* Uncompressed image */
 
-    /* Copy image data, flipping along axes if necessary. Assuming src is
-       tightly packed, stride gets calculated implicitly. */
+    /* Adjust pixel storage if row size is not four byte aligned */
+    PixelStorage storage;
+    if((levelData.size.x()*_f->pixelFormat.size)%4 != 0)
+        storage.setAlignment(1);
+
+    if(zeroCopy)
+        return ImageData<dimensions>{storage, _f->pixelFormat.uncompressed, size, DataFlags{}, levelData.data};
+
+    /* Copy image data, flipping along axes, swizzling BGR(A) and swapping
+       endianness if necessary, all in a single pass. If the data were taken
+       over from the decompressed level above, there's no flip and the
+       operation is done in-place. Assuming src is tightly packed, stride gets
+       calculated implicitly. */
     Containers::StridedArrayView4D<const char> src{levelData.data, {
         std::size_t(levelData.size.z()),
         std::size_t(levelData.size.y()),
         std::size_t(levelData.size.x()),
         _f->pixelFormat.size
     }};
+    if(data.empty()) data = Containers::Array<char>{NoInit, levelData.data.size()};
     Containers::StridedArrayView4D<char> dst{data, src.size()};
 
     if(_f->flip[2]) src = src.flipped<0>();
     if(_f->flip[1]) src = src.flipped<1>();
     if(_f->flip[0]) src = src.flipped<2>();
 
-    /* Without flipped dimensions this becomes a single memcpy */
-    Utility::copy(src, dst);
-
-    /* Swizzle BGR(A) if necessary */
-    swizzlePixels(_f->pixelFormat.swizzle, _f->pixelFormat.typeSize, data);
-
-    endianSwap(data, _f->pixelFormat.typeSize);
-
-    /* Adjust pixel storage if row size is not four byte aligned */
-    PixelStorage storage;
-    if((levelData.size.x()*_f->pixelFormat.size)%4 != 0)
-        storage.setAlignment(1);
+    const Implementation::PixelTransform transform{_f->pixelFormat.size,
+        _f->pixelFormat.typeSize, _f->pixelFormat.swizzle != SwizzleType::None,
+        #ifdef CORRADE_TARGET_BIG_ENDIAN
+        true
+        #else
+        false
+        #endif
+    };
+    Implementation::transformPixels(transform, src, dst);
 
     return ImageData<dimensions>{storage, _f->pixelFormat.uncompressed, size, std::move(data)};
 }
@@ -780,7 +916,7 @@ UnsignedInt KtxImporter::doImage1DCount() const { return (_f->numDataDimensions
 UnsignedInt KtxImporter::doImage1DLevelCount(UnsignedInt id) { return _f->imageData[id].size(); }
 
 Containers::Optional<ImageData1D> KtxImporter::doImage1D(UnsignedInt id, UnsignedInt level) {
-    return doImage<1>(id, level);
+    return doImage<1>(id, level, "Trade::KtxImporter::image1D():");
 }
 
 UnsignedInt KtxImporter::doImage2DCount() const { return (_f->numDataDimensions == 2) ? _f->imageData.size() : 0; }
@@ -788,7 +924,7 @@ UnsignedInt KtxImporter::doImage2DCount() const { return (_f->numDataDimensions
 UnsignedInt KtxImporter::doImage2DLevelCount(UnsignedInt id) { return _f->imageData[id].size(); }
 
 Containers::Optional<ImageData2D> KtxImporter::doImage2D(UnsignedInt id, UnsignedInt level) {
-    return doImage<2>(id, level);
+    return doImage<2>(id, level, "Trade::KtxImporter::image2D():");
 }
 
 UnsignedInt KtxImporter::doImage3DCount() const { return (_f->numDataDimensions == 3) ? _f->imageData.size() : 0; }
@@ -796,7 +932,7 @@ UnsignedInt KtxImporter::doImage3DCount() const { return (_f->numDataDimensions
 UnsignedInt KtxImporter::doImage3DLevelCount(UnsignedInt id) { return _f->imageData[id].size(); }
 
 Containers::Optional<ImageData3D> KtxImporter::doImage3D(UnsignedInt id, const UnsignedInt level) {
-    return doImage<3>(id, level);
+    return doImage<3>(id, level, "Trade::KtxImporter::image3D():");
 }
 
 UnsignedInt KtxImporter::doTextureCount() const { return _f->imageData.size(); }
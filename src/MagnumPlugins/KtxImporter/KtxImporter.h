@@ -145,8 +145,51 @@ can't be imported.
 
 @subsection Trade-KtxImporter-behavior-supercompression Supercompression
 
-Importing files with [supercompression](https://github.khronos.org/KTX-Specification/#supercompressionSchemes)
-is not supported.
+Files with [Zstandard or zlib supercompression](https://github.khronos.org/KTX-Specification/#supercompressionSchemes)
+are imported if the plugin was built with [zstd](https://github.com/facebook/zstd)
+or [zlib](https://zlib.net), respectively, otherwise the import fails. BasisLZ
+supercompression is not supported.
+
+Each mip level is decompressed only when an image is imported from it, and
+only for the duration of the @ref image1D() / @ref image2D() / @ref image3D()
+call, so levels that are never requested don't pay the decompression cost. If
+the level contains just the requested image and no flipping is needed, the
+decompressed data are used directly without an additional copy. Enabling the
+@cb{.ini} prefetchLevels @ce @ref Trade-KtxImporter-configuration "configuration option"
+decompresses all levels already in @ref openData(), distributed across the
+count of threads given by the @cb{.ini} threads @ce option, and keeps them
+until the file is closed. The plugin doesn't link to `pthread` on its own and
+on Linux it's the application that needs to link to it instead if prefetching
+is enabled:
+
+@code{.cmake}
+find_package(Threads REQUIRED)
+target_link_libraries(your-application PRIVATE Threads::Threads)
+@endcode
+
+@subsection Trade-KtxImporter-behavior-memory Memory-mapped, borrowed and zero-copy data
+
+By default, the file is read into an allocated array in @ref openFile() and
+the data passed to @ref openData() are copied, and every image returned from
+@ref image1D() / @ref image2D() / @ref image3D() is another copy. Enabling the
+@cb{.ini} memoryMapFile @ce @ref Trade-KtxImporter-configuration "configuration option"
+makes @ref openFile() memory-map the file instead, while the
+@cb{.ini} borrowData @ce option makes @ref openData() reference the passed
+memory directly. In that case the caller is responsible for keeping the memory
+alive and unchanged for as long as the importer is opened. Memory mapping is
+supported only on Unix and non-RT Windows platforms, elsewhere the option is
+ignored.
+
+With the @cb{.ini} zeroCopyImages @ce option enabled, images that need no
+further processing are returned as views on the file data. That's always the
+case for block-compressed formats, for uncompressed formats it means no
+axis flipping and no BGR(A) swizzle, and additionally a single-byte type on
+big-endian platforms. Levels of supercompressed files are referenced only if
+they were decompressed with @cb{.ini} prefetchLevels @ce, as otherwise the
+decompressed data are owned by the image already. Such images have empty
+@ref ImageData::dataFlags() and are valid only for as long as the importer is
+opened. Combined with @cb{.ini} memoryMapFile @ce, no image data are copied
+at all.
 
 @subsection Trade-KtxImporter-behavior-swizzle Swizzle support
 
@@ -156,6 +199,16 @@ other non-identity channel remapping is unsupported and results in an error.
 For reasons similar to the restriction on axis-flips, compressed formats don't
 support any swizzling, and the import fails if an image with a compressed
 format contains a swizzle that isn't RGBA.
+
+@section Trade-KtxImporter-configuration Plugin-specific config
+
+It's possible to tune various import options through @ref configuration(). See
+below for all options and their default values:
+
+@snippet MagnumPlugins/KtxImporter/KtxImporter.conf config
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
 */
 class MAGNUM_KTXIMPORTER_EXPORT KtxImporter: public AbstractImporter {
     public:
@@ -168,6 +221,7 @@ class MAGNUM_KTXIMPORTER_EXPORT KtxImporter: public AbstractImporter {
         MAGNUM_KTXIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
         MAGNUM_KTXIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_KTXIMPORTER_LOCAL void doClose() override;
+        MAGNUM_KTXIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
         MAGNUM_KTXIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
 
         MAGNUM_KTXIMPORTER_LOCAL UnsignedInt doImage1DCount() const override;
@@ -189,8 +243,10 @@ class MAGNUM_KTXIMPORTER_EXPORT KtxImporter: public AbstractImporter {
         struct File;
         Containers::Pointer<File> _f;
 
+        MAGNUM_KTXIMPORTER_LOCAL void openDataInternal(Containers::Pointer<File>&& f);
+
         template<UnsignedInt dimensions>
-        ImageData<dimensions> doImage(UnsignedInt id, UnsignedInt level);
+        Containers::Optional<ImageData<dimensions>> doImage(UnsignedInt id, UnsignedInt level, const char* prefix);
 };
 
 }}
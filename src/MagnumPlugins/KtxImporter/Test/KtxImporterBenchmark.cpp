@@ -0,0 +1,299 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Endianness.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/ImageData.h>
+
+#include "MagnumPlugins/Implementation/anonymousResidentMemory.h"
+#include "MagnumPlugins/KtxImporter/KtxHeader.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct KtxImporterBenchmark: TestSuite::Tester {
+    explicit KtxImporterBenchmark();
+
+    void openFile();
+    void openData();
+
+    #ifdef __linux__
+    void openFileMemory();
+    void openDataMemory();
+
+    void memoryBegin();
+    std::uint64_t memoryEnd();
+    #endif
+
+    std::string _filenames[2];
+    Containers::Array<char> _data[2];
+    #ifdef __linux__
+    std::uint64_t _memoryBaseline;
+    #endif
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+constexpr Int Size = 2048;
+
+constexpr struct {
+    const char* name;
+    const char* filename;
+    Implementation::VkFormat format;
+    /* Block size in pixels and bytes per block */
+    Int blockSize;
+    std::size_t blockDataSize;
+} FormatData[]{
+    {"BC1", "benchmark-bc1.ktx2", 134 /* VK_FORMAT_BC1_RGBA_SRGB_BLOCK */, 4, 8},
+    {"RGBA8", "benchmark-rgba8.ktx2", 43 /* VK_FORMAT_R8G8B8A8_SRGB */, 1, 4}
+};
+
+constexpr struct {
+    const char* name;
+    std::size_t format;
+    const char* option;
+    bool zeroCopy;
+} OpenFileData[]{
+    {"BC1, copy", 0, nullptr, false},
+    {"BC1, memory-mapped, zero-copy", 0, "memoryMapFile", true},
+    {"RGBA8, copy", 1, nullptr, false},
+    {"RGBA8, memory-mapped, zero-copy", 1, "memoryMapFile", true}
+};
+
+constexpr struct {
+    const char* name;
+    std::size_t format;
+    const char* option;
+    bool zeroCopy;
+} OpenDataData[]{
+    {"BC1, copy", 0, nullptr, false},
+    {"BC1, borrowed", 0, "borrowData", false},
+    {"BC1, borrowed, zero-copy", 0, "borrowData", true},
+    {"RGBA8, copy", 1, nullptr, false},
+    {"RGBA8, borrowed", 1, "borrowData", false},
+    {"RGBA8, borrowed, zero-copy", 1, "borrowData", true}
+};
+
+/* A square 2D texture with a full mip chain and the level data filled with a
+   repeating pattern. The orientation matches what Magnum expects, so the
+   uncompressed variant doesn't need to be flipped on import. */
+Containers::Array<char> generateKtx(Implementation::VkFormat format, Int blockSize, std::size_t blockDataSize) {
+    const UnsignedInt levelCount = Math::log2(Size) + 1;
+    constexpr char KeyValue[]{'K', 'T', 'X', 'o', 'r', 'i', 'e', 'n', 't', 'a', 't', 'i', 'o', 'n', '\0', 'r', 'u', '\0'};
+    const std::size_t kvdOffset = sizeof(Implementation::KtxHeader) + levelCount*sizeof(Implementation::KtxLevel);
+    const std::size_t kvdSize = 4 + (sizeof(KeyValue) + 3)/4*4;
+
+    /* Level data are stored from the smallest, each aligned to lcm(texel
+       size, 4), which is at most 8 here */
+    std::size_t levelOffsets[16];
+    std::size_t levelSizes[16];
+    std::size_t offset = kvdOffset + kvdSize;
+    for(Int i = levelCount - 1; i >= 0; --i) {
+        const Int blockCount = (Math::max(Size >> i, 1) + blockSize - 1)/blockSize;
+        offset = (offset + 7)/8*8;
+        levelOffsets[i] = offset;
+        levelSizes[i] = std::size_t(blockCount)*blockCount*blockDataSize;
+        offset += levelSizes[i];
+    }
+
+    Containers::Array<char> out{ValueInit, offset};
+
+    Implementation::KtxHeader& header = *reinterpret_cast<Implementation::KtxHeader*>(out.data());
+    std::memcpy(header.identifier, Implementation::KtxFileIdentifier, sizeof(header.identifier));
+    header.vkFormat = format;
+    header.typeSize = 1;
+    header.imageSize = {UnsignedInt(Size), UnsignedInt(Size), 0};
+    header.faceCount = 1;
+    header.levelCount = levelCount;
+    header.kvdByteOffset = kvdOffset;
+    header.kvdByteLength = kvdSize;
+    Utility::Endianness::littleEndianInPlace(header.vkFormat,
+        header.typeSize, header.imageSize[0], header.imageSize[1],
+        header.faceCount, header.levelCount,
+        header.kvdByteOffset, header.kvdByteLength);
+
+    auto levelIndex = Containers::arrayCast<Implementation::KtxLevel>(out.suffix(sizeof(Implementation::KtxHeader)).prefix(levelCount*sizeof(Implementation::KtxLevel)));
+    for(UnsignedInt i = 0; i != levelCount; ++i) {
+        levelIndex[i].byteOffset = levelOffsets[i];
+        levelIndex[i].byteLength = levelIndex[i].uncompressedByteLength = levelSizes[i];
+        Utility::Endianness::littleEndianInPlace(levelIndex[i].byteOffset,
+            levelIndex[i].byteLength, levelIndex[i].uncompressedByteLength);
+
+        for(std::size_t j = 0; j != levelSizes[i]; ++j)
+            out[levelOffsets[i] + j] = char(j*37);
+    }
+
+    const UnsignedInt keyValueSize = Utility::Endianness::littleEndian(UnsignedInt(sizeof(KeyValue)));
+    std::memcpy(out + kvdOffset, &keyValueSize, 4);
+    std::memcpy(out + kvdOffset + 4, KeyValue, sizeof(KeyValue));
+
+    return out;
+}
+
+KtxImporterBenchmark::KtxImporterBenchmark() {
+    addInstancedBenchmarks({&KtxImporterBenchmark::openFile}, 5,
+        Containers::arraySize(OpenFileData));
+    addInstancedBenchmarks({&KtxImporterBenchmark::openData}, 5,
+        Containers::arraySize(OpenDataData));
+
+    #ifdef __linux__
+    addCustomInstancedBenchmarks({&KtxImporterBenchmark::openFileMemory}, 1,
+        Containers::arraySize(OpenFileData),
+        &KtxImporterBenchmark::memoryBegin,
+        &KtxImporterBenchmark::memoryEnd,
+        BenchmarkUnits::Bytes);
+    addCustomInstancedBenchmarks({&KtxImporterBenchmark::openDataMemory}, 1,
+        Containers::arraySize(OpenDataData),
+        &KtxImporterBenchmark::memoryBegin,
+        &KtxImporterBenchmark::memoryEnd,
+        BenchmarkUnits::Bytes);
+    #endif
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef KTXIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(KTXIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::mkpath(KTXIMPORTER_TEST_OUTPUT_DIR));
+    for(std::size_t i = 0; i != Containers::arraySize(FormatData); ++i) {
+        _data[i] = generateKtx(FormatData[i].format, FormatData[i].blockSize, FormatData[i].blockDataSize);
+        _filenames[i] = Utility::Directory::join(KTXIMPORTER_TEST_OUTPUT_DIR, FormatData[i].filename);
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::write(_filenames[i], _data[i]));
+    }
+}
+
+/* Imports all levels of the first image, the result is kept alive so the
+   memory benchmarks account for it */
+Containers::Array<ImageData2D> importAllLevels(AbstractImporter& importer) {
+    Containers::Array<ImageData2D> images;
+    for(UnsignedInt i = 0, max = importer.image2DLevelCount(0); i != max; ++i) {
+        Containers::Optional<ImageData2D> image = importer.image2D(0, i);
+        if(!image) return {};
+        arrayAppend(images, std::move(*image));
+    }
+
+    return images;
+}
+
+void KtxImporterBenchmark::openFile() {
+    auto&& data = OpenFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+    if(data.option) importer->configuration().setValue(data.option, true);
+    importer->configuration().setValue("zeroCopyImages", data.zeroCopy);
+
+    Containers::Array<ImageData2D> images;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openFile(_filenames[data.format]));
+        images = importAllLevels(*importer);
+    }
+
+    CORRADE_COMPARE(images.size(), std::size_t(Math::log2(Size) + 1));
+    CORRADE_COMPARE(images[0].size(), Vector2i{Size});
+}
+
+void KtxImporterBenchmark::openData() {
+    auto&& data = OpenDataData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+    if(data.option) importer->configuration().setValue(data.option, true);
+    importer->configuration().setValue("zeroCopyImages", data.zeroCopy);
+
+    Containers::Array<ImageData2D> images;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData(_data[data.format]));
+        images = importAllLevels(*importer);
+    }
+
+    CORRADE_COMPARE(images.size(), std::size_t(Math::log2(Size) + 1));
+    CORRADE_COMPARE(images[0].size(), Vector2i{Size});
+}
+
+#ifdef __linux__
+void KtxImporterBenchmark::memoryBegin() {
+    _memoryBaseline = Implementation::anonymousResidentMemory();
+}
+
+std::uint64_t KtxImporterBenchmark::memoryEnd() {
+    return Implementation::anonymousResidentMemory() - _memoryBaseline;
+}
+
+void KtxImporterBenchmark::openFileMemory() {
+    auto&& data = OpenFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+    if(data.option) importer->configuration().setValue(data.option, true);
+    importer->configuration().setValue("zeroCopyImages", data.zeroCopy);
+
+    /* The importer is kept opened and the images alive until the measurement
+       ends, so the value is the memory needed to get all levels of the
+       texture */
+    Containers::Array<ImageData2D> images;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openFile(_filenames[data.format]));
+        images = importAllLevels(*importer);
+    }
+
+    CORRADE_VERIFY(!images.empty());
+}
+
+void KtxImporterBenchmark::openDataMemory() {
+    auto&& data = OpenDataData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+    if(data.option) importer->configuration().setValue(data.option, true);
+    importer->configuration().setValue("zeroCopyImages", data.zeroCopy);
+
+    /* The importer is kept opened and the images alive until the measurement
+       ends, so the value is the memory needed to get all levels of the
+       texture */
+    Containers::Array<ImageData2D> images;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData(_data[data.format]));
+        images = importAllLevels(*importer);
+    }
+
+    CORRADE_VERIFY(!images.empty());
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::KtxImporterBenchmark)
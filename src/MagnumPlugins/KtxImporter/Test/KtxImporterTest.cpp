@@ -47,6 +47,7 @@
 #include <Magnum/Trade/ImageData.h>
 #include <Magnum/Trade/TextureData.h>
 
+#include "MagnumPlugins/Implementation/PixelTransform.h"
 #include "MagnumPlugins/KtxImporter/KtxHeader.h"
 
 #include "configure.h"
@@ -109,6 +110,21 @@ struct KtxImporterTest: TestSuite::Tester {
     void swizzleUnsupported();
     void swizzleCompressed();
 
+    void pixelTransform();
+    void pixelTransformInPlace();
+
+    void supercompressed();
+    void supercompressedLayers();
+    void supercompressedInvalid();
+    void supercompressedTruncated();
+    void supercompressedNotSupported();
+
+    void fileNotFound();
+    void memoryMapFile();
+    void borrowData();
+    void zeroCopyImages();
+    void zeroCopyImages1D();
+
     void openTwice();
     void importTwice();
 
@@ -231,9 +247,12 @@ const struct {
     {"compressed type size", "2d-compressed-etc2.ktx2",
         offsetof(Implementation::KtxHeader, typeSize), 4,
         "invalid type size for compressed format, expected 1 but got 4"},
-    {"supercompression", "2d-rgb.ktx2",
+    {"supercompression BasisLZ", "2d-rgb.ktx2",
         offsetof(Implementation::KtxHeader, supercompressionScheme), 1,
-        "supercompression is currently not supported"},
+        "BasisLZ supercompression is not supported"},
+    {"supercompression unknown", "2d-rgb.ktx2",
+        offsetof(Implementation::KtxHeader, supercompressionScheme), 4,
+        "unsupported supercompression scheme 4"},
     {"3d depth", "3d.ktx2",
         offsetof(Implementation::KtxHeader, vkFormat), VK_FORMAT_D32_SFLOAT,
         "3D images can't have depth/stencil format"},
@@ -396,6 +415,81 @@ const struct {
         nullptr, Containers::arrayCast<const char>(PatternRgba2DData)}
 };
 
+/* Shared with DdsImporter and KtxImageConverter, tested here as the importer
+   uses all of its code paths */
+const struct {
+    const char* name;
+    std::size_t pixelSize, typeSize;
+    bool swizzle, endianSwap, flipX, flipY;
+} PixelTransformData[]{
+    {"RGB8, swizzle", 3, 1, true, false, false, false},
+    {"RGBA8, swizzle", 4, 1, true, false, false, false},
+    {"RGBA8, swizzle, Y flip", 4, 1, true, false, false, true},
+    {"RGBA8, swizzle, X flip", 4, 1, true, false, true, false},
+    {"RG16, endian swap", 4, 2, false, true, false, false},
+    {"RGB16, endian swap, X flip", 6, 2, false, true, true, false},
+    {"RGBA16, swizzle, endian swap", 8, 2, true, true, false, false},
+    {"RGB32, swizzle", 12, 4, true, false, false, false},
+    {"RGBA32, endian swap", 16, 4, false, true, false, false},
+    {"RGBA32, swizzle, endian swap, Y flip", 16, 4, true, true, false, true},
+    {"RG64, endian swap", 16, 8, false, true, false, false},
+    {"RGBA8, copy, Y flip", 4, 1, false, false, false, true}
+};
+
+#ifdef MAGNUM_KTXIMPORTER_WITH_ZSTD
+constexpr bool ZstdSupported = true;
+#else
+constexpr bool ZstdSupported = false;
+#endif
+#ifdef MAGNUM_KTXIMPORTER_WITH_ZLIB
+constexpr bool ZlibSupported = true;
+#else
+constexpr bool ZlibSupported = false;
+#endif
+
+const struct {
+    const char* name;
+    const char* file;
+    const char* library;
+    bool supported;
+    bool prefetch;
+} SupercompressedData[]{
+    {"Zstandard", "2d-mipmaps-zstd.ktx2", "zstd", ZstdSupported, false},
+    {"Zstandard, prefetched", "2d-mipmaps-zstd.ktx2", "zstd", ZstdSupported, true},
+    {"zlib", "2d-mipmaps-zlib.ktx2", "zlib", ZlibSupported, false},
+    {"zlib, prefetched", "2d-mipmaps-zlib.ktx2", "zlib", ZlibSupported, true}
+}, SupercompressedLayersData[]{
+    {"Zstandard", "3d-layers-zstd.ktx2", "zstd", ZstdSupported, false},
+    {"Zstandard, prefetched", "3d-layers-zstd.ktx2", "zstd", ZstdSupported, true},
+    {"zlib", "3d-layers-zlib.ktx2", "zlib", ZlibSupported, false},
+    {"zlib, prefetched", "3d-layers-zlib.ktx2", "zlib", ZlibSupported, true}
+};
+
+const struct {
+    const char* name;
+    const char* file;
+    bool supported;
+    const char* message;
+} SupercompressedNotSupportedData[]{
+    {"Zstandard", "2d-mipmaps-zstd.ktx2", ZstdSupported,
+        "Zstandard supercompression is not supported, the plugin was built without zstd"},
+    {"zlib", "2d-mipmaps-zlib.ktx2", ZlibSupported,
+        "zlib supercompression is not supported, the plugin was built without zlib"}
+};
+
+const struct {
+    const char* name;
+    const char* file;
+    bool supported;
+    bool zeroCopy;
+} ZeroCopyImagesData[]{
+    {"block-compressed", "2d-compressed-bc1.ktx2", true, true},
+    /* Needs to be flipped along y, thus copied */
+    {"uncompressed, flipped", "2d-rgb.ktx2", true, false},
+    /* Decompressed on import, thus owned */
+    {"supercompressed", "2d-mipmaps-zlib.ktx2", ZlibSupported, false}
+};
+
 Containers::Array<char> createKeyValueData(Containers::StringView key, Containers::ArrayView<const char> value, bool terminatingZero = false) {
     UnsignedInt size = key.size() + 1 + value.size() + UnsignedInt(terminatingZero);
     size = (size + 3)/4*4;
@@ -502,7 +596,34 @@ KtxImporterTest::KtxImporterTest() {
     addTests({&KtxImporterTest::swizzleMultipleBytes,
               &KtxImporterTest::swizzleIdentity,
               &KtxImporterTest::swizzleUnsupported,
-              &KtxImporterTest::swizzleCompressed,
+              &KtxImporterTest::swizzleCompressed});
+
+    addInstancedTests({&KtxImporterTest::pixelTransform,
+                       &KtxImporterTest::pixelTransformInPlace},
+        Containers::arraySize(PixelTransformData));
+
+    addInstancedTests({&KtxImporterTest::supercompressed},
+        Containers::arraySize(SupercompressedData));
+
+    addInstancedTests({&KtxImporterTest::supercompressedLayers},
+        Containers::arraySize(SupercompressedLayersData));
+
+    addInstancedTests({&KtxImporterTest::supercompressedInvalid},
+        Containers::arraySize(SupercompressedData));
+
+    addTests({&KtxImporterTest::supercompressedTruncated});
+
+    addInstancedTests({&KtxImporterTest::supercompressedNotSupported},
+        Containers::arraySize(SupercompressedNotSupportedData));
+
+    addTests({&KtxImporterTest::fileNotFound,
+              &KtxImporterTest::memoryMapFile,
+              &KtxImporterTest::borrowData});
+
+    addInstancedTests({&KtxImporterTest::zeroCopyImages},
+        Containers::arraySize(ZeroCopyImagesData));
+
+    addTests({&KtxImporterTest::zeroCopyImages1D,
 
               &KtxImporterTest::openTwice,
               &KtxImporterTest::importTwice});
@@ -1757,6 +1878,300 @@ void KtxImporterTest::swizzleCompressed() {
     CORRADE_COMPARE(out.str(), "Trade::KtxImporter::openData(): unsupported channel mapping bgra\n");
 }
 
+/* Two layers of 37x5 pixels, the odd width is so the SSSE3 variant has a
+   remainder to process */
+Containers::Array<char> pixelTransformInput(const std::size_t pixelSize) {
+    Containers::Array<char> data{NoInit, 2*5*37*pixelSize};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = char(i*37 + i/pixelSize);
+    return data;
+}
+
+/* Byte-by-byte reference, independent of the permutation tables and the
+   type-specific kernels */
+Containers::Array<char> pixelTransformExpected(const Containers::StridedArrayView4D<const char>& src, const std::size_t typeSize, const bool swizzle, const bool endianSwap) {
+    const std::size_t pixelSize = src.size()[3];
+    Containers::Array<char> out{NoInit, src.size()[0]*src.size()[1]*src.size()[2]*pixelSize};
+    std::size_t i = 0;
+    for(std::size_t z = 0; z != src.size()[0]; ++z)
+        for(std::size_t y = 0; y != src.size()[1]; ++y)
+            for(std::size_t x = 0; x != src.size()[2]; ++x)
+                for(std::size_t b = 0; b != pixelSize; ++b) {
+                    const std::size_t channel = b/typeSize;
+                    const std::size_t byte = b%typeSize;
+                    out[i++] = src[z][y][x][
+                        (swizzle && channel < 3 ? 2 - channel : channel)*typeSize +
+                        (endianSwap ? typeSize - 1 - byte : byte)];
+                }
+    return out;
+}
+
+void KtxImporterTest::pixelTransform() {
+    auto&& data = PixelTransformData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Containers::Array<char> in = pixelTransformInput(data.pixelSize);
+    Containers::StridedArrayView4D<const char> src{in, {2, 5, 37, data.pixelSize}};
+    if(data.flipX) src = src.flipped<2>();
+    if(data.flipY) src = src.flipped<1>();
+
+    Containers::Array<char> out{NoInit, in.size()};
+    Implementation::transformPixels(
+        Implementation::PixelTransform{data.pixelSize, data.typeSize, data.swizzle, data.endianSwap},
+        src, Containers::StridedArrayView4D<char>{out, src.size()});
+
+    CORRADE_COMPARE_AS(out,
+        pixelTransformExpected(src, data.typeSize, data.swizzle, data.endianSwap),
+        TestSuite::Compare::Container);
+}
+
+void KtxImporterTest::pixelTransformInPlace() {
+    auto&& data = PixelTransformData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(data.flipX || data.flipY)
+        CORRADE_SKIP("Flipping in-place is not supported.");
+
+    Containers::Array<char> out = pixelTransformInput(data.pixelSize);
+    const Containers::StridedArrayView4D<char> view{out, {2, 5, 37, data.pixelSize}};
+    const Containers::Array<char> expected = pixelTransformExpected(view, data.typeSize, data.swizzle, data.endianSwap);
+
+    Implementation::transformPixels(
+        Implementation::PixelTransform{data.pixelSize, data.typeSize, data.swizzle, data.endianSwap},
+        view, view);
+
+    CORRADE_COMPARE_AS(out, expected, TestSuite::Compare::Container);
+}
+
+void KtxImporterTest::supercompressed() {
+    auto&& data = SupercompressedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!data.supported)
+        CORRADE_SKIP("The plugin was built without" << data.library << "support.");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+    importer->configuration().setValue("prefetchLevels", data.prefetch);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(KTXIMPORTER_TEST_DIR, data.file)));
+
+    /* Same as image2DMipmaps() */
+    const auto mip0 = Containers::arrayCast<const Color3ub>(PatternRgbData[0]);
+    const Color3ub mip1[2]{0xffffff_rgb, 0x007f7f_rgb};
+    const Color3ub mip2[1]{0x000000_rgb};
+    const Containers::ArrayView<const Color3ub> mipViews[3]{mip0, mip1, mip2};
+
+    CORRADE_COMPARE(importer->image2DCount(), 1);
+    CORRADE_COMPARE(importer->image2DLevelCount(0), Containers::arraySize(mipViews));
+
+    /* Import in reverse order and then the first level again to verify
+       decompression doesn't depend on any previous state */
+    for(UnsignedInt i: {2, 1, 0, 2}) {
+        CORRADE_ITERATION(i);
+
+        auto image = importer->image2D(0, i);
+        CORRADE_VERIFY(image);
+
+        CORRADE_VERIFY(!image->isCompressed());
+        CORRADE_COMPARE(image->format(), PixelFormat::RGB8Srgb);
+        CORRADE_COMPARE(image->size(), Math::max(Vector2i{4, 3} >> i, 1));
+        CORRADE_COMPARE_AS(image->data(), Containers::arrayCast<const char>(mipViews[i]), TestSuite::Compare::Container);
+    }
+}
+
+void KtxImporterTest::supercompressedLayers() {
+    auto&& data = SupercompressedLayersData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!data.supported)
+        CORRADE_SKIP("The plugin was built without" << data.library << "support.");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+    importer->configuration().setValue("prefetchLevels", data.prefetch);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(KTXIMPORTER_TEST_DIR, data.file)));
+
+    /* Same as image3DLayers(), both layers are in a single supercompressed
+       level */
+    const auto layer0 = Containers::arrayCast<const Color3ub>(PatternRgbData);
+    Color3ub layer1Data[3][3][4]{};
+    Utility::copy(Containers::arrayView(PatternRgbData[0]), layer1Data[0]);
+    const auto layer1 = Containers::arrayCast<const Color3ub>(layer1Data);
+
+    const Containers::ArrayView<const Color3ub> imageViews[2]{layer0, layer1};
+
+    CORRADE_COMPARE(importer->image3DCount(), Containers::arraySize(imageViews));
+
+    for(UnsignedInt i: {1, 0}) {
+        CORRADE_ITERATION(i);
+
+        auto image = importer->image3D(i);
+        CORRADE_VERIFY(image);
+        CORRADE_COMPARE(image->size(), (Vector3i{4, 3, 3}));
+        CORRADE_COMPARE_AS(image->data(), Containers::arrayCast<const char>(imageViews[i]), TestSuite::Compare::Container);
+    }
+}
+
+void KtxImporterTest::supercompressedInvalid() {
+    auto&& data = SupercompressedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!data.supported)
+        CORRADE_SKIP("The plugin was built without" << data.library << "support.");
+
+    /* The uncompressed byte length is used to allocate the output, so anything
+       else than the exact size is rejected already when opening, even if it's
+       just one byte more */
+    auto fileData = Utility::Directory::read(Utility::Directory::join(KTXIMPORTER_TEST_DIR, data.file));
+    const std::size_t offset = sizeof(Implementation::KtxHeader) + offsetof(Implementation::KtxLevel, uncompressedByteLength);
+    CORRADE_INTERNAL_ASSERT(fileData[offset] == 36);
+    fileData[offset] = 37;
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+    importer->configuration().setValue("prefetchLevels", data.prefetch);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(fileData));
+
+    /* Or a terabyte */
+    fileData[offset] = 36;
+    fileData[offset + 5] = 1;
+    CORRADE_VERIFY(!importer->openData(fileData));
+    CORRADE_COMPARE(out.str(),
+        "Trade::KtxImporter::openData(): expected 36 bytes of uncompressed level data but got 37\n"
+        "Trade::KtxImporter::openData(): expected 36 bytes of uncompressed level data but got 1099511627812\n");
+}
+
+void KtxImporterTest::supercompressedTruncated() {
+    if(!ZlibSupported)
+        CORRADE_SKIP("The plugin was built without zlib support.");
+
+    /* The first level decompresses to one byte less than the level index
+       says. The file is opened fine, the failure is reported only on import,
+       and a failed prefetch gets retried on import as well. */
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+    importer->configuration().setValue("prefetchLevels", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "2d-mipmaps-zlib-truncated.ktx2")));
+
+    /* Other levels are still fine */
+    CORRADE_VERIFY(importer->image2D(0, 1));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->image2D(0, 0));
+    CORRADE_COMPARE(out.str(), "Trade::KtxImporter::image2D(): can't decompress level 0: size doesn't match the uncompressed byte length\n");
+}
+
+void KtxImporterTest::supercompressedNotSupported() {
+    auto&& data = SupercompressedNotSupportedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(data.supported)
+        CORRADE_SKIP("The plugin was built with support for this scheme.");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(KTXIMPORTER_TEST_DIR, data.file)));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::KtxImporter::openData(): {}\n", data.message));
+}
+
+void KtxImporterTest::fileNotFound() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openFile("nonexistent.ktx2"));
+    CORRADE_COMPARE(out.str(), "Trade::KtxImporter::openFile(): cannot open file nonexistent.ktx2\n");
+}
+
+void KtxImporterTest::memoryMapFile() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+    importer->configuration().setValue("memoryMapFile", true);
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "2d-rgb.ktx2")));
+
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+
+    /* The image owns its data, so it should be usable even after the file
+       gets unmapped */
+    importer->close();
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayCast<const char>(PatternRgbData[0]), TestSuite::Compare::Container);
+}
+
+void KtxImporterTest::borrowData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+    importer->configuration().setValue("borrowData", true);
+
+    Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "2d-rgb.ktx2"));
+    CORRADE_VERIFY(importer->openData(data));
+
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+
+    /* The image owns its data, so it should stay intact even if the borrowed
+       memory gets changed */
+    importer->close();
+    for(char& i: data) i = 0;
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayCast<const char>(PatternRgbData[0]), TestSuite::Compare::Container);
+}
+
+void KtxImporterTest::zeroCopyImages() {
+    auto&& data = ZeroCopyImagesData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!data.supported)
+        CORRADE_SKIP("The plugin was built without zlib support.");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+    importer->configuration().setValue("borrowData", true);
+    importer->configuration().setValue("zeroCopyImages", true);
+
+    const Containers::Array<char> fileData = Utility::Directory::read(Utility::Directory::join(KTXIMPORTER_TEST_DIR, data.file));
+    CORRADE_VERIFY(importer->openData(fileData));
+
+    /* Compare to the output without zero-copy */
+    Containers::Pointer<AbstractImporter> expectedImporter = _manager.instantiate("KtxImporter");
+    CORRADE_VERIFY(expectedImporter->openData(fileData));
+
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    Containers::Optional<ImageData2D> expected = expectedImporter->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(expected);
+    CORRADE_COMPARE(image->isCompressed(), expected->isCompressed());
+    CORRADE_COMPARE(image->size(), expected->size());
+    CORRADE_COMPARE_AS(image->data(), expected->data(), TestSuite::Compare::Container);
+
+    const bool pointsToFile = image->data().begin() >= fileData.begin() && image->data().end() <= fileData.end();
+    if(data.zeroCopy) {
+        CORRADE_COMPARE(image->dataFlags(), DataFlags{});
+        CORRADE_VERIFY(pointsToFile);
+    } else {
+        CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+        CORRADE_VERIFY(!pointsToFile);
+    }
+}
+
+void KtxImporterTest::zeroCopyImages1D() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("KtxImporter");
+    importer->configuration().setValue("memoryMapFile", true);
+    importer->configuration().setValue("zeroCopyImages", true);
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "1d.ktx2")));
+
+    /* The 1D image doesn't need to be flipped, so the uncompressed data can
+       be referenced directly */
+    Containers::Optional<ImageData1D> image = importer->image1D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlags{});
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB8Srgb);
+    CORRADE_COMPARE(image->size(), (Math::Vector<1, Int>{4}));
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayCast<const char>(PatternRgb1DData[0]), TestSuite::Compare::Container);
+}
+
 void KtxImporterTest::openTwice() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("KtxImporter");
 
@@ -0,0 +1,132 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "MagnumPlugins/Implementation/PixelTransform.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct PixelTransformBenchmark: TestSuite::Tester {
+    explicit PixelTransformBenchmark();
+
+    void benchmarkTwoPass();
+    void benchmarkSinglePass();
+};
+
+constexpr std::size_t Width = 1024;
+constexpr std::size_t Height = 1024;
+
+constexpr struct {
+    const char* name;
+    std::size_t pixelSize, typeSize;
+    bool swizzle, endianSwap, flipX, flipY;
+} TransformData[]{
+    {"RGB8, swizzle", 3, 1, true, false, false, false},
+    {"RGBA8, swizzle", 4, 1, true, false, false, false},
+    {"RGBA8, swizzle, Y flip", 4, 1, true, false, false, true},
+    {"RGBA8, swizzle, X flip", 4, 1, true, false, true, false},
+    {"RG16, endian swap", 4, 2, false, true, false, false},
+    {"RGB16, endian swap, X flip", 6, 2, false, true, true, false},
+    {"RGBA16, swizzle, endian swap", 8, 2, true, true, false, false},
+    {"RGB32, swizzle", 12, 4, true, false, false, false},
+    {"RGBA32, endian swap", 16, 4, false, true, false, false},
+    {"RGBA32, swizzle, endian swap, Y flip", 16, 4, true, true, false, true},
+    {"RG64, endian swap", 16, 8, false, true, false, false},
+    {"RGBA8, copy, Y flip", 4, 1, false, false, false, true}
+};
+
+PixelTransformBenchmark::PixelTransformBenchmark() {
+    addInstancedBenchmarks({&PixelTransformBenchmark::benchmarkTwoPass,
+                            &PixelTransformBenchmark::benchmarkSinglePass}, 10,
+        Containers::arraySize(TransformData));
+}
+
+Containers::Array<char> generateData(std::size_t pixelSize) {
+    Containers::Array<char> data{NoInit, Width*Height*pixelSize};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = char(i*37 + i/pixelSize);
+    return data;
+}
+
+Containers::StridedArrayView4D<const char> sourceView(const Containers::ArrayView<const char> data, std::size_t pixelSize, bool flipX, bool flipY) {
+    Containers::StridedArrayView4D<const char> view{data, {1, Height, Width, pixelSize}};
+    if(flipX) view = view.flipped<2>();
+    if(flipY) view = view.flipped<1>();
+    return view;
+}
+
+/* What the plugins were doing originally -- a (possibly flipping) copy
+   followed by a swizzle and an endian swap operating on the output, each
+   going through the whole image again */
+void transformTwoPass(const Containers::StridedArrayView4D<const char>& src, Containers::ArrayView<char> dst, std::size_t pixelSize, std::size_t typeSize, bool swizzle, bool endianSwap) {
+    Utility::copy(src, Containers::StridedArrayView4D<char>{dst, src.size()});
+
+    if(swizzle) for(std::size_t i = 0; i < dst.size(); i += pixelSize) {
+        char* const pixel = dst + i;
+        for(std::size_t b = 0; b != typeSize; ++b)
+            std::swap(pixel[b], pixel[2*typeSize + b]);
+    }
+
+    if(endianSwap) for(std::size_t i = 0; i < dst.size(); i += typeSize)
+        std::reverse(dst + i, dst + i + typeSize);
+}
+
+void PixelTransformBenchmark::benchmarkTwoPass() {
+    auto&& data = TransformData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Containers::Array<char> in = generateData(data.pixelSize);
+    const Containers::StridedArrayView4D<const char> src = sourceView(in, data.pixelSize, data.flipX, data.flipY);
+    Containers::Array<char> out{NoInit, in.size()};
+
+    CORRADE_BENCHMARK(5)
+        transformTwoPass(src, out, data.pixelSize, data.typeSize, data.swizzle, data.endianSwap);
+
+    CORRADE_COMPARE(out.size(), in.size());
+}
+
+void PixelTransformBenchmark::benchmarkSinglePass() {
+    auto&& data = TransformData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Containers::Array<char> in = generateData(data.pixelSize);
+    const Containers::StridedArrayView4D<const char> src = sourceView(in, data.pixelSize, data.flipX, data.flipY);
+    Containers::Array<char> out{NoInit, in.size()};
+
+    const Implementation::PixelTransform transform{data.pixelSize, data.typeSize, data.swizzle, data.endianSwap};
+    CORRADE_BENCHMARK(5)
+        Implementation::transformPixels(transform, src, Containers::StridedArrayView4D<char>{out, src.size()});
+
+    CORRADE_COMPARE(out.size(), in.size());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::PixelTransformBenchmark)
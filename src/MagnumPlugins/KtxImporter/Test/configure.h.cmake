@@ -26,3 +26,6 @@
 
 #cmakedefine KTXIMPORTER_PLUGIN_FILENAME "${KTXIMPORTER_PLUGIN_FILENAME}"
 #define KTXIMPORTER_TEST_DIR "${KTXIMPORTER_TEST_DIR}"
+#define KTXIMPORTER_TEST_OUTPUT_DIR "${KTXIMPORTER_TEST_OUTPUT_DIR}"
+#cmakedefine MAGNUM_KTXIMPORTER_WITH_ZSTD
+#cmakedefine MAGNUM_KTXIMPORTER_WITH_ZLIB
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+
+#
+#   This file is part of Magnum.
+#
+#   Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+#               2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+#
+#   Permission is hereby granted, free of charge, to any person obtaining a
+#   copy of this software and associated documentation files (the "Software"),
+#   to deal in the Software without restriction, including without limitation
+#   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+#   and/or sell copies of the Software, and to permit persons to whom the
+#   Software is furnished to do so, subject to the following conditions:
+#
+#   The above copyright notice and this permission notice shall be included
+#   in all copies or substantial portions of the Software.
+#
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+#   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+#   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+#   DEALINGS IN THE SOFTWARE.
+#
+
+# Supercompresses the levels of an existing KTX2 file with Zstandard or zlib.
+# Khronos Texture Tools can do only the former and only with a fresh input, so
+# this is used to create the *-zstd.ktx2 and *-zlib.ktx2 test files from the
+# uncompressed ones. Zstandard compression needs the zstd command-line tool.
+# With --truncate, the first level has its last byte cut off before compressing
+# but the level index still states the original size, to test that the
+# importer checks the size after decompression.
+#
+#   ./supercompress.py [--truncate] zstd|zlib input.ktx2 output.ktx2
+
+import struct
+import subprocess
+import sys
+import zlib
+
+args = sys.argv[1:]
+truncate = args[0] == '--truncate'
+if truncate: args = args[1:]
+scheme, input, output = args
+
+with open(input, 'rb') as f:
+    data = bytearray(f.read())
+
+# identifier, vkFormat, typeSize, pixelWidth/Height/Depth, layerCount,
+# faceCount, levelCount, supercompressionScheme, dfdByteOffset/Length,
+# kvdByteOffset/Length, sgdByteOffset/Length
+header_format = '<12sIIIIIIIIIIIIIQQ'
+header = list(struct.unpack_from(header_format, data))
+assert header[9] == 0, "the input is already supercompressed"
+level_count = max(header[8], 1)
+dfd_offset = header[10]
+
+# Levels with the original data, the level index is sorted from the largest
+levels = []
+for i in range(level_count):
+    offset, length, _ = struct.unpack_from('<QQQ', data, 80 + i*24)
+    levels += [bytes(data[offset:offset + length])]
+
+def compress(level):
+    if scheme == 'zlib':
+        return zlib.compress(level, 9)
+    return subprocess.run(['zstd', '-19', '-c', '-q'], input=level,
+        stdout=subprocess.PIPE, check=True).stdout
+
+# Keep everything until the first level (header, level index, DFD, key/value
+# data), data of supercompressed levels don't need any alignment
+first_offset = min(struct.unpack_from('<Q', data, 80 + i*24)[0] for i in range(level_count))
+out = data[:first_offset]
+header[9] = {'zstd': 2, 'zlib': 3}[scheme]
+struct.pack_into(header_format, out, 0, *header)
+
+# The spec wants bytesPlane0 in the DFD to be 0 for supercompressed data
+out[dfd_offset + 20] = 0
+
+# Level data are stored from the smallest
+for i in reversed(range(level_count)):
+    compressed = compress(levels[i][:-1] if truncate and i == 0 else levels[i])
+    struct.pack_into('<QQQ', out, 80 + i*24, len(out), len(compressed), len(levels[i]))
+    out += compressed
+
+with open(output, 'wb') as f:
+    f.write(out)
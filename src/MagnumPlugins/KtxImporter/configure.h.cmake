@@ -25,3 +25,5 @@
 */
 
 #cmakedefine MAGNUM_KTXIMPORTER_BUILD_STATIC
+#cmakedefine MAGNUM_KTXIMPORTER_WITH_ZSTD
+#cmakedefine MAGNUM_KTXIMPORTER_WITH_ZLIB
@@ -47,6 +47,8 @@
 #include <ImfStandardAttributes.h>
 #include <ImfTiledOutputFile.h>
 
+#include "MagnumPlugins/Implementation/openExrThreadCount.h"
+
 namespace Magnum { namespace Trade {
 
 using namespace Containers::Literals;
@@ -264,11 +266,12 @@ Containers::Array<char> convertToDataInternal(const Utility::ConfigurationGroup&
     Containers::Array<char> data;
     {
         MemoryOStream stream{data};
+        const int threads = Implementation::openExrThreadCount(configuration);
 
         /* Scanline output. Only if we have just one level and the output
            wasn't forced to be tiled. */
         if(levelCount == 1 && !configuration.value<bool>("forceTiledOutput")) {
-            Imf::OutputFile file{stream, header};
+            Imf::OutputFile file{stream, header, threads};
             file.setFrameBuffer(framebuffer);
 
             /* For consistency, the pixels are assumed to be ready only after
@@ -289,7 +292,7 @@ Containers::Array<char> convertToDataInternal(const Utility::ConfigurationGroup&
                 levelCount == 1 ? Imf::ONE_LEVEL : Imf::MIPMAP_LEVELS,
                 Imf::ROUND_DOWN}); /** @todo configurable? can't use a >> 1 then */
 
-            Imf::TiledOutputFile file{stream, header};
+            Imf::TiledOutputFile file{stream, header, threads};
             file.setFrameBuffer(framebuffer);
 
             /* There doesn't seem to be a way to set level count, it's
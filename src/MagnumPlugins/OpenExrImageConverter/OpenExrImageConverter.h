@@ -194,6 +194,19 @@ the @cb{.ini} tileSize @ce @ref Trade-OpenExrImporter-configuration "configurati
 Single-level images are implicitly written as scanline files, you can override
 that with the @cpp forceTiledOutput @ce option.
 
+@subsection Trade-OpenExrImageConverter-behavior-multithreading Multithreaded compression
+
+By default, the data are compressed on as many threads as
+@ref std::thread::hardware_concurrency() reports, using OpenEXR's own thread
+pool. The count can be changed with the @cb{.ini} threads @ce
+@ref Trade-OpenExrImageConverter-configuration "configuration option", setting
+it to `1` makes the conversion single-threaded. The output is the same
+regardless of the thread count.
+
+Same as with @ref Trade-OpenExrImporter-behavior-multithreading "OpenExrImporter",
+the global OpenEXR thread pool is enlarged if it has less threads than
+requested, but never shrunk.
+
 @section Trade-OpenExrImageConverter-configuration Plugin-specific configuration
 
 It's possible to tune various options mainly for channel mapping through
@@ -0,0 +1,150 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Half.h>
+#include <Magnum/Trade/AbstractImageConverter.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/ImageData.h>
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct OpenExrImageConverterBenchmark: TestSuite::Tester {
+    explicit OpenExrImageConverterBenchmark();
+
+    void convert();
+    void import();
+
+    Containers::Array<Half> _pixels;
+    Containers::Array<char> _files[9];
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImageConverter> _manager{"nonexistent"};
+    PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
+};
+
+constexpr Vector2i Size{2048, 1024};
+
+constexpr const char* Compression[]{
+    "", "rle", "zip", "zips", "piz", "pxr24", "b44", "dwaa", "dwab"
+};
+
+/* 0 is hardware concurrency */
+constexpr Int Threads[]{1, 2, 4, 0};
+
+OpenExrImageConverterBenchmark::OpenExrImageConverterBenchmark() {
+    addInstancedBenchmarks({&OpenExrImageConverterBenchmark::convert,
+                            &OpenExrImageConverterBenchmark::import}, 5,
+        Containers::arraySize(Compression)*Containers::arraySize(Threads));
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef OPENEXRIMAGECONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(OPENEXRIMAGECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    /* The OpenExrImporter is optional */
+    #ifdef OPENEXRIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_importerManager.load(OPENEXRIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    /* A RGBA16F image with smooth gradients and a bit of noise, similar to
+       what a rendered lightprobe would contain, to give the lossless
+       compressors something realistic to work with */
+    _pixels = Containers::Array<Half>{NoInit, std::size_t(Size.product()*4)};
+    UnsignedInt seed = 1;
+    for(Int y = 0; y != Size.y(); ++y) for(Int x = 0; x != Size.x(); ++x) {
+        for(Int c = 0; c != 4; ++c) {
+            seed = seed*1103515245 + 12345;
+            const Float noise = Float((seed >> 16) & 0xff)/2048.0f;
+            _pixels[(y*Size.x() + x)*4 + c] = Half{
+                c == 3 ? 1.0f : 4.0f*Math::sin(Rad(Float(x*(c + 1))/Float(Size.x())))*Float(y)/Float(Size.y()) + noise};
+        }
+    }
+
+    /* Files for the import benchmark, always produced single-threaded */
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("OpenExrImageConverter");
+    converter->configuration().setValue("threads", 1);
+    for(std::size_t i = 0; i != Containers::arraySize(Compression); ++i) {
+        converter->configuration().setValue("compression", Compression[i]);
+        _files[i] = converter->convertToData(ImageView2D{PixelFormat::RGBA16F, Size, _pixels});
+        CORRADE_INTERNAL_ASSERT(_files[i]);
+    }
+}
+
+void OpenExrImageConverterBenchmark::convert() {
+    const char* const compression = Compression[testCaseInstanceId()/Containers::arraySize(Threads)];
+    const Int threads = Threads[testCaseInstanceId()%Containers::arraySize(Threads)];
+    setTestCaseDescription(Utility::formatString("{}, {} threads",
+        *compression ? compression : "uncompressed",
+        threads ? Utility::formatString("{}", threads) : "all"));
+
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("OpenExrImageConverter");
+    converter->configuration().setValue("compression", compression);
+    converter->configuration().setValue("threads", threads);
+
+    const ImageView2D image{PixelFormat::RGBA16F, Size, _pixels};
+    Containers::Array<char> out;
+    CORRADE_BENCHMARK(1)
+        out = converter->convertToData(image);
+
+    CORRADE_VERIFY(out);
+}
+
+void OpenExrImageConverterBenchmark::import() {
+    const std::size_t compressionId = testCaseInstanceId()/Containers::arraySize(Threads);
+    const char* const compression = Compression[compressionId];
+    const Int threads = Threads[testCaseInstanceId()%Containers::arraySize(Threads)];
+    setTestCaseDescription(Utility::formatString("{}, {} threads",
+        *compression ? compression : "uncompressed",
+        threads ? Utility::formatString("{}", threads) : "all"));
+
+    if(_importerManager.loadState("OpenExrImporter") == PluginManager::LoadState::NotFound)
+        CORRADE_SKIP("OpenExrImporter plugin not found, cannot test");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("OpenExrImporter");
+    importer->configuration().setValue("threads", threads);
+
+    Containers::Optional<ImageData2D> image;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData(_files[compressionId]));
+        image = importer->image2D(0);
+    }
+
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Size);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::OpenExrImageConverterBenchmark)
@@ -86,6 +86,8 @@ struct OpenExrImageConverterTest: TestSuite::Tester {
     void compressionCubeMap();
     void compressionInvalid();
 
+    void threads();
+
     void levels2D();
     void levels2DIncomplete();
     void levels2DInvalidLevelSize();
@@ -194,6 +196,18 @@ const struct {
     {"piz", 395, 426}
 };
 
+const struct {
+    const char* name;
+    const char* compression;
+    bool tiled;
+    Int threads;
+} ThreadsData[]{
+    {"zip, 4 threads", "zip", false, 4},
+    {"zip, tiled, 4 threads", "zip", true, 4},
+    {"piz, 4 threads", "piz", false, 4},
+    {"piz, tiled, hardware concurrency", "piz", true, 0}
+};
+
 const struct {
     const char* name;
     const char* filename;
@@ -239,6 +253,9 @@ OpenExrImageConverterTest::OpenExrImageConverterTest() {
 
     addTests({&OpenExrImageConverterTest::compressionInvalid});
 
+    addInstancedTests({&OpenExrImageConverterTest::threads},
+        Containers::arraySize(ThreadsData));
+
     addInstancedTests({&OpenExrImageConverterTest::levels2D},
         Containers::arraySize(Levels2DData));
 
@@ -781,6 +798,43 @@ void OpenExrImageConverterTest::compressionInvalid() {
     CORRADE_COMPARE(out.str(), "Trade::OpenExrImageConverter::convertToData(): unknown compression zstd, allowed values are rle, zip, zips, piz, pxr24, b44, b44a, dwaa, dwab or empty for uncompressed output\n");
 }
 
+void OpenExrImageConverterTest::threads() {
+    auto&& data = ThreadsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Large enough to span many zip / piz line blocks and tiles so there's
+       actually something to do in parallel */
+    Containers::Array<Float> pixels{NoInit, 256*256*4};
+    for(std::size_t i = 0; i != pixels.size(); ++i)
+        pixels[i] = Float(i%1021)*0.25f;
+    const ImageView2D image{PixelFormat::RGBA32F, {256, 256}, pixels};
+
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("OpenExrImageConverter");
+    converter->configuration().setValue("compression", data.compression);
+    converter->configuration().setValue("forceTiledOutput", data.tiled);
+    converter->configuration().setValue("threads", 1);
+    const auto expected = converter->convertToData(image);
+    CORRADE_VERIFY(expected);
+
+    /* The output should be the same regardless of the thread count */
+    converter->configuration().setValue("threads", data.threads);
+    const auto out = converter->convertToData(image);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+
+    if(_importerManager.loadState("OpenExrImporter") == PluginManager::LoadState::NotFound)
+        CORRADE_SKIP("OpenExrImporter plugin not found, cannot test");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("OpenExrImporter");
+    importer->configuration().setValue("threads", data.threads);
+    CORRADE_VERIFY(importer->openData(out));
+
+    Containers::Optional<Trade::ImageData2D> imported = importer->image2D(0);
+    CORRADE_VERIFY(imported);
+    CORRADE_COMPARE_AS(*imported, image, DebugTools::CompareImage);
+}
+
 void OpenExrImageConverterTest::levels2D() {
     auto&& data = Levels2DData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -49,6 +49,8 @@
 #include <ImfTiledOutputFile.h>
 #include <ImfTestFile.h>
 
+#include "MagnumPlugins/Implementation/openExrThreadCount.h"
+
 namespace Magnum { namespace Trade {
 
 using namespace Containers::Literals;
@@ -146,8 +148,9 @@ void OpenExrImporter::doOpenData(const Containers::ArrayView<const char> data) {
        dealing with mipmaps and regular files. */
     const Imf::Header* header;
     try {
+        const int threads = Implementation::openExrThreadCount(configuration());
         if(Imf::isTiledOpenExrFile(state->stream)) {
-            state->tiledFile.emplace(state->stream);
+            state->tiledFile.emplace(state->stream, threads);
 
             /* Ripmap files need extra care, we don't support those at the
                moment. */
@@ -155,7 +158,7 @@ void OpenExrImporter::doOpenData(const Containers::ArrayView<const char> data) {
                 Warning{} << "Trade::OpenExrImporter::openData(): ripmap files not supported, importing only the top level";
                 state->tiledFile = Containers::NullOpt;
                 state->stream.seekg(0);
-                state->file.emplace(state->stream);
+                state->file.emplace(state->stream, threads);
                 state->completeLevelCount = 1;
                 header = &state->file->header();
             } else {
@@ -163,7 +166,7 @@ void OpenExrImporter::doOpenData(const Containers::ArrayView<const char> data) {
                 header = &state->tiledFile->header();
             }
         } else {
-            state->file.emplace(state->stream);
+            state->file.emplace(state->stream, threads);
             state->completeLevelCount = 1;
             header = &state->file->header();
         }
@@ -173,7 +176,6 @@ void OpenExrImporter::doOpenData(const Containers::ArrayView<const char> data) {
         return;
     }
 
-    /** @todo thread setup */
     /** @todo multipart support */
 
     /* Cube map files will be exposed as 3D images. However, because they're
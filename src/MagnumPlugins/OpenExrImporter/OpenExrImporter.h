@@ -207,6 +207,20 @@ also levels with @cpp height < 6 @ce. Because those would result in a 3D image
 with zero height, the smallest levels are ignored, with a message printed if
 @ref ImporterFlag::Verbose is enabled.
 
+@subsection Trade-OpenExrImporter-behavior-multithreading Multithreaded decompression
+
+By default, the file data are decompressed on as many threads as
+@ref std::thread::hardware_concurrency() reports, using OpenEXR's own thread
+pool. The count can be changed with the
+@cb{.ini} threads @ce @ref Trade-OpenExrImporter-configuration "configuration option",
+setting it to `1` makes the import single-threaded. The option is applied when
+opening a file, so it has to be set before calling @ref openData() or
+@ref openFile().
+
+The OpenEXR thread pool is global for the whole application. If it has less
+threads than requested, the plugin enlarges it, but never shrinks it to not
+affect other OpenEXR users, including @ref OpenExrImageConverter.
+
 @section Trade-OpenExrImporter-configuration Plugin-specific configuration
 
 It's possible to tune various options mainly for channel mapping through
@@ -74,6 +74,8 @@ struct OpenExrImporterTest: TestSuite::Tester {
     void levelsCubeMap();
     void levelsCubeMapIncomplete();
 
+    void threads();
+
     void openTwice();
     void importTwice();
 
@@ -102,6 +104,16 @@ const struct {
     {"custom data/display window", "envmap-cube-custom-windows.exr"},
 };
 
+const struct {
+    const char* name;
+    const char* filename;
+    Int threads;
+} ThreadsData[]{
+    {"scanline, 4 threads", "rgba32f.exr", 4},
+    {"tiled, 4 threads", "rgb16f-tiled.exr", 4},
+    {"tiled, hardware concurrency", "levels2D-tile1x1.exr", 0}
+};
+
 const struct {
     const char* name;
     const char* filename;
@@ -185,6 +197,9 @@ OpenExrImporterTest::OpenExrImporterTest() {
     addInstancedTests({&OpenExrImporterTest::levelsCubeMapIncomplete},
         Containers::arraySize(IncompletelCubeMapData));
 
+    addInstancedTests({&OpenExrImporterTest::threads},
+        Containers::arraySize(ThreadsData));
+
     addTests({&OpenExrImporterTest::openTwice,
               &OpenExrImporterTest::importTwice});
 
@@ -809,6 +824,29 @@ void OpenExrImporterTest::levelsCubeMapIncomplete() {
     }
 }
 
+void OpenExrImporterTest::threads() {
+    auto&& data = ThreadsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::string filename = Utility::Directory::join(OPENEXRIMPORTER_TEST_DIR, data.filename);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("OpenExrImporter");
+    importer->configuration().setValue("threads", 1);
+    CORRADE_VERIFY(importer->openFile(filename));
+    Containers::Optional<Trade::ImageData2D> expected = importer->image2D(0);
+    CORRADE_VERIFY(expected);
+
+    /* The option is applied on opening, so the file has to be reopened */
+    importer->configuration().setValue("threads", data.threads);
+    CORRADE_VERIFY(importer->openFile(filename));
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->format(), expected->format());
+    CORRADE_COMPARE(image->size(), expected->size());
+    CORRADE_COMPARE_AS(image->data(), expected->data(),
+        TestSuite::Compare::Container);
+}
+
 void OpenExrImporterTest::openTwice() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("OpenExrImporter");
 
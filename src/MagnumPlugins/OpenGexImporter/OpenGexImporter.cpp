@@ -26,7 +26,6 @@
 
 #include "OpenGexImporter.h"
 
-#include <algorithm>
 #include <limits>
 #include <unordered_map>
 #include <Corrade/Containers/ArrayView.h>
@@ -76,6 +75,11 @@ struct OpenGexImporter::Document {
         materials,
         textures;
 
+    /* Indexed with OpenDdl::Structure::index(), contains ID of the structure
+       in whichever of the above lists it's in, or ~UnsignedInt{} if it's in
+       none of them. Used to resolve references in constant time. */
+    std::vector<UnsignedInt> structureIds;
+
     std::unordered_map<std::string, Int> nodesForName,
         materialsForName;
 
@@ -88,14 +92,14 @@ struct OpenGexImporter::Document {
 
 namespace {
 
-inline Int findStructureId(const std::vector<OpenDdl::Structure>& structures, OpenDdl::Structure structure) {
-    auto found = std::find(structures.begin(), structures.end(), structure);
-    return found == structures.end() ? -1 : found - structures.begin();
+void addStructure(std::vector<UnsignedInt>& structureIds, std::vector<OpenDdl::Structure>& structures, const OpenDdl::Structure structure) {
+    structureIds[structure.index()] = structures.size();
+    structures.push_back(structure);
 }
 
-UnsignedInt structureId(const std::vector<OpenDdl::Structure>& structures, OpenDdl::Structure structure) {
-    const Int id = findStructureId(structures, structure);
-    CORRADE_INTERNAL_ASSERT(id != -1);
+UnsignedInt structureId(const std::vector<UnsignedInt>& structureIds, const std::vector<OpenDdl::Structure>& structures, const OpenDdl::Structure structure) {
+    const UnsignedInt id = structureIds[structure.index()];
+    CORRADE_INTERNAL_ASSERT(id < structures.size() && structures[id] == structure);
     return id;
 }
 
@@ -115,14 +119,14 @@ bool OpenGexImporter::doIsOpened() const { return !!_d; }
 
 namespace {
 
-void gatherNodes(OpenDdl::Structure node, std::vector<OpenDdl::Structure>& nodes, std::unordered_map<std::string, Int>& nodesForName) {
+void gatherNodes(OpenDdl::Structure node, std::vector<UnsignedInt>& structureIds, std::vector<OpenDdl::Structure>& nodes, std::unordered_map<std::string, Int>& nodesForName) {
     if(const auto name = node.findFirstChildOf(OpenGex::Name))
         nodesForName.emplace(name->firstChild().as<std::string>(), nodes.size());
-    nodes.push_back(node);
+    addStructure(structureIds, nodes, node);
 
     /* Recurse into children */
     for(const OpenDdl::Structure childNode: node.childrenOf(OpenGex::Node, OpenGex::BoneNode, OpenGex::GeometryNode, OpenGex::CameraNode, OpenGex::LightNode))
-        gatherNodes(childNode, nodes, nodesForName);
+        gatherNodes(childNode, structureIds, nodes, nodesForName);
 }
 
 }
@@ -136,6 +140,8 @@ void OpenGexImporter::doOpenData(const Containers::ArrayView<const char> data) {
     /* Validate the document */
     if(!d->document.validate(OpenGex::rootStructures, OpenGex::structureInfo)) return;
 
+    d->structureIds.resize(d->document.structureCount(), ~UnsignedInt{});
+
     /* Metrics */
     for(const OpenDdl::Structure metric: d->document.childrenOf(OpenGex::Metric)) {
         auto&& key = metric.propertyOf(OpenGex::key).as<std::string>();
@@ -181,7 +187,7 @@ void OpenGexImporter::doOpenData(const Containers::ArrayView<const char> data) {
 
     /* Common code for light and material textures */
     auto gatherTexture = [&d](const OpenDdl::Structure& texture) {
-        d->textures.push_back(texture);
+        addStructure(d->structureIds, d->textures, texture);
 
         /* Add the filename to the list, if not already */
         const std::string filename = texture.firstChildOf(OpenDdl::Type::String).as<std::string>();
@@ -191,16 +197,16 @@ void OpenGexImporter::doOpenData(const Containers::ArrayView<const char> data) {
 
     /* Gather all cameras */
     for(const OpenDdl::Structure camera: d->document.childrenOf(OpenGex::CameraObject))
-        d->cameras.push_back(camera);
+        addStructure(d->structureIds, d->cameras, camera);
 
     /* Gather all meshes */
     /** @todo Support for LOD */
     for(const OpenDdl::Structure geometry: d->document.childrenOf(OpenGex::GeometryObject))
-        d->meshes.push_back(geometry);
+        addStructure(d->structureIds, d->meshes, geometry);
 
     /* Gather all lights and light textures */
     for(const OpenDdl::Structure light: d->document.childrenOf(OpenGex::LightObject)) {
-        d->lights.push_back(light);
+        addStructure(d->structureIds, d->lights, light);
 
         for(const OpenDdl::Structure texture: light.childrenOf(OpenGex::Texture))
             gatherTexture(texture);
@@ -211,7 +217,7 @@ void OpenGexImporter::doOpenData(const Containers::ArrayView<const char> data) {
         for(const OpenDdl::Structure material: d->document.childrenOf(OpenGex::Material)) {
             if(const auto name = material.findFirstChildOf(OpenGex::Name))
                 d->materialsForName.emplace(name->firstChild().as<std::string>(), d->materials.size());
-            d->materials.push_back(material);
+            addStructure(d->structureIds, d->materials, material);
 
             /* Gather all material textures */
             for(const OpenDdl::Structure texture: material.childrenOf(OpenGex::Texture))
@@ -221,7 +227,7 @@ void OpenGexImporter::doOpenData(const Containers::ArrayView<const char> data) {
 
     /* Gather the scene nodes */
     for(const OpenDdl::Structure node: d->document.childrenOf(OpenGex::Node, OpenGex::BoneNode, OpenGex::GeometryNode, OpenGex::CameraNode, OpenGex::LightNode))
-        gatherNodes(node, d->nodes, d->nodesForName);
+        gatherNodes(node, d->structureIds, d->nodes, d->nodesForName);
 
     /* Everything okay, save the instance */
     _d = std::move(d);
@@ -428,7 +434,7 @@ Containers::Pointer<ObjectData3D> OpenGexImporter::doObject3D(const UnsignedInt
     /* Child node IDs */
     std::vector<UnsignedInt> children;
     for(const OpenDdl::Structure childNode: node.childrenOf(OpenGex::Node, OpenGex::BoneNode, OpenGex::GeometryNode, OpenGex::CameraNode, OpenGex::LightNode))
-        children.push_back(structureId(_d->nodes, childNode));
+        children.push_back(structureId(_d->structureIds, _d->nodes, childNode));
 
     /* Mesh object */
     if(node.identifier() == OpenGex::GeometryNode) {
@@ -438,14 +444,14 @@ Containers::Pointer<ObjectData3D> OpenGexImporter::doObject3D(const UnsignedInt
             Error() << "Trade::OpenGexImporter::object3D(): null geometry reference";
             return nullptr;
         }
-        const UnsignedInt meshId = structureId(_d->meshes, *mesh);
+        const UnsignedInt meshId = structureId(_d->structureIds, _d->meshes, *mesh);
 
         /* Material ID, if present */
         /** @todo support more materials per mesh */
         Int materialId = -1;
         if(const auto materialRef = node.findFirstChildOf(OpenGex::MaterialRef))
             if(const auto material = materialRef->firstChildOf(OpenDdl::Type::Reference).asReference())
-                materialId = structureId(_d->materials, *material);
+                materialId = structureId(_d->structureIds, _d->materials, *material);
 
         return Containers::pointer(new MeshObjectData3D{children, transformation, meshId, materialId, -1, &node});
 
@@ -457,7 +463,7 @@ Containers::Pointer<ObjectData3D> OpenGexImporter::doObject3D(const UnsignedInt
             Error() << "Trade::OpenGexImporter::object3D(): null camera reference";
             return nullptr;
         }
-        const UnsignedInt cameraId = structureId(_d->cameras, *camera);
+        const UnsignedInt cameraId = structureId(_d->structureIds, _d->cameras, *camera);
 
         return Containers::pointer(new ObjectData3D{children, transformation, ObjectInstanceType3D::Camera, cameraId, &node});
 
@@ -469,7 +475,7 @@ Containers::Pointer<ObjectData3D> OpenGexImporter::doObject3D(const UnsignedInt
             Error() << "Trade::OpenGexImporter::object3D(): null light reference";
             return nullptr;
         }
-        const UnsignedInt lightId = structureId(_d->lights, *light);
+        const UnsignedInt lightId = structureId(_d->structureIds, _d->lights, *light);
 
         return Containers::pointer(new ObjectData3D{children, transformation, ObjectInstanceType3D::Light, lightId, &node});
     }
@@ -768,9 +774,9 @@ Containers::Optional<MaterialData> OpenGexImporter::doMaterial(const UnsignedInt
     for(const OpenDdl::Structure texture: material.childrenOf(OpenGex::Texture)) {
         const auto& attrib = texture.propertyOf(OpenGex::attrib).as<std::string>();
         if(attrib == "diffuse") {
-            arrayAppend(attributes, InPlaceInit, MaterialAttribute::DiffuseTexture, structureId(_d->textures, texture));
+            arrayAppend(attributes, InPlaceInit, MaterialAttribute::DiffuseTexture, structureId(_d->structureIds, _d->textures, texture));
         } else if(attrib == "specular") {
-            arrayAppend(attributes, InPlaceInit, MaterialAttribute::SpecularTexture, structureId(_d->textures, texture));
+            arrayAppend(attributes, InPlaceInit, MaterialAttribute::SpecularTexture, structureId(_d->structureIds, _d->textures, texture));
         }
     }
 
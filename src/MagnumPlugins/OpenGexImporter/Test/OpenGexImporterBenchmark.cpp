@@ -0,0 +1,135 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/ObjectData3D.h>
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct OpenGexImporterBenchmark: TestSuite::Tester {
+    explicit OpenGexImporterBenchmark();
+
+    void openData();
+    void object3D();
+
+    std::string _data;
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+/* 1000 root nodes with 99 children each, every child referencing one of a
+   few meshes and materials */
+constexpr std::size_t RootNodeCount = 1000;
+constexpr std::size_t ChildNodeCount = 99;
+constexpr std::size_t NodeCount = RootNodeCount*(ChildNodeCount + 1);
+constexpr std::size_t MeshCount = 100;
+constexpr std::size_t MaterialCount = 10;
+
+std::string generateScene() {
+    std::string out;
+
+    for(std::size_t i = 0; i != MeshCount; ++i)
+        out += Utility::formatString(
+            "GeometryObject %mesh{} {{\n"
+            "    Mesh {{ VertexArray (attrib = \"position\") {{ float[3] {{ {{0.0, 0.0, 0.0}} }} }} }}\n"
+            "}}\n", i);
+
+    for(std::size_t i = 0; i != MaterialCount; ++i)
+        out += Utility::formatString("Material %material{} {{}}\n", i);
+
+    for(std::size_t i = 0; i != RootNodeCount; ++i) {
+        out += Utility::formatString(
+            "Node {{\n"
+            "    Name {{ string {{ \"node{}\" }} }}\n", i);
+        for(std::size_t j = 0; j != ChildNodeCount; ++j)
+            out += Utility::formatString(
+                "    GeometryNode {{\n"
+                "        ObjectRef {{ ref {{ %mesh{} }} }}\n"
+                "        MaterialRef {{ ref {{ %material{} }} }}\n"
+                "        Translation {{ float[3] {{ {{{}.0, 0.0, 1.5}} }} }}\n"
+                "    }}\n", (i*ChildNodeCount + j)%MeshCount, j%MaterialCount, j);
+        out += "}\n";
+    }
+
+    return out;
+}
+
+OpenGexImporterBenchmark::OpenGexImporterBenchmark() {
+    addBenchmarks({&OpenGexImporterBenchmark::openData,
+                   &OpenGexImporterBenchmark::object3D}, 5);
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef OPENGEXIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(OPENGEXIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    _data = generateScene();
+}
+
+void OpenGexImporterBenchmark::openData() {
+    setTestCaseDescription(Utility::formatString("{} nodes", NodeCount));
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("OpenGexImporter");
+
+    CORRADE_BENCHMARK(1)
+        CORRADE_VERIFY(importer->openData({_data.data(), _data.size()}));
+
+    CORRADE_COMPARE(importer->object3DCount(), NodeCount);
+}
+
+void OpenGexImporterBenchmark::object3D() {
+    setTestCaseDescription(Utility::formatString("{} nodes", NodeCount));
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("OpenGexImporter");
+    CORRADE_VERIFY(importer->openData({_data.data(), _data.size()}));
+    CORRADE_COMPARE(importer->object3DCount(), NodeCount);
+
+    /* Each node resolves its children, mesh and material, which used to be a
+       linear search through all nodes, meshes and materials */
+    std::size_t meshIdSum = 0;
+    std::size_t childCount = 0;
+    CORRADE_BENCHMARK(1) {
+        for(UnsignedInt i = 0; i != NodeCount; ++i) {
+            Containers::Pointer<ObjectData3D> object = importer->object3D(i);
+            childCount += object->children().size();
+            if(object->instanceType() == ObjectInstanceType3D::Mesh)
+                meshIdSum += object->instance();
+        }
+    }
+
+    CORRADE_COMPARE(childCount, RootNodeCount*ChildNodeCount);
+    CORRADE_COMPARE(meshIdSum, RootNodeCount*ChildNodeCount*(MeshCount - 1)/2);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::OpenGexImporterBenchmark)
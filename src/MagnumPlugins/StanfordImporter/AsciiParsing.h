@@ -0,0 +1,219 @@
+#ifndef Magnum_Trade_AsciiParsing_h
+#define Magnum_Trade_AsciiParsing_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <Corrade/Containers/ArrayView.h>
+#include <Magnum/Magnum.h>
+
+/* Used by both StanfordImporter and StlImporter, which is why it isn't
+   directly inside StanfordImporter.cpp. OTOH it doesn't need to be exposed
+   publicly, which is why it has no docblocks. */
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+/* Everything up to and including a space is treated as a whitespace, which
+   means all control characters are delimiters as well. Makes the check a
+   single comparison. */
+inline bool isAsciiWhitespace(const char c) {
+    return UnsignedByte(c) <= ' ';
+}
+
+/* Returns the next whitespace-delimited token and advances `in` past it. If
+   there's nothing left, returns an empty view. */
+inline Containers::ArrayView<const char> nextAsciiToken(Containers::ArrayView<const char>& in) {
+    const char* it = in.begin();
+    const char* const end = in.end();
+    while(it != end && isAsciiWhitespace(*it)) ++it;
+    const char* const begin = it;
+    while(it != end && !isAsciiWhitespace(*it)) ++it;
+    in = {it, std::size_t(end - it)};
+    return {begin, std::size_t(it - begin)};
+}
+
+/* Advances `in` past the end of the current line */
+inline void skipAsciiLine(Containers::ArrayView<const char>& in) {
+    const char* it = in.begin();
+    const char* const end = in.end();
+    while(it != end && *it != '\n') ++it;
+    if(it != end) ++it;
+    in = {it, std::size_t(end - it)};
+}
+
+inline bool asciiTokenEquals(const Containers::ArrayView<const char> token, const char* const string) {
+    std::size_t i = 0;
+    for(; i != token.size(); ++i)
+        if(token[i] != string[i]) return false;
+    return string[i] == '\0';
+}
+
+/* Parses a whole token as a (signed) decimal integer, returns false if it's
+   not a valid integer or it doesn't fit into 64 bits */
+inline bool parseAsciiInteger(const Containers::ArrayView<const char> token, Long& out) {
+    const char* it = token.begin();
+    const char* const end = token.end();
+
+    bool negative = false;
+    if(it != end && (*it == '-' || *it == '+')) {
+        negative = *it == '-';
+        ++it;
+    }
+
+    /* 18 digits fit into a 63-bit value always, anything longer is rejected
+       instead of doing overflow checks in each iteration */
+    if(it == end || end - it > 18) return false;
+
+    Long value = 0;
+    for(; it != end; ++it) {
+        const UnsignedInt digit = UnsignedByte(*it) - '0';
+        if(digit > 9) return false;
+        value = value*10 + digit;
+    }
+
+    out = negative ? -value : value;
+    return true;
+}
+
+/* Parses a whole token as a decimal floating-point number, locale
+   independently. Returns false if it's not a valid number.
+
+   The mantissa digits are accumulated into a 64-bit integer, and if both the
+   mantissa and the power of ten are exactly representable in a double, which
+   is the case for the vast majority of real-world data, a single
+   multiplication or division gives a correctly rounded result (Clinger's fast
+   path). Otherwise it falls back to std::pow(), which may be off by one ulp
+   for numbers with more than 15 significant digits or extreme exponents. */
+inline bool parseAsciiDouble(const Containers::ArrayView<const char> token, Double& out) {
+    constexpr Double ExactPowersOfTen[]{
+        1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7, 1.0e8, 1.0e9,
+        1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16, 1.0e17,
+        1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22
+    };
+    /* Once the mantissa is above this, another digit wouldn't fit */
+    constexpr std::uint64_t MantissaLimit = 1000000000000000000ull;
+
+    const char* it = token.begin();
+    const char* const end = token.end();
+
+    bool negative = false;
+    if(it != end && (*it == '-' || *it == '+')) {
+        negative = *it == '-';
+        ++it;
+    }
+
+    /* Infinity and NaN, as printed by printf() on various platforms */
+    const Containers::ArrayView<const char> rest{it, std::size_t(end - it)};
+    if(asciiTokenEquals(rest, "inf") || asciiTokenEquals(rest, "Inf") || asciiTokenEquals(rest, "INF") || asciiTokenEquals(rest, "infinity")) {
+        out = negative ? -std::numeric_limits<Double>::infinity() : std::numeric_limits<Double>::infinity();
+        return true;
+    }
+    if(asciiTokenEquals(rest, "nan") || asciiTokenEquals(rest, "NaN") || asciiTokenEquals(rest, "NAN")) {
+        out = std::numeric_limits<Double>::quiet_NaN();
+        return true;
+    }
+
+    std::uint64_t mantissa = 0;
+    Int exponent = 0;
+    std::size_t digitCount = 0;
+
+    /* Integral part. Digits that no longer fit into the mantissa only
+       increase the exponent. */
+    for(; it != end; ++it, ++digitCount) {
+        const UnsignedInt digit = UnsignedByte(*it) - '0';
+        if(digit > 9) break;
+        if(mantissa < MantissaLimit) mantissa = mantissa*10 + digit;
+        else ++exponent;
+    }
+
+    /* Fractional part. Digits that no longer fit are dropped. */
+    if(it != end && *it == '.') {
+        for(++it; it != end; ++it, ++digitCount) {
+            const UnsignedInt digit = UnsignedByte(*it) - '0';
+            if(digit > 9) break;
+            if(mantissa < MantissaLimit) {
+                mantissa = mantissa*10 + digit;
+                --exponent;
+            }
+        }
+    }
+
+    if(!digitCount) return false;
+
+    /* Exponent. Clamped to a value that's large enough to make the result
+       either zero or infinity. */
+    if(it != end && (*it == 'e' || *it == 'E')) {
+        ++it;
+        bool negativeExponent = false;
+        if(it != end && (*it == '-' || *it == '+')) {
+            negativeExponent = *it == '-';
+            ++it;
+        }
+
+        if(it == end) return false;
+        Int explicitExponent = 0;
+        for(; it != end; ++it) {
+            const UnsignedInt digit = UnsignedByte(*it) - '0';
+            if(digit > 9) return false;
+            if(explicitExponent < 100000)
+                explicitExponent = explicitExponent*10 + digit;
+        }
+
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    /* Trailing garbage */
+    if(it != end) return false;
+
+    Double value;
+    if(mantissa == 0)
+        value = 0.0;
+    else if(mantissa <= (std::uint64_t{1} << 53) && exponent >= -22 && exponent <= 22)
+        value = exponent < 0 ?
+            Double(mantissa)/ExactPowersOfTen[-exponent] :
+            Double(mantissa)*ExactPowersOfTen[exponent];
+    /* Split the power for denormals, as 10^exponent alone would underflow
+       to zero */
+    else if(exponent < -300)
+        value = Double(mantissa)*std::pow(10.0, exponent + 300)*1.0e-300;
+    else
+        value = Double(mantissa)*std::pow(10.0, exponent);
+
+    out = negative ? -value : value;
+    return true;
+}
+
+inline bool parseAsciiFloat(const Containers::ArrayView<const char> token, Float& out) {
+    Double value;
+    if(!parseAsciiDouble(token, value)) return false;
+    out = Float(value);
+    return true;
+}
+
+}}}
+
+#endif
@@ -26,6 +26,8 @@
 
 #include "StanfordImporter.h"
 
+#include <cstring>
+#include <thread>
 #include <unordered_map>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/GrowableArray.h>
@@ -38,14 +40,17 @@
 #include <Corrade/Utility/String.h>
 #include <Magnum/Mesh.h>
 #include <Magnum/Math/Color.h>
+#include <Magnum/Math/Functions.h>
 #include <Magnum/MeshTools/Combine.h>
 #include <Magnum/Trade/ArrayAllocator.h>
 #include <Magnum/Trade/MeshData.h>
 
+#include "MagnumPlugins/Implementation/ImporterFileData.h"
+#include "MagnumPlugins/StanfordImporter/AsciiParsing.h"
+
 namespace Magnum { namespace Trade {
 
-struct StanfordImporter::State {
-    Containers::Array<char> data;
+struct StanfordImporter::State: Implementation::ImporterFileData {
     std::size_t headerSize;
     Containers::Array<MeshAttributeData> attributeData;
     Containers::Array<MeshAttributeData> faceAttributeData;
@@ -62,6 +67,9 @@ StanfordImporter::StanfordImporter() {
     configuration().setValue("perFaceToPerVertex", true);
     configuration().setValue("triangleFastPath", true);
     configuration().setValue("objectIdAttribute", "object_id");
+    configuration().setValue("threads", 1);
+    configuration().setValue("memoryMapFile", false);
+    configuration().setValue("borrowData", false);
 }
 
 StanfordImporter::StanfordImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
@@ -75,18 +83,18 @@ bool StanfordImporter::doIsOpened() const { return !!_state; }
 void StanfordImporter::doClose() { _state = nullptr; }
 
 void StanfordImporter::doOpenFile(const std::string& filename) {
-    if(!Utility::Directory::exists(filename)) {
-        Error{} << "Trade::StanfordImporter::openFile(): cannot open file" << filename;
+    auto state = Containers::pointer<State>();
+    if(!state->openFile(filename, configuration().value<bool>("memoryMapFile"), "Trade::StanfordImporter::openFile():"))
         return;
-    }
 
-    openDataInternal(Utility::Directory::read(filename));
+    openDataInternal(std::move(state));
 }
 
 void StanfordImporter::doOpenData(Containers::ArrayView<const char> data) {
-    Containers::Array<char> copy{NoInit, data.size()};
-    Utility::copy(data, copy);
-    openDataInternal(std::move(copy));
+    auto state = Containers::pointer<State>();
+    state->openData(data, configuration().value<bool>("borrowData"));
+
+    openDataInternal(std::move(state));
 }
 
 namespace {
@@ -167,6 +175,87 @@ std::string extractLine(Containers::ArrayView<const char>& in) {
     return {out.begin(), out.end()};
 }
 
+VertexFormat indexTypeVertexFormat(const MeshIndexType type) {
+    switch(type) {
+        /* LCOV_EXCL_START */
+        #define _c(type) case MeshIndexType::type: return VertexFormat::type;
+        _c(UnsignedByte)
+        _c(UnsignedShort)
+        _c(UnsignedInt)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* Parses an ASCII value of given element property as given type and writes
+   it to `out` in native endianness, returning the size written or 0 on
+   failure. Integer values have to fit into the range of the type, otherwise
+   they would get silently truncated in the binary representation. */
+std::size_t parseAsciiValue(const Containers::ArrayView<const char> token, const VertexFormat format, const char* const element, const std::string& property, char* const out) {
+    if(format == VertexFormat::Float || format == VertexFormat::Double) {
+        Double value;
+        if(!Implementation::parseAsciiDouble(token, value)) {
+            Error{} << "Trade::StanfordImporter::openData(): invalid" << element << "property" << property << "value" << std::string{token.begin(), token.end()};
+            return 0;
+        }
+        if(format == VertexFormat::Double) {
+            std::memcpy(out, &value, 8);
+            return 8;
+        }
+
+        const Float floatValue = Float(value);
+        std::memcpy(out, &floatValue, 4);
+        return 4;
+    }
+
+    Long value;
+    if(!Implementation::parseAsciiInteger(token, value)) {
+        Error{} << "Trade::StanfordImporter::openData(): invalid" << element << "property" << property << "value" << std::string{token.begin(), token.end()};
+        return 0;
+    }
+
+    Long min, max;
+    std::size_t size;
+    switch(format) {
+        case VertexFormat::UnsignedByte: min = 0; max = 0xff; size = 1; break;
+        case VertexFormat::Byte: min = -0x80; max = 0x7f; size = 1; break;
+        case VertexFormat::UnsignedShort: min = 0; max = 0xffff; size = 2; break;
+        case VertexFormat::Short: min = -0x8000; max = 0x7fff; size = 2; break;
+        case VertexFormat::UnsignedInt: min = 0; max = 0xffffffffll; size = 4; break;
+        case VertexFormat::Int: min = -0x80000000ll; max = 0x7fffffff; size = 4; break;
+        default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+
+    if(value < min || value > max) {
+        Error{} << "Trade::StanfordImporter::openData():" << element << "property" << property << "value" << value << "out of range for" << format;
+        return 0;
+    }
+
+    /* Two's complement, so the low bytes of the value are the same for
+       both the signed and unsigned variant */
+    switch(size) {
+        case 1: {
+            const UnsignedByte integerValue = UnsignedByte(value);
+            std::memcpy(out, &integerValue, 1);
+            return 1;
+        }
+        case 2: {
+            const UnsignedShort integerValue = UnsignedShort(value);
+            std::memcpy(out, &integerValue, 2);
+            return 2;
+        }
+        case 4: {
+            const UnsignedInt integerValue = UnsignedInt(value);
+            std::memcpy(out, &integerValue, 4);
+            return 4;
+        }
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
 template<std::size_t size> bool checkVectorAttributeValidity(const Math::Vector<size, VertexFormat>& formats, const Math::Vector<size, UnsignedInt>& offsets, const char* name) {
     /* Check that we have the same type for all position coordinates */
     if(formats != Math::Vector<size, VertexFormat>{formats[0]}) {
@@ -188,22 +277,20 @@ template<std::size_t size> bool checkVectorAttributeValidity(const Math::Vector<
 
 }
 
-void StanfordImporter::openDataInternal(Containers::Array<char>&& data) {
-    /* Because here we're copying the data and using the _in to check if file
-       is opened, having them nullptr would mean openData() would fail without
-       any error message. It's not possible to do this check on the importer
-       side, because empty file is valid in some formats (OBJ or glTF). We also
-       can't do the full import here because then doImage2D() would need to
-       copy the imported data instead anyway (and the uncompressed size is much
-       larger). This way it'll also work nicely with a future openMemory(). */
-    if(data.empty()) {
+void StanfordImporter::openDataInternal(Containers::Pointer<State>&& state) {
+    /* Because here we're keeping the data and using the _state to check if
+       file is opened, having them nullptr would mean openData() would fail
+       without any error message. It's not possible to do this check on the
+       importer side, because empty file is valid in some formats (OBJ or
+       glTF). We also can't do the full import here because then doMesh()
+       would need to copy the imported data instead anyway. This way the data
+       can be also memory-mapped or borrowed from the user. */
+    if(state->data.empty()) {
         Error{} << "Trade::StanfordImporter::openData(): the file is empty";
         return;
     }
 
-    /* Initialize the state */
-    auto state = Containers::pointer<State>();
-    Containers::ArrayView<const char> in = data;
+    Containers::ArrayView<const char> in = state->data;
 
     /* Check file signature */
     {
@@ -216,6 +303,7 @@ void StanfordImporter::openDataInternal(Containers::Array<char>&& data) {
 
     /* Parse format line */
     Containers::Optional<bool> fileFormatNeedsEndianSwapping;
+    bool ascii = false;
     {
         while(in) {
             const std::string line = extractLine(in);
@@ -236,7 +324,13 @@ void StanfordImporter::openDataInternal(Containers::Array<char>&& data) {
             }
 
             if(tokens[2] == "1.0") {
-                if(tokens[1] == "binary_little_endian") {
+                /* ASCII data get converted to binary with native endianness,
+                   so no swapping is needed */
+                if(tokens[1] == "ascii") {
+                    fileFormatNeedsEndianSwapping = false;
+                    ascii = true;
+                    break;
+                } else if(tokens[1] == "binary_little_endian") {
                     fileFormatNeedsEndianSwapping = Utility::Endianness::isBigEndian();
                     break;
                 } else if(tokens[1] == "binary_big_endian") {
@@ -271,6 +365,14 @@ void StanfordImporter::openDataInternal(Containers::Array<char>&& data) {
     bool perFaceNormals = false;
     bool perFaceColors = false;
     bool perFaceObjectIds = false;
+    /* Formats of all vertex and face components in order, used for parsing
+       ASCII files */
+    Containers::Array<VertexFormat> vertexComponentFormats;
+    Containers::Array<VertexFormat> faceComponentFormats;
+    Containers::Array<std::string> vertexComponentNames;
+    Containers::Array<std::string> faceComponentNames;
+    std::string faceIndicesName;
+    std::size_t faceComponentCountBeforeIndices = 0;
     {
         std::size_t vertexComponentOffset{};
         PropertyType propertyType{};
@@ -375,6 +477,8 @@ void StanfordImporter::openDataInternal(Containers::Array<char>&& data) {
 
                     /* Add size of current component to total offset */
                     vertexComponentOffset += vertexFormatSize(componentFormat);
+                    arrayAppend(vertexComponentFormats, componentFormat);
+                    arrayAppend(vertexComponentNames, tokens[2]);
 
                 /* Face element properties */
                 } else if(propertyType == PropertyType::Face) {
@@ -384,6 +488,8 @@ void StanfordImporter::openDataInternal(Containers::Array<char>&& data) {
                     if(tokens.size() == 5 && tokens[1] == "list" && (tokens[4] == "vertex_indices" || tokens[4] == "vertex_index")) {
                         state->faceIndicesOffset = state->faceSkip;
                         state->faceSkip = 0;
+                        faceComponentCountBeforeIndices = faceComponentFormats.size();
+                        faceIndicesName = tokens[4];
 
                         /* Face size type */
                         if((state->faceSizeType = parseIndexType(tokens[2])) == MeshIndexType{}) {
@@ -458,6 +564,8 @@ void StanfordImporter::openDataInternal(Containers::Array<char>&& data) {
                         }
 
                         state->faceSkip += vertexFormatSize(componentFormat);
+                        arrayAppend(faceComponentFormats, componentFormat);
+                        arrayAppend(faceComponentNames, tokens[2]);
 
                     /* Fail on unknown lines */
                     } else {
@@ -644,15 +752,118 @@ void StanfordImporter::openDataInternal(Containers::Array<char>&& data) {
             objectIdOffset, 0u, std::ptrdiff_t(state->faceIndicesOffset + state->faceSkip));
     }
 
-    if(in.size() < state->vertexStride*state->vertexCount) {
-        Error{} << "Trade::StanfordImporter::openData(): incomplete vertex data";
-        return;
+    /* ASCII files get converted to the same layout a binary file would have,
+       with native endianness, so doMesh() can then treat them the same way */
+    if(ascii) {
+        const UnsignedInt faceSizeTypeSize = meshIndexTypeSize(state->faceSizeType);
+        const UnsignedInt faceIndexTypeSize = meshIndexTypeSize(state->faceIndexType);
+        const VertexFormat faceSizeFormat = indexTypeVertexFormat(state->faceSizeType);
+        const VertexFormat faceIndexFormat = indexTypeVertexFormat(state->faceIndexType);
+        const Long faceSizeMax = (Long{1} << 8*faceSizeTypeSize) - 1;
+
+        /* The vertex data size is known exactly, so it's allocated all at
+           once. For faces reserve optimistically for all-triangle faces and
+           grow the array once per face as its size gets known. The values
+           are then written directly to the allocated memory. */
+        Containers::Array<char> binary;
+        Containers::arrayReserve(binary,
+            state->vertexStride*state->vertexCount +
+            state->faceCount*(state->faceIndicesOffset + faceSizeTypeSize + 3*faceIndexTypeSize + state->faceSkip));
+        Containers::arrayResize(binary, NoInit, state->vertexStride*state->vertexCount);
+
+        char* out = binary.data();
+        for(std::size_t i = 0; i != state->vertexCount; ++i) {
+            for(std::size_t j = 0; j != vertexComponentFormats.size(); ++j) {
+                const Containers::ArrayView<const char> token = Implementation::nextAsciiToken(in);
+                if(token.empty()) {
+                    Error{} << "Trade::StanfordImporter::openData(): incomplete vertex data";
+                    return;
+                }
+                const std::size_t size = parseAsciiValue(token, vertexComponentFormats[j], "vertex", vertexComponentNames[j], out);
+                if(!size) return;
+                out += size;
+            }
+        }
+
+        for(std::size_t i = 0; i != state->faceCount; ++i) {
+            /* Components before the face size have a fixed size */
+            out = Containers::arrayAppend(binary, NoInit, state->faceIndicesOffset).data();
+            for(std::size_t j = 0, jMax = faceComponentFormats.size() + 1; j != jMax; ++j) {
+                /* Face size followed by the indices */
+                if(j == faceComponentCountBeforeIndices) {
+                    const Containers::ArrayView<const char> token = Implementation::nextAsciiToken(in);
+                    Long size;
+                    if(token.empty()) {
+                        Error{} << "Trade::StanfordImporter::openData(): incomplete face data";
+                        return;
+                    }
+                    /* The size has to fit into the face size type, as that's
+                       what gets stored in the binary representation and
+                       what doMesh() reads back */
+                    if(!Implementation::parseAsciiInteger(token, size) || size < 0 || size > faceSizeMax) {
+                        Error{} << "Trade::StanfordImporter::openData(): invalid face size" << std::string{token.begin(), token.end()};
+                        return;
+                    }
+                    const UnsignedInt faceSize = UnsignedInt(size);
+
+                    /* Now the rest of the face size is known */
+                    out = Containers::arrayAppend(binary, NoInit, faceSizeTypeSize + faceSize*faceIndexTypeSize + state->faceSkip).data();
+
+                    /* The token was already parsed successfully above, so
+                       this can't fail */
+                    const std::size_t sizeSize = parseAsciiValue(token, faceSizeFormat, "face", faceIndicesName, out);
+                    CORRADE_INTERNAL_ASSERT(sizeSize == faceSizeTypeSize);
+                    out += sizeSize;
+
+                    for(std::size_t k = 0; k != faceSize; ++k) {
+                        const Containers::ArrayView<const char> indexToken = Implementation::nextAsciiToken(in);
+                        if(indexToken.empty()) {
+                            Error{} << "Trade::StanfordImporter::openData(): incomplete face data";
+                            return;
+                        }
+                        const std::size_t indexSize = parseAsciiValue(indexToken, faceIndexFormat, "face", faceIndicesName, out);
+                        if(!indexSize) return;
+                        out += indexSize;
+                    }
+
+                    continue;
+                }
+
+                /* Other components */
+                const Containers::ArrayView<const char> token = Implementation::nextAsciiToken(in);
+                if(token.empty()) {
+                    Error{} << "Trade::StanfordImporter::openData(): incomplete face data";
+                    return;
+                }
+                const std::size_t component = j < faceComponentCountBeforeIndices ? j : j - 1;
+                const std::size_t size = parseAsciiValue(token, faceComponentFormats[component], "face", faceComponentNames[component], out);
+                if(!size) return;
+                out += size;
+            }
+        }
+
+        /* Replace the textual data with the binary representation. For the
+           binary data there's no header. */
+        state->ownedData = std::move(binary);
+        #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+        state->mappedData = nullptr;
+        #endif
+        state->data = state->ownedData;
+        state->headerSize = 0;
+
+    /* For binary files check that there's enough data for all vertices */
+    } else {
+        if(in.size() < state->vertexStride*state->vertexCount) {
+            Error{} << "Trade::StanfordImporter::openData(): incomplete vertex data";
+            return;
+        }
+
+        /* Remember header size so we can directly access the binary data in
+           doMesh() */
+        state->headerSize = state->data.size() - in.size();
     }
 
-    /* All good, move the data to the state struct and save it. Remember header
-       size so we can directly access the binary data in doMesh(). */
-    state->data = std::move(data);
-    state->headerSize = state->data.size() - in.size();
+    /* All good, save the state */
     _state = std::move(state);
 }
 
@@ -687,6 +898,12 @@ Containers::Optional<MeshData> StanfordImporter::doMesh(UnsignedInt, const Unsig
     const UnsignedInt faceSizeTypeSize = meshIndexTypeSize(_state->faceSizeType);
     UnsignedInt triangleFaceCount = _state->faceCount;
 
+    /* Decide how many chunks to split the faces into for parallel parsing.
+       There's no point in having more chunks than faces. */
+    std::size_t chunkCount = configuration().value<UnsignedInt>("threads");
+    if(chunkCount == 0) chunkCount = std::thread::hardware_concurrency();
+    chunkCount = Math::max(std::size_t{1}, Math::min(chunkCount, std::size_t(_state->faceCount)));
+
     /* Fast path -- if all faces are triangles, we can just copy all indices
        and per-face data directly without parsing anything */
     if(configuration().value<bool>("triangleFastPath") && in.size() == _state->faceCount*(_state->faceIndicesOffset + faceSizeTypeSize + 3*faceIndexTypeSize + _state->faceSkip)) {
@@ -720,6 +937,104 @@ Containers::Optional<MeshData> StanfordImporter::doMesh(UnsignedInt, const Unsig
                 dst.suffix({0, _state->faceIndicesOffset}));
         }
 
+    /* Otherwise, if parallel parsing is enabled, first do a serial pass
+       that only checks face sizes. That verifies the data, calculates the
+       exact output size and finds where each chunk starts in the input and
+       output. Then the chunks get decoded in parallel directly into
+       preallocated arrays. */
+    } else if(chunkCount > 1) {
+        struct Chunk {
+            std::size_t inputOffset;
+            std::size_t faceOffset;
+            std::size_t triangleOffset;
+        };
+        Containers::Array<Chunk> chunks{NoInit, chunkCount + 1};
+
+        std::size_t inputOffset = 0;
+        std::size_t quadCount = 0;
+        std::size_t nextChunk = 0;
+        for(std::size_t i = 0; i != _state->faceCount; ++i) {
+            /* Faces are split evenly among the chunks */
+            if(i == _state->faceCount*nextChunk/chunkCount) {
+                chunks[nextChunk] = {inputOffset, i, i + quadCount};
+                ++nextChunk;
+            }
+
+            /* The same checks, in the same order, as in the serial path
+               below */
+            if(in.size() < inputOffset + _state->faceIndicesOffset + faceSizeTypeSize) {
+                Error() << "Trade::StanfordImporter::mesh(): incomplete index data";
+                return Containers::NullOpt;
+            }
+
+            const UnsignedInt faceSize = extractIndexValue<UnsignedInt>(in + inputOffset + _state->faceIndicesOffset, _state->faceSizeType, _state->fileFormatNeedsEndianSwapping);
+            if(faceSize < 3 || faceSize > 4) {
+                Error() << "Trade::StanfordImporter::mesh(): unsupported face size" << faceSize;
+                return Containers::NullOpt;
+            }
+
+            if(in.size() < inputOffset + _state->faceIndicesOffset + faceSizeTypeSize + faceIndexTypeSize*faceSize + _state->faceSkip) {
+                Error() << "Trade::StanfordImporter::mesh(): incomplete face data";
+                return Containers::NullOpt;
+            }
+
+            inputOffset += _state->faceIndicesOffset + faceSizeTypeSize + faceIndexTypeSize*faceSize + _state->faceSkip;
+            if(faceSize == 4) ++quadCount;
+        }
+        CORRADE_INTERNAL_ASSERT(nextChunk == chunkCount);
+        chunks[chunkCount] = {inputOffset, _state->faceCount, _state->faceCount + quadCount};
+        triangleFaceCount += UnsignedInt(quadCount);
+
+        /* Allocate the output. In contrast to the serial path the arrays
+           don't need to be growable. */
+        const std::size_t faceStride = _state->faceIndicesOffset + _state->faceSkip;
+        if(level == 0) indexData = Containers::Array<char>{NoInit,
+            triangleFaceCount*3*faceIndexTypeSize};
+        if(parsePerFaceAttributes) faceData = Containers::Array<char>{NoInit,
+            triangleFaceCount*faceStride};
+
+        /* Decode a single chunk. Everything was verified in the scan above
+           already, so this doesn't need to do any checks. */
+        auto parseChunk = [&](const std::size_t chunk) {
+            const char* face = in + chunks[chunk].inputOffset;
+            char* indexOut = level == 0 ? indexData + chunks[chunk].triangleOffset*3*faceIndexTypeSize : nullptr;
+            char* faceOut = parsePerFaceAttributes ? faceData + chunks[chunk].triangleOffset*faceStride : nullptr;
+            for(std::size_t i = chunks[chunk].faceOffset; i != chunks[chunk + 1].faceOffset; ++i) {
+                const char* faceDataBeforeIndices = face;
+                const UnsignedInt faceSize = extractIndexValue<UnsignedInt>(face + _state->faceIndicesOffset, _state->faceSizeType, _state->fileFormatNeedsEndianSwapping);
+                const char* faceIndexData = face + _state->faceIndicesOffset + faceSizeTypeSize;
+                const char* faceDataAfterIndices = faceIndexData + faceIndexTypeSize*faceSize;
+                face = faceDataAfterIndices + _state->faceSkip;
+
+                /* Either the triangle or the first triangle of the quad and
+                   then, for a quad, the 0, 2 and 3 indices forming another
+                   triangle. Same as in the serial path below. */
+                const std::size_t triangleCount = faceSize == 4 ? 2 : 1;
+                if(level == 0) {
+                    std::memcpy(indexOut, faceIndexData, 3*faceIndexTypeSize);
+                    indexOut += 3*faceIndexTypeSize;
+                    if(faceSize == 4) {
+                        std::memcpy(indexOut + 0*faceIndexTypeSize, faceIndexData + 0*faceIndexTypeSize, faceIndexTypeSize);
+                        std::memcpy(indexOut + 1*faceIndexTypeSize, faceIndexData + 2*faceIndexTypeSize, faceIndexTypeSize);
+                        std::memcpy(indexOut + 2*faceIndexTypeSize, faceIndexData + 3*faceIndexTypeSize, faceIndexTypeSize);
+                        indexOut += 3*faceIndexTypeSize;
+                    }
+                }
+                if(parsePerFaceAttributes) for(std::size_t j = 0; j != triangleCount; ++j) {
+                    std::memcpy(faceOut, faceDataBeforeIndices, _state->faceIndicesOffset);
+                    std::memcpy(faceOut + _state->faceIndicesOffset, faceDataAfterIndices, _state->faceSkip);
+                    faceOut += faceStride;
+                }
+            }
+        };
+
+        /* The first chunk is processed on the calling thread */
+        Containers::Array<std::thread> threads{chunkCount - 1};
+        for(std::size_t i = 1; i != chunkCount; ++i)
+            threads[i - 1] = std::thread{parseChunk, i};
+        parseChunk(0);
+        for(std::thread& thread: threads) thread.join();
+
     /* Otherwise reserve optimistically amount for all-triangle faces, and let
        the array grow */
     /** @todo the size could be estimated *exactly* via the above equation
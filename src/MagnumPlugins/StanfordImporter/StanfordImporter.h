@@ -102,8 +102,13 @@ In order to optimize for fast import, the importer supports a restricted subset
 of PLY features, which however shouldn't affect any real-world models.
 
 -   Both Little- and Big-Endian binary files are supported, with bytes swapped
-    to match platform endianness. ASCII files are not supported due to the
-    storage size overhead and inherent inefficiency of float literal parsing.
+    to match platform endianness. ASCII files are supported as well, they
+    get converted to a binary representation with platform endianness on
+    opening. The conversion uses a locale-independent number parser, but
+    it's still considerably slower than importing a binary file and the
+    converted data need to be kept in memory, so the binary variant is
+    recommended for large meshes. Integer values that don't fit into the
+    range of their property type cause the import to fail.
 -   Position coordinates (`x`/`y`/`z`) are expected to have the same type, be
     tightly packed in a XYZ order and be either 32-bit floats or (signed) bytes
     or shorts. Resulting position type is then
@@ -183,6 +188,44 @@ using @ref meshAttributeName() and @ref meshAttributeForName(). Attributes with
 unknown types cause the import to fail, as the format relies on knowing the
 type size.
 
+@subsection Trade-StanfordImporter-behavior-multithreading Multithreaded face parsing
+
+If the file contains also quads or if the @cb{.ini} triangleFastPath @ce
+@ref Trade-StanfordImporter-configuration "configuration option" is disabled,
+the faces have to be parsed one by one. Setting the @cb{.ini} threads @ce
+option to a value other than `1` splits this work across multiple threads ---
+a serial pass first verifies all face sizes and calculates the exact output
+size, and then each thread decodes its range of faces directly into the
+output. The imported data are the same regardless of the thread count.
+
+On Linux it may happen that the import will fail with
+`undefined symbol: pthread_create` or a @ref std::system_error being thrown
+when multithreading is enabled. Similarly to
+@ref Trade-BasisImageConverter-behavior-loading "BasisImageConverter", the
+plugin doesn't link to `pthread` on its own and it's the application that
+needs to link to it instead. With CMake it can be done like this:
+
+@code{.cmake}
+find_package(Threads REQUIRED)
+target_link_libraries(your-application PRIVATE Threads::Threads)
+@endcode
+
+@subsection Trade-StanfordImporter-behavior-memory Memory-mapped and borrowed data
+
+By default, @ref openFile() reads the whole file into memory and
+@ref openData() makes a copy of the passed data, which means large files need
+the memory twice until the mesh gets imported. Enabling the
+@cb{.ini} memoryMapFile @ce
+@ref Trade-StanfordImporter-configuration "configuration option" makes
+@ref openFile() memory-map the file instead, with @ref mesh() then reading the
+data directly from the mapped memory. The mapping is available on Unix and
+non-RT Windows platforms, elsewhere the option is ignored. Similarly, the
+@cb{.ini} borrowData @ce option makes @ref openData() reference the passed
+memory instead of copying it --- in that case it's the caller's responsibility
+to keep the memory alive and unchanged until the importer is closed. In both
+cases the returned @ref MeshData still own their data, so they can outlive the
+importer.
+
 @section Trade-StanfordImporter-configuration Plugin-specific config
 
 It's possible to tune various import options through @ref configuration(). See
@@ -204,12 +247,14 @@ class MAGNUM_STANFORDIMPORTER_EXPORT StanfordImporter: public AbstractImporter {
         ~StanfordImporter();
 
     private:
+        struct State;
+
         MAGNUM_STANFORDIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
 
         MAGNUM_STANFORDIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_STANFORDIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
         MAGNUM_STANFORDIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
-        MAGNUM_STANFORDIMPORTER_LOCAL void openDataInternal(Containers::Array<char>&& data);
+        MAGNUM_STANFORDIMPORTER_LOCAL void openDataInternal(Containers::Pointer<State>&& state);
         MAGNUM_STANFORDIMPORTER_LOCAL void doClose() override;
 
 
@@ -219,7 +264,6 @@ class MAGNUM_STANFORDIMPORTER_EXPORT StanfordImporter: public AbstractImporter {
         MAGNUM_STANFORDIMPORTER_LOCAL MeshAttribute doMeshAttributeForName(const std::string& name) override;
         MAGNUM_STANFORDIMPORTER_LOCAL std::string doMeshAttributeName(UnsignedShort name) override;
 
-        struct State;
         Containers::Pointer<State> _state;
 };
 
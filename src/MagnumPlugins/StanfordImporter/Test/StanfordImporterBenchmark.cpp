@@ -0,0 +1,262 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/EndiannessBatch.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/String.h>
+#include <Magnum/Math/Vector3.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/MeshData.h>
+
+#include "MagnumPlugins/Implementation/anonymousResidentMemory.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct StanfordImporterBenchmark: TestSuite::Tester {
+    explicit StanfordImporterBenchmark();
+
+    void openFile();
+    void openData();
+    void openDataAscii();
+
+    #ifdef __linux__
+    void openFileMemory();
+    void openDataMemory();
+
+    void memoryBegin();
+    std::uint64_t memoryEnd();
+    #endif
+
+    std::string _filename;
+    Containers::Array<char> _data;
+    std::string _asciiData;
+    #ifdef __linux__
+    std::uint64_t _memoryBaseline;
+    #endif
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+constexpr std::size_t VertexCount = 1 << 18;
+constexpr std::size_t FaceCount = 1 << 19;
+
+constexpr struct {
+    const char* name;
+    const char* option;
+} OpenFileData[]{
+    {"copy", nullptr},
+    {"memory-mapped", "memoryMapFile"}
+};
+
+constexpr struct {
+    const char* name;
+    const char* option;
+} OpenDataData[]{
+    {"copy", nullptr},
+    {"borrowed", "borrowData"}
+};
+
+StanfordImporterBenchmark::StanfordImporterBenchmark() {
+    addInstancedBenchmarks({&StanfordImporterBenchmark::openFile}, 5,
+        Containers::arraySize(OpenFileData));
+    addInstancedBenchmarks({&StanfordImporterBenchmark::openData}, 5,
+        Containers::arraySize(OpenDataData));
+    addBenchmarks({&StanfordImporterBenchmark::openDataAscii}, 5);
+
+    #ifdef __linux__
+    addCustomInstancedBenchmarks({&StanfordImporterBenchmark::openFileMemory}, 1,
+        Containers::arraySize(OpenFileData),
+        &StanfordImporterBenchmark::memoryBegin,
+        &StanfordImporterBenchmark::memoryEnd,
+        BenchmarkUnits::Bytes);
+    addCustomInstancedBenchmarks({&StanfordImporterBenchmark::openDataMemory}, 1,
+        Containers::arraySize(OpenDataData),
+        &StanfordImporterBenchmark::memoryBegin,
+        &StanfordImporterBenchmark::memoryEnd,
+        BenchmarkUnits::Bytes);
+    #endif
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef STANFORDIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(STANFORDIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    /* Generate a large little-endian triangle mesh with float positions and
+       32-bit indices */
+    std::string header = Utility::formatString(
+        "ply\n"
+        "format binary_little_endian 1.0\n"
+        "element vertex {}\n"
+        "property float x\n"
+        "property float y\n"
+        "property float z\n"
+        "element face {}\n"
+        "property list uchar uint vertex_indices\n"
+        "end_header\n", VertexCount, FaceCount);
+    constexpr std::size_t FaceSize = 1 + 3*4;
+    _data = Containers::Array<char>{ValueInit,
+        header.size() + VertexCount*sizeof(Vector3) + FaceCount*FaceSize};
+    std::memcpy(_data, header.data(), header.size());
+
+    Containers::ArrayView<char> vertexData = _data.slice(header.size(), header.size() + VertexCount*sizeof(Vector3));
+    Containers::ArrayView<Vector3> positions = Containers::arrayCast<Vector3>(vertexData);
+    for(std::size_t i = 0; i != VertexCount; ++i)
+        positions[i] = {Float(i%512), Float(i/512), Float(i%7)};
+    Utility::Endianness::littleEndianInPlace(Containers::arrayCast<Float>(vertexData));
+
+    char* face = vertexData.end();
+    for(std::size_t i = 0; i != FaceCount; ++i, face += FaceSize) {
+        *face = 3;
+        const UnsignedInt indices[]{
+            Utility::Endianness::littleEndian(UnsignedInt(i%VertexCount)),
+            Utility::Endianness::littleEndian(UnsignedInt((i + 1)%VertexCount)),
+            Utility::Endianness::littleEndian(UnsignedInt((i + 512)%VertexCount))};
+        std::memcpy(face + 1, indices, sizeof(indices));
+    }
+
+    /* The same mesh as ASCII, for comparing with the binary import */
+    std::ostringstream ascii;
+    ascii << Utility::String::replaceFirst(header, "binary_little_endian", "ascii");
+    for(std::size_t i = 0; i != VertexCount; ++i)
+        ascii << Float(i%512) << ' ' << Float(i/512) << ' ' << Float(i%7) << '\n';
+    for(std::size_t i = 0; i != FaceCount; ++i)
+        ascii << "3 " << i%VertexCount << ' ' << (i + 1)%VertexCount << ' ' << (i + 512)%VertexCount << '\n';
+    _asciiData = ascii.str();
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::mkpath(STANFORDIMPORTER_TEST_OUTPUT_DIR));
+    _filename = Utility::Directory::join(STANFORDIMPORTER_TEST_OUTPUT_DIR, "benchmark.ply");
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::write(_filename, _data));
+}
+
+void StanfordImporterBenchmark::openFile() {
+    auto&& data = OpenFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    if(data.option) importer->configuration().setValue(data.option, true);
+
+    Containers::Optional<MeshData> mesh;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openFile(_filename));
+        mesh = importer->mesh(0);
+    }
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), VertexCount);
+    CORRADE_COMPARE(mesh->indexCount(), FaceCount*3);
+}
+
+void StanfordImporterBenchmark::openData() {
+    auto&& data = OpenDataData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    if(data.option) importer->configuration().setValue(data.option, true);
+
+    Containers::Optional<MeshData> mesh;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData(_data));
+        mesh = importer->mesh(0);
+    }
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), VertexCount);
+    CORRADE_COMPARE(mesh->indexCount(), FaceCount*3);
+}
+
+void StanfordImporterBenchmark::openDataAscii() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+
+    Containers::Optional<MeshData> mesh;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData({_asciiData.data(), _asciiData.size()}));
+        mesh = importer->mesh(0);
+    }
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), VertexCount);
+    CORRADE_COMPARE(mesh->indexCount(), FaceCount*3);
+}
+
+#ifdef __linux__
+void StanfordImporterBenchmark::memoryBegin() {
+    _memoryBaseline = Implementation::anonymousResidentMemory();
+}
+
+std::uint64_t StanfordImporterBenchmark::memoryEnd() {
+    return Implementation::anonymousResidentMemory() - _memoryBaseline;
+}
+
+void StanfordImporterBenchmark::openFileMemory() {
+    auto&& data = OpenFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    if(data.option) importer->configuration().setValue(data.option, true);
+
+    /* The importer is kept opened and the mesh alive until the measurement
+       ends, so the value is the peak memory needed to get the first mesh */
+    Containers::Optional<MeshData> mesh;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openFile(_filename));
+        mesh = importer->mesh(0);
+    }
+
+    CORRADE_VERIFY(mesh);
+}
+
+void StanfordImporterBenchmark::openDataMemory() {
+    auto&& data = OpenDataData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    if(data.option) importer->configuration().setValue(data.option, true);
+
+    /* The importer is kept opened and the mesh alive until the measurement
+       ends, so the value is the peak memory needed to get the first mesh */
+    Containers::Optional<MeshData> mesh;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData(_data));
+        mesh = importer->mesh(0);
+    }
+
+    CORRADE_VERIFY(mesh);
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::StanfordImporterBenchmark)
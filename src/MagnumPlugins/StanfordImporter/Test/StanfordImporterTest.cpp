@@ -64,6 +64,13 @@ struct StanfordImporterTest: TestSuite::Tester {
     void triangleFastPath();
     void triangleFastPathPerFaceToPerVertex();
 
+    void parallel();
+    void parallelFileTooShort();
+    void parallelUnsupportedFaceSize();
+
+    void memoryMapFile();
+    void borrowData();
+
     void openTwice();
     void importTwice();
 
@@ -79,7 +86,7 @@ constexpr struct {
     {"invalid-signature", "invalid file signature bla", true},
 
     {"format-invalid", "invalid format line format binary_big_endian 1.0 extradata", true},
-    {"format-unsupported", "unsupported file format ascii 1.0", true},
+    {"format-unsupported", "unsupported file format ascii 2.0", true},
     {"format-missing", "missing format line", true},
     {"format-too-late", "expected format line, got element face 1", true},
 
@@ -117,7 +124,15 @@ constexpr struct {
 
     {"objectid-unsupported-type", "unsupported object ID type VertexFormat::Float", true},
 
-    {"unsupported-face-size", "unsupported face size 5", false}
+    {"unsupported-face-size", "unsupported face size 5", false},
+
+    {"ascii-incomplete-vertex-data", "incomplete vertex data", true},
+    {"ascii-incomplete-face-data", "incomplete face data", true},
+    {"ascii-invalid-vertex-value", "invalid vertex property y value 1,5", true},
+    {"ascii-invalid-face-index", "invalid face property vertex_indices value two", true},
+    {"ascii-invalid-face-size", "invalid face size 259", true},
+    {"ascii-vertex-value-out-of-range", "vertex property weight value 128 out of range for VertexFormat::Byte", true},
+    {"ascii-face-value-out-of-range", "face property objectid value 65536 out of range for VertexFormat::UnsignedShort", true}
 };
 
 constexpr struct {
@@ -143,6 +158,11 @@ constexpr struct {
         VertexFormat::Vector3, VertexFormat{},
         VertexFormat{}, VertexFormat{},
         VertexFormat{}, nullptr, 1, 0},
+    /* ASCII, converted to the same layout */
+    {"positions-float-indices-uint-ascii", MeshIndexType::UnsignedInt,
+        VertexFormat::Vector3, VertexFormat{},
+        VertexFormat{}, VertexFormat{},
+        VertexFormat{}, nullptr, 1, 0},
     /* All supported attributes, in the canonical type */
     {"positions-colors-normals-texcoords-float-objectid-uint-indices-int",
         MeshIndexType::UnsignedInt,
@@ -222,7 +242,11 @@ constexpr struct {
     {"per-face normals, object ids, verbose", "per-face-normals-objectid.ply", 2,
         MeshIndexType::UnsignedByte,
         VertexFormat{}, VertexFormat::Vector3, VertexFormat::UnsignedShort,
-        ImporterFlag::Verbose, "Trade::StanfordImporter::mesh(): converting 2 per-face attributes to per-vertex\n"}
+        ImporterFlag::Verbose, "Trade::StanfordImporter::mesh(): converting 2 per-face attributes to per-vertex\n"},
+    {"per-face normals, object ids, ASCII", "per-face-normals-objectid-ascii.ply", 2,
+        MeshIndexType::UnsignedByte,
+        VertexFormat{}, VertexFormat::Vector3, VertexFormat::UnsignedShort,
+        {}, ""}
 };
 
 constexpr struct {
@@ -248,6 +272,20 @@ constexpr struct {
     {"disabled", false}
 };
 
+constexpr struct {
+    const char* name;
+    const char* filename;
+    bool perFaceToPerVertex;
+    UnsignedInt threads;
+} ParallelData[]{
+    {"per-face colors, 2 threads", "per-face-colors-be.ply", false, 2},
+    {"per-face colors, per-face to per-vertex, 2 threads", "per-face-colors-be.ply", true, 2},
+    {"per-face normals and object IDs, 2 threads", "per-face-normals-objectid.ply", false, 2},
+    {"per-face normals and object IDs, more threads than faces", "per-face-normals-objectid.ply", false, 7},
+    {"custom components, hardware concurrency", "custom-components.ply", false, 0},
+    {"custom components, Big-Endian, 2 threads", "custom-components-be.ply", false, 2}
+};
+
 StanfordImporterTest::StanfordImporterTest() {
     addInstancedTests({&StanfordImporterTest::invalid},
         Containers::arraySize(InvalidData));
@@ -279,7 +317,18 @@ StanfordImporterTest::StanfordImporterTest() {
                        &StanfordImporterTest::triangleFastPathPerFaceToPerVertex},
         Containers::arraySize(FastTrianglePathData));
 
-    addTests({&StanfordImporterTest::openTwice,
+    addInstancedTests({&StanfordImporterTest::parallel},
+        Containers::arraySize(ParallelData));
+
+    addInstancedTests({&StanfordImporterTest::parallelFileTooShort},
+        Containers::arraySize(ShortFileData));
+
+    addTests({&StanfordImporterTest::parallelUnsupportedFaceSize});
+
+    addTests({&StanfordImporterTest::memoryMapFile,
+              &StanfordImporterTest::borrowData,
+
+              &StanfordImporterTest::openTwice,
               &StanfordImporterTest::importTwice});
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
@@ -1005,6 +1054,126 @@ void StanfordImporterTest::triangleFastPathPerFaceToPerVertex() {
         }), TestSuite::Compare::Container);
 }
 
+void StanfordImporterTest::parallel() {
+    auto&& data = ParallelData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* The fast path would be used otherwise, and it's never parallel */
+    Containers::Pointer<AbstractImporter> serial = _manager.instantiate("StanfordImporter");
+    serial->configuration().setValue("triangleFastPath", false);
+    serial->configuration().setValue("perFaceToPerVertex", data.perFaceToPerVertex);
+    Containers::Pointer<AbstractImporter> parallel = _manager.instantiate("StanfordImporter");
+    parallel->configuration().setValue("triangleFastPath", false);
+    parallel->configuration().setValue("perFaceToPerVertex", data.perFaceToPerVertex);
+    parallel->configuration().setValue("threads", data.threads);
+
+    const std::string filename = Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, data.filename);
+    CORRADE_VERIFY(serial->openFile(filename));
+    CORRADE_VERIFY(parallel->openFile(filename));
+    CORRADE_COMPARE(parallel->meshLevelCount(0), serial->meshLevelCount(0));
+
+    /* The output should be byte-for-byte the same as in the serial case */
+    for(UnsignedInt level = 0; level != serial->meshLevelCount(0); ++level) {
+        Containers::Optional<MeshData> expected = serial->mesh(0, level);
+        Containers::Optional<MeshData> actual = parallel->mesh(0, level);
+        CORRADE_VERIFY(expected);
+        CORRADE_VERIFY(actual);
+        CORRADE_COMPARE(actual->primitive(), expected->primitive());
+        CORRADE_COMPARE(actual->isIndexed(), expected->isIndexed());
+        if(expected->isIndexed()) {
+            CORRADE_COMPARE(actual->indexType(), expected->indexType());
+            CORRADE_COMPARE_AS(actual->indexData(), expected->indexData(),
+                TestSuite::Compare::Container);
+        }
+        CORRADE_COMPARE(actual->vertexCount(), expected->vertexCount());
+        CORRADE_COMPARE(actual->attributeCount(), expected->attributeCount());
+        CORRADE_COMPARE_AS(actual->vertexData(), expected->vertexData(),
+            TestSuite::Compare::Container);
+    }
+}
+
+void StanfordImporterTest::parallelFileTooShort() {
+    auto&& data = ShortFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.message);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    importer->configuration().setValue("threads", 2);
+
+    Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "positions-float-indices-uint.ply"));
+
+    /* The errors should be the same as in the serial case */
+    std::ostringstream out;
+    Error redirectError{&out};
+    const bool failed = !importer->openData(file.prefix(data.prefix));
+    CORRADE_VERIFY(failed == data.duringOpen);
+    if(!failed) {
+        CORRADE_VERIFY(!importer->mesh(0));
+    }
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::StanfordImporter::{}(): {}\n",
+        data.duringOpen ? "openData" : "mesh",
+        data.message));
+}
+
+void StanfordImporterTest::parallelUnsupportedFaceSize() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    importer->configuration().setValue("threads", 2);
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unsupported-face-size.ply")));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh(): unsupported face size 5\n");
+}
+
+void StanfordImporterTest::memoryMapFile() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    importer->configuration().setValue("memoryMapFile", true);
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "positions-float-indices-uint.ply")));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE_AS(mesh->indicesAsArray(),
+        Containers::arrayView(Indices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView(Positions),
+        TestSuite::Compare::Container);
+
+    /* The mesh owns its data, so it should be usable even after the file
+       gets unmapped */
+    importer->close();
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView(Positions),
+        TestSuite::Compare::Container);
+}
+
+void StanfordImporterTest::borrowData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
+    importer->configuration().setValue("borrowData", true);
+
+    Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "positions-float-indices-uint.ply"));
+    CORRADE_VERIFY(importer->openData(data));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE_AS(mesh->indicesAsArray(),
+        Containers::arrayView(Indices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView(Positions),
+        TestSuite::Compare::Container);
+
+    /* The mesh owns its data, so it should stay intact even if the borrowed
+       memory gets changed */
+    importer->close();
+    for(char& i: data) i = 0;
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView(Positions),
+        TestSuite::Compare::Container);
+}
+
 void StanfordImporterTest::openTwice() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StanfordImporter");
 
@@ -25,3 +25,4 @@
 
 #cmakedefine STANFORDIMPORTER_PLUGIN_FILENAME "${STANFORDIMPORTER_PLUGIN_FILENAME}"
 #define STANFORDIMPORTER_TEST_DIR "${STANFORDIMPORTER_TEST_DIR}"
+#define STANFORDIMPORTER_TEST_OUTPUT_DIR "${STANFORDIMPORTER_TEST_OUTPUT_DIR}"
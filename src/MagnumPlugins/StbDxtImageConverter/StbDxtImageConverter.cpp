@@ -25,13 +25,14 @@
 
 #include "StbDxtImageConverter.h"
 
+#include <thread>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
-#include <Corrade/Containers/StaticArray.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
-#include <Magnum/Math/Color.h>
 #include <Magnum/ImageView.h>
 #include <Magnum/PixelFormat.h>
+#include <Magnum/Math/Functions.h>
 #include <Magnum/Trade/ImageData.h>
 
 #define STB_DXT_IMPLEMENTATION
@@ -45,24 +46,75 @@ StbDxtImageConverter::StbDxtImageConverter(PluginManager::AbstractManager& manag
 
 ImageConverterFeatures StbDxtImageConverter::doFeatures() const { return ImageConverterFeature::Convert2D; }
 
+namespace {
+
+/* Compresses given range of block rows. Pixels in image rows are always
+   contiguous, so a block is gathered into a linear array with just four
+   copies, one for each of its rows. */
+template<std::size_t pixelSize, class Compress> void compressBlockRows(const Containers::StridedArrayView3D<const char>& input, const Containers::StridedArrayView2D<UnsignedByte>& output, const std::size_t blockRowBegin, const std::size_t blockRowEnd, const Compress& compress) {
+    CORRADE_INTERNAL_ASSERT(std::size_t(input.stride()[1]) == pixelSize);
+    const char* const inputData = static_cast<const char*>(input.data());
+    const std::ptrdiff_t inputRowStride = input.stride()[0];
+    for(std::size_t y = blockRowBegin; y != blockRowEnd; ++y) {
+        for(std::size_t x = 0, xMax = output.size()[1]; x != xMax; ++x) {
+            UnsignedByte inputBlockData[16*pixelSize];
+            for(std::size_t i = 0; i != 4; ++i)
+                std::memcpy(inputBlockData + 4*i*pixelSize,
+                    inputData + std::ptrdiff_t(4*y + i)*inputRowStride + 4*x*pixelSize,
+                    4*pixelSize);
+
+            compress(&output[y][x], inputBlockData);
+        }
+    }
+}
+
+/* Splits the block rows evenly across given count of threads, with the first
+   chunk processed on the calling thread */
+template<std::size_t pixelSize, class Compress> void compressBlocks(const Containers::StridedArrayView3D<const char>& input, const Containers::StridedArrayView2D<UnsignedByte>& output, const std::size_t threadCount, const Compress& compress) {
+    const std::size_t blockRowCount = output.size()[0];
+    auto compressChunk = [&](const std::size_t i) {
+        compressBlockRows<pixelSize>(input, output,
+            blockRowCount*i/threadCount, blockRowCount*(i + 1)/threadCount,
+            compress);
+    };
+
+    Containers::Array<std::thread> threads{threadCount - 1};
+    for(std::size_t i = 1; i != threadCount; ++i)
+        threads[i - 1] = std::thread{compressChunk, i};
+    compressChunk(0);
+    for(std::thread& thread: threads) thread.join();
+}
+
+}
+
 Containers::Optional<ImageData2D> StbDxtImageConverter::doConvert(const ImageView2D& image) {
     const bool alpha = configuration().value<bool>("alpha");
     const Int flags = configuration().value<bool>("highQuality") ? STB_DXT_HIGHQUAL : STB_DXT_NORMAL;
 
     /* Decide on the output format */
     CompressedPixelFormat outputFormat;
+    std::size_t outputBlockSize;
     switch(image.format()) {
         case PixelFormat::RGBA8Unorm:
             outputFormat = alpha ?
                 CompressedPixelFormat::Bc3RGBAUnorm :
                 CompressedPixelFormat::Bc1RGBUnorm;
+            outputBlockSize = alpha ? 16 : 8;
             break;
         case PixelFormat::RGBA8Srgb:
             outputFormat = alpha ?
                 CompressedPixelFormat::Bc3RGBASrgb :
                 CompressedPixelFormat::Bc1RGBSrgb;
+            outputBlockSize = alpha ? 16 : 8;
+            break;
+        case PixelFormat::R8Unorm:
+            outputFormat = CompressedPixelFormat::Bc4RUnorm;
+            outputBlockSize = 8;
+            break;
+        case PixelFormat::RG8Unorm:
+            outputFormat = CompressedPixelFormat::Bc5RGUnorm;
+            outputBlockSize = 16;
             break;
-        /** @todo BC4/5 (single/two channel) -- template the loop? */
         default:
             Error{} << "Trade::StbDxtImageConverter::convert(): unsupported format" << image.format();
             return {};
@@ -73,34 +125,33 @@ Containers::Optional<ImageData2D> StbDxtImageConverter::doConvert(const ImageVie
         return {};
     }
 
-    const Containers::StridedArrayView2D<const Color4ub> input = image.pixels<Color4ub>();
-
-    const std::size_t outputBlockSize = alpha ? 16 : 8;
-
     /** @todo use blocks() once the compressed image APIs are done */
     Containers::Array<char> outputData{NoInit, std::size_t(image.size().product()*outputBlockSize/16)};
     const Containers::StridedArrayView2D<UnsignedByte> output{
         Containers::arrayCast<UnsignedByte>(outputData),
         {std::size_t(image.size().y()/4), std::size_t(image.size().x()/4)},
-        {std::ptrdiff_t(image.size().x()*outputBlockSize/4), outputBlockSize}
+        {std::ptrdiff_t(image.size().x()*outputBlockSize/4), std::ptrdiff_t(outputBlockSize)}
     };
 
+    /* There's no point in having more threads than block rows */
+    std::size_t threadCount = configuration().value<UnsignedInt>("threads");
+    if(threadCount == 0) threadCount = std::thread::hardware_concurrency();
+    threadCount = Math::max(std::size_t{1}, Math::min(threadCount, output.size()[0]));
+
     /* Go through all blocks in the input file and compress them */
-    for(std::size_t y = 0, yMax = image.size().y()/4; y < yMax; ++y) {
-        for(std::size_t x = 0, xMax = image.size().x()/4; x < xMax; ++x) {
-            /* Gather pixels in a block together to a linear array */
-            Containers::StaticArray<16, Color4ub> inputBlockData{NoInit};
-            std::size_t i = 0;
-            for(const Containers::StridedArrayView1D<const Color4ub> inputBlockRow: input.slice({4*y, 4*x}, {4*y + 4, 4*x + 4})) {
-                for(const Color4ub inputBlockPixel: inputBlockRow)
-                    inputBlockData[i++] = inputBlockPixel;
-            }
-            CORRADE_INTERNAL_ASSERT(i == 16);
-
-            /* Compress the block */
-            stb_compress_dxt_block(&output[y][x], reinterpret_cast<const UnsignedByte*>(inputBlockData.data()), alpha, flags);
-        }
-    }
+    const Containers::StridedArrayView3D<const char> input = image.pixels();
+    if(outputFormat == CompressedPixelFormat::Bc4RUnorm)
+        compressBlocks<1>(input, output, threadCount, [](UnsignedByte* out, const UnsignedByte* in) {
+            stb_compress_bc4_block(out, in);
+        });
+    else if(outputFormat == CompressedPixelFormat::Bc5RGUnorm)
+        compressBlocks<2>(input, output, threadCount, [](UnsignedByte* out, const UnsignedByte* in) {
+            stb_compress_bc5_block(out, in);
+        });
+    else
+        compressBlocks<4>(input, output, threadCount, [alpha, flags](UnsignedByte* out, const UnsignedByte* in) {
+            stb_compress_dxt_block(out, in, alpha, flags);
+        });
 
     return ImageData2D{outputFormat, image.size(), std::move(outputData)};
 }
@@ -53,13 +53,14 @@
 namespace Magnum { namespace Trade {
 
 /**
-@brief BC1/BC3 compressor using stb_dxt
+@brief BC1/BC3/BC4/BC5 compressor using stb_dxt
 @m_since_latest_{plugins}
 
 @m_keywords{OpenExrImageConverter}
 
-Converts uncompressed RGBA images to block-compressed BC1/BC3 images using the
-[stb_dxt](https://github.com/nothings/stb) library.
+Converts uncompressed RGBA, single- and two-channel images to block-compressed
+BC1/BC3, BC4 and BC5 images using the [stb_dxt](https://github.com/nothings/stb)
+library.
 
 @m_class{m-block m-primary}
 
@@ -109,13 +110,17 @@ See @ref building-plugins, @ref cmake-plugins, @ref plugins and
 
 @section Trade-StbDxtImageConverter-behavior Behavior and limitations
 
-Currently, only @ref PixelFormat::RGBA8Unorm /
-@relativeref{PixelFormat,RGBA8Srgb} is accepted, producing a compressed
-@ref ImageData2D with @ref CompressedPixelFormat::Bc3RGBAUnorm /
+The @ref PixelFormat::RGBA8Unorm / @relativeref{PixelFormat,RGBA8Srgb} formats
+produce a compressed @ref ImageData2D with
+@ref CompressedPixelFormat::Bc3RGBAUnorm /
 @relativeref{CompressedPixelFormat,Bc3RGBASrgb}. If the @cb{.ini} alpha @ce
 @ref Trade-StbDxtImageConverter-configuration "configuration option" is
 disabled, an image with @ref CompressedPixelFormat::Bc1RGBUnorm /
 @relativeref{CompressedPixelFormat,Bc1RGBSrgb} is returned instead.
+Additionally, @ref PixelFormat::R8Unorm is compressed to
+@ref CompressedPixelFormat::Bc4RUnorm and @ref PixelFormat::RG8Unorm to
+@ref CompressedPixelFormat::Bc5RGUnorm. The signed variants of BC4 and BC5
+aren't supported by stb_dxt.
 
 The input image size is expected to be divisible by four in both dimensions. If
 your image doesn't fit this requirement, you have to pad/crop or resample it
@@ -127,6 +132,24 @@ with Y-flipping block-compressed data. This is in line with importers of
 compressed pixel formats such as @ref DdsImporter, which don't Y-flip
 compressed formats on import either.
 
+@subsection Trade-StbDxtImageConverter-behavior-multithreading Multithreaded compression
+
+Setting the @cb{.ini} threads @ce
+@ref Trade-StbDxtImageConverter-configuration "configuration option" to a
+value other than `1` splits the image into ranges of block rows, each
+compressed on a separate thread directly into the output. The output is the
+same regardless of the thread count.
+
+Similarly to @ref Trade-StanfordImporter-behavior-multithreading "StanfordImporter",
+the plugin doesn't link to `pthread` on its own and it's the application that
+needs to link to it instead if multithreading is enabled. With CMake it can be
+done like this:
+
+@code{.cmake}
+find_package(Threads REQUIRED)
+target_link_libraries(your-application PRIVATE Threads::Threads)
+@endcode
+
 @section Trade-StbDxtImageConverter-configuration Plugin-specific configuration
 
 Various compressor options can be set through @ref configuration(). See below
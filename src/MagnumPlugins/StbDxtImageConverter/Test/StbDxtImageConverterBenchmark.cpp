@@ -0,0 +1,135 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/Trade/AbstractImageConverter.h>
+#include <Magnum/Trade/ImageData.h>
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct StbDxtImageConverterBenchmark: TestSuite::Tester {
+    explicit StbDxtImageConverterBenchmark();
+
+    void convert();
+
+    void throughputBegin();
+    std::uint64_t throughputEnd();
+
+    Containers::Array<char> _data;
+    std::size_t _throughputBytes;
+    std::chrono::steady_clock::time_point _throughputBegin;
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImageConverter> _manager{"nonexistent"};
+};
+
+constexpr Vector2i Size{2048, 2048};
+
+const struct {
+    const char* name;
+    PixelFormat format;
+    bool alpha;
+    bool highQuality;
+    UnsignedInt threads;
+} ConvertData[]{
+    {"BC1, 1 thread", PixelFormat::RGBA8Unorm, false, false, 1},
+    {"BC3, 1 thread", PixelFormat::RGBA8Unorm, true, false, 1},
+    {"BC3, high quality, 1 thread", PixelFormat::RGBA8Unorm, true, true, 1},
+    {"BC3, 4 threads", PixelFormat::RGBA8Unorm, true, false, 4},
+    {"BC3, hardware thread count", PixelFormat::RGBA8Unorm, true, false, 0},
+    {"BC4, 1 thread", PixelFormat::R8Unorm, true, false, 1},
+    {"BC4, hardware thread count", PixelFormat::R8Unorm, true, false, 0},
+    {"BC5, 1 thread", PixelFormat::RG8Unorm, true, false, 1},
+    {"BC5, hardware thread count", PixelFormat::RG8Unorm, true, false, 0},
+};
+
+StbDxtImageConverterBenchmark::StbDxtImageConverterBenchmark() {
+    /* The measured value is input bytes processed per second */
+    addCustomInstancedBenchmarks({&StbDxtImageConverterBenchmark::convert}, 5,
+        Containers::arraySize(ConvertData),
+        &StbDxtImageConverterBenchmark::throughputBegin,
+        &StbDxtImageConverterBenchmark::throughputEnd,
+        BenchmarkUnits::Bytes);
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef STBDXTIMAGECONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(STBDXTIMAGECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    /* Smooth gradients with some noise on top, large enough for all formats.
+       Pure noise or flat color would make the compressor take unrealistic
+       shortcuts. */
+    _data = Containers::Array<char>{NoInit, std::size_t(Size.product()*4)};
+    UnsignedInt seed = 1;
+    for(std::size_t i = 0; i != _data.size(); ++i) {
+        seed = seed*1103515245u + 12345u;
+        const std::size_t x = (i/4)%Size.x(), y = (i/4)/Size.x();
+        _data[i] = char(((x + y*(i%4 + 1))/16 + (seed >> 28)) & 0xff);
+    }
+}
+
+void StbDxtImageConverterBenchmark::throughputBegin() {
+    _throughputBegin = std::chrono::steady_clock::now();
+}
+
+std::uint64_t StbDxtImageConverterBenchmark::throughputEnd() {
+    const std::uint64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _throughputBegin).count();
+    return nanoseconds ? _throughputBytes*1000000000ull/nanoseconds : 0;
+}
+
+void StbDxtImageConverterBenchmark::convert() {
+    auto&& data = ConvertData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("StbDxtImageConverter");
+    converter->configuration().setValue("alpha", data.alpha);
+    converter->configuration().setValue("highQuality", data.highQuality);
+    converter->configuration().setValue("threads", data.threads);
+
+    const ImageView2D image{data.format, Size,
+        _data.prefix(Size.product()*pixelSize(data.format))};
+    _throughputBytes = image.data().size();
+
+    Containers::Optional<ImageData2D> compressed;
+    CORRADE_BENCHMARK(1) {
+        compressed = converter->convert(image);
+    }
+
+    CORRADE_VERIFY(compressed);
+    CORRADE_VERIFY(compressed->isCompressed());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::StbDxtImageConverterBenchmark)
@@ -47,6 +47,7 @@ struct StbDxtImageConverterTest: TestSuite::Tester {
     void unsupportedSize();
 
     void rgba();
+    void rg();
 
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImageConverter> _converterManager{"nonexistent"};
@@ -58,19 +59,49 @@ const struct {
     Containers::Optional<bool> alpha;
     Containers::Optional<bool> highQuality;
     Containers::Optional<PixelFormat> overrideInputFormat;
+    UnsignedInt threads;
     CompressedPixelFormat expectedFormat;
     const char* expectedFile;
 } RgbaData[] {
-    {"", {}, {}, {},
+    {"", {}, {}, {}, 1,
         CompressedPixelFormat::Bc3RGBAUnorm, "ship.bc3"},
-    {"high quality", {}, true, {},
+    {"high quality", {}, true, {}, 1,
         CompressedPixelFormat::Bc3RGBAUnorm, "ship-hq.bc3"},
-    {"sRGB", {}, {}, PixelFormat::RGBA8Srgb,
+    {"sRGB", {}, {}, PixelFormat::RGBA8Srgb, 1,
         CompressedPixelFormat::Bc3RGBASrgb, "ship.bc3"},
-    {"no alpha", false, {}, {},
+    {"no alpha", false, {}, {}, 1,
         CompressedPixelFormat::Bc1RGBUnorm, "ship.bc1"},
-    {"no alpha + sRGB", false, {}, PixelFormat::RGBA8Srgb,
+    {"no alpha + sRGB", false, {}, PixelFormat::RGBA8Srgb, 1,
         CompressedPixelFormat::Bc1RGBSrgb, "ship.bc1"},
+    /* The image has 24 block rows, so this exercises uneven splits */
+    {"5 threads", {}, {}, {}, 5,
+        CompressedPixelFormat::Bc3RGBAUnorm, "ship.bc3"},
+    {"no alpha, 5 threads", false, {}, {}, 5,
+        CompressedPixelFormat::Bc1RGBUnorm, "ship.bc1"},
+    {"hardware thread count", {}, {}, {}, 0,
+        CompressedPixelFormat::Bc3RGBAUnorm, "ship.bc3"},
+    /* More threads than block rows */
+    {"100 threads", {}, {}, {}, 100,
+        CompressedPixelFormat::Bc3RGBAUnorm, "ship.bc3"},
+};
+
+const struct {
+    const char* name;
+    Int channelCount;
+    UnsignedInt threads;
+    PixelFormat expectedInputFormat;
+    CompressedPixelFormat expectedFormat;
+    std::size_t expectedBlockSize;
+    const char* expectedFile;
+} RgData[] {
+    {"single-channel", 1, 1, PixelFormat::R8Unorm,
+        CompressedPixelFormat::Bc4RUnorm, 8, "ship.bc4"},
+    {"single-channel, 5 threads", 1, 5, PixelFormat::R8Unorm,
+        CompressedPixelFormat::Bc4RUnorm, 8, "ship.bc4"},
+    {"two-channel", 2, 1, PixelFormat::RG8Unorm,
+        CompressedPixelFormat::Bc5RGUnorm, 16, "ship.bc5"},
+    {"two-channel, 5 threads", 2, 5, PixelFormat::RG8Unorm,
+        CompressedPixelFormat::Bc5RGUnorm, 16, "ship.bc5"},
 };
 
 StbDxtImageConverterTest::StbDxtImageConverterTest() {
@@ -80,6 +111,9 @@ StbDxtImageConverterTest::StbDxtImageConverterTest() {
     addInstancedTests({&StbDxtImageConverterTest::rgba},
         Containers::arraySize(RgbaData));
 
+    addInstancedTests({&StbDxtImageConverterTest::rg},
+        Containers::arraySize(RgData));
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
     #ifdef STBDXTIMAGECONVERTER_PLUGIN_FILENAME
@@ -130,6 +164,7 @@ void StbDxtImageConverterTest::rgba() {
         converter->configuration().setValue("alpha", *data.alpha);
     if(data.highQuality)
         converter->configuration().setValue("highQuality", *data.highQuality);
+    converter->configuration().setValue("threads", data.threads);
 
     Containers::Optional<Trade::ImageData2D> compressed;
     if(data.overrideInputFormat) {
@@ -150,6 +185,39 @@ void StbDxtImageConverterTest::rgba() {
         TestSuite::Compare::StringToFile);
 }
 
+void StbDxtImageConverterTest::rg() {
+    auto&& data = RgData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(_importerManager.loadState("StbImageImporter") == PluginManager::LoadState::NotFound)
+        CORRADE_SKIP("StbImageImporter plugin not found, cannot test");
+
+    /* The single-channel image is the luminance, the second channel of the
+       two-channel one is alpha, which is fully opaque for a JPEG */
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("StbImageImporter");
+    importer->configuration().setValue("forceChannelCount", data.channelCount);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STBDXTIMAGECONVERTER_TEST_DIR, "ship.jpg")));
+    Containers::Optional<Trade::ImageData2D> uncompressed = importer->image2D(0);
+    CORRADE_VERIFY(uncompressed);
+    CORRADE_COMPARE(uncompressed->format(), data.expectedInputFormat);
+    CORRADE_COMPARE(uncompressed->size(), (Vector2i{160, 96}));
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("StbDxtImageConverter");
+    converter->configuration().setValue("threads", data.threads);
+
+    Containers::Optional<Trade::ImageData2D> compressed = converter->convert(*uncompressed);
+    CORRADE_VERIFY(compressed);
+    CORRADE_VERIFY(compressed->isCompressed());
+    CORRADE_COMPARE(compressed->compressedFormat(), data.expectedFormat);
+    CORRADE_COMPARE(compressed->size(), (Vector2i{160, 96}));
+    CORRADE_COMPARE(compressed->data().size(),
+        compressed->size().product()*data.expectedBlockSize/16);
+
+    CORRADE_COMPARE_AS((std::string{compressed->data(), compressed->data().size()}),
+        Utility::Directory::join(STBDXTIMAGECONVERTER_TEST_DIR, data.expectedFile),
+        TestSuite::Compare::StringToFile);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::StbDxtImageConverterTest)
@@ -27,25 +27,160 @@
 
 #include "StbVorbisImporter.h"
 
+#include <Corrade/Containers/ScopeGuard.h>
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Debug.h>
 #include <Corrade/Utility/Endianness.h>
+#include <Magnum/Math/Functions.h>
+
+#include "MagnumPlugins/Implementation/AudioStream.h"
 
 #define STB_VORBIS_NO_STDIO 1
 #include "stb_vorbis.c"
 
 namespace Magnum { namespace Audio {
 
+namespace {
+
+BufferFormat formatFor(const Int numChannels, const bool floatingPoint) {
+    switch(numChannels) {
+        case 1: return floatingPoint ? BufferFormat::MonoFloat : BufferFormat::Mono16;
+        case 2: return floatingPoint ? BufferFormat::StereoFloat : BufferFormat::Stereo16;
+        case 4: return floatingPoint ? BufferFormat::Quad32 : BufferFormat::Quad16;
+        case 6: return floatingPoint ? BufferFormat::Surround51Channel32 : BufferFormat::Surround51Channel16;
+        case 7: return floatingPoint ? BufferFormat::Surround61Channel32 : BufferFormat::Surround61Channel16;
+        case 8: return floatingPoint ? BufferFormat::Surround71Channel32 : BufferFormat::Surround71Channel16;
+    }
+
+    return BufferFormat{};
+}
+
+/* Opens a decoder on given data, printing a message on failure. The data
+   have to stay in scope for as long as the decoder is used. */
+stb_vorbis* openDecoder(const Containers::ArrayView<const char> data) {
+    /* Not written to if the data pointer is null */
+    Int error{};
+    stb_vorbis* const handle = stb_vorbis_open_memory(reinterpret_cast<const UnsignedByte*>(data.data()), data.size(), &error, nullptr);
+    if(!handle) {
+        if(error == VORBIS_outofmem)
+            Error() << "Audio::StbVorbisImporter::openData(): out of memory";
+        else
+            Error() << "Audio::StbVorbisImporter::openData(): the file signature is invalid";
+    }
+
+    return handle;
+}
+
+/* stb_vorbis_decode_memory() has only a 16-bit variant, so floats are
+   decoded through an opened decoder instead. The stream length is taken from
+   the last page of the file, which may be missing or bogus for broken files,
+   so it's only used as an initial estimate. 0 means the length is unknown, a
+   too large value is capped and the output grows while decoding, the same
+   way stb_vorbis_decode_memory() does it. */
+Containers::Array<char> decodeFloat(stb_vorbis* const handle, const Int channels) {
+    std::size_t frameCapacity = stb_vorbis_stream_length_in_samples(handle);
+    if(!frameCapacity) frameCapacity = 4096;
+    else frameCapacity = Math::min(frameCapacity, std::size_t{1} << 24);
+
+    Containers::Array<char> out{NoInit, frameCapacity*channels*sizeof(Float)};
+    std::size_t frameCount = 0;
+    for(;;) {
+        if(frameCount == frameCapacity) {
+            Containers::Array<char> grown{NoInit, out.size()*2};
+            Utility::copy(out, grown.prefix(out.size()));
+            out = std::move(grown);
+            frameCapacity *= 2;
+        }
+
+        /* The function takes an int, decode in chunks of whole frames that
+           fit into it */
+        const Int count = Int(Math::min(frameCapacity - frameCount, std::size_t(0x7fffffff/channels))*channels);
+        const Int read = stb_vorbis_get_samples_float_interleaved(handle, channels, reinterpret_cast<Float*>(out.data()) + frameCount*channels, count);
+        if(!read) break;
+        frameCount += read;
+    }
+
+    /* Keep only what was actually decoded */
+    if(frameCount != frameCapacity) {
+        Containers::Array<char> prefix{NoInit, frameCount*channels*sizeof(Float)};
+        Utility::copy(out.prefix(prefix.size()), prefix);
+        return prefix;
+    }
+
+    return out;
+}
+
+}
+
+struct StbVorbisImporter::Stream: Implementation::AudioStream {
+    using AudioStream::AudioStream;
+
+    ~Stream() { stb_vorbis_close(handle); }
+
+    stb_vorbis* handle{};
+    bool floatingPoint;
+};
+
 StbVorbisImporter::StbVorbisImporter() = default;
 
 StbVorbisImporter::StbVorbisImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
+StbVorbisImporter::~StbVorbisImporter() = default;
+
 ImporterFeatures StbVorbisImporter::doFeatures() const { return ImporterFeature::OpenData; }
 
-bool StbVorbisImporter::doIsOpened() const { return _data; }
+bool StbVorbisImporter::doIsOpened() const { return _data || _stream; }
 
 void StbVorbisImporter::doOpenData(Containers::ArrayView<const char> data) {
+    const bool floatingPoint = configuration().value<bool>("floatOutput");
+
+    /* In streaming mode only open the decoder, operating on a copy owned by
+       the stream */
+    if(configuration().value<bool>("streaming")) {
+        Containers::Pointer<Stream> stream{new Stream{data}};
+        if(!(stream->handle = openDecoder(stream->data))) return;
+
+        const stb_vorbis_info info = stb_vorbis_get_info(stream->handle);
+        const BufferFormat format = formatFor(info.channels, floatingPoint);
+        if(format == BufferFormat{}) {
+            Error() << "Audio::StbVorbisImporter::openData(): unsupported channel count"
+                    << info.channels << "with" << (floatingPoint ? 32 : 16) << "bits per sample";
+            return;
+        }
+
+        stream->channels = info.channels;
+        stream->sampleSize = floatingPoint ? sizeof(Float) : sizeof(Short);
+        stream->frameCount = stb_vorbis_stream_length_in_samples(stream->handle);
+        stream->floatingPoint = floatingPoint;
+
+        _frequency = info.sample_rate;
+        _format = format;
+        _stream = std::move(stream);
+        return;
+    }
+
+    /* Floats need to go through an opened decoder */
+    if(floatingPoint) {
+        stb_vorbis* const handle = openDecoder(data);
+        if(!handle) return;
+        Containers::ScopeGuard closeHandle{handle, stb_vorbis_close};
+
+        const stb_vorbis_info info = stb_vorbis_get_info(handle);
+        const BufferFormat format = formatFor(info.channels, true);
+        if(format == BufferFormat{}) {
+            Error() << "Audio::StbVorbisImporter::openData(): unsupported channel count"
+                    << info.channels << "with" << 32 << "bits per sample";
+            return;
+        }
+
+        _frequency = info.sample_rate;
+        _format = format;
+        _data = decodeFloat(handle, info.channels);
+        return;
+    }
+
     Int numChannels, frequency;
     Short* decodedData = nullptr;
 
@@ -64,20 +199,8 @@ void StbVorbisImporter::doOpenData(Containers::ArrayView<const char> data) {
         [](char* data, size_t) { std::free(data); }};
     _frequency = frequency;
 
-    /** @todo Floating-point formats */
-    if(numChannels == 1)
-        _format = BufferFormat::Mono16;
-    else if(numChannels == 2)
-        _format = BufferFormat::Stereo16;
-    else if(numChannels == 4)
-        _format = BufferFormat::Quad16;
-    else if(numChannels == 6)
-        _format = BufferFormat::Surround51Channel16;
-    else if(numChannels == 7)
-        _format = BufferFormat::Surround61Channel16;
-    else if(numChannels == 8)
-        _format = BufferFormat::Surround71Channel16;
-    else {
+    _format = formatFor(numChannels, false);
+    if(_format == BufferFormat{}) {
         Error() << "Audio::StbVorbisImporter::openData(): unsupported channel count"
                 << numChannels << "with" << 16 << "bits per sample";
         return;
@@ -86,18 +209,70 @@ void StbVorbisImporter::doOpenData(Containers::ArrayView<const char> data) {
     _data = std::move(tempData);
 }
 
-void StbVorbisImporter::doClose() { _data = nullptr; }
+void StbVorbisImporter::doClose() {
+    _data = Containers::NullOpt;
+    _stream = nullptr;
+}
 
 BufferFormat StbVorbisImporter::doFormat() const { return _format; }
 
 UnsignedInt StbVorbisImporter::doFrequency() const { return _frequency; }
 
 Containers::Array<char> StbVorbisImporter::doData() {
-    Containers::Array<char> copy{NoInit, _data.size()};
-    Utility::copy(_data, copy);
+    /* In streaming mode decode the whole file from scratch so the current
+       stream position isn't affected */
+    if(_stream) {
+        if(_stream->floatingPoint) {
+            stb_vorbis* const handle = stb_vorbis_open_memory(reinterpret_cast<const UnsignedByte*>(_stream->data.data()), _stream->data.size(), nullptr, nullptr);
+            CORRADE_INTERNAL_ASSERT(handle);
+            Containers::ScopeGuard closeHandle{handle, stb_vorbis_close};
+            return decodeFloat(handle, _stream->channels);
+        }
+
+        Int numChannels;
+        Short* decodedData = nullptr;
+        const Int samples = stb_vorbis_decode_memory(reinterpret_cast<const UnsignedByte*>(_stream->data.data()), _stream->data.size(), &numChannels, nullptr, &decodedData);
+        if(samples < 0) return {};
+
+        return Containers::Array<char>{reinterpret_cast<char*>(decodedData), size_t(samples*numChannels*2),
+            [](char* data, size_t) { std::free(data); }};
+    }
+
+    /* Give up the ownership if requested. An empty array is left behind, so
+       the importer stays opened. */
+    if(configuration().value<bool>("releaseData"))
+        return std::move(*_data);
+
+    Containers::Array<char> copy{NoInit, _data->size()};
+    Utility::copy(*_data, copy);
     return copy;
 }
 
+std::size_t StbVorbisImporter::decodeInto(const Containers::ArrayView<char> data) {
+    std::size_t frameCount = Implementation::streamFrameCountFor(_stream.get(), data, "Audio::StbVorbisImporter::decodeInto():");
+    if(!frameCount) return 0; /* LCOV_EXCL_LINE */
+
+    /* The function takes an int, clamp to whole frames that fit into it */
+    const Int channels = _stream->channels;
+    const std::size_t frameSize = channels*_stream->sampleSize;
+    frameCount = Math::min(frameCount, std::size_t(0x7fffffff)/channels);
+    if(_stream->floatingPoint)
+        return stb_vorbis_get_samples_float_interleaved(_stream->handle, channels, reinterpret_cast<Float*>(data.data()), frameCount*channels)*frameSize;
+    return stb_vorbis_get_samples_short_interleaved(_stream->handle, channels, reinterpret_cast<Short*>(data.data()), frameCount*channels)*frameSize;
+}
+
+bool StbVorbisImporter::seek(const UnsignedLong frame) {
+    if(!Implementation::streamSeekInRange(_stream.get(), frame, "Audio::StbVorbisImporter::seek():"))
+        return false;
+
+    if(!(frame ? stb_vorbis_seek(_stream->handle, frame) : stb_vorbis_seek_start(_stream->handle))) {
+        Error{} << "Audio::StbVorbisImporter::seek(): can't seek to frame" << frame;
+        return false;
+    }
+
+    return true;
+}
+
 }}
 
 CORRADE_PLUGIN_REGISTER(StbVorbisAudioImporter, Magnum::Audio::StbVorbisImporter,
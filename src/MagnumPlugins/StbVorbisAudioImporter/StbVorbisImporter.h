@@ -32,6 +32,8 @@
  */
 
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Magnum/Audio/AbstractImporter.h>
 
 #include "MagnumPlugins/StbVorbisAudioImporter/configure.h"
@@ -64,7 +66,13 @@ the [stb_vorbis](https://github.com/nothings/stb) library. The files are
 imported with @ref BufferFormat::Mono16, @ref BufferFormat::Stereo16,
 @ref BufferFormat::Quad16, @ref BufferFormat::Surround51Channel16,
 @ref BufferFormat::Surround61Channel16 and @ref BufferFormat::Surround71Channel16,
-respectively.
+respectively. If the @cb{.ini} floatOutput @ce @ref Audio-StbVorbisImporter-configuration "configuration option"
+is enabled, the files are decoded directly to @ref BufferFormat::MonoFloat,
+@ref BufferFormat::StereoFloat, @ref BufferFormat::Quad32,
+@ref BufferFormat::Surround51Channel32, @ref BufferFormat::Surround61Channel32
+and @ref BufferFormat::Surround71Channel32 instead. The decoder works with
+floats internally, so this also avoids losing precision to the 16-bit
+conversion.
 
 This plugins provides `VorbisAudioImporter`, but note that this plugin doesn't
 have complete support for all format quirks and the performance might be worse
@@ -115,6 +123,30 @@ target_link_libraries(your-app PRIVATE MagnumPlugins::StbVorbisAudioImporter)
 
 See @ref building-plugins, @ref cmake-plugins and @ref plugins for more
 information.
+
+@section Audio-StbVorbisImporter-data-ownership Data ownership
+
+By default, @ref data() returns a copy of the decoded data. If the
+@cb{.ini} releaseData @ce @ref Audio-StbVorbisImporter-configuration "configuration option"
+is enabled, the first call moves the data out of the importer instead. See
+@ref audio-importer-data-ownership for more information.
+
+@section Audio-StbVorbisImporter-streaming Streaming decoding
+
+If the @cb{.ini} streaming @ce @ref Audio-StbVorbisImporter-configuration "configuration option"
+is enabled, the audio is decoded on demand using @ref decodeInto() and
+@ref seek() instead of when opening the file. See @ref audio-importer-streaming
+for more information.
+
+@section Audio-StbVorbisImporter-configuration Plugin-specific configuration
+
+It's possible to tune various import options through @ref configuration().
+See below for all options and their default values:
+
+@snippet MagnumPlugins/StbVorbisAudioImporter/StbVorbisAudioImporter.conf config
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
 */
 class MAGNUM_STBVORBISAUDIOIMPORTER_EXPORT StbVorbisImporter: public AbstractImporter {
     public:
@@ -124,7 +156,38 @@ class MAGNUM_STBVORBISAUDIOIMPORTER_EXPORT StbVorbisImporter: public AbstractImp
         /** @brief Plugin manager constructor */
         explicit StbVorbisImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        ~StbVorbisImporter();
+
+        /**
+         * @brief Decode next chunk of audio data
+         * @m_since_latest_{plugins}
+         *
+         * Expects that a file is opened with the @cb{.ini} streaming @ce
+         * @ref Audio-StbVorbisImporter-configuration "configuration option" enabled
+         * and that @p data is large enough to fit at least one frame. Decodes
+         * as many whole frames as fit into @p data, in the @ref format() the
+         * file is imported as, and returns count of bytes written. Returns
+         * @cpp 0 @ce when the end of the stream is reached.
+         * @see @ref Audio-StbVorbisImporter-streaming
+         */
+        std::size_t decodeInto(Containers::ArrayView<char> data);
+
+        /**
+         * @brief Seek to given frame
+         * @m_since_latest_{plugins}
+         *
+         * Expects that a file is opened with the @cb{.ini} streaming @ce
+         * @ref Audio-StbVorbisImporter-configuration "configuration option" enabled.
+         * The next @ref decodeInto() call continues from @p frame. If
+         * @p frame is out of range or the seek fails, prints a message to
+         * @relativeref{Magnum,Error} and returns @cpp false @ce.
+         * @see @ref Audio-StbVorbisImporter-streaming
+         */
+        bool seek(UnsignedLong frame);
+
     private:
+        struct Stream;
+
         MAGNUM_STBVORBISAUDIOIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
         MAGNUM_STBVORBISAUDIOIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_STBVORBISAUDIOIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
@@ -134,9 +197,10 @@ class MAGNUM_STBVORBISAUDIOIMPORTER_EXPORT StbVorbisImporter: public AbstractImp
         MAGNUM_STBVORBISAUDIOIMPORTER_LOCAL UnsignedInt doFrequency() const override;
         MAGNUM_STBVORBISAUDIOIMPORTER_LOCAL Containers::Array<char> doData() override;
 
-        Containers::Array<char> _data;
+        Containers::Optional<Containers::Array<char>> _data;
         BufferFormat _format;
         UnsignedInt _frequency;
+        Containers::Pointer<Stream> _stream;
 };
 
 }}
@@ -0,0 +1,114 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "MagnumPlugins/StbVorbisAudioImporter/StbVorbisImporter.h"
+#include "MagnumPlugins/Implementation/Test/AudioImporterTester.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct StbVorbisImporterStreamingTest: AudioImporterTester {
+    explicit StbVorbisImporterStreamingTest();
+
+    void decode();
+    void seek();
+    void seekOutOfRange();
+};
+
+constexpr struct {
+    const char* name;
+    const char* filename;
+    bool floatOutput;
+    std::size_t frameSize;
+} DecodeData[]{
+    {"mono", "mono16.ogg", false, 2},
+    {"stereo", "stereo8.ogg", false, 4},
+    {"mono, float output", "mono16.ogg", true, 4},
+    {"stereo, float output", "stereo8.ogg", true, 8}
+};
+
+StbVorbisImporterStreamingTest::StbVorbisImporterStreamingTest() {
+    addInstancedTests({&StbVorbisImporterStreamingTest::decode,
+                       &StbVorbisImporterStreamingTest::seek},
+        Containers::arraySize(DecodeData));
+
+    addTests({&StbVorbisImporterStreamingTest::seekOutOfRange});
+}
+
+void StbVorbisImporterStreamingTest::decode() {
+    auto&& data = DecodeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    StbVorbisImporter reference;
+    reference.configuration().setValue("floatOutput", data.floatOutput);
+    CORRADE_VERIFY(reference.openFile(Utility::Directory::join(STBVORBISAUDIOIMPORTER_TEST_DIR, data.filename)));
+
+    StbVorbisImporter importer;
+    importer.configuration().setValue("streaming", true);
+    importer.configuration().setValue("floatOutput", data.floatOutput);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STBVORBISAUDIOIMPORTER_TEST_DIR, data.filename)));
+    CORRADE_COMPARE(importer.format(), reference.format());
+    CORRADE_COMPARE(importer.frequency(), reference.frequency());
+
+    verifyDecode(importer, reference.data(), data.frameSize);
+}
+
+void StbVorbisImporterStreamingTest::seek() {
+    auto&& data = DecodeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    StbVorbisImporter reference;
+    reference.configuration().setValue("floatOutput", data.floatOutput);
+    CORRADE_VERIFY(reference.openFile(Utility::Directory::join(STBVORBISAUDIOIMPORTER_TEST_DIR, data.filename)));
+    const Containers::Array<char> expected = reference.data();
+
+    StbVorbisImporter importer;
+    importer.configuration().setValue("streaming", true);
+    importer.configuration().setValue("floatOutput", data.floatOutput);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STBVORBISAUDIOIMPORTER_TEST_DIR, data.filename)));
+
+    /* The test files have just one or two frames, so seek to the last one */
+    verifySeek(importer, expected, data.frameSize, expected.size()/data.frameSize - 1);
+}
+
+void StbVorbisImporterStreamingTest::seekOutOfRange() {
+    StbVorbisImporter reference;
+    CORRADE_VERIFY(reference.openFile(Utility::Directory::join(STBVORBISAUDIOIMPORTER_TEST_DIR, "mono16.ogg")));
+
+    StbVorbisImporter importer;
+    importer.configuration().setValue("streaming", true);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STBVORBISAUDIOIMPORTER_TEST_DIR, "mono16.ogg")));
+
+    verifySeekOutOfRange(importer, "StbVorbisImporter", reference.data().size()/2);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::StbVorbisImporterStreamingTest)
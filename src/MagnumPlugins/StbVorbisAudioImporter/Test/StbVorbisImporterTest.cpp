@@ -28,15 +28,18 @@
 #include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 #include <Magnum/Audio/AbstractImporter.h>
 
+#include "MagnumPlugins/Implementation/Test/AudioImporterTester.h"
+
 #include "configure.h"
 
 namespace Magnum { namespace Audio { namespace Test { namespace {
 
-class StbVorbisImporterTest: public TestSuite::Tester {
+class StbVorbisImporterTest: public AudioImporterTester {
     public:
         explicit StbVorbisImporterTest();
 
@@ -49,6 +52,15 @@ class StbVorbisImporterTest: public TestSuite::Tester {
         void mono16();
         void stereo8();
 
+        void mono16Float();
+        void stereo8Float();
+        void unsupportedChannelCountFloat();
+
+        void truncated();
+        void truncatedFloat();
+
+        void releaseData();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
@@ -61,7 +73,16 @@ StbVorbisImporterTest::StbVorbisImporterTest() {
               &StbVorbisImporterTest::zeroSamples,
 
               &StbVorbisImporterTest::mono16,
-              &StbVorbisImporterTest::stereo8});
+              &StbVorbisImporterTest::stereo8,
+
+              &StbVorbisImporterTest::mono16Float,
+              &StbVorbisImporterTest::stereo8Float,
+              &StbVorbisImporterTest::unsupportedChannelCountFloat,
+
+              &StbVorbisImporterTest::truncated,
+              &StbVorbisImporterTest::truncatedFloat,
+
+              &StbVorbisImporterTest::releaseData});
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
@@ -133,6 +154,81 @@ void StbVorbisImporterTest::stereo8() {
         }), TestSuite::Compare::Container);
 }
 
+void StbVorbisImporterTest::mono16Float() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StbVorbisAudioImporter");
+    importer->configuration().setValue("floatOutput", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STBVORBISAUDIOIMPORTER_TEST_DIR, "mono16.ogg")));
+
+    CORRADE_COMPARE(importer->format(), BufferFormat::MonoFloat);
+    CORRADE_COMPARE(importer->frequency(), 96000);
+    CORRADE_COMPARE_AS(Containers::arrayCast<Float>(importer->data()),
+        Containers::arrayView<Float>({
+            0.0843833f, 0.0794475f
+        }), TestSuite::Compare::Container);
+}
+
+void StbVorbisImporterTest::stereo8Float() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StbVorbisAudioImporter");
+    importer->configuration().setValue("floatOutput", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STBVORBISAUDIOIMPORTER_TEST_DIR, "stereo8.ogg")));
+
+    CORRADE_COMPARE(importer->format(), BufferFormat::StereoFloat);
+    CORRADE_COMPARE(importer->frequency(), 96000);
+    CORRADE_COMPARE_AS(Containers::arrayCast<Float>(importer->data()),
+        Containers::arrayView<Float>({
+            0.197193f, 0.180586f
+        }), TestSuite::Compare::Container);
+}
+
+void StbVorbisImporterTest::unsupportedChannelCountFloat() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StbVorbisAudioImporter");
+    importer->configuration().setValue("floatOutput", true);
+    CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(STBVORBISAUDIOIMPORTER_TEST_DIR, "unsupportedChannelCount.ogg")));
+    CORRADE_COMPARE(out.str(), "Audio::StbVorbisImporter::openData(): unsupported channel count 5 with 32 bits per sample\n");
+}
+
+void StbVorbisImporterTest::truncated() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StbVorbisAudioImporter");
+
+    /* The mono16.ogg file with the last byte cut off. The last page is
+       incomplete, but the audio packet in it can still be decoded. */
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STBVORBISAUDIOIMPORTER_TEST_DIR, "truncated.ogg")));
+
+    CORRADE_COMPARE(importer->format(), BufferFormat::Mono16);
+    CORRADE_COMPARE(importer->frequency(), 96000);
+    CORRADE_COMPARE_AS(importer->data(),
+        Containers::arrayView<char>({
+            '\xcd', '\x0a', '\x2b', '\x0a'
+        }), TestSuite::Compare::Container);
+}
+
+void StbVorbisImporterTest::truncatedFloat() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StbVorbisAudioImporter");
+    importer->configuration().setValue("floatOutput", true);
+
+    /* The stream length can't be determined without the last page, it
+       shouldn't result in an empty output */
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STBVORBISAUDIOIMPORTER_TEST_DIR, "truncated.ogg")));
+
+    CORRADE_COMPARE(importer->format(), BufferFormat::MonoFloat);
+    CORRADE_COMPARE(importer->frequency(), 96000);
+    CORRADE_COMPARE_AS(Containers::arrayCast<Float>(importer->data()),
+        Containers::arrayView<Float>({
+            0.0843833f, 0.0794475f
+        }), TestSuite::Compare::Container);
+}
+
+void StbVorbisImporterTest::releaseData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StbVorbisAudioImporter");
+    importer->configuration().setValue("releaseData", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STBVORBISAUDIOIMPORTER_TEST_DIR, "mono16.ogg")));
+
+    verifyReleaseData(*importer, Utility::Directory::join(STBVORBISAUDIOIMPORTER_TEST_DIR, "mono16.ogg"));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::StbVorbisImporterTest)
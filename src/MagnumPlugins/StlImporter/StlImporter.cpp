@@ -26,6 +26,8 @@
 #include "StlImporter.h"
 
 #include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
@@ -37,8 +39,22 @@
 #include <Magnum/Math/Vector3.h>
 #include <Magnum/Trade/MeshData.h>
 
+#include "MagnumPlugins/Implementation/ImporterFileData.h"
+#include "MagnumPlugins/StanfordImporter/AsciiParsing.h"
+
 namespace Magnum { namespace Trade {
 
+struct StlImporter::State: Implementation::ImporterFileData {
+    /* ASCII files are parsed into a 3D normal followed by three 3D vertices
+       for each triangle, in Little-Endian to match the binary files */
+    Containers::Array<Vector3> asciiData;
+
+    /* View on the triangles either in data or in asciiData */
+    Containers::ArrayView<const char> triangleData;
+    std::size_t triangleCount;
+    std::ptrdiff_t triangleStride;
+};
+
 StlImporter::StlImporter() = default;
 
 StlImporter::StlImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
@@ -47,32 +63,261 @@ StlImporter::~StlImporter() = default;
 
 ImporterFeatures StlImporter::doFeatures() const { return ImporterFeature::OpenData; }
 
-bool StlImporter::doIsOpened() const { return !!_in; }
+bool StlImporter::doIsOpened() const { return !!_state; }
 
-void StlImporter::doClose() { _in = Containers::NullOpt; }
+void StlImporter::doClose() { _state = nullptr; }
 
 void StlImporter::doOpenFile(const std::string& filename) {
-    if(!Utility::Directory::exists(filename)) {
-        Error{} << "Trade::StlImporter::openFile(): cannot open file" << filename;
+    auto state = Containers::pointer<State>();
+    if(!state->openFile(filename, configuration().value<bool>("memoryMapFile"), "Trade::StlImporter::openFile():"))
         return;
-    }
 
-    openDataInternal(Utility::Directory::read(filename));
+    openDataInternal(std::move(state));
 }
 
 void StlImporter::doOpenData(Containers::ArrayView<const char> data) {
-    Containers::Array<char> copy{NoInit, data.size()};
-    Utility::copy(data, copy);
-    openDataInternal(std::move(copy));
+    auto state = Containers::pointer<State>();
+    state->openData(data, configuration().value<bool>("borrowData"));
+
+    openDataInternal(std::move(state));
 }
 
 namespace {
-    /* In the input file, the triangle is represented by 12 floats (3D normal
-       followed by three 3D vertices) and 2 extra bytes. */
-    constexpr std::ptrdiff_t InputTriangleStride = 12*4 + 2;
+
+/* In the input file, the triangle is represented by 12 floats (3D normal
+   followed by three 3D vertices) and 2 extra bytes. */
+constexpr std::ptrdiff_t InputTriangleStride = 12*4 + 2;
+
+/* Parsed ASCII files have no extra bytes */
+constexpr std::ptrdiff_t AsciiTriangleStride = 12*4;
+
+bool expectAsciiKeyword(Containers::ArrayView<const char>& in, const char* const keyword) {
+    const Containers::ArrayView<const char> token = Implementation::nextAsciiToken(in);
+    if(Implementation::asciiTokenEquals(token, keyword)) return true;
+
+    if(token.empty())
+        Error{} << "Trade::StlImporter::openData(): expected" << keyword << "but got end of file";
+    else
+        Error{} << "Trade::StlImporter::openData(): expected" << keyword << "but got" << std::string{token.begin(), token.end()};
+    return false;
+}
+
+bool parseAsciiVector(Containers::ArrayView<const char>& in, Vector3& out) {
+    for(std::size_t i = 0; i != 3; ++i) {
+        const Containers::ArrayView<const char> token = Implementation::nextAsciiToken(in);
+        if(!Implementation::parseAsciiFloat(token, out[i])) {
+            if(token.empty())
+                Error{} << "Trade::StlImporter::openData(): expected a number but got end of file";
+            else
+                Error{} << "Trade::StlImporter::openData(): invalid number" << std::string{token.begin(), token.end()};
+            return false;
+        }
+    }
+
+    return true;
 }
 
-void StlImporter::openDataInternal(Containers::Array<char>&& data) {
+bool parseAscii(Containers::ArrayView<const char> in, Containers::Array<Vector3>& out) {
+    /* Reserve optimistically for the shortest possible facet with
+       single-digit numbers and no indentation, the array will grow if that's
+       not enough */
+    Containers::arrayReserve(out, 4*(in.size()/130 + 1));
+
+    /* There can be more than one solid in the file, all triangles are put
+       into a single mesh. The file is expected to start with "solid", which
+       was checked by the caller already. */
+    for(;;) {
+        Containers::ArrayView<const char> token = Implementation::nextAsciiToken(in);
+        if(token.empty()) break;
+        if(!Implementation::asciiTokenEquals(token, "solid")) {
+            Error{} << "Trade::StlImporter::openData(): expected solid but got" << std::string{token.begin(), token.end()};
+            return false;
+        }
+
+        /* Solid name, if any, is ignored */
+        Implementation::skipAsciiLine(in);
+
+        for(;;) {
+            token = Implementation::nextAsciiToken(in);
+            if(Implementation::asciiTokenEquals(token, "endsolid")) {
+                /* Again ignoring the name */
+                Implementation::skipAsciiLine(in);
+                break;
+            }
+
+            if(!Implementation::asciiTokenEquals(token, "facet")) {
+                if(token.empty())
+                    Error{} << "Trade::StlImporter::openData(): expected facet or endsolid but got end of file";
+                else
+                    Error{} << "Trade::StlImporter::openData(): expected facet or endsolid but got" << std::string{token.begin(), token.end()};
+                return false;
+            }
+
+            Vector3 normal, a, b, c;
+            if(!expectAsciiKeyword(in, "normal") ||
+               !parseAsciiVector(in, normal) ||
+               !expectAsciiKeyword(in, "outer") ||
+               !expectAsciiKeyword(in, "loop") ||
+               !expectAsciiKeyword(in, "vertex") ||
+               !parseAsciiVector(in, a) ||
+               !expectAsciiKeyword(in, "vertex") ||
+               !parseAsciiVector(in, b) ||
+               !expectAsciiKeyword(in, "vertex") ||
+               !parseAsciiVector(in, c) ||
+               !expectAsciiKeyword(in, "endloop") ||
+               !expectAsciiKeyword(in, "endfacet"))
+                return false;
+
+            Containers::arrayAppend(out, normal);
+            Containers::arrayAppend(out, a);
+            Containers::arrayAppend(out, b);
+            Containers::arrayAppend(out, c);
+        }
+    }
+
+    return true;
+}
+
+UnsignedInt hashVertex(const Containers::ArrayView<const UnsignedInt> vertex) {
+    /* Combining the bit patterns of all components, with a final avalanche
+       so the low bits used for the table slot depend on all input bits */
+    UnsignedInt hash = 0x811c9dc5u;
+    for(const UnsignedInt i: vertex) hash = (hash ^ i)*0x01000193u;
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    return hash;
+}
+
+/* Copies given vertex from the input, as integers to have the comparison
+   bitwise, same as MeshTools::removeDuplicates() */
+void gatherVertex(const Containers::StridedArrayView2D<const Vector3>& inputPositions, const Containers::StridedArrayView2D<const Vector3>& inputNormals, const bool withNormals, const std::size_t i, UnsignedInt* const out) {
+    std::memcpy(out, &inputPositions[i/3][i%3], sizeof(Vector3));
+    if(withNormals)
+        std::memcpy(out + 3, &inputNormals[i/3][0], sizeof(Vector3));
+}
+
+/* Produces an indexed mesh with bit-identical vertices merged. The extra
+   memory is an open-addressing hash table pointing to the first occurrence of
+   each unique vertex in the input, sized based on the unique vertex count,
+   not the input size. Indices are written directly to the output index
+   buffer and the unique vertices are copied from the input straight to the
+   output vertex buffer once their count is known. */
+Containers::Optional<MeshData> deduplicatedMesh(const Containers::StridedArrayView2D<const Vector3>& inputPositions, const Containers::StridedArrayView2D<const Vector3>& inputNormals, const bool withNormals) {
+    const std::size_t vertexCount = inputPositions.size()[0]*3;
+    const std::size_t vertexSize = withNormals ? 6 : 3;
+
+    /* The indices are 32-bit during deduplication, converted to a smaller
+       type at the end if possible */
+    Containers::Array<char> indexData{NoInit, vertexCount*4};
+    const Containers::ArrayView<UnsignedInt> indices = Containers::arrayCast<UnsignedInt>(indexData);
+    Containers::Array<std::size_t> table{DirectInit, 1024, ~std::size_t{}};
+    std::size_t uniqueCount = 0;
+    for(std::size_t i = 0; i != vertexCount; ++i) {
+        UnsignedInt vertex[6];
+        gatherVertex(inputPositions, inputNormals, withNormals, i, vertex);
+        const Containers::ArrayView<const UnsignedInt> vertexView{vertex, vertexSize};
+
+        /* Find the vertex in the table using linear probing, add it if not
+           there yet */
+        const std::size_t mask = table.size() - 1;
+        for(std::size_t slot = hashVertex(vertexView) & mask;; slot = (slot + 1) & mask) {
+            const std::size_t first = table[slot];
+            if(first == ~std::size_t{}) {
+                /* The vertex count in MeshData is 32-bit */
+                if(uniqueCount == ~UnsignedInt{}) {
+                    Error{} << "Trade::StlImporter::mesh(): can't deduplicate to more than" << ~UnsignedInt{} << "vertices";
+                    return {};
+                }
+
+                table[slot] = i;
+                indices[i] = UnsignedInt(uniqueCount++);
+                break;
+            }
+
+            UnsignedInt other[6];
+            gatherVertex(inputPositions, inputNormals, withNormals, first, other);
+            if(std::memcmp(other, vertex, vertexSize*4) == 0) {
+                indices[i] = indices[first];
+                break;
+            }
+        }
+
+        /* Keep the table at most half full, rehash when it gets over */
+        if(uniqueCount*2 > table.size()) {
+            Containers::Array<std::size_t> newTable{DirectInit, table.size()*2, ~std::size_t{}};
+            const std::size_t newMask = newTable.size() - 1;
+            for(const std::size_t first: table) {
+                if(first == ~std::size_t{}) continue;
+
+                UnsignedInt other[6];
+                gatherVertex(inputPositions, inputNormals, withNormals, first, other);
+                std::size_t slot = hashVertex({other, vertexSize}) & newMask;
+                while(newTable[slot] != ~std::size_t{}) slot = (slot + 1) & newMask;
+                newTable[slot] = first;
+            }
+            table = std::move(newTable);
+        }
+    }
+
+    /* Free the table before allocating the output vertex buffer to keep the
+       peak memory use lower */
+    table = nullptr;
+
+    /* Unique vertices got their IDs in order of their first occurrence, so
+       copy each input vertex whose index is the next ID. Then convert the
+       endianness. This is needed only on Big-Endian systems, but it's enabled
+       always to minimize a risk of accidental breakage when we can't test. */
+    const std::size_t stride = vertexSize*4;
+    Containers::Array<char> vertexData{NoInit, uniqueCount*stride};
+    const Containers::ArrayView<UnsignedInt> vertices = Containers::arrayCast<UnsignedInt>(vertexData);
+    for(std::size_t i = 0, next = 0; next != uniqueCount; ++i) {
+        if(indices[i] != next) continue;
+        gatherVertex(inputPositions, inputNormals, withNormals, i, vertices + next*vertexSize);
+        ++next;
+    }
+    Utility::Endianness::littleEndianInPlace(vertices);
+
+    /* Pick the smallest index type that can represent all vertices. The 32-bit
+       index buffer is used as-is if it can't be made smaller. */
+    MeshIndexType indexType;
+    if(uniqueCount <= 0x100) {
+        indexType = MeshIndexType::UnsignedByte;
+        Containers::Array<char> out{NoInit, vertexCount};
+        Containers::ArrayView<UnsignedByte> outIndices = Containers::arrayCast<UnsignedByte>(out);
+        for(std::size_t i = 0; i != vertexCount; ++i)
+            outIndices[i] = UnsignedByte(indices[i]);
+        indexData = std::move(out);
+    } else if(uniqueCount <= 0x10000) {
+        indexType = MeshIndexType::UnsignedShort;
+        Containers::Array<char> out{NoInit, vertexCount*2};
+        Containers::ArrayView<UnsignedShort> outIndices = Containers::arrayCast<UnsignedShort>(out);
+        for(std::size_t i = 0; i != vertexCount; ++i)
+            outIndices[i] = UnsignedShort(indices[i]);
+        indexData = std::move(out);
+    } else indexType = MeshIndexType::UnsignedInt;
+
+    Containers::Array<MeshAttributeData> attributeData{withNormals ? 2u : 1u};
+    attributeData[0] = MeshAttributeData{MeshAttribute::Position,
+        Containers::StridedArrayView1D<const Vector3>{vertexData,
+            reinterpret_cast<const Vector3*>(vertexData.data()),
+            uniqueCount, std::ptrdiff_t(stride)}};
+    if(withNormals) attributeData[1] = MeshAttributeData{MeshAttribute::Normal,
+        Containers::StridedArrayView1D<const Vector3>{vertexData,
+            reinterpret_cast<const Vector3*>(vertexData.data() + sizeof(Vector3)),
+            uniqueCount, std::ptrdiff_t(stride)}};
+
+    const MeshIndexData meshIndices{indexType, indexData};
+    return MeshData{MeshPrimitive::Triangles,
+        std::move(indexData), meshIndices,
+        std::move(vertexData), std::move(attributeData)};
+}
+
+}
+
+void StlImporter::openDataInternal(Containers::Pointer<State>&& state) {
+    const Containers::ArrayView<const char> data = state->data;
+
     /* At this point we can't even check if it's an ASCII or binary file, bail
        out */
     if(data.size() < 5) {
@@ -80,8 +325,32 @@ void StlImporter::openDataInternal(Containers::Array<char>&& data) {
         return;
     }
 
-    if(std::memcmp(data, "solid", 5) == 0) {
-        Error{} << "Trade::StlImporter::openData(): ASCII STL files are not supported, sorry";
+    /* ASCII files start with "solid", but some exporters put that into the
+       header of binary files as well. Treat the file as ASCII only if its size
+       doesn't match a binary file. */
+    UnsignedInt triangleCount{};
+    if(data.size() >= 84) {
+        std::memcpy(&triangleCount, data + 80, 4);
+        Utility::Endianness::littleEndianInPlace(triangleCount);
+    }
+    if(std::memcmp(data, "solid", 5) == 0 && (data.size() < 84 || data.size() != 84 + InputTriangleStride*std::size_t(triangleCount))) {
+        if(!parseAscii(data, state->asciiData)) return;
+
+        /* The textual data aren't needed anymore */
+        state->ownedData = nullptr;
+        #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+        state->mappedData = nullptr;
+        #endif
+        state->data = nullptr;
+
+        /* This is needed only on Big-Endian systems, but it's enabled always
+           to minimize a risk of accidental breakage when we can't test. */
+        Utility::Endianness::littleEndianInPlace(Containers::arrayCast<Float>(Containers::arrayView(state->asciiData)));
+
+        state->triangleData = Containers::arrayCast<const char>(Containers::arrayView(state->asciiData));
+        state->triangleCount = state->asciiData.size()/4;
+        state->triangleStride = AsciiTriangleStride;
+        _state = std::move(state);
         return;
     }
 
@@ -90,14 +359,16 @@ void StlImporter::openDataInternal(Containers::Array<char>&& data) {
         return;
     }
 
-    const UnsignedInt triangleCount = Utility::Endianness::littleEndian(*reinterpret_cast<const UnsignedInt*>(data + 80));
     const std::size_t expectedSize = InputTriangleStride*triangleCount;
     if(data.size() != 84 + expectedSize) {
         Error{} << "Trade::StlImporter::openData(): file size doesn't match triangle count, expected" << 84 + expectedSize << "but got" << data.size() << "for" << triangleCount << "triangles";
         return;
     }
 
-    _in = std::move(data);
+    state->triangleData = data.suffix(84);
+    state->triangleCount = triangleCount;
+    state->triangleStride = InputTriangleStride;
+    _state = std::move(state);
 }
 
 UnsignedInt StlImporter::doMeshCount() const { return 1; }
@@ -112,16 +383,20 @@ Containers::Optional<MeshData> StlImporter::doMesh(UnsignedInt, UnsignedInt leve
     const bool perFaceToPerVertex = configuration().value<bool>("perFaceToPerVertex");
     CORRADE_INTERNAL_ASSERT(!(level == 1 && perFaceToPerVertex));
 
-    Containers::ArrayView<const char> in = _in->suffix(84);
+    Containers::ArrayView<const char> in = _state->triangleData;
 
     /* Make 2D views on input normals and positions */
-    const std::size_t triangleCount = in.size()/InputTriangleStride;
+    const std::size_t triangleCount = _state->triangleCount;
     Containers::StridedArrayView2D<const Vector3> inputNormals{in,
         reinterpret_cast<const Vector3*>(in.data() + 0),
-        {triangleCount, 1}, {InputTriangleStride, 0}};
+        {triangleCount, 1}, {_state->triangleStride, 0}};
     Containers::StridedArrayView2D<const Vector3> inputPositions{in,
         reinterpret_cast<const Vector3*>(in.data() + sizeof(Vector3)),
-        {triangleCount, 3}, {InputTriangleStride, sizeof(Vector3)}};
+        {triangleCount, 3}, {_state->triangleStride, sizeof(Vector3)}};
+
+    /* Indexed output with duplicate vertices merged */
+    if(level == 0 && configuration().value<bool>("deduplicateVertices"))
+        return deduplicatedMesh(inputPositions, inputNormals, perFaceToPerVertex);
 
     /* Decide on output vertex stride and attribute count */
     std::size_t vertexCount;
@@ -30,8 +30,7 @@
  * @m_since_{plugins,2020,06}
  */
 
-#include <Corrade/Containers/Optional.h>
-#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Magnum/Trade/AbstractImporter.h>
 
 #include "MagnumPlugins/StlImporter/configure.h"
@@ -58,7 +57,7 @@ namespace Magnum { namespace Trade {
 @brief STL importer plugin
 @m_since_{plugins,2020,06}
 
-Imports normal and vertex information from binary
+Imports normal and vertex information from ASCII and binary
 [Stereolitography STL](https://en.wikipedia.org/wiki/STL_(file_format)) files.
 
 @section Trade-StlImporter-usage Usage
@@ -98,7 +97,7 @@ See @ref building-plugins, @ref cmake-plugins, @ref plugins and
 
 @section Trade-StlImporter-behavior Behavior and limitations
 
-The file is always imported as a non-indexed triangle mesh with per-face
+By default, the file is imported as a non-indexed triangle mesh with per-face
 normals (i.e., same normal for all vertices in the triangle). Both positions
 and normals are imported as @ref VertexFormat::Vector3. Using the
 @cb{.ini} perFaceToPerVertex @ce @ref Trade-StanfordImporter-configuration "configuration option"
@@ -106,9 +105,51 @@ it's possible to import per-face normals separately without duplicating them
 for each vertex --- useful for example when you want to deduplicate the
 positions and generate smooth normals from these.
 
-Similarly to @ref StanfordImporter, ASCII files are not supported, only binary.
+ASCII files are detected by the `solid` keyword at the beginning. Because
+some exporters put that keyword into the header of binary files as well, a file
+is treated as binary if its size matches the triangle count stored in the
+binary header. ASCII files are parsed fully already during @ref openData(),
+into the same representation as binary files, and if there's more than one
+solid in the file, all are put into a single mesh. Names of the solids are
+ignored. Numbers are parsed with a locale-independent parser into a double,
+which is correctly rounded for values with up to 15 significant digits, and
+then narrowed to a float. Because of the double rounding, the result may in
+rare cases differ from a correctly rounded float in the last bit.
+
 The [non-standard extensions for vertex colors](https://en.wikipedia.org/wiki/STL_(file_format)#Color_in_binary_STL)
-are also not supported due to a lack of generally available files for testing.
+are not supported due to a lack of generally available files for testing.
+
+@subsection Trade-StlImporter-behavior-deduplication Vertex deduplication
+
+Because STL has no concept of shared vertices, a non-indexed mesh contains
+every vertex at least three times. Enabling the
+@cb{.ini} deduplicateVertices @ce
+@ref Trade-StlImporter-configuration "configuration option" merges
+bit-identical vertices together during @ref mesh() and produces an indexed
+mesh instead, with the smallest index type that can represent all vertices.
+With @cb{.ini} perFaceToPerVertex @ce enabled, a vertex is a position and a
+normal, which means only vertices shared by triangles facing the same
+direction get merged. Disable it to weld all identical positions together ---
+the per-face normals are then still available in the second mesh level.
+
+The deduplication is done directly on the file data, without creating the
+non-indexed mesh first. Apart from the output, the only additional memory is a
+hash table pointing to the first occurrence of each unique vertex in the file,
+with a @ref std::size_t entry for every unique vertex, at most half full. If
+the final index type is smaller than 32 bits, the indices are additionally
+converted from a temporary 32-bit array at the end. This is cheaper than
+importing the non-indexed mesh and passing it to
+@ref MeshTools::removeDuplicates() afterwards.
+
+@subsection Trade-StlImporter-behavior-memory Memory-mapped and borrowed data
+
+Enabling the @cb{.ini} memoryMapFile @ce
+@ref Trade-StlImporter-configuration "configuration option" makes
+@ref openFile() memory-map the file instead of reading it into memory, while
+the @cb{.ini} borrowData @ce option makes @ref openData() reference the passed
+memory instead of copying it. See the
+@ref Trade-StanfordImporter-behavior-memory "StanfordImporter documentation"
+for details, the behavior is the same here.
 
 @section Trade-StlImporter-configuration Plugin-specific config
 
@@ -131,19 +172,21 @@ class MAGNUM_STLIMPORTER_EXPORT StlImporter: public AbstractImporter {
         ~StlImporter();
 
     private:
+        struct State;
+
         MAGNUM_STLIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
 
         MAGNUM_STLIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_STLIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
         MAGNUM_STLIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
-        MAGNUM_STLIMPORTER_LOCAL void openDataInternal(Containers::Array<char>&& data);
+        MAGNUM_STLIMPORTER_LOCAL void openDataInternal(Containers::Pointer<State>&& state);
         MAGNUM_STLIMPORTER_LOCAL void doClose() override;
 
         MAGNUM_STLIMPORTER_LOCAL UnsignedInt doMeshCount() const override;
         MAGNUM_STLIMPORTER_LOCAL UnsignedInt doMeshLevelCount(UnsignedInt id) override;
         MAGNUM_STLIMPORTER_LOCAL Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt level) override;
 
-        Containers::Optional<Containers::Array<char>> _in;
+        Containers::Pointer<State> _state;
 };
 
 }}
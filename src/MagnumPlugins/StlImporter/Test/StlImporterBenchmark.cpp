@@ -0,0 +1,245 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Endianness.h>
+#include <Magnum/Math/Vector3.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/MeshData.h>
+
+#include "MagnumPlugins/Implementation/anonymousResidentMemory.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct StlImporterBenchmark: TestSuite::Tester {
+    explicit StlImporterBenchmark();
+
+    void openFile();
+    void openData();
+    void openDataAscii();
+
+    #ifdef __linux__
+    void openFileMemory();
+    void openDataMemory();
+
+    void memoryBegin();
+    std::uint64_t memoryEnd();
+    #endif
+
+    std::string _filename;
+    Containers::Array<char> _data;
+    std::string _asciiData;
+    #ifdef __linux__
+    std::uint64_t _memoryBaseline;
+    #endif
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+constexpr std::size_t TriangleCount = 1 << 18;
+
+constexpr struct {
+    const char* name;
+    const char* option;
+} OpenFileData[]{
+    {"copy", nullptr},
+    {"memory-mapped", "memoryMapFile"}
+};
+
+constexpr struct {
+    const char* name;
+    const char* option;
+} OpenDataData[]{
+    {"copy", nullptr},
+    {"borrowed", "borrowData"}
+};
+
+StlImporterBenchmark::StlImporterBenchmark() {
+    addInstancedBenchmarks({&StlImporterBenchmark::openFile}, 5,
+        Containers::arraySize(OpenFileData));
+    addInstancedBenchmarks({&StlImporterBenchmark::openData}, 5,
+        Containers::arraySize(OpenDataData));
+    addBenchmarks({&StlImporterBenchmark::openDataAscii}, 5);
+
+    #ifdef __linux__
+    addCustomInstancedBenchmarks({&StlImporterBenchmark::openFileMemory}, 1,
+        Containers::arraySize(OpenFileData),
+        &StlImporterBenchmark::memoryBegin,
+        &StlImporterBenchmark::memoryEnd,
+        BenchmarkUnits::Bytes);
+    addCustomInstancedBenchmarks({&StlImporterBenchmark::openDataMemory}, 1,
+        Containers::arraySize(OpenDataData),
+        &StlImporterBenchmark::memoryBegin,
+        &StlImporterBenchmark::memoryEnd,
+        BenchmarkUnits::Bytes);
+    #endif
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef STLIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(STLIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    /* Generate a large binary STL, with a zero header and zero normals and
+       attribute bytes */
+    constexpr std::size_t TriangleSize = 12*4 + 2;
+    _data = Containers::Array<char>{ValueInit, 84 + TriangleCount*TriangleSize};
+    const UnsignedInt triangleCount = Utility::Endianness::littleEndian(UnsignedInt(TriangleCount));
+    std::memcpy(_data + 80, &triangleCount, 4);
+    for(std::size_t i = 0; i != TriangleCount; ++i) {
+        Float positions[9]{
+            Float(i%512), Float(i/512), 0.0f,
+            Float(i%512 + 1), Float(i/512), 0.0f,
+            Float(i%512), Float(i/512 + 1), 0.0f};
+        for(Float& j: positions) Utility::Endianness::littleEndianInPlace(j);
+        std::memcpy(_data + 84 + i*TriangleSize + 12, positions, sizeof(positions));
+    }
+
+    /* The same triangles as ASCII, for comparing with the binary import */
+    std::ostringstream ascii;
+    ascii << "solid benchmark\n";
+    for(std::size_t i = 0; i != TriangleCount; ++i) {
+        const Float x = Float(i%512), y = Float(i/512);
+        ascii << "  facet normal 0 0 0\n"
+              << "    outer loop\n"
+              << "      vertex " << x << ' ' << y << " 0\n"
+              << "      vertex " << x + 1.0f << ' ' << y << " 0\n"
+              << "      vertex " << x << ' ' << y + 1.0f << " 0\n"
+              << "    endloop\n"
+              << "  endfacet\n";
+    }
+    ascii << "endsolid benchmark\n";
+    _asciiData = ascii.str();
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::mkpath(STLIMPORTER_TEST_OUTPUT_DIR));
+    _filename = Utility::Directory::join(STLIMPORTER_TEST_OUTPUT_DIR, "benchmark.stl");
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::write(_filename, _data));
+}
+
+void StlImporterBenchmark::openFile() {
+    auto&& data = OpenFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StlImporter");
+    if(data.option) importer->configuration().setValue(data.option, true);
+
+    Containers::Optional<MeshData> mesh;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openFile(_filename));
+        mesh = importer->mesh(0);
+    }
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), TriangleCount*3);
+}
+
+void StlImporterBenchmark::openData() {
+    auto&& data = OpenDataData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StlImporter");
+    if(data.option) importer->configuration().setValue(data.option, true);
+
+    Containers::Optional<MeshData> mesh;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData(_data));
+        mesh = importer->mesh(0);
+    }
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), TriangleCount*3);
+}
+
+void StlImporterBenchmark::openDataAscii() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StlImporter");
+
+    Containers::Optional<MeshData> mesh;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData({_asciiData.data(), _asciiData.size()}));
+        mesh = importer->mesh(0);
+    }
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), TriangleCount*3);
+}
+
+#ifdef __linux__
+void StlImporterBenchmark::memoryBegin() {
+    _memoryBaseline = Implementation::anonymousResidentMemory();
+}
+
+std::uint64_t StlImporterBenchmark::memoryEnd() {
+    return Implementation::anonymousResidentMemory() - _memoryBaseline;
+}
+
+void StlImporterBenchmark::openFileMemory() {
+    auto&& data = OpenFileData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StlImporter");
+    if(data.option) importer->configuration().setValue(data.option, true);
+
+    /* The importer is kept opened and the mesh alive until the measurement
+       ends, so the value is the peak memory needed to get the first mesh */
+    Containers::Optional<MeshData> mesh;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openFile(_filename));
+        mesh = importer->mesh(0);
+    }
+
+    CORRADE_VERIFY(mesh);
+}
+
+void StlImporterBenchmark::openDataMemory() {
+    auto&& data = OpenDataData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StlImporter");
+    if(data.option) importer->configuration().setValue(data.option, true);
+
+    /* The importer is kept opened and the mesh alive until the measurement
+       ends, so the value is the peak memory needed to get the first mesh */
+    Containers::Optional<MeshData> mesh;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData(_data));
+        mesh = importer->mesh(0);
+    }
+
+    CORRADE_VERIFY(mesh);
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::StlImporterBenchmark)
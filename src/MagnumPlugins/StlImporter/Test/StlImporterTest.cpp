@@ -23,14 +23,16 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
 #include <sstream>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
-#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Endianness.h>
 #include <Corrade/Utility/FormatStl.h>
 #include <Magnum/Math/Vector3.h>
 #include <Magnum/Trade/AbstractImporter.h>
@@ -46,10 +48,18 @@ struct StlImporterTest: TestSuite::Tester {
     void invalid();
     void fileNotFound();
     void ascii();
+    void asciiInvalid();
     void almostAsciiButNotActually();
+    void binaryWithSolidHeader();
     void emptyBinary();
     void binary();
 
+    void deduplicateVertices();
+    void deduplicateVerticesIndexType();
+
+    void memoryMapFile();
+    void borrowData();
+
     void openTwice();
     void importTwice();
 
@@ -98,6 +108,29 @@ const struct {
         "file size doesn't match triangle count, expected 234 but got 235 for 3 triangles"}
 };
 
+const struct {
+    const char* name;
+    const char* data;
+    const char* message;
+} InvalidAsciiData[] {
+    {"not a solid", "solid a\nendsolid a\nsolidus",
+        "expected solid but got solidus"},
+    {"unexpected end", "solid a\n  facet normal 0 0 1\n    outer loop\n",
+        "expected vertex but got end of file"},
+    {"no endsolid", "solid a\n",
+        "expected facet or endsolid but got end of file"},
+    {"unknown keyword", "solid a\n  face normal 0 0 1\n",
+        "expected facet or endsolid but got face"},
+    {"invalid number", "solid a\n  facet normal 0 0,1 1\n",
+        "invalid number 0,1"},
+    {"too few numbers", "solid a\n  facet normal 0 0\n",
+        "expected a number but got end of file"},
+    {"too many vertices", "solid a\n  facet normal 0 0 1\n    outer loop\n"
+        "      vertex 0 0 0\n      vertex 0 0 0\n      vertex 0 0 0\n"
+        "      vertex 0 0 0\n",
+        "expected endloop but got vertex"}
+};
+
 const struct {
     const char* name;
     bool perFaceToPerVertex;
@@ -115,19 +148,78 @@ const struct {
         false, 1, 2, MeshPrimitive::Faces, 2, 1, false, false}
 };
 
+/* Two triangles sharing an edge, the second normal differs in some cases */
+constexpr const char DeduplicateData[] =
+    "solid quad\n"
+    "  facet normal 0 0 1\n"
+    "    outer loop\n"
+    "      vertex 0 0 0\n"
+    "      vertex 1 0 0\n"
+    "      vertex 0 1 0\n"
+    "    endloop\n"
+    "  endfacet\n"
+    "  facet normal 0 0 {}\n"
+    "    outer loop\n"
+    "      vertex 1 0 0\n"
+    "      vertex 1 1 0\n"
+    "      vertex 0 1 0\n"
+    "    endloop\n"
+    "  endfacet\n"
+    "endsolid quad\n";
+
+const struct {
+    const char* name;
+    bool perFaceToPerVertex;
+    Float secondNormalZ;
+    UnsignedInt vertexCount;
+    UnsignedInt expectedIndices[6];
+} DeduplicateVerticesData[]{
+    {"same normals", true, 1.0f, 4,
+        {0, 1, 2, 1, 3, 2}},
+    {"different normals", true, -1.0f, 6,
+        {0, 1, 2, 3, 4, 5}},
+    {"different normals, per-face", false, -1.0f, 4,
+        {0, 1, 2, 1, 3, 2}}
+};
+
+const struct {
+    const char* name;
+    std::size_t triangleCount;
+    MeshIndexType indexType;
+} DeduplicateVerticesIndexTypeData[]{
+    {"255 vertices", 85, MeshIndexType::UnsignedByte},
+    {"258 vertices", 86, MeshIndexType::UnsignedShort},
+    {"65535 vertices", 21845, MeshIndexType::UnsignedShort},
+    {"65538 vertices", 21846, MeshIndexType::UnsignedInt}
+};
+
 StlImporterTest::StlImporterTest() {
     addInstancedTests({&StlImporterTest::invalid},
         Containers::arraySize(InvalidData));
 
     addTests({&StlImporterTest::fileNotFound,
-              &StlImporterTest::ascii,
-              &StlImporterTest::almostAsciiButNotActually,
+              &StlImporterTest::ascii});
+
+    addInstancedTests({&StlImporterTest::asciiInvalid},
+        Containers::arraySize(InvalidAsciiData));
+
+    addTests({&StlImporterTest::almostAsciiButNotActually,
+              &StlImporterTest::binaryWithSolidHeader,
               &StlImporterTest::emptyBinary});
 
     addInstancedTests({&StlImporterTest::binary},
         Containers::arraySize(BinaryData));
 
-    addTests({&StlImporterTest::openTwice,
+    addInstancedTests({&StlImporterTest::deduplicateVertices},
+        Containers::arraySize(DeduplicateVerticesData));
+
+    addInstancedTests({&StlImporterTest::deduplicateVerticesIndexType},
+        Containers::arraySize(DeduplicateVerticesIndexTypeData));
+
+    addTests({&StlImporterTest::memoryMapFile,
+              &StlImporterTest::borrowData,
+
+              &StlImporterTest::openTwice,
               &StlImporterTest::importTwice});
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
@@ -162,10 +254,49 @@ void StlImporterTest::fileNotFound() {
 void StlImporterTest::ascii() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StlImporter");
 
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STLIMPORTER_TEST_DIR, "ascii.stl")));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_VERIFY(!mesh->isIndexed());
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh->attributeCount(), 2);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            { 1.0f, 0.0f, 0.0f},
+            {-1.0f, 0.0f, 0.0f},
+            { 0.0f, 1.0f, 0.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Normal),
+        Containers::arrayView<Vector3>({
+            {0.0f, 0.0f, 1.0f},
+            {0.0f, 0.0f, 1.0f},
+            {0.0f, 0.0f, 1.0f}
+        }), TestSuite::Compare::Container);
+
+    /* Per-face normals should work the same as with binary files */
+    importer->configuration().setValue("perFaceToPerVertex", false);
+    Containers::Optional<MeshData> faces = importer->mesh(0, 1);
+    CORRADE_VERIFY(faces);
+    CORRADE_COMPARE(faces->primitive(), MeshPrimitive::Faces);
+    CORRADE_COMPARE_AS(faces->attribute<Vector3>(MeshAttribute::Normal),
+        Containers::arrayView<Vector3>({
+            {0.0f, 0.0f, 1.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void StlImporterTest::asciiInvalid() {
+    auto&& data = InvalidAsciiData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StlImporter");
+
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(!importer->openFile(Utility::Directory::join(STLIMPORTER_TEST_DIR, "ascii.stl")));
-    CORRADE_COMPARE(out.str(), "Trade::StlImporter::openData(): ASCII STL files are not supported, sorry\n");
+    CORRADE_VERIFY(!importer->openData({data.data, std::strlen(data.data)}));
+    CORRADE_COMPARE(out.str(),
+        Utility::formatString("Trade::StlImporter::openData(): {}\n", data.message));
 }
 
 void StlImporterTest::almostAsciiButNotActually() {
@@ -192,6 +323,31 @@ void StlImporterTest::almostAsciiButNotActually() {
     CORRADE_COMPARE(mesh->attributeCount(), 2);
 }
 
+void StlImporterTest::binaryWithSolidHeader() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StlImporter");
+
+    constexpr const char data[]{
+        /* 80-byte header, starting with the ASCII keyword. As the size matches
+           a binary file with one triangle, it should be treated as binary. */
+        's', 'o', 'l', 'i', 'd', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+
+        1, 0, 0, 0, /* One triangle */
+
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    };
+
+    CORRADE_VERIFY(importer->openData(data));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+}
+
 void StlImporterTest::emptyBinary() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StlImporter");
 
@@ -273,6 +429,147 @@ void StlImporterTest::binary() {
     } else CORRADE_INTERNAL_ASSERT_UNREACHABLE();
 }
 
+void StlImporterTest::deduplicateVertices() {
+    auto&& data = DeduplicateVerticesData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StlImporter");
+    importer->configuration().setValue("deduplicateVertices", true);
+    importer->configuration().setValue("perFaceToPerVertex", data.perFaceToPerVertex);
+
+    const std::string file = Utility::formatString(DeduplicateData, data.secondNormalZ);
+    CORRADE_VERIFY(importer->openData({file.data(), file.size()}));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(mesh->isIndexed());
+    CORRADE_COMPARE(mesh->indexType(), MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE_AS(mesh->indicesAsArray(),
+        Containers::arrayView(data.expectedIndices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(mesh->vertexCount(), data.vertexCount);
+    CORRADE_COMPARE(mesh->attributeCount(), data.perFaceToPerVertex ? 2 : 1);
+
+    /* The positions in the order they're first referenced */
+    Containers::Array<Vector3> positions = mesh->positions3DAsArray();
+    const UnsignedInt* indices = data.expectedIndices;
+    const Vector3 expectedPositions[]{
+        {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}
+    };
+    for(std::size_t i = 0; i != 6; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(positions[indices[i]], expectedPositions[i]);
+    }
+
+    if(data.perFaceToPerVertex) {
+        Containers::Array<Vector3> normals = mesh->normalsAsArray();
+        for(std::size_t i = 0; i != 6; ++i) {
+            CORRADE_ITERATION(i);
+            CORRADE_COMPARE(normals[indices[i]], (Vector3{0.0f, 0.0f, i < 3 ? 1.0f : data.secondNormalZ}));
+        }
+
+    /* Per-face normals are still available in the second level */
+    } else {
+        CORRADE_COMPARE(importer->meshLevelCount(0), 2);
+        Containers::Optional<MeshData> faces = importer->mesh(0, 1);
+        CORRADE_VERIFY(faces);
+        CORRADE_VERIFY(!faces->isIndexed());
+        CORRADE_COMPARE_AS(faces->attribute<Vector3>(MeshAttribute::Normal),
+            Containers::arrayView<Vector3>({
+                {0.0f, 0.0f, 1.0f},
+                {0.0f, 0.0f, -1.0f}
+            }), TestSuite::Compare::Container);
+    }
+}
+
+void StlImporterTest::deduplicateVerticesIndexType() {
+    auto&& data = DeduplicateVerticesIndexTypeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* A binary file where all vertices are unique, thus the vertex count is
+       three times the triangle count */
+    Containers::Array<char> file{ValueInit, 84 + data.triangleCount*50};
+    const UnsignedInt triangleCount = Utility::Endianness::littleEndian(UnsignedInt(data.triangleCount));
+    std::memcpy(file + 80, &triangleCount, 4);
+    for(std::size_t i = 0; i != data.triangleCount; ++i) {
+        Float positions[9]{};
+        for(std::size_t j = 0; j != 3; ++j)
+            positions[j*3] = Utility::Endianness::littleEndian(Float(i*3 + j));
+        std::memcpy(file + 84 + i*50 + 12, positions, sizeof(positions));
+    }
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StlImporter");
+    importer->configuration().setValue("deduplicateVertices", true);
+    CORRADE_VERIFY(importer->openData(file));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indexType(), data.indexType);
+    CORRADE_COMPARE(mesh->indexCount(), data.triangleCount*3);
+    CORRADE_COMPARE(mesh->vertexCount(), data.triangleCount*3);
+
+    /* All vertices are unique, so the indices are just a sequence */
+    Containers::Array<UnsignedInt> indices = mesh->indicesAsArray();
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        if(indices[i] != i) {
+            CORRADE_ITERATION(i);
+            CORRADE_COMPARE(indices[i], UnsignedInt(i));
+        }
+    }
+}
+
+void StlImporterTest::memoryMapFile() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StlImporter");
+    importer->configuration().setValue("memoryMapFile", true);
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(STLIMPORTER_TEST_DIR, "binary.stl")));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+
+    /* The mesh owns its data, so it should be usable even after the file
+       gets unmapped */
+    importer->close();
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f},
+            {7.0f, 8.0f, 9.0f},
+
+            {1.1f, 2.1f, 3.1f},
+            {4.1f, 5.1f, 6.1f},
+            {7.1f, 8.1f, 9.1f}
+        }), TestSuite::Compare::Container);
+}
+
+void StlImporterTest::borrowData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StlImporter");
+    importer->configuration().setValue("borrowData", true);
+
+    Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(STLIMPORTER_TEST_DIR, "binary.stl"));
+    CORRADE_VERIFY(importer->openData(data));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+
+    /* The mesh owns its data, so it should stay intact even if the borrowed
+       memory gets changed */
+    importer->close();
+    for(char& i: data) i = 0;
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f},
+            {7.0f, 8.0f, 9.0f},
+
+            {1.1f, 2.1f, 3.1f},
+            {4.1f, 5.1f, 6.1f},
+            {7.1f, 8.1f, 9.1f}
+        }), TestSuite::Compare::Container);
+}
+
 void StlImporterTest::openTwice() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("StlImporter");
 
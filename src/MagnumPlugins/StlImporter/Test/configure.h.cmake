@@ -25,3 +25,4 @@
 
 #cmakedefine STLIMPORTER_PLUGIN_FILENAME "${STLIMPORTER_PLUGIN_FILENAME}"
 #define STLIMPORTER_TEST_DIR "${STLIMPORTER_TEST_DIR}"
+#define STLIMPORTER_TEST_OUTPUT_DIR "${STLIMPORTER_TEST_OUTPUT_DIR}"